@@ -20,6 +20,7 @@
             2014.08.24 adapted to modified item set reporter interface
             2014.08.28 functions acc_data() and acc_repo() added
             2014.10.24 changed from LGPL license to MIT license
+            2026.10.18 option -B added (binary item set output)
 ------------------------------------------------------------------------
   Reference for the Accretion algorithm:
     G.L. Gerstein, D.H. Perkel and K.N. Subramanian.
@@ -582,6 +583,7 @@ int main (int argc, char *argv[])
   int     scan     = 0;         /* mode for item set reporting */
   int     bdrcnt   = 0;         /* number of support values in border */
   int     stats    = 0;         /* flag for item set statistics */
+  int     binary   = 0;         /* flag for binary output format */
   PATSPEC *psp;                 /* collected pattern spectrum */
   ITEM    m;                    /* number of items */
   TID     n;                    /* number of transactions */
@@ -633,6 +635,8 @@ int main (int argc, char *argv[])
     printf("-P#      write a pattern spectrum to a file\n");
     printf("-Z       print item set statistics "
                     "(number of item sets per size)\n");
+    printf("-B       write item sets in binary format "
+                    "(compressed)\n");
     printf("-g       write output in scanable form "
                     "(quote certain characters)\n");
     printf("-h#      record header  for output                "
@@ -682,6 +686,7 @@ int main (int argc, char *argv[])
           case 'R': optarg = &fn_sel;                break;
           case 'P': optarg = &fn_psp;                break;
           case 'Z': stats  = 1;                      break;
+          case 'B': binary = 1;                      break;
           case 'g': scan   = 1;                      break;
           case 'h': optarg = &hdr;                   break;
           case 'k': optarg = &sep;                   break;
@@ -795,7 +800,8 @@ int main (int argc, char *argv[])
     error(E_NOMEM);             /* set a pattern spectrum if req. */
   if (isr_setfmt(report, scan, hdr, sep, NULL, info) != 0)
     error(E_NOMEM);             /* set the output format strings */
-  k = isr_open(report, NULL, fn_out);
+  k = (binary) ? isr_openbin(report, NULL, fn_out)
+               : isr_open   (report, NULL, fn_out);
   if (k) error(k, isr_name(report)); /* open the item set file */
   if ((acc_repo(report, target, ACC_VERBOSE) < 0)
   ||  (isr_setup(report) < 0))  /* prepare reporter for Accretion */
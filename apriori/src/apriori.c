@@ -91,6 +91,10 @@
             2014.08.21 adapted to modified item set reporter interface
             2014.08.28 functions apriori_data() and apriori_repo() added
             2014.10.24 changed from LGPL license to MIT license
+            2026.10.18 option -N# added (number of counting threads)
+            2026.10.18 option -M added (no triangular matrix for pairs)
+            2026.10.18 option -B added (binary item set output)
+            2026.10.18 progress/cancellation polling per item set size
 ------------------------------------------------------------------------
   Reference for the Apriori algorithm:
     R. Agrawal and R. Srikant.
@@ -371,6 +375,8 @@ int apriori (TABAG *tabag, int target, SUPP smin, SUPP body,
     else          ist_countb(a.istree, tabag);
     ist_commit(a.istree);       /* count the transaction tree/bag */
     tc = clock() -x;            /* compute the new counting time */
+    if (isr_poll(report) < 0)   /* call the progress function */
+      return cleanup(&a);       /* and check for a cancellation */
   }
   free(a.map); a.map = NULL;    /* delete filter map and trans. tree */
   if (!(mode & APR_NOCLEAN) && a.tatree) {
@@ -610,6 +616,7 @@ int main (int argc, char *argv[])
   int     scan     = 0;         /* flag for scanable item output */
   int     bdrcnt   = 0;         /* number of support values in border */
   int     stats    = 0;         /* flag for item set statistics */
+  int     binary   = 0;         /* flag for binary output format */
   PATSPEC *psp;                 /* collected pattern spectrum */
   ITEM    m;                    /* number of items */
   TID     n;                    /* number of transactions */
@@ -664,6 +671,8 @@ int main (int argc, char *argv[])
     printf("-P#      write a pattern spectrum to a file\n");
     printf("-Z       print item set statistics "
                     "(number of item sets per size)\n");
+    printf("-B       write item sets in binary format "
+                    "(compressed)\n");
     printf("-g       write output in scanable form "
                     "(quote certain characters)\n");
     printf("-h#      record header  for output                "
@@ -712,6 +721,7 @@ int main (int argc, char *argv[])
           case 'R': optarg = &fn_sel;                break;
           case 'P': optarg = &fn_psp;                break;
           case 'Z': stats  = 1;                      break;
+          case 'B': binary = 1;                      break;
           case 'g': scan   = 1;                      break;
           case 'h': optarg = &hdr;                   break;
           case 'k': optarg = &sep;                   break;
@@ -829,7 +839,8 @@ int main (int argc, char *argv[])
     error(E_NOMEM);             /* set a pattern spectrum if req. */
   if (isr_setfmt(report, scan, hdr, sep, NULL, info) != 0)
     error(E_NOMEM);             /* set the output format strings */
-  k = isr_open(report, NULL, fn_out);
+  k = (binary) ? isr_openbin(report, NULL, fn_out)
+               : isr_open   (report, NULL, fn_out);
   if (k) error(k, isr_name(report)); /* open the output file */
   if (isr_setup(report) < 0)    /* set up the item set reporter */
     error(E_NOMEM);             /* (prepare reporter for output) */
@@ -902,12 +913,14 @@ int main (int argc, char *argv[])
   int     sort     = 2;         /* flag for item sorting and recoding */
   int     algo     = APR_BASIC; /* variant of apriori algorithm */
   int     mode     = APR_DEFAULT;  /* search mode (e.g. pruning) */
+  int     cpus     = 1;         /* number of threads for counting */
   double  filter   = 0.01;      /* item usage filtering parameter */
   int     order    = 0;         /* size order item set/rule output */
   int     mtar     = 0;         /* mode for transaction reading */
   int     scan     = 0;         /* flag for scanable item output */
   int     bdrcnt   = 0;         /* number of support values in border */
   int     stats    = 0;         /* flag for item set statistics */
+  int     binary   = 0;         /* flag for binary output format */
   PATSPEC *psp;                 /* collected pattern spectrum */
   ITEM    m;                    /* number of items */
   TID     n;                    /* number of transactions */
@@ -969,6 +982,9 @@ int main (int argc, char *argv[])
                     "(default: prune)\n");
     printf("-y       a-posteriori pruning of infrequent item sets\n");
     printf("-T       do not organize transactions as a prefix tree\n");
+    printf("-M       do not count item pairs with a triangular matrix\n");
+    printf("-N#      number of threads for support counting   "
+                    "(default: %d)\n", cpus);
     printf("-F#:#..  support border for filtering item sets   "
                     "(default: none)\n");
     printf("         (list of minimum support values, "
@@ -979,6 +995,8 @@ int main (int argc, char *argv[])
     printf("-P#      write a pattern spectrum to a file\n");
     printf("-Z       print item set statistics "
                     "(number of item sets per size)\n");
+    printf("-B       write item sets in binary format "
+                    "(compressed)\n");
     printf("-g       write item names in scanable form "
                     "(quote certain characters)\n");
     printf("-h#      record header  for output                "
@@ -1010,7 +1028,7 @@ int main (int argc, char *argv[])
     return 0;                   /* print a usage message */
   }                             /* and abort the program */
   #endif  /* #ifndef QUIET */
-  /* free option characters: il [A-Z]\[CFIPSTZ] */
+  /* free option characters: il [A-Z]\[CFIMNPSTZ] */
 
   /* --- evaluate arguments --- */
   for (i = 1; i < argc; i++) {  /* traverse the arguments */
@@ -1037,10 +1055,13 @@ int main (int argc, char *argv[])
           case 'x': mode  &= ~APR_PERFECT;           break;
           case 'y': mode  |=  APR_POST;              break;
           case 'T': mode  &= ~APR_TATREE;            break;
+          case 'M': mode  &= ~APR_PAIRS;             break;
+          case 'N': cpus   = (int) strtol(s, &s, 0); break;
           case 'F': bdrcnt = getbdr(s, &s, &border); break;
           case 'R': optarg = &fn_sel;                break;
           case 'P': optarg = &fn_psp;                break;
           case 'Z': stats  = 1;                      break;
+          case 'B': binary = 1;                      break;
           case 'g': scan   = 1;                      break;
           case 'h': optarg = &hdr;                   break;
           case 'k': optarg = &sep;                   break;
@@ -1072,6 +1093,8 @@ int main (int argc, char *argv[])
   if (bdrcnt < 0)   error(E_NOMEM);
   if ((conf  < 0) || (conf > 100))
     error(E_CONF, conf);        /* check the minimum confidence */
+  if (cpus > 1)                 /* add the number of threads */
+    mode |= (cpus < APR_CPUS) ? cpus : APR_CPUS;
   if ((!fn_inp || !*fn_inp) && (fn_sel && !*fn_sel))
     error(E_STDIN);             /* stdin must not be used twice */
   switch (target) {             /* check and translate target type */
@@ -1121,6 +1144,8 @@ int main (int argc, char *argv[])
     filter = 0;                 /* check and adapt the filter option */
   if (target & ISR_RULES) fn_psp = NULL;
   else conf = 100;              /* no pattern spectrum for rules */
+  if ((target & ISR_RULES) && binary)
+    error(E_TARGET, 'r');       /* binary format only for item sets */
   if (info == dflt) {           /* if default info. format is used, */
     if (target != ISR_RULES)    /* set default according to target */
          info = (supp < 0) ? " (%a)"     : " (%S)";
@@ -1190,7 +1215,8 @@ int main (int argc, char *argv[])
     error(E_NOMEM);             /* set a pattern spectrum if req. */
   if (isr_setfmt(report, scan, hdr, sep, imp, info) != 0)
     error(E_NOMEM);             /* set the output format strings */
-  k = isr_open(report, NULL, fn_out);
+  k = (binary) ? isr_openbin(report, NULL, fn_out)
+               : isr_open   (report, NULL, fn_out);
   if (k) error(k, isr_name(report)); /* open item set output file */
   if ((apriori_repo(report, target, eval, thresh, algo, mode) < 0)
   ||  (isr_setup(report) < 0))  /* prepare reporter for Apriori */
@@ -7,6 +7,8 @@
             2013.03.30 adapted to type changes in module tract
             2014.08.21 parameter 'body' added to function apriori()
             2014.08.28 functions apriori_data() and apriori_repo() added
+            2026.10.18 mode field APR_CPUS added (threads for counting)
+            2026.10.18 mode flag APR_PAIRS added (triangular matrix)
 ----------------------------------------------------------------------*/
 #ifndef __APRIORI__
 #define __APRIORI__
@@ -31,10 +33,12 @@
 #define APR_AVG     IST_AVG     /* average of measure values */
 
 /* --- operation modes --- */
+#define APR_CPUS    IST_CPUS    /* number of threads for counting */
 #define APR_PERFECT IST_PERFECT /* prune with perfect extensions */
+#define APR_PAIRS   IST_PAIRS   /* count pairs with a tri. matrix */
 #define APR_TATREE  0x1000      /* use transaction tree */
 #define APR_POST    0x2000      /* use a-posteriori pruning */
-#define APR_DEFAULT (APR_PERFECT|APR_TATREE)
+#define APR_DEFAULT (APR_PERFECT|APR_PAIRS|APR_TATREE)
 #ifdef NDEBUG
 #define APR_NOCLEAN 0x8000      /* do not clean up memory */
 #else                           /* in function apriori() */
@@ -89,6 +89,11 @@
             2014.08.22 bugs in functions ist_down(), ist_[]supp() fixed
             2014.08.28 function ist_clomax() adapted to IST_REVERSE
             2014.11.14 bug in function evaluate() fixed (negative index)
+            2026.10.18 multi-threaded counting (split of root subtrees)
+            2026.10.18 triangular matrix for counting item pairs added
+            2026.10.18 bound-based pruning of rule generation (top-k)
+            2026.10.18 abort of item set/rule reporting propagated
+            2026.10.18 counting threads started with tpl_exec()
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -99,6 +104,9 @@
 #include "istree.h"
 #include "chi2.h"
 #include "gamma.h"
+#ifdef IST_THREADS
+#include "thdpool.h"
+#endif
 #ifdef STORAGE
 #include "storage.h"
 #endif
@@ -165,6 +173,34 @@
 /* Note that not all 64 bit architectures need pointers to be aligned */
 /* to addresses divisible by 8. Use ALIGN8 only if this is the case.  */
 
+#ifdef IST_THREADS
+#ifndef IST_PARMIN              /* minimum number of transactions */
+#define IST_PARMIN  1024        /* (or tree nodes) for using threads */
+#endif
+#endif
+
+#ifndef IST_TRIMAX              /* maximum number of counters */
+#define IST_TRIMAX  0x04000000  /* in a triangular pair matrix */
+#endif
+#define TRIROW(m,a) ((((size_t)(a)*(size_t)((m)+(m)-(a)-1)) >> 1) \
+                    -(size_t)(a) -1)
+/* TRIROW(m,a) +b is the index of the counter of the item pair (a,b), */
+/* a < b, in a packed triangular matrix over m items (row by row).   */
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+#ifdef IST_THREADS
+typedef struct {                /* --- counting thread data --- */
+  ISTNODE      *root;           /* root with a subset of the children */
+  const TABAG  *bag;            /* transaction bag to count */
+#ifdef TATREEFN
+  const TATREE *tree;           /* transaction tree to count */
+#endif
+  ITEM         min;             /* minimum number of items */
+} CNTWORK;                      /* (counting thread data) */
+#endif
+
 /*----------------------------------------------------------------------
   Auxiliary Functions
 ----------------------------------------------------------------------*/
@@ -530,6 +566,239 @@ static void countx (ISTNODE *node, const TANODE *tan, ITEM min)
 
 #endif  /* #ifdef TATCOMPACT .. #else .. */
 #endif  /* #ifdef TATREEFN */
+
+/*--------------------------------------------------------------------*/
+
+static void countb (ISTNODE *root, const TABAG *bag, ITEM min)
+{                               /* --- count a transaction bag */
+  TID   i;                      /* loop variable */
+  ITEM  k;                      /* number of items */
+  TRACT *t;                     /* to traverse the transactions */
+
+  assert(root && bag);          /* check the function arguments */
+  for (i = tbg_cnt(bag); --i >= 0; ) {
+    t = tbg_tract(bag, i);      /* traverse the transactions */
+    k = ta_size(t);             /* get the transaction size and */
+    if (k >= min)               /* count the transaction recursively */
+      count(root, ta_items(t), k, ta_wgt(t), min);
+  }
+}  /* countb() */
+
+/*--------------------------------------------------------------------*/
+#ifdef IST_THREADS
+
+static int worker (void *p)
+{                               /* --- worker function for a thread */
+  CNTWORK *w = (CNTWORK*)p;     /* type the argument pointer */
+
+  assert(p);                    /* check the function argument */
+  #ifdef TATREEFN               /* if transaction trees are available */
+  if (w->tree) countx(w->root, tat_root(w->tree), w->min);
+  else                          /* count the transaction tree */
+  #endif                        /* or the transaction bag */
+  countb(w->root, w->bag, w->min);
+  return 0;                     /* return 'ok' */
+}  /* worker() */
+
+/*--------------------------------------------------------------------*/
+
+static int countp (ISTREE *ist, const CNTWORK *data)
+{                               /* --- count with multiple threads */
+  int     i, k;                 /* loop variable, number of threads */
+  ITEM    j, n;                 /* loop variable, number of children */
+  size_t  z, x;                 /* size of root node and its copies */
+  char    *copies;              /* copies of the root node */
+  ISTNODE *root, **src, **chn;  /* root node and its child arrays */
+  ISTNODE *leaf;                /* placeholder for the first child */
+  CNTWORK *w;                   /* data for the counting threads */
+
+  assert(ist && data);          /* check the function arguments */
+  k    = ist->mode & IST_CPUS;  /* get the number of threads */
+  root = ist->lvls[0];          /* and the root node */
+  if ((k <= 1) || (root->offset < 0) || (root->chcnt <= 1))
+    return -1;                  /* check whether threads can be used */
+  n = root->chcnt;              /* get the number of children */
+  if (k > n) k = (int)n;        /* (at most one thread per child) */
+  src = (ISTNODE**)(root->cnts +root->size);
+  ALIGN(src);                   /* get the child node array */
+  z = (size_t)((char*)(src+n) -(char*)root);
+  z = (z +15) & ~(size_t)15;    /* compute the size of a root copy */
+  x = z +((sizeof(ISTNODE) +15) & ~(size_t)15);
+  w = (CNTWORK*)malloc((size_t)k *sizeof(CNTWORK));
+  if (!w) return -1;            /* create the thread data */
+  copies = (char*)malloc((size_t)k *x);
+  if (!copies) { free(w); return -1; }
+  for (i = 0; i < k; i++) {     /* traverse the threads */
+    w[i] = *data;               /* copy the counting parameters */
+    w[i].root = (ISTNODE*)(copies +(size_t)i *x);
+    memcpy(w[i].root, root, (size_t)((char*)(src+n) -(char*)root));
+    chn = (ISTNODE**)(w[i].root->cnts +root->size);
+    ALIGN(chn);                 /* keep only every k-th child, */
+    for (j = 0; j < n; j++)     /* so that each thread counts into */
+      if (j % k != i) chn[j] = NULL;   /* a disjoint set of subtrees */
+    if (chn[0]) continue;       /* (no merging of counters needed) */
+    leaf = (ISTNODE*)(copies +(size_t)i *x +z);
+    leaf->succ   = leaf->parent = NULL;
+    leaf->item   = src[0]->item;/* the first child yields the offset */
+    leaf->offset = ITEM_MAX;    /* of the child array, so it must */
+    leaf->size   = leaf->chcnt = 0; /* exist: replace it with */
+    chn[0] = leaf;              /* an empty leaf node (no counters) */
+  }
+  tpl_exec(w, sizeof(CNTWORK), k, worker);
+                                /* count in one thread per part */
+  free(copies); free(w);        /* delete the root node copies */
+  return 0;                     /* and the thread data */
+}  /* countp() */
+
+#endif  /* #ifdef IST_THREADS */
+
+/*----------------------------------------------------------------------
+  Pair Counting Functions
+----------------------------------------------------------------------*/
+
+static SUPP* trimat (ISTREE *ist)
+{                               /* --- create a triangular matrix */
+  ITEM    i, m;                 /* loop variable, number of items */
+  size_t  n, z;                 /* number of matrix cells/counters */
+  ISTNODE *root, **chn;         /* root node and its child array */
+
+  assert(ist);                  /* check the function argument */
+  root = ist->lvls[0];          /* get the root node */
+  if ((ist->height != 2)        /* only for the pairs of items */
+  || !(ist->mode & IST_PAIRS)   /* if the matrix is requested */
+  ||  (ist->mode & IST_REVERSE) /* (items in ascending order) */
+  ||  (root->offset < 0) || (root->chcnt <= 0))
+    return NULL;                /* check whether a matrix can be used */
+  m = root->size;               /* get the number of items */
+  n = ((size_t)m *(size_t)(m-1)) >> 1;
+  if (n > IST_TRIMAX) return NULL; /* check the matrix size */
+  chn = (ISTNODE**)(root->cnts +root->size);
+  ALIGN(chn);                   /* get the child node array */
+  for (z = 0, i = root->chcnt; --i >= 0; )
+    if (chn[i]) z += (size_t)chn[i]->size;
+  if (n > z+z +(size_t)m)       /* sum the level 2 counters and */
+    return NULL;                /* check whether they are too sparse */
+  return (SUPP*)calloc(n, sizeof(SUPP));
+}  /* trimat() */               /* allocate the matrix counters */
+
+/*--------------------------------------------------------------------*/
+
+static void pairb (SUPP *tri, ITEM m, const TABAG *bag)
+{                               /* --- count pairs in a trans. bag */
+  TID        i;                 /* loop variable for transactions */
+  ITEM       a;                 /* first item of a pair */
+  size_t     r;                 /* offset of the matrix row */
+  SUPP       w;                 /* transaction weight */
+  const ITEM *s, *p, *e;        /* to traverse the items */
+  TRACT      *t;                /* to traverse the transactions */
+
+  assert(tri && bag);           /* check the function arguments */
+  for (i = tbg_cnt(bag); --i >= 0; ) {
+    t = tbg_tract(bag, i);      /* traverse the transactions */
+    if (ta_size(t) < 2) continue;
+    s = ta_items(t);            /* get the transaction items, */
+    e = s +ta_size(t);          /* their end, and the weight */
+    w = ta_wgt(t);              /* (items are in ascending order) */
+    for ( ; s < e-1; s++) {     /* traverse the first items */
+      a = *s; r = TRIROW(m, a); /* get the matrix row of the item */
+      for (p = s+1; p < e; p++) /* traverse the second items and */
+        tri[r +(size_t)*p] += w;/* add the weight to the counters */
+    }                           /* of all pairs in the transaction */
+  }
+}  /* pairb() */
+
+/*--------------------------------------------------------------------*/
+#ifdef TATREEFN
+#ifdef TATCOMPACT
+
+static void pairx (SUPP *tri, ITEM m, const TANODE *tan,
+                   size_t *rows, ITEM d)
+{                               /* --- count pairs in a trans. tree */
+  ITEM       i, k, n;           /* loop variables, number of items */
+  size_t     r;                 /* offset of a matrix column */
+  SUPP       w;                 /* weight of transaction(s) */
+  const ITEM *s;                /* items of a transaction suffix */
+  TANODE     *cld;              /* child node in transaction tree */
+
+  assert(tri && tan && rows);   /* check the function arguments */
+  n = tan_max(tan);             /* get the maximum tansaction length */
+  k = n & ~ITEM_MIN;            /* if the transactions do not */
+  if (d +k < 2) return;         /* contain a pair, abort */
+  if (n <= 0) {                 /* if this is a leaf node */
+    if (n == 0) return;         /* (there must be a suffix) */
+    s = tan_suffix(tan); w = tan_wgt(tan);
+    for (n = 0; n < k; n++) {   /* traverse the suffix items */
+      r = (size_t)s[n];         /* add pairs with preceding items */
+      for (i = 0; i < d; i++) tri[rows[i] +r] += w;
+      rows[d++] = TRIROW(m, s[n]);
+    } return; }                 /* extend the item path */
+  for (cld = tan_children(tan); cld; cld = tan_sibling(cld)) {
+    r = (size_t)tan_item(cld);  /* traverse the child nodes */
+    w = tan_wgt(cld);           /* add pairs with the path items */
+    for (i = 0; i < d; i++) tri[rows[i] +r] += w;
+    rows[d] = TRIROW(m, tan_item(cld));
+    pairx(tri, m, cld, rows, d+1);
+  }                             /* count the subtrees recursively */
+}  /* pairx() */
+
+/*--------------------------------------------------------------------*/
+#else  /* #ifdef TATCOMPACT */
+
+static void pairx (SUPP *tri, ITEM m, const TANODE *tan,
+                   size_t *rows, ITEM d)
+{                               /* --- count pairs in a trans. tree */
+  ITEM       i, k, n;           /* loop variables, number of items */
+  size_t     r;                 /* offset of a matrix column */
+  SUPP       w;                 /* weight of transaction(s) */
+  const ITEM *s;                /* items of a transaction suffix */
+  TANODE     *cld;              /* child node in transaction tree */
+
+  assert(tri && tan && rows);   /* check the function arguments */
+  if (d +tan_max(tan) < 2)      /* if the transactions do not */
+    return;                     /* contain a pair, abort */
+  n = tan_size(tan);            /* get the number of children */
+  if (n <= 0) {                 /* if there are no children */
+    s = tan_items(tan); w = tan_wgt(tan);
+    for (k = 0; k < -n; k++) {  /* traverse the suffix items */
+      r = (size_t)s[k];         /* add pairs with preceding items */
+      for (i = 0; i < d; i++) tri[rows[i] +r] += w;
+      rows[d++] = TRIROW(m, s[k]);
+    } return; }                 /* extend the item path */
+  for (k = 0; k < n; k++) {     /* traverse the node's items */
+    cld = tan_child(tan, k);    /* and the corresp. child nodes */
+    r   = (size_t)tan_item(tan, k);
+    w   = tan_wgt(cld);         /* add pairs with the path items */
+    for (i = 0; i < d; i++) tri[rows[i] +r] += w;
+    rows[d] = TRIROW(m, tan_item(tan, k));
+    pairx(tri, m, cld, rows, d+1);
+  }                             /* count the subtrees recursively */
+}  /* pairx() */
+
+#endif  /* #ifdef TATCOMPACT .. #else .. */
+#endif  /* #ifdef TATREEFN */
+
+/*--------------------------------------------------------------------*/
+
+static void seed (ISTREE *ist, SUPP *tri)
+{                               /* --- transfer the pair counters */
+  ITEM    i, k;                 /* loop variables */
+  size_t  r;                    /* offset of the matrix row */
+  ISTNODE *root, **chn, *node;  /* root node, child array, child */
+
+  assert(ist && tri);           /* check the function arguments */
+  root = ist->lvls[0];          /* get the root node */
+  chn  = (ISTNODE**)(root->cnts +root->size);
+  ALIGN(chn);                   /* get the child node array */
+  for (i = 0; i < root->chcnt; i++) {
+    node = chn[i];              /* traverse the child nodes */
+    if (!node) continue;        /* (nodes for the first items) */
+    r = TRIROW(root->size, ITEMOF(node));
+    for (k = 0; k < node->size; k++)
+      INC(node->cnts[k], tri[r +(size_t)ITEMAT(node, k)]);
+  }                             /* copy the pair counters */
+  free(tri);                    /* to the item set tree and */
+}  /* seed() */                 /* delete the triangular matrix */
+
 /*----------------------------------------------------------------------
   Evaluation Functions
 ----------------------------------------------------------------------*/
@@ -701,19 +970,29 @@ void ist_countt (ISTREE *ist, const TRACT *t)
 
 void ist_countb (ISTREE *ist, const TABAG *bag)
 {                               /* --- count a transaction bag */
-  TID   i;                      /* loop variable */
-  ITEM  k;                      /* number of items */
-  TRACT *t;                     /* to traverse the transactions */
+  SUPP    *tri;                 /* triangular matrix for pairs */
+  #ifdef IST_THREADS            /* if multi-threading is available */
+  CNTWORK w;                    /* counting parameters for threads */
+  #endif
 
   assert(ist && bag);           /* check the function arguments */
   if (!tbg_max(bag) >= ist->height)
     return;                     /* check for suff. long transactions */
-  for (i = tbg_cnt(bag); --i >= 0; ) {
-    t = tbg_tract(bag, i);      /* traverse the transactions */
-    k = ta_size(t);             /* get the transaction size and */
-    if (k >= ist->height)       /* count the transaction recursively */
-      count(ist->lvls[0], ta_items(t), k, ta_wgt(t), ist->height);
-  }
+  #ifdef IST_THREADS            /* if multi-threading is available */
+  if (tbg_cnt(bag) >= IST_PARMIN) {
+    w.bag = bag; w.min = ist->height;
+    #ifdef TATREEFN             /* if there are enough transactions, */
+    w.tree = NULL;              /* try to count with multiple threads */
+    #endif
+    if (countp(ist, &w) >= 0) return;
+  }                             /* if threads cannot be used, */
+  #endif                        /* count in the calling thread */
+  tri = trimat(ist);            /* if the item pairs are counted, */
+  if (tri) {                    /* try to use a triangular matrix */
+    pairb(tri, ist->lvls[0]->size, bag);
+    seed(ist, tri); return;     /* count the pairs in the matrix and */
+  }                             /* transfer them to the tree nodes */
+  countb(ist->lvls[0], bag, ist->height);
 }  /* ist_countb() */
 
 /*--------------------------------------------------------------------*/
@@ -721,7 +1000,29 @@ void ist_countb (ISTREE *ist, const TABAG *bag)
 
 void ist_countx (ISTREE *ist, const TATREE *tree)
 {                               /* --- count transaction in tree */
+  SUPP    *tri;                 /* triangular matrix for pairs */
+  size_t  *rows;                /* matrix rows of the path items */
+  #ifdef IST_THREADS            /* if multi-threading is available */
+  CNTWORK w;                    /* counting parameters for threads */
+  #endif
+
   assert(ist && tree);          /* check the function arguments */
+  #ifdef IST_THREADS            /* if multi-threading is available */
+  if (tat_size(tree) >= IST_PARMIN) {
+    w.bag = NULL; w.tree = tree; w.min = ist->height;
+    if (countp(ist, &w) >= 0) return;
+  }                             /* try to count with multiple threads */
+  #endif                        /* otherwise count in this thread */
+  tri = trimat(ist);            /* if the item pairs are counted, */
+  if (tri) {                    /* try to use a triangular matrix */
+    rows = (size_t*)malloc((size_t)(ist->lvls[0]->size+1)
+                          *sizeof(size_t));
+    if (rows) {                 /* create a buffer for the item path */
+      pairx(tri, ist->lvls[0]->size, tat_root(tree), rows, 0);
+      free(rows); seed(ist, tri); return;
+    }                           /* count the pairs in the matrix and */
+    free(tri);                  /* transfer them to the tree nodes */
+  }
   countx(ist->lvls[0], tat_root(tree), ist->height);
 }  /* ist_countx() */           /* recursively count the trans. tree */
 
@@ -1930,8 +2231,8 @@ static int isets (ISTREE *ist, ISREPORT *rep, ISTNODE *node, SUPP supp)
       supp = node->cnts[i];     /* get the item support (with flag) */
       k -= off;                 /* compute the child node index */
       if ((k >= 0)              /* if the corresp. child node exists, */
-      &&  (k <  c) && chn[k])   /* recursively report the subtree */
-        isets(ist, rep, chn[k], supp);
+      &&  (k <  c) && chn[k]) { /* recursively report the subtree */
+        if (isets(ist, rep, chn[k], supp) < 0) return -1; }
       else if (!IS2SKIP(supp)){ /* report item set if not marked */
         v = evaluate(ist, node, i);
         if ((v *ist->dir >= ist->thresh)
@@ -1957,8 +2258,8 @@ static int isets (ISTREE *ist, ISREPORT *rep, ISTNODE *node, SUPP supp)
       if (k <= c)               /* if there may be a child node, */
         while (ITEMOF(*chn) < k) chn++;  /* skip preceding items */
       if ((k <= c)              /* if the corresp. child node exists, */
-      &&  (k == ITEMOF(*chn)))  /* recursively report the subtree */
-        isets(ist, rep, *chn, supp);
+      &&  (k == ITEMOF(*chn))) {/* recursively report the subtree */
+        if (isets(ist, rep, *chn, supp) < 0) return -1; }
       else if (!IS2SKIP(supp)){ /* report item set if not marked */
         v = evaluate(ist, node, i);
         if ((v *ist->dir >= ist->thresh)
@@ -1990,6 +2291,8 @@ static int r4set (ISTREE *ist, ISREPORT *rep, ISTNODE *node, ITEM index)
   &&     rep && node && (index >= 0));
   refn = ((ist->eval > RE_NONE) && (ist->eval < RE_FNCNT))
        ? re_function(ist->eval) : (RULEVALFN*)0;
+  if (isr_tkdir(rep) && (isr_tkeval(rep) > ist->thresh))
+    ist->thresh = isr_tkeval(rep); /* raise threshold for top-k */
   base = COUNT(ist->wgt);       /* get base and item set support */
   supp = COUNT(node->cnts[index]);
   item = (node->offset >= 0) ? node->offset +index
@@ -2027,15 +2330,19 @@ static int r4set (ISTREE *ist, ISREPORT *rep, ISTNODE *node, ITEM index)
   ist->path = ist->buf +ist->height;
   *--ist->path = item; n = 1;   /* store head item on the path */
   for ( ; parent; node = parent, parent = node->parent) {
-    body = COUNT(getsupp(parent, ist->path, n));
-    *--ist->path = item = node->item;
+    item = node->item;          /* get the next head candidate */
+    head = COUNT(ist->lvls[0]->cnts[item]);
+    app  = (ib_getapp(ist->base, item) & APP_HEAD)
+        && (!refn || (ist->dir *re_bound(ist->eval, supp, head, base)
+                      >= ist->thresh));
+    if (app)                    /* if the rule may qualify, */
+      body = COUNT(getsupp(parent, ist->path, n));  /* get body supp. */
+    *--ist->path = item;        /* store the item on the path */
     n += 1;                     /* traverse the path to the root */
-    if (!(ib_getapp(ist->base, item) & APP_HEAD))
-      continue;                 /* check whether item can be a head */
+    if (!app) continue;         /* check whether item can be a head */
     if ((body < ist->body)      /* check the body support */
     ||  ((double)supp < (double)body *ist->conf))
       continue;                 /* check the rule confidence */
-    head = COUNT(ist->lvls[0]->cnts[item]);
     if (!refn) val = 0;         /* if no add. eval. measure given, */
     else {                      /* clear the evaluation, otherwise */
       val = (!ist->invbxs       /* compute add. evaluation measure */
@@ -2051,6 +2358,49 @@ static int r4set (ISTREE *ist, ISREPORT *rep, ISTNODE *node, ITEM index)
 
 /*--------------------------------------------------------------------*/
 
+static int hopeless (ISTREE *ist, ISREPORT *rep, ISTNODE *node)
+{                               /* --- check for a hopeless subtree */
+  ITEM i, item;                 /* loop variable, item */
+  ITEM *map;                    /* item identifier map */
+  SUPP supp, smax;              /* (maximum) support of an item set */
+  SUPP head, hmin;              /* (minimum) support of a head item */
+
+  assert(ist && rep && node);   /* check the function arguments */
+  if ((ist->eval <= RE_NONE) || (ist->eval >= RE_FNCNT))
+    return 0;                   /* (no measure: no pruning possible) */
+  if (isr_tkdir(rep) && (isr_tkeval(rep) > ist->thresh))
+    ist->thresh = isr_tkeval(rep); /* raise threshold for top-k */
+  map  = (node->offset < 0) ? (ITEM*)(node->cnts +node->size) : NULL;
+  smax = 0; hmin = SUPP_MAX;    /* traverse the items of the node */
+  for (i = 0; i < node->size; i++) {
+    supp = COUNT(node->cnts[i]);/* skip infrequent item sets */
+    if (supp < ist->smin) continue;
+    if (supp > smax) smax = supp;
+    item = (map) ? map[i] : node->offset +i;
+    if (!(ib_getapp(ist->base, item) & APP_HEAD)) continue;
+    head = COUNT(ist->lvls[0]->cnts[item]);
+    if (head < hmin) hmin = head;
+  }                             /* find max. set/min. head support */
+  if (smax <= 0) return 1;      /* check for frequent item sets */
+  for (i = isr_cnt(rep); --i >= 0; ) {
+    item = isr_itemx(rep, i);   /* traverse the items on the path */
+    if (!(ib_getapp(ist->base, item) & APP_HEAD)) continue;
+    head = COUNT(ist->lvls[0]->cnts[item]);
+    if (head < hmin) hmin = head;
+  }                             /* find the minimum head support */
+  return ist->dir *re_bound(ist->eval, smax, hmin, COUNT(ist->wgt))
+       < ist->thresh;           /* compare optimistic bound */
+}  /* hopeless() */             /* to the evaluation threshold */
+
+/* The item sets in the subtree rooted at a node extend the current */
+/* item set by items of that node. Hence their supports cannot      */
+/* exceed the largest support in the node and the head of a rule    */
+/* must be an item on the path or in the node. If the bound of the  */
+/* evaluation measure for these values does not reach the threshold */
+/* (which is raised in top-k mode), the subtree is skipped.         */
+
+/*--------------------------------------------------------------------*/
+
 static int rules (ISTREE *ist, ISREPORT *rep, ISTNODE *node)
 {                               /* --- recursive rule reporting */
   ITEM    i, k, c;              /* loop variables, buffers */
@@ -2073,8 +2423,10 @@ static int rules (ISTREE *ist, ISREPORT *rep, ISTNODE *node)
       isr_add(rep, k, supp);    /* add the item to the reporter */
       k -= off;                 /* compute the child node index */
       if ((k >= 0)              /* if the corresp. child node exists, */
-      &&  (k <  c) && chn[k])   /* recursively report the subtree, */
-        rules(ist, rep, chn[k]);/* then report rules for item set */
+      &&  (k <  c) && chn[k]    /* recursively report the subtree, */
+      &&  !hopeless(ist, rep, chn[k])
+      &&  (rules(ist, rep, chn[k]) < 0))
+        return -1;              /* then report rules for item set */
       if (r4set(ist, rep, node, i) < 0) return -1;
       isr_remove(rep, 1);       /* remove the last item */
     } }                         /* from the current item set */
@@ -2092,8 +2444,10 @@ static int rules (ISTREE *ist, ISREPORT *rep, ISTNODE *node)
       supp = node->cnts[i];     /* get the item support (with flag) */
       if (k <= c) {             /* if there may be a child node, */
         while (ITEMOF(*chn) < k) chn++;  /* skip preceding items */
-        if (k == ITEMOF(*chn))  /* if the corresp. child node exists, */
-          rules(ist, rep, *chn);/* recursively report the subtree, */
+        if ((k == ITEMOF(*chn)) /* if the corresp. child node exists, */
+        &&  !hopeless(ist, rep, *chn)
+        &&  (rules(ist, rep, *chn) < 0))
+          return -1;            /* recursively report the subtree, */
       }                         /* then report rules for item set */
       if (r4set(ist, rep, node, i) < 0) return -1;
       isr_remove(rep, 1);       /* remove the last item */
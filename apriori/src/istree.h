@@ -43,6 +43,8 @@
             2014.08.01 minimum improvement of evaluation measure removed
             2014.08.14 function ist_addchn() and related functions added
             2014.08.21 parameter 'body' added to function ist_create()
+            2026.10.18 mode field IST_CPUS added (threads for counting)
+            2026.10.18 mode flag IST_PAIRS added (triangular matrix)
 ----------------------------------------------------------------------*/
 #ifndef __ISTREE__
 #define __ISTREE__
@@ -55,9 +57,11 @@
   Preprocessor Definitions
 ----------------------------------------------------------------------*/
 /* --- operation modes --- */
+#define IST_CPUS    0x00ff      /* number of threads for counting */
 #define IST_PERFECT 0x0100      /* prune with perfect extensions */
 #define IST_PARTIAL 0x0200      /* do only partial subset checks */
 #define IST_REVERSE 0x0400      /* reverse item order */
+#define IST_PAIRS   0x0800      /* count pairs with a tri. matrix */
 
 /* --- additional evaluation measures --- */
 /* evaluation measure definitions in ruleval.h */
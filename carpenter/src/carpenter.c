@@ -28,6 +28,12 @@
             2014.08.02 option -c renamed to -z (maximal item set filter)
             2014.08.28 functions carp_data() and carp_repo() added
             2014.10.24 changed from LGPL license to MIT license
+            2026.10.18 option -B added (binary item set output)
+            2026.10.18 progress/cancellation polling in recursion
+            2026.10.18 table row filtering with AVX2/AVX-512 (gather)
+            2026.10.18 parallel search with worker threads (CARP_THREADS)
+            2026.10.18 AVX2/AVX-512 row filtering selected at run time
+            2026.10.18 worker threads moved to module thdpool
 ------------------------------------------------------------------------
   Reference for the Carpenter algorithm:
     F. Pan, G. Cong, A.K.H. Tung, J. Yang, and M. Zaki.
@@ -66,6 +72,23 @@
 #ifdef CARP_MAIN
 #include "error.h"
 #endif
+#ifdef CARP_THREADS
+#include "thdpool.h"
+#endif
+#define int         1           /* to check definitions */
+#define long        2           /* for certain types */
+#define ptrdiff_t   3
+#if ITEM==int && SUPP==int && defined __GNUC__ && defined __x86_64__ \
+&&  !defined CARP_NOSIMD
+#define CARP_SIMD               /* use AVX2/AVX-512 if possible */
+#endif
+#undef int                      /* remove preprocessor definitions */
+#undef long                     /* needed for the type checking */
+#undef ptrdiff_t
+#ifdef CARP_SIMD
+#include <stdint.h>
+#include <immintrin.h>
+#endif
 #ifdef STORAGE
 #include "storage.h"
 #endif
@@ -102,6 +125,16 @@
 
 #define SEC_SINCE(t)  ((double)(clock()-(t)) /(double)CLOCKS_PER_SEC)
 
+#define SETPAD      16          /* padding of the item set buffer */
+                                /* (for vector stores in filter()) */
+
+#ifdef CARP_THREADS
+#ifndef CARP_PARMIN             /* minimum number of table cells */
+#define CARP_PARMIN 4096        /* (items x trans.) for a worker */
+#endif
+#define CARP_POLL   1024        /* search nodes between stop checks */
+#endif
+
 /*----------------------------------------------------------------------
   Type Definitions
 ----------------------------------------------------------------------*/
@@ -119,8 +152,29 @@ typedef struct {                /* --- recursion data --- */
   SUPP     *muls;               /* multiplicity of transactions */
   ITEM     *set;                /* buffer for an item set */
   REPOTREE *rpt;                /* repository of item sets */
+  ISREPORT *report;             /* item set reporter (progress) */
+  #ifdef CARP_THREADS           /* if multi-threading is available */
+  THDPOOL  *pool;               /* pool of worker threads (or NULL) */
+  #endif
 } RECDATA;                      /* (recursion data) */
 
+#ifdef CARP_THREADS
+typedef SUPP TABFN (ITEM *set, ITEM k, TID n, SUPP supp, RECDATA *rd);
+typedef SUPP TIDFN (TIDLIST *lists, ITEM k, TID n, SUPP supp,
+                    RECDATA *rd);
+
+typedef struct {                /* --- task of a worker thread --- */
+  TABFN       *tabfn;           /* recursion on occurrence table */
+  TIDFN       *tidfn;           /* recursion on trans. id lists */
+  size_t      size;             /* size of an element of the buffer */
+  RECDATA     rd;               /* recursion data of the worker */
+  void        *buf;             /* item set or tid list buffer */
+  ITEM        k;                /* number of items in the set */
+  TID         n;                /* number of transactions to process */
+  SUPP        supp;             /* support of the item set */
+} TASK;                         /* (task of a worker thread) */
+#endif
+
 /*----------------------------------------------------------------------
   Constants
 ----------------------------------------------------------------------*/
@@ -150,6 +204,10 @@ static const char *errmsgs[] = {
 /*----------------------------------------------------------------------
   Global Variables
 ----------------------------------------------------------------------*/
+#ifdef CARP_SIMD
+static int simd = -1;           /* 0: none, 1: AVX2, 2: AVX-512 */
+#endif
+
 #ifdef CARP_MAIN
 #ifndef QUIET
 static CCHAR    *prgname;       /* program name for error messages */
@@ -238,13 +296,228 @@ static void show_tid (const char *text, TIDLIST *lists, ITEM k, int ind)
 }  /* show_tid() */
 
 #endif  /* #ifndef NDEBUG */
+/*----------------------------------------------------------------------
+  Parallel Search
+----------------------------------------------------------------------*/
+#ifdef CARP_THREADS
+
+static int task (void *data)
+{                               /* --- search a subproblem */
+  TASK    *t = (TASK*)data;     /* type the argument pointer */
+  TIDLIST *lists;               /* tid lists to search */
+  ITEM    i;                    /* loop variable */
+  SUPP    r;                    /* support or error status */
+
+  assert(data);                 /* check the function argument */
+  if (t->tidfn) {               /* if to search tid lists */
+    lists = (TIDLIST*)t->buf;   /* get the tid lists and search them */
+    r = t->tidfn(lists, t->k, t->n, t->supp, &t->rd);
+    if (r > t->supp) {          /* if there are perfect extensions */
+      for (i = 0; i < t->k; i++)/* collect the items of the set */
+        t->rd.set[i] = lists[i].item;
+      r = (SUPP)rpt_add(t->rd.rpt, t->rd.set, t->k, r);
+    } }                         /* update the item set repository */
+  else {                        /* if to search the occurrence table */
+    r = t->tabfn((ITEM*)t->buf, t->k, t->n, t->supp, &t->rd);
+    if (r > t->supp)            /* if there are perfect extensions */
+      r = (SUPP)rpt_add(t->rd.rpt, (ITEM*)t->buf, t->k, r);
+  }                             /* update the item set repository */
+  return (r < 0) ? -1 : 0;      /* return the error status */
+}  /* task() */
+
+/*--------------------------------------------------------------------*/
+
+static int spawn (const void *data, ITEM k, TID n, SUPP supp,
+                  RECDATA *rd)
+{                               /* --- hand a subproblem to a worker */
+  TPLWORK *w;                   /* worker to hand the subproblem to */
+  TASK    *t;                   /* task data of the worker */
+
+  assert(data && (k > 0) && (n >= 0) && rd && rd->pool);
+  w = tpl_idle(rd->pool);       /* get an idle worker */
+  if (!w) return (tpl_stopped(rd->pool)) ? -1 : 0;
+  t = (TASK*)tpl_data(w);       /* get the task data of the worker */
+  memcpy(t->buf, data, (size_t)k *t->size);
+  t->k = k; t->n = n;           /* copy the item set or tid lists */
+  t->supp = supp;               /* and note the number of trans. */
+  return (tpl_start(w) < 0) ? 0 : 1;
+}  /* spawn() */                /* and the item set support */
+
+/* The function spawn() returns 1 if the subproblem (an item set that */
+/* was just added to the repository together with the transactions   */
+/* that are still to be intersected with it) was handed to a worker  */
+/* thread. It returns 0 if no worker is idle or no thread can be     */
+/* started, so that the subproblem has to be searched directly.      */
+
+/*--------------------------------------------------------------------*/
+
+static SUPP parallel (void *data, ITEM k, TID n, size_t x,
+                      TABFN *tabfn, TIDFN *tidfn, RECDATA *rd,
+                      int cpus)
+{                               /* --- search with multiple threads */
+  int     i, e = 0;             /* loop variable, error status */
+  SUPP    r;                    /* support of the full item set */
+  size_t  z;                    /* size of a worker buffer */
+  THDPOOL *pool = NULL;         /* pool of worker threads */
+  TASK    *tasks = NULL, *t;    /* task data of the workers */
+
+  assert(data && (k > 0) && (tabfn || tidfn) && rd && (cpus > 1));
+  if ((double)k*(double)n >= CARP_PARMIN)  /* threads only for */
+    pool = tpl_create(rd->report, cpus-1, task, CARP_POLL);
+  if (pool) {                   /* if a pool of workers was created */
+    tasks = (TASK*)calloc((size_t)(cpus-1), sizeof(TASK));
+    if (!tasks) { tpl_delete(pool); pool = NULL; }
+  }                             /* create the task data */
+  if (pool) {                   /* get the size of a buffer */
+    z = (tidfn) ? ((size_t)k +x) *sizeof(TIDLIST) +(size_t)k *sizeof(ITEM)
+                : ((size_t)k +x +SETPAD) *sizeof(ITEM);
+    for (i = 0; i < tpl_cnt(pool); i++) {
+      t = tasks +i;             /* traverse the workers */
+      t->tabfn   = tabfn;       /* note the recursion functions */
+      t->tidfn   = tidfn;       /* and the buffer element size */
+      t->size    = (tidfn) ? sizeof(TIDLIST) : sizeof(ITEM);
+      t->rd      = *rd;         /* copy the recursion data */
+      t->rd.pool = NULL;        /* (workers do not spawn threads) */
+      t->rd.report = tpl_report(tpl_worker(pool, i));
+      t->buf     = malloc(z);   /* use the reporter shard and */
+      t->rd.rpt  = rpt_create(NULL, k, rpt_dir(rd->rpt));
+      if (!t->buf || !t->rd.rpt) {  /* create a buffer and */
+        if (t->rd.rpt) rpt_delete(t->rd.rpt, 1);
+        if (t->buf)    free(t->buf);
+        break;                  /* a repository; on failure */
+      }                         /* delete the created objects */
+      if (tidfn) t->rd.set = (ITEM*)((TIDLIST*)t->buf +k +x);
+      tpl_setdata(tpl_worker(pool, i), t);
+    }
+    tpl_setcnt(pool, i);        /* note the number of workers */
+    rd->pool = (i > 0) ? pool : NULL;
+  }                             /* search in the calling thread */
+  r = (tidfn) ? tidfn((TIDLIST*)data, k, n, 0, rd)
+              : tabfn((ITEM*)   data, k, n, 0, rd);
+  if (!pool) return r;          /* if no threads were used, abort */
+  rd->pool = NULL;              /* (calling thread hands off work) */
+  if (r < 0) tpl_stop(pool);    /* on failure stop all workers */
+  if ((tpl_cnt(pool) > 0) && (tpl_drain(pool) < 0))
+    e = -1;                     /* collect the remaining workers */
+  for (i = 0; i < tpl_cnt(pool); i++) {
+    t = tasks +i;               /* traverse the workers */
+    if ((r >= 0) && (e >= 0) && (rpt_merge(rd->rpt, t->rd.rpt) < 0))
+      e = -1;                   /* merge the item set repositories */
+    rpt_delete(t->rd.rpt, 1);   /* delete the repository */
+    free(t->buf);               /* and the buffer */
+  }
+  tpl_delete(pool);             /* delete the pool of workers */
+  free(tasks);                  /* and the task data */
+  return (e < 0) ? -1 : r;      /* return the error status */
+}  /* parallel() */
+
+/*----------------------------------------------------------------------
+The enumeration of transaction (row) sets is split into subproblems,
+each of which consists of an item set that was just added to the
+repository and the transactions that remain to be intersected with it.
+Only the calling thread hands off subproblems (with at least CARP_PARMIN
+table cells) to idle workers; it continues with the remaining rows on
+all levels of the recursion. Each worker adds the item sets it finds to
+a repository of its own, which is merged into the main repository
+after all workers finished. Since the repository keeps the maximum
+support of each item set, the merged repository is the same as with a
+sequential search and rpt_report() yields the same item sets. Only the
+pruning with the repository is weaker, as a worker does not know the
+item sets found by other threads.
+----------------------------------------------------------------------*/
+
+#endif  /* #ifdef CARP_THREADS */
 /*----------------------------------------------------------------------
   Carpenter based on an Item Occurrence Table
 ----------------------------------------------------------------------*/
 
+#ifdef CARP_SIMD
+
+__attribute__((target("avx512f")))
+static ITEM filt512 (ITEM *dst, const ITEM *set, ITEM k,
+                     const SUPP *row, SUPP s)
+{                               /* --- filter item set with row */
+  ITEM      i, m;               /* loop variable, item counter */
+  __m512i   x, t;               /* items and support threshold */
+  __mmask16 b;                  /* mask of items to keep */
+
+  t = _mm512_set1_epi32(s);     /* get the support threshold vector */
+  for (i = m = 0; i < k; i += 16) {  /* traverse blocks of 16 items */
+    x = _mm512_loadu_si512((const void*)(set+i));
+    b = _mm512_cmpgt_epi32_mask(/* gather the row counters */
+          _mm512_i32gather_epi32(x, (const void*)row, 4), t);
+    _mm512_mask_compressstoreu_epi32(dst+m, b, x);
+    m += (ITEM)__builtin_popcount((unsigned int)b);
+  }                             /* store the items to keep */
+  return m;                     /* return the number of items kept */
+}  /* filt512() */
+
+/*--------------------------------------------------------------------*/
+
+__attribute__((target("avx2,bmi2")))
+static ITEM filt256 (ITEM *dst, const ITEM *set, ITEM k,
+                     const SUPP *row, SUPP s)
+{                               /* --- filter item set with row */
+  ITEM      i, m;               /* loop variable, item counter */
+  __m256i   x, t;               /* items and support threshold */
+  uint64_t  b, p;               /* mask and indices of items to keep */
+
+  t = _mm256_set1_epi32(s);     /* get the support threshold vector */
+  for (i = m = 0; i < k; i += 8) {   /* traverse blocks of 8 items */
+    x = _mm256_loadu_si256((const __m256i*)(set+i));
+    b = (uint64_t)_mm256_movemask_ps(_mm256_castsi256_ps(
+          _mm256_cmpgt_epi32(   /* gather the row counters */
+            _mm256_i32gather_epi32((const int*)row, x, 4), t)));
+    p = _pdep_u64(b, 0x0101010101010101ULL) *0xff;
+    p = _pext_u64(0x0706050403020100ULL, p);
+    x = _mm256_permutevar8x32_epi32(x,
+          _mm256_cvtepu8_epi32(_mm_cvtsi64_si128((long long)p)));
+    _mm256_storeu_si256((__m256i*)(dst+m), x);
+    m += (ITEM)__builtin_popcountll(b);
+  }                             /* compress the items to keep */
+  return m;                     /* return the number of items kept */
+}  /* filt256() */
+
+#endif
+/*--------------------------------------------------------------------*/
+
+static ITEM filter (ITEM *dst, const ITEM *set, ITEM k,
+                    const SUPP *row, SUPP s)
+{                               /* --- filter item set with row */
+  ITEM i, m;                    /* loop variable, item counter */
+
+  assert(dst && set && row);    /* check the function arguments */
+  i = m = 0;                    /* initialize the item counters */
+  #ifdef CARP_SIMD              /* if SIMD instructions supported, */
+  if      (simd > 1)            /* process full blocks of items */
+    m = filt512(dst, set, i = k & ~15, row, s);
+  else if (simd > 0)            /* (AVX-512: 16, AVX2: 8 items) */
+    m = filt256(dst, set, i = k & ~7,  row, s);
+  #endif
+  for ( ; i < k; i++) {         /* traverse the remaining items */
+    dst[m] = set[i];            /* store the item unconditionally */
+    m += (row[set[i]] > s);     /* and keep it if it is frequent */
+  }                             /* in the remaining transactions */
+  return m;                     /* return the new number of items */
+}  /* filter() */
+
+/*----------------------------------------------------------------------
+The function filter() intersects an item set with a table row, that is,
+it keeps all items whose (remaining) support in the table row exceeds
+the threshold s. If the CPU supports AVX-512 or AVX2 (checked once in
+carp_tab(), so the program need not be compiled for a specific CPU),
+blocks of items are processed at once: the row counters are gathered,
+compared with the threshold, and the items to keep are compressed into
+the destination. Since the vector stores may write a full block past
+the last item that is kept, the item set buffer is padded by SETPAD
+items. The remaining items are processed with a branch-free loop,
+which avoids mispredicted branches for rows in which the outcome of
+the comparison is hard to predict.
+----------------------------------------------------------------------*/
+
 static SUPP rec_tab (ITEM *set, ITEM k, TID n, SUPP supp, RECDATA *rd)
 {                               /* --- carpenter recursion */
-  ITEM i, m;                    /* loop variables, item counter */
+  ITEM m;                       /* number of items in intersection */
   SUPP s, r;                    /* needed support, error status */
   SUPP *row;                    /* to traverse the table rows */
   ITEM *dst;                    /* intersection destination */
@@ -252,14 +525,15 @@ static SUPP rec_tab (ITEM *set, ITEM k, TID n, SUPP supp, RECDATA *rd)
 
   assert(set                    /* check the function arguments */
   &&    (k > 0) && (n >= 0) && (supp >= 0) && rd);
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
   dst = set +k;                 /* get destination for intersections */
   pex = (rd->mode & CARP_PERFECT) ? k : ITEM_MAX;
   s   = rd->smin -supp -1;      /* get minimum for perfect exts. */
   if (s < 0) s = 0;             /* and end value for trans. loop */
   while (--n >= s) {            /* traverse remaining transactions */
     row = rd->tab[n];           /* filter item set with table row */
-    for (i = m = 0; i < k; i++) /* corresp. to current transaction */
-      if (row[set[i]] > s) dst[m++] = set[i];
+    m   = filter(dst, set, k, row, s);  /* of current transaction */
     if (m <  rd->zmin) continue;/* skip too small intersections */
     if (m <= 1) {               /* if there is only one item left */
       r = (SUPP)rpt_add(rd->rpt, dst, m, supp +row[*dst]);
@@ -273,6 +547,13 @@ static SUPP rec_tab (ITEM *set, ITEM k, TID n, SUPP supp, RECDATA *rd)
     r = (SUPP)rpt_add(rd->rpt, dst, m, supp+1);
     if (r <  0) return r;       /* add item set to the repository */
     if (r <= 0) continue;       /* find closed item sets recursively */
+    #ifdef CARP_THREADS         /* if multi-threading is available */
+    if (rd->pool && ((double)m*(double)n >= CARP_PARMIN)) {
+      r = (SUPP)spawn(dst, m, n, supp+1, rd);
+      if (r < 0) return r;      /* try to hand off the subproblem */
+      if (r > 0) continue;      /* to an idle worker thread */
+    }                           /* (worker adds perfect extensions) */
+    #endif
     r = rec_tab(dst, m, n, supp+1, rd);
     if (r > supp+1)             /* if there are perfect extensions */
       r = (SUPP)rpt_add(rd->rpt, dst, m, r);
@@ -285,7 +566,7 @@ static SUPP rec_tab (ITEM *set, ITEM k, TID n, SUPP supp, RECDATA *rd)
 
 static SUPP rec_mtb (ITEM *set, ITEM k, TID n, SUPP supp, RECDATA *rd)
 {                               /* --- carpenter recursion */
-  ITEM i, m;                    /* loop variables, item counter */
+  ITEM m;                       /* number of items in intersection */
   SUPP s, r;                    /* needed support, error status */
   SUPP *row;                    /* to traverse the table rows */
   ITEM *dst;                    /* intersection destination */
@@ -293,14 +574,15 @@ static SUPP rec_mtb (ITEM *set, ITEM k, TID n, SUPP supp, RECDATA *rd)
 
   assert(set                    /* check the function arguments */
   &&    (k > 0) && (n >= 0) && (supp >= 0) && rd);
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
   dst = set +k;                 /* get destination for intersections */
   pex = (rd->mode & CARP_PERFECT) ? k : ITEM_MAX;
   while (--n >= 0) {            /* traverse the transaction ids */
     s = rd->smin -supp -1;      /* compute the minimum support -1 */
     if (s < 0) s = 0;           /* needed in remaining transactions */
     row = rd->tab[n];           /* filter item set with table row */
-    for (i = m = 0; i < k; i++) /* corresp. to current transaction */
-      if (row[set[i]] > s) dst[m++] = set[i];
+    m   = filter(dst, set, k, row, s);  /* of current transaction */
     if (m <  rd->zmin) continue;/* skip too small intersections */
     if (m <= 1) {               /* if there is only one item left */
       r = (SUPP)rpt_add(rd->rpt, dst, m, supp +row[*dst]);
@@ -315,6 +597,13 @@ static SUPP rec_mtb (ITEM *set, ITEM k, TID n, SUPP supp, RECDATA *rd)
     r = (SUPP)rpt_add(rd->rpt, dst, m, s);
     if (r <  0) return r;       /* add item set to the repository */
     if (r <= 0) continue;       /* find closed item sets recursively */
+    #ifdef CARP_THREADS         /* if multi-threading is available */
+    if (rd->pool && ((double)m*(double)n >= CARP_PARMIN)) {
+      r = (SUPP)spawn(dst, m, n, s, rd);
+      if (r < 0) return r;      /* try to hand off the subproblem */
+      if (r > 0) continue;      /* to an idle worker thread */
+    }                           /* (worker adds perfect extensions) */
+    #endif
     r = rec_mtb(dst, m, n, s, rd);
     if (r > s)                  /* if there are perfect extensions */
       r = (SUPP)rpt_add(rd->rpt, dst, m, r);
@@ -332,7 +621,7 @@ only allocated in rpt_add() for the closed item set repository rd->rpt.
 ----------------------------------------------------------------------*/
 
 int carp_tab (TABAG *tabag, SUPP smin, ITEM zmin, int mode,
-              REPOTREE *rpt)
+              REPOTREE *rpt, ISREPORT *report)
 {                               /* --- search for frequent item sets */
   ITEM       i, k;              /* loop variable, number of items */
   TID        j, n, m;           /* loop variable, number of trans. */
@@ -360,10 +649,15 @@ int carp_tab (TABAG *tabag, SUPP smin, ITEM zmin, int mode,
   for (m = j = 0; j < n; j++)   /* traverse the transactions */
     if (ta_wgt(tbg_tract(tabag, j)) != 1) {
       m = n; break; }           /* check for unit weights only */
+  #ifdef CARP_SIMD              /* check (once) for SIMD support */
+  if (simd < 0) simd = (__builtin_cpu_supports("avx512f")) ? 2
+                     : (__builtin_cpu_supports("avx2")
+                     && __builtin_cpu_supports("bmi2"))   ? 1 : 0;
+  #endif                        /* to choose the filter function */
   z = (size_t)n*(size_t)k;      /* compute the table size */
   rd.tab = (SUPP**)malloc((size_t) n       *sizeof(SUPP*)
                         +((size_t)(m+k)+z) *sizeof(SUPP)
-                        +((size_t) k   +x) *sizeof(ITEM));
+                        +((size_t) k+x+SETPAD) *sizeof(ITEM));
   if (!rd.tab) return -1;       /* allocate memory for occ. table */
   rd.muls = (SUPP*)(rd.tab +n); /* split off multiplicity array, */
   frqs    = rd.muls +m;         /* the transaction counter array, */
@@ -389,7 +683,15 @@ int carp_tab (TABAG *tabag, SUPP smin, ITEM zmin, int mode,
   if (rpt_dir(rpt) > 0)         /* set the initial (full) item set */
        for (i = 0; i < k; i++) set[i] = i;
   else for (i = 0; i < k; i++) set[i] = k-1-i;
-  rd.rpt = rpt;                 /* search for closed freq. item sets */
+  rd.rpt    = rpt;              /* note the repository and */
+  rd.report = report;           /* the reporter (for progress) */
+  #ifdef CARP_THREADS           /* if multi-threading is available */
+  rd.pool = NULL;               /* and several threads are requested, */
+  if ((mode & CARP_CPUS) > CARP_CPU1)  /* search with worker threads */
+    w = parallel(set, k, n, x, (m) ? rec_mtb : rec_tab, NULL, &rd,
+                 (mode & CARP_CPUS) >> 8);
+  else                          /* otherwise execute the carpenter */
+  #endif                        /* recursion directly */
   w = (m) ? rec_mtb(set, k, n, 0, &rd)
           : rec_tab(set, k, n, 0, &rd);
   if (w > 0)                    /* if there are perfect extensions, */
@@ -412,6 +714,8 @@ static SUPP rec_tid (TIDLIST *lists, ITEM k, TID n, SUPP supp,
 
   assert(lists                  /* check the function arguments */
   &&    (k > 0) && (n >= 0) && (supp >= 0) && rd);
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
   dst = lists +k;               /* get destination for intersections */
   pex = (rd->mode & CARP_PERFECT) ? k : ITEM_MAX;
   s   = rd->smin -supp -1;      /* compute end value for trans. loop */
@@ -438,6 +742,13 @@ static SUPP rec_tid (TIDLIST *lists, ITEM k, TID n, SUPP supp,
     r = (SUPP)rpt_add(rd->rpt, rd->set, m, supp+1);
     if (r <  0) return r;       /* add item set to the repository */
     if (r <= 0) continue;       /* check whether recursion is needed */
+    #ifdef CARP_THREADS         /* if multi-threading is available */
+    if (rd->pool && ((double)m*(double)n >= CARP_PARMIN)) {
+      r = (SUPP)spawn(dst, m, n, supp+1, rd);
+      if (r < 0) return r;      /* try to hand off the subproblem */
+      if (r > 0) continue;      /* to an idle worker thread */
+    }                           /* (worker adds perfect extensions) */
+    #endif
     r = rec_tid(dst, m, n, supp+1, rd);
     if (r > supp+1) {           /* find closed item sets recursively */
       for (i = 0; i < m; i++)   /* if there are perfect extensions */
@@ -461,6 +772,8 @@ static SUPP rec_mti (TIDLIST *lists, ITEM k, TID n, SUPP supp,
 
   assert(lists                  /* check the function arguments */
   &&    (k > 0) && (n >= 0) && (supp >= 0) && rd);
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
   dst = lists +k;               /* get destination for intersections */
   pex = (rd->mode & CARP_PERFECT) ? k : ITEM_MAX;
   while (--n >= 0) {            /* traverse the transaction ids */
@@ -490,6 +803,13 @@ static SUPP rec_mti (TIDLIST *lists, ITEM k, TID n, SUPP supp,
     r = (SUPP)rpt_add(rd->rpt, rd->set, m, s);
     if (r <  0) return r;       /* add item set to the repository */
     if (r <= 0) continue;       /* check whether recursion is needed */
+    #ifdef CARP_THREADS         /* if multi-threading is available */
+    if (rd->pool && ((double)m*(double)n >= CARP_PARMIN)) {
+      r = (SUPP)spawn(dst, m, n, s, rd);
+      if (r < 0) return r;      /* try to hand off the subproblem */
+      if (r > 0) continue;      /* to an idle worker thread */
+    }                           /* (worker adds perfect extensions) */
+    #endif
     r = rec_mti(dst, m, n, s, rd);
     if (r > s) {                /* find closed item sets recursively */
       for (i = 0; i < m; i++)   /* if there are perfect extensions */
@@ -510,7 +830,7 @@ only allocated in rpt_add() for the closed item set repository rd->rpt.
 ----------------------------------------------------------------------*/
 
 int carp_tid (TABAG *tabag, SUPP smin, ITEM zmin, int mode,
-              REPOTREE *rpt)
+              REPOTREE *rpt, ISREPORT *report)
 {                               /* --- search for frequent item sets */
   ITEM       i, k;              /* loop variable, number of items */
   TID        j, n, m;           /* loop variable, number of trans. */
@@ -569,7 +889,15 @@ int carp_tid (TABAG *tabag, SUPP smin, ITEM zmin, int mode,
       *next[*s]++ = j;          /* traverse the transaction's items */
     }                           /* sum the transaction weight and */
   }                             /* collect the transaction ids */
-  rd.rpt = rpt;                 /* search for closed freq. item sets */
+  rd.rpt    = rpt;              /* note the repository and */
+  rd.report = report;           /* the reporter (for progress) */
+  #ifdef CARP_THREADS           /* if multi-threading is available */
+  rd.pool = NULL;               /* and several threads are requested, */
+  if ((mode & CARP_CPUS) > CARP_CPU1)  /* search with worker threads */
+    w = parallel(lists, k, n, x, NULL, (m) ? rec_mti : rec_tid, &rd,
+                 (mode & CARP_CPUS) >> 8);
+  else                          /* otherwise execute the carpenter */
+  #endif                        /* recursion directly */
   w = (m) ? rec_mti(lists, k, n, 0, &rd)
           : rec_tid(lists, k, n, 0, &rd);
   if (w > 0)                    /* if there are perfect extensions, */
@@ -673,9 +1001,9 @@ int carpenter (TABAG *tabag, int target, SUPP smin,
   if (!rpt) return E_NOMEM;     /* create an item set repository */
   zmin = isr_zmin(report);      /* get the minimum item set size */
   if (algo == CARP_TIDLIST)     /* transaction identifier lists */
-    r = carp_tid(tabag, smin, zmin, mode, rpt);
+    r = carp_tid(tabag, smin, zmin, mode, rpt, report);
   else                          /* item occurrence counter table */
-    r = carp_tab(tabag, smin, zmin, mode, rpt);
+    r = carp_tab(tabag, smin, zmin, mode, rpt, report);
   if (r < 0) {                  /* intersect transaction sets */
     if (!(mode & CARP_NOCLEAN)) rpt_delete(rpt, 1); return E_NOMEM; }
   XMSG(stderr, "[%"SIZE_FMT" node(s)]", rpt_nodecnt(rpt));
@@ -818,6 +1146,7 @@ int main (int argc, char *argv[])
   int     scan     = 0;         /* flag for scanable item output */
   int     bdrcnt   = 0;         /* number of support values in border */
   int     stats    = 0;         /* flag for item set statistics */
+  int     binary   = 0;         /* flag for binary output format */
   PATSPEC *psp;                 /* collected pattern spectrum */
   ITEM    m;                    /* number of items */
   TID     n;                    /* number of transactions */
@@ -877,6 +1206,8 @@ int main (int argc, char *argv[])
     printf("-P#      write a pattern spectrum to a file\n");
     printf("-Z       print item set statistics "
                     "(number of item sets per size)\n");
+    printf("-B       write item sets in binary format "
+                    "(compressed)\n");
     printf("-g       write output in scanable form "
                     "(quote certain characters)\n");
     printf("-h#      record header  for output                "
@@ -929,6 +1260,7 @@ int main (int argc, char *argv[])
           case 'R': optarg = &fn_sel;                break;
           case 'P': optarg = &fn_psp;                break;
           case 'Z': stats  = -1;                     break;
+          case 'B': binary = 1;                      break;
           case 'g': scan   = 1;                      break;
           case 'h': optarg = &hdr;                   break;
           case 'k': optarg = &sep;                   break;
@@ -1034,7 +1366,8 @@ int main (int argc, char *argv[])
     error(E_NOMEM);             /* add a pattern spectrum if req. */
   if (isr_setfmt(report, scan, hdr, sep, NULL, info) != 0)
     error(E_NOMEM);             /* set the output format strings */
-  k = isr_open(report, NULL, fn_out);
+  k = (binary) ? isr_openbin(report, NULL, fn_out)
+               : isr_open   (report, NULL, fn_out);
   if (k) error(k, isr_name(report)); /* open item set file */
   if ((carp_repo(report, target, eval, thresh, algo, mode) < 0)
   ||  (isr_setup(report) < 0))  /* prepare reporter for Carpenter */
@@ -5,6 +5,7 @@
   History : 2013.10.31 file created from carpenter.c
             2014.08.23 interface of function carpenter() changed
             2014.08.28 functions carp_data() and carp_repo() added
+            2026.10.18 mode field CARP_CPUS added (number of threads)
 ----------------------------------------------------------------------*/
 #ifndef __CARPENTER__
 #define __CARPENTER__
@@ -27,6 +28,8 @@
 #define CARP_FILTER   0x0020    /* filter maximal sets with repo. */
 #define CARP_MAXONLY  0x0040    /* add only maximal sets to repo. */
 #define CARP_COLLATE  0x0080    /* flag for collating transactions */
+#define CARP_CPUS     0x3f00    /* number of threads (times CARP_CPU1) */
+#define CARP_CPU1     0x0100    /* one thread (unit of CARP_CPUS) */
 #define CARP_DEFAULT  CARP_COLLATE|CARP_PERFECT
 #ifdef NDEBUG
 #define CARP_NOCLEAN  0x8000
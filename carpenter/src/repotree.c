@@ -16,6 +16,9 @@
             2012.04.27 function rpt_prune() added (support pruning)
             2013.04.01 adapted to type changes in module tract
             2013.10.15 checks of return code of isr_report() added
+            2026.10.18 function rpt_merge() added (parallel search)
+            2026.10.18 item masks of subtrees added (superset pruning)
+            2026.10.18 child indices added for nodes with many children
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -33,6 +36,14 @@
 ----------------------------------------------------------------------*/
 #define pos(x,y)   ((x) < (y))  /* macros for item comparison */
 #define neg(x,y)   ((x) > (y))  /* (ascending and descending) */
+#define BIT(i)     ((RPTMASK)1 << ((i) & 63))  /* item mask bit */
+
+#ifndef RPT_IDXMIN              /* minimum number of children */
+#define RPT_IDXMIN  8           /* for creating a child index */
+#endif                          /* size and offset of a child index */
+#define IDXBLK      65536       /* block size for child indices */
+#define IDXSIZE(t,x)    (((t)->dir < 0) ? (x) : (t)->size-1-(x))
+#define IDXOFF(t,x,i)   (((t)->dir < 0) ? (i) : (i)-(x)-1)
 
 /*----------------------------------------------------------------------
   Closed Item Set Repository Tree Functions
@@ -45,15 +56,24 @@ REPOTREE* rpt_create (MEMSYS *mem, ITEM size, int dir)
 
   assert(size >= 0);            /* check the function arguments */
   rpt = (REPOTREE*)malloc(sizeof(REPOTREE)
-                        +(size_t)(size-1) *sizeof(REPONODE));
+                        +(size_t)(size-1) *sizeof(REPONODE)
+                        +(size_t)(size+1) *sizeof(RPTMASK));
   if (!rpt) return NULL;        /* create an item set repository tree */
+  rpt->sfx  = (RPTMASK*)(rpt->tops +size);
   rpt->size = size;             /* and initialize its fields */
   rpt->dir  = (dir < 0) ? -1 : +1;
   rpt->supp = 0;                /* create a memory system for nodes */
   rpt->mem  = (mem) ? mem : ms_create(sizeof(REPONODE), 65535);
   if (!rpt->mem) { free(rpt); return NULL; }
+  rpt->stk  = mst_create(IDXBLK);  /* create a memory stack */
+  if (!rpt->stk) {              /* for the child indices */
+    if (!mem) ms_delete(rpt->mem);
+    free(rpt); return NULL;     /* on failure delete the memory */
+  }                             /* system and the tree body */
   while (--size >= 0) {         /* initialize the top-level nodes */
     node = rpt->tops +size; node->supp = 0; node->item = size;
+    node->mask    = BIT(size);
+    node->index   = NULL;       /* there is no child index yet */
     node->sibling = node->children = NULL;
   }                             /* (sibling pointer is no used) */
   return rpt;                   /* return the created prefix tree */
@@ -82,16 +102,43 @@ void rpt_delete (REPOTREE *rpt, int delms)
   else                          /* if to keep the memory system, */
     while (--rpt->size >= 0)    /* delete tree nodes recursively */
       delete(rpt->tops[rpt->size].children, rpt->mem);
-  free(rpt);                    /* delete the base structure */
+  mst_delete(rpt->stk);         /* delete the child indices */
+  free(rpt);                    /* and the base structure */
 }  /* rpt_delete() */
 
 /*--------------------------------------------------------------------*/
 
+static void mkindex (REPOTREE *rpt, REPONODE *node)
+{                               /* --- create a child index */
+  ITEM     n;                   /* number of children/index size */
+  REPONODE *c;                  /* to traverse the children */
+
+  assert(rpt && node && !node->index);
+  for (n = 0, c = node->children; c; c = c->sibling)
+    if (++n >= RPT_IDXMIN) break;
+  if (n < RPT_IDXMIN) return;   /* check for enough children */
+  n = IDXSIZE(rpt, node->item); /* get the size of the index */
+  node->index = (REPONODE**)mst_alloc(rpt->stk,
+                                      (size_t)n *sizeof(REPONODE*));
+  if (!node->index) return;     /* allocate a child index */
+  memset(node->index, 0, (size_t)n *sizeof(REPONODE*));
+  for (c = node->children; c; c = c->sibling)
+    node->index[IDXOFF(rpt, node->item, c->item)] = c;
+}  /* mkindex() */              /* store the child nodes */
+
+/* A child index is a pointer array that maps items directly to the */
+/* child nodes. It is only created for nodes with at least          */
+/* RPT_IDXMIN children, for which a sibling list search is slow.    */
+/* If no memory is available, the sibling list is searched instead. */
+
+/*--------------------------------------------------------------------*/
+
 int rpt_add (REPOTREE *rpt, const ITEM *items, ITEM n, SUPP supp)
 {                               /* --- add item set to repository */
   int      c = 0;               /* changed flag */
   ITEM     i;                   /* buffer for an item */
-  REPONODE *node;               /* to traverse the (new) nodes */
+  RPTMASK  *m;                  /* to traverse the suffix masks */
+  REPONODE *node, *par;         /* to traverse the (new) nodes */
   REPONODE **p;                 /* insertion position for new node */
 
   assert(rpt                    /* check the function arguments */
@@ -99,28 +146,43 @@ int rpt_add (REPOTREE *rpt, const ITEM *items, ITEM n, SUPP supp)
   if (supp > rpt->supp) {       /* adapt the empty set support */
     rpt->supp = supp; c = 1; }  /* and set the changed flag */
   if (--n < 0) return c;        /* if there are no items, abort */
+  m = rpt->sfx +n; *m = BIT(items[n]);
+  for (i = n; --i >= 0; m--)    /* compute the masks of the suffixes */
+    m[-1] = *m | BIT(items[i]); /* of the item set (m[0]: full set) */
   node = rpt->tops +*items++;   /* get top-level node for first item */
-  do {                          /* traverse the items of the set */
+  while (1) {                   /* traverse the items of the set */
+    node->mask |= *m++;         /* add the items to the subtree mask */
     if (supp > node->supp) {    /* adapt the item set support */
       node->supp = supp; c = 1;}/* and set the changed flag */
     if (--n < 0) return c;      /* if all items are processed, abort */
     i = *items++;               /* get the next item in the set */
+    if (node->index             /* if there is a child index, */
+    &&  node->index[IDXOFF(rpt, node->item, i)]) { /* look up item */
+      node = node->index[IDXOFF(rpt, node->item, i)]; continue; }
     p = &node->children;        /* traverse the list of children */
     if (rpt->dir < 0) while (*p && ((*p)->item > i)) p = &(*p)->sibling;
     else              while (*p && ((*p)->item < i)) p = &(*p)->sibling;
+    if (!*p || ((*p)->item != i)) break;
     node = *p;                  /* find the item/insertion position */
-  } while (node && (node->item == i));
+  }                             /* and go to the child node */
+  par  = node;                  /* note the parent of the new node */
   node = (REPONODE*)ms_alloc(rpt->mem);
   if (!node) return -1;         /* create a new prefix tree node */
   node->item    = i;            /* store the current item and */
   node->supp    = supp;         /* the support of the item set */
+  node->mask    = *m++;         /* and the items of the subtree */
+  node->index   = NULL;         /* there is no child index yet */
   node->sibling = *p;           /* insert the created node */
   *p = node;                    /* into the sibling list */
+  if (par->index) par->index[IDXOFF(rpt, par->item, i)] = node;
+  else            mkindex(rpt, par);  /* update or create index */
   while (--n >= 0) {            /* traverse the rest of the items */
     node = node->children = (REPONODE*)ms_alloc(rpt->mem);
     if (!node) return -1;       /* create a new prefix tree node */
     node->item    = *items++;   /* store the current item and */
     node->supp    = supp;       /* the support of the item set */
+    node->mask    = *m++;       /* and the items of the subtree */
+    node->index   = NULL;       /* there is no child index yet */
     node->sibling = NULL;       /* there are no siblings yet */
   }
   node->children = NULL;        /* last created node is a leaf */
@@ -129,6 +191,72 @@ int rpt_add (REPOTREE *rpt, const ITEM *items, ITEM n, SUPP supp)
 
 /*--------------------------------------------------------------------*/
 
+static int merge (REPOTREE *rpt, REPONODE *par, const REPONODE *src)
+{                               /* --- recursively merge nodes */
+  REPONODE *node;               /* to traverse the destination nodes */
+  REPONODE **p;                 /* insertion position for new node */
+
+  assert(rpt && par);           /* check the function arguments */
+  p = &par->children;           /* start with the first child */
+  for ( ; src; src = src->sibling) {
+    if (rpt->dir < 0)           /* traverse the source siblings */
+         while (*p && ((*p)->item > src->item)) p = &(*p)->sibling;
+    else while (*p && ((*p)->item < src->item)) p = &(*p)->sibling;
+    node = *p;                  /* find the item/insertion position */
+    if (!node || (node->item != src->item)) {
+      node = (REPONODE*)ms_alloc(rpt->mem);
+      if (!node) return -1;     /* create a new prefix tree node */
+      node->item     = src->item;
+      node->supp     = src->supp;
+      node->mask     = src->mask;
+      node->index    = NULL;    /* copy item, support and mask */
+      node->children = NULL;    /* and insert the created node */
+      node->sibling  = *p;      /* into the sibling list */
+      *p = node;                /* (and into the child index) */
+      if (par->index) par->index[IDXOFF(rpt,par->item,node->item)] = node;
+    }
+    else {                      /* if the node already exists */
+      node->mask |= src->mask;  /* update the subtree mask */
+      if (src->supp > node->supp) node->supp = src->supp;
+    }                           /* and the support of the node */
+    if (src->children           /* merge the children recursively */
+    && (merge(rpt, node, src->children) < 0))
+      return -1;                /* and check for an error */
+    p = &node->sibling;         /* continue with the next sibling */
+  }                             /* (sibling lists are sorted) */
+  return 0;                     /* return 'ok' */
+}  /* merge() */
+
+/*--------------------------------------------------------------------*/
+
+int rpt_merge (REPOTREE *rpt, const REPOTREE *src)
+{                               /* --- merge two repository trees */
+  ITEM     i;                   /* loop variable */
+  REPONODE *node;               /* to traverse the top-level nodes */
+
+  assert(rpt && src             /* check the function arguments */
+  &&    (rpt->size == src->size) && (rpt->dir == src->dir));
+  if (src->supp > rpt->supp)    /* adapt the empty set support */
+    rpt->supp = src->supp;
+  for (i = 0; i < src->size; i++) {
+    node = rpt->tops +i;        /* traverse the top-level nodes */
+    node->mask |= src->tops[i].mask;
+    if (src->tops[i].supp > node->supp)
+      node->supp = src->tops[i].supp;
+    if (merge(rpt, node, src->tops[i].children) < 0)
+      return -1;                /* update the item support and */
+  }                             /* merge the subtrees recursively */
+  return 0;                     /* return 'ok' */
+}  /* rpt_merge() */
+
+/*----------------------------------------------------------------------
+Since every node stores the maximum support of all item sets that were
+added with it as a prefix, merging two repositories only has to unite
+the (sorted) sibling lists and take the maximum of the supports. The
+result is the same as if all item sets that were added to the source
+had been added to the destination directly.
+----------------------------------------------------------------------*/
+
 SUPP rpt_get (REPOTREE *rpt, const ITEM *items, ITEM n)
 {                               /* --- get support of an item set */
   ITEM     i;                   /* buffer for an item */
@@ -139,8 +267,13 @@ SUPP rpt_get (REPOTREE *rpt, const ITEM *items, ITEM n)
     return rpt->supp;           /* return the empty set support */
   p = rpt->tops +*items++;      /* get top-level node for first item */
   while (--n >= 0) {            /* while not at the last item */
-    p = p->children;            /* continue with the child nodes */
     i = *items++;               /* try to find a corresp. child node */
+    if (p->index) {             /* if there is a child index, */
+      p = p->index[IDXOFF(rpt, p->item, i)];   /* look up the item */
+      if (!p) return -1;        /* if there is no child node, */
+      continue;                 /* the item set is not contained, */
+    }                           /* otherwise go to the next item */
+    p = p->children;            /* continue with the child nodes */
     if (rpt->dir < 0) while (p && (p->item > i)) p = p->sibling;
     else              while (p && (p->item < i)) p = p->sibling;
     if (!p || (p->item != i))   /* if a node with the next item */
@@ -153,17 +286,19 @@ SUPP rpt_get (REPOTREE *rpt, const ITEM *items, ITEM n)
 
 #define SUPER(dir) \
 static int super_##dir (REPONODE *node, const ITEM *items, ITEM n,     \
-                        SUPP supp)                                     \
+                        SUPP supp, const RPTMASK *sfx)                 \
 {                               /* --- check for a superset */         \
-  assert(items && (n > 0) && (supp > 0));   /* check arguments */      \
+  assert(items && (n > 0) && (supp > 0) && sfx);  /* check args. */    \
   while (node                   /* while there is another node */      \
   && !dir(*items, node->item)){ /* with item before next to match */   \
+    if ((node->supp < supp)     /* if the node is infrequent or */     \
+    ||  (~node->mask & sfx[n])){/* its subtree lacks needed items, */  \
+      node = node->sibling; continue; }     /* skip the subtree */     \
     if (node->item == *items) { /* if at node with matching item */    \
-      if (--n <= 0) return node->supp >= supp;                         \
-      items++; }                /* check for last and skip item */     \
-    else if (super_##dir(node->sibling, items, n, supp))               \
+      if (--n <= 0) return -1;  /* check for last and skip item */     \
+      items++; }                /* (the node is frequent) */           \
+    else if (super_##dir(node->sibling, items, n, supp, sfx))          \
       return -1;                /* process siblings of current node */ \
-    if (node->supp < supp) return 0; /* check for a frequent set */    \
     node = node->children;      /* continue with the child nodes */    \
   }                             /* (match the remaining items) */      \
   return 0;                     /* return 'no superset exists' */      \
@@ -179,28 +314,53 @@ SUPER(neg)                      /* function for descending item order */
 static int super (REPOTREE *rpt, const ITEM *items, ITEM n, SUPP supp)
 {                               /* --- check for a superset */
   ITEM     i, k;                /* loop variables */
+  RPTMASK  *m;                  /* suffix masks of the item set */
   REPONODE *node;               /* to traverse the top-level nodes */
 
   assert(rpt                    /* check the function arguments */
   &&     items && (n > 0) && (supp > 0));
+  if (rpt_get(rpt, items, n) >= supp)
+    return -1;                  /* check the item set itself */
+  m = rpt->sfx; m[0] = 0;       /* compute the masks of the suffixes */
+  for (i = 1; i <= n; i++)      /* of the item set (m[i]: last i) */
+    m[i] = m[i-1] | BIT(items[n-i]);
   node = rpt->tops +*items;     /* get top-level node for first item */
   if (n <= 1) {                 /* check special case for one item */
     if (node->supp >= supp) return -1; }
-  else if ((rpt->dir < 0)       /* check with matching first item */
-  ?        super_neg(node->children, items+1, n-1, supp)
-  :        super_pos(node->children, items+1, n-1, supp))
+  else if ((node->supp >= supp) /* check with matching first item */
+  &&      !(~node->mask & m[n])
+  &&      ((rpt->dir < 0)
+  ?        super_neg(node->children, items+1, n-1, supp, m)
+  :        super_pos(node->children, items+1, n-1, supp, m)))
     return -1;                  /* abort if a superset was found */
   k = (rpt->dir < 0) ? rpt->size : -1;
   for (i = *items; (i -= rpt->dir) != k; ) {
     node = rpt->tops +i;        /* traverse the top-level nodes */
+    if ((node->supp < supp)     /* skip infrequent subtrees */
+    ||  (~node->mask & m[n]))   /* and subtrees that lack items */
+      continue;                 /* (masks need not be exact) */
     if ((rpt->dir < 0)          /* check by skipping node item */
-    ?   super_neg(node->children, items, n, supp)
-    :   super_pos(node->children, items, n, supp))
+    ?   super_neg(node->children, items, n, supp, m)
+    :   super_pos(node->children, items, n, supp, m))
       return -1;                /* if a superset could be found, */
   }                             /* abort with success, otherwise */
   return 0;                     /* return 'no superset exists' */
 }  /* super() */
 
+/*----------------------------------------------------------------------
+Since in most calls the item set itself is contained in the repository
+(with a sufficient support), it is looked up first (which is fast with
+the child indices), before a search for a proper superset is started.
+Every node stores a mask of the items in its subtree (including its own
+item), with one bit per item class (item identifier modulo 64). Before
+a subtree is searched for the remaining items of an item set, the mask
+of these items (precomputed for all suffixes of the item set) is tested
+against the subtree mask. If a needed item is missing, the subtree
+cannot contain a superset and is skipped. Since masks are only updated
+by additions, they may be too large after pruning, but never too small,
+so the pruning of the search is always safe.
+----------------------------------------------------------------------*/
+
 /*--------------------------------------------------------------------*/
 
 int rpt_super (REPOTREE *rpt, const ITEM *items, ITEM n, SUPP supp)
@@ -219,6 +379,7 @@ static void prune (REPONODE **node, SUPP supp, MEMSYS *mem)
   REPONODE *t;                  /* temporary buffer for deletion */
 
   while (*node) {               /* traverse the sibling list */
+    (*node)->index = NULL;      /* drop the child index */
     if ((*node)->children)      /* prune children recursively */
       prune(&(*node)->children, supp, mem);
     if ((*node)->supp >= supp){ /* keep nodes with sufficient supp. */
@@ -234,9 +395,11 @@ void rpt_prune (REPOTREE *rpt, SUPP supp)
 {                               /* --- prune item set repository */
   ITEM i;                       /* loop variable */
   assert(rpt && (supp >= 0));   /* check the function arguments */
-  for (i = rpt->size; --i >= 0;)/* recursively prune sibling lists */
+  for (i = rpt->size; --i >= 0;) { /* recursively prune */
+    rpt->tops[i].index = NULL;  /* the sibling lists */
     prune(&rpt->tops[i].children, supp, rpt->mem);
-}  /* rpt_prune() */
+  }                             /* (child indices are dropped, */
+}  /* rpt_prune() */            /* as they may refer to deleted nodes) */
 
 /*--------------------------------------------------------------------*/
 
@@ -11,6 +11,9 @@
             2012.04.26 special maximal item set functions added
             2012.04.27 function rpt_prune() added (support pruning)
             2013.04.01 adapted to type changes in module tract
+            2026.10.18 function rpt_merge() added (parallel search)
+            2026.10.18 item masks of subtrees added (superset pruning)
+            2026.10.18 child indices added for nodes with many children
 ----------------------------------------------------------------------*/
 #ifndef __REPOTREE__
 #define __REPOTREE__
@@ -24,20 +27,26 @@
 /*----------------------------------------------------------------------
   Type Definitions
 ----------------------------------------------------------------------*/
+typedef unsigned long long RPTMASK; /* item mask (bit per item class) */
+
 typedef struct reponode {       /* --- repository tree node --- */
   ITEM            item;         /* associated item (last item in set) */
   SUPP            supp;         /* support of represented item set */
+  RPTMASK         mask;         /* mask of the items in the subtree */
   struct reponode *sibling;     /* successor node in sibling list */
   struct reponode *children;    /* list of child nodes */
+  struct reponode **index;      /* child index (many children only) */
 } REPONODE;                     /* (repository tree node) */
 
 typedef struct {                /* --- item set repository tree --- */
   MEMSYS          *mem;         /* memory management system */
+  MSSTACK         *stk;         /* memory for the child indices */
   ITEM            size;         /* (maximum) number of items */
   int             dir;          /* direction of item order */
   SUPP            supp;         /* support of the empty set */
   SUPP            min;          /* minimum support   for reporting */
   ISREPORT        *rep;         /* item set reporter for reporting */
+  RPTMASK         *sfx;         /* buffer for item set suffix masks */
   REPONODE        tops[1];      /* top level nodes (like roots) */
 } REPOTREE;                     /* (item set repository tree) */
 
@@ -54,6 +63,7 @@ SUPP      rpt_supp    (REPOTREE *rpt);
 
 int       rpt_add     (REPOTREE *rpt, const ITEM *items, ITEM n,
                        SUPP supp);
+int       rpt_merge   (REPOTREE *rpt, const REPOTREE *src);
 SUPP      rpt_get     (REPOTREE *rpt, const ITEM *items, ITEM n);
 int       rpt_super   (REPOTREE *rpt, const ITEM *items, ITEM n,
                        SUPP min);
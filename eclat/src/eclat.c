@@ -86,6 +86,9 @@
             2014.09.04 functions rec_odcm(), odclo() and odmax() added
             2014.09.08 item bit filtering added to closed() and odclo()
             2014.10.24 changed from LGPL license to MIT license
+            2026.10.18 option -B added (binary item set output)
+            2026.10.18 option -j added (closed filter with tid set hashes)
+            2026.10.18 progress/cancellation polling in recursion
 ------------------------------------------------------------------------
   Reference for the Eclat algorithm:
   * M.J. Zaki, S. Parthasarathy, M. Ogihara, and W. Li.
@@ -406,6 +409,18 @@ static TID isect (TIDLIST *dst, TIDLIST *src1, TIDLIST *src2,SUPP *muls)
 
 /*--------------------------------------------------------------------*/
 
+static size_t tidsig (const TID *tids)
+{                               /* --- compute a tid list signature */
+  size_t h = 0;                 /* computed signature */
+
+  assert(tids);                 /* check the function argument */
+  for ( ; *tids >= 0; tids++)   /* traverse the transaction ids */
+    h = (h ^ (size_t)*tids) *(size_t)0x100000001b3ULL;
+  return h;                     /* combine them FNV-1a style */
+}  /* tidsig() */               /* and return the signature */
+
+/*--------------------------------------------------------------------*/
+
 static int rec_base (TIDLIST **lists, ITEM k, size_t x, RECDATA *rd)
 {                               /* --- eclat recursion with tid lists */
   int     r;                    /* error status */
@@ -416,6 +431,10 @@ static int rec_base (TIDLIST **lists, ITEM k, size_t x, RECDATA *rd)
   TID     *p;                   /* to organize the trans. id lists */
 
   assert(lists && (k > 0) && rd);  /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
+  if (isr_topk(rd->report))     /* raise support for top-k mining */
+    rd->smin = isr_tksupp(rd->report, rd->smin);
   if ((k > 1)                   /* if there is more than one item */
   &&  isr_xable(rd->report,2)){ /* and another item can be added */
     proj = (TIDLIST**)malloc((size_t)k *sizeof(TIDLIST*) +x);
@@ -425,9 +444,11 @@ static int rec_base (TIDLIST **lists, ITEM k, size_t x, RECDATA *rd)
   else             { z = -1; k -= 1; }
   for (r = 0; k != z; k += rd->dir) {
     l = lists[k];               /* traverse the items / tid lists */
-    r = isr_add(rd->report, l->item, l->supp);
-    if (r <  0) break;          /* add current item to the reporter */
-    if (r <= 0) continue;       /* check if item needs processing */
+    r = (rd->mode & ECL_HASHCM) /* add current item to the reporter */
+      ? isr_addsig(rd->report, l->item, l->supp, tidsig(l->tids))
+      : isr_add   (rd->report, l->item, l->supp);
+    if (r <  0) break;          /* (with tid list signature */
+    if (r <= 0) continue;       /* for the closed set hash filter) */
     if (proj && (k > 0)) {      /* if another item can be added */
       pex = (rd->mode & ECL_PERFECT) ? l->supp : SUPP_MAX;
       proj[m = 0] = d = (TIDLIST*)(p = (TID*)(proj +k+1));
@@ -472,6 +493,8 @@ int eclat_base (TABAG *tabag, int target, SUPP smin, int mode,
   assert(tabag && report);      /* check the function arguments */
   rd.target = target;           /* store target type, search mode */
   rd.mode   = mode;             /* and item processing direction */
+  if (!(isr_mode(report) & ISR_CMHASH))
+    rd.mode &= ~ECL_HASHCM;     /* tid set hashes only if filtered */
   rd.dir    = (target & (ISR_CLOSED|ISR_MAXIMAL)) ? -1 : +1;
   rd.smin   = (smin > 0) ? smin : 1;   /* check and adapt the support */
   pex       = tbg_wgt(tabag);   /* check the total transaction weight */
@@ -670,6 +693,10 @@ static int rec_tcm (TIDLIST **lists, ITEM k, size_t x, ITEM e,
   ITEM    *t;                   /* to collect the tail items */
 
   assert(lists && (k > 0) && rd);  /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
+  if (isr_topk(rd->report))     /* raise support for top-k mining */
+    rd->smin = isr_tksupp(rd->report, rd->smin);
   if (rd->mode & ECL_TAIL) {    /* if to use tail to prune w/ repo. */
     t = isr_buf(rd->report);    /* collect the tail items in buffer */
     for (m = 0, i = k; --i >= 0; ) t[m++] = lists[i]->item;
@@ -767,6 +794,10 @@ static int rec_tid (TIDLIST **lists, ITEM k, size_t x, RECDATA *rd)
   ITEM    *t;                   /* to collect the tail items */
 
   assert(lists && (k > 0) && rd);  /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
+  if (isr_topk(rd->report))     /* raise support for top-k mining */
+    rd->smin = isr_tksupp(rd->report, rd->smin);
   if (rd->mode & ECL_TAIL) {    /* if to use tail to prune w/ repo. */
     t = isr_buf(rd->report);    /* collect the tail items in buffer */
     for (m = 0, i = k; --i >= 0; ) t[m++] = lists[i]->item;
@@ -1092,6 +1123,10 @@ static int rec_bit (BITVEC **vecs, ITEM k, TID n, RECDATA *rd)
   ITEM   *t;                    /* to collect the tail items */
 
   assert(vecs && (k > 0) && rd);/* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
+  if (isr_topk(rd->report))     /* raise support for top-k mining */
+    rd->smin = isr_tksupp(rd->report, rd->smin);
   if (rd->mode & ECL_TAIL) {    /* if to use tail to prune w/ repo. */
     t = isr_buf(rd->report);    /* collect the tail items in buffer */
     for (m = 0, i = k; --i >= 0; ) t[m++] = vecs[i]->item;
@@ -1221,6 +1256,10 @@ static int rec_tab (TIDLIST **lists, ITEM k, size_t x, RECDATA *rd)
   ITEM    *t;                   /* to collect the tail items */
 
   assert(lists && (k > 0) && rd);  /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
+  if (isr_topk(rd->report))     /* raise support for top-k mining */
+    rd->smin = isr_tksupp(rd->report, rd->smin);
   if (rd->mode & ECL_TAIL) {    /* if to use tail to prune w/ repo. */
     t = isr_buf(rd->report);    /* collect the tail items in buffer */
     for (m = 0, i = k; --i >= 0; ) t[m++] = lists[i]->item;
@@ -1376,6 +1415,10 @@ static int rec_simp (TID *tids, SUPP n, ITEM k, RECDATA *rd)
 
   assert(tids                   /* check the function arguments */
   &&    (n > 0) && (k > 0) && rd);
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
+  if (isr_topk(rd->report))     /* raise support for top-k mining */
+    rd->smin = isr_tksupp(rd->report, rd->smin);
   pex = (rd->mode & ECL_PERFECT) ? n : SUPP_MAX;
   dst = tids +(TID)n+1;         /* get destination for intersections */
   if (rd->dir > 0) { z =  k; k  = 0; }
@@ -1597,6 +1640,10 @@ static int rec_trg (TRGLIST **lists, ITEM k, size_t x, RECDATA *rd)
   ITEM     *t;                  /* to collect the tail items */
 
   assert(lists && (k > 0) && rd);  /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
+  if (isr_topk(rd->report))     /* raise support for top-k mining */
+    rd->smin = isr_tksupp(rd->report, rd->smin);
   if (rd->mode & ECL_TAIL) {    /* if to use tail to prune w/ repo. */
     t = isr_buf(rd->report);    /* collect the tail items in buffer */
     for (m = 0, i = k; --i >= 0; ) t[m++] = lists[i]->item;
@@ -1817,6 +1864,8 @@ static SUPP rec_odcm (TALIST **lists, ITEM k, RECDATA *rd)
   const ITEM *s;                /* to traverse items */
 
   assert(lists && (k > 0) && rd);  /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
   l = lists[k]; m = 0;          /* get the trans. list to process */
   for (n = 0; n < l->cnt; n++){ /* traverse the transactions */
     t = l->tracts[n];           /* get the next transaction */
@@ -1874,6 +1923,10 @@ static int rec_odfx (TALIST **lists, ITEM k, RECDATA *rd)
   const ITEM *s;                /* to traverse items */
 
   assert(lists && (k > 0) && rd);  /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
+  if (isr_topk(rd->report))     /* raise support for top-k mining */
+    rd->smin = isr_tksupp(rd->report, rd->smin);
   l = lists[k];                 /* collate equal transactions */
   taa_collate(l->tracts, l->cnt, k);
   for (n = 0; n < l->cnt; n++){ /* traverse the transactions, */
@@ -1938,6 +1991,10 @@ static int rec_odro (TALIST **lists, ITEM k, RECDATA *rd)
   void       *mem = NULL;       /* memory for reduction */
 
   assert(lists && (k > 0) && rd);  /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
+  if (isr_topk(rd->report))     /* raise support for top-k mining */
+    rd->smin = isr_tksupp(rd->report, rd->smin);
   supp = (SUPP*)memset(rd->muls, 0, (size_t)k *sizeof(SUPP));
   l    = lists[k];              /* initialize the item support array */
   for (x = 0, n = 0; n < l->cnt; n++) {
@@ -2172,6 +2229,10 @@ static int rec_diff (TIDLIST **lists, ITEM k, TID x,
   ITEM    *t;                   /* to collect the tail items */
 
   assert(lists && (k > 0) && rd);  /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
+  if (isr_topk(rd->report))     /* raise support for top-k mining */
+    rd->smin = isr_tksupp(rd->report, rd->smin);
   if (rd->mode & ECL_TAIL) {    /* if to use tail to prune w/ repo. */
     t = isr_buf(rd->report);    /* collect the tail items in buffer */
     for (m = 0, i = k; --i >= 0; ) t[m++] = lists[i]->item;
@@ -2534,6 +2595,8 @@ int eclat_repo (ISREPORT *report, int target,
   if ((mode & ECL_EXTCHK) || (target & ISR_RULES)
   || ((eval > RE_NONE) && (eval < RE_FNCNT)))
     mrep |= ISR_NOFILTER;       /* no filtering if done in Eclat */
+  if ((mode & ECL_HASHCM) && (algo == ECL_BASIC))
+    mrep |= ISR_CMHASH;         /* closed filter with tid set hashes */
 
   /* --- configure item set reporter --- */
   if (eval == ECL_LDRATIO)      /* set additional evaluation measure */
@@ -2843,6 +2906,7 @@ int main (int argc, char *argv[])
   int     scan     = 0;         /* flag for scanable item output */
   int     bdrcnt   = 0;         /* number of support values in border */
   int     stats    = 0;         /* flag for item set statistics */
+  int     binary   = 0;         /* flag for binary output format */
   PATSPEC *psp;                 /* collected pattern spectrum */
   ITEM    m;                    /* number of items */
   TID     n;                    /* number of transactions */
@@ -2916,6 +2980,10 @@ int main (int argc, char *argv[])
                     "(default: use hut)\n");
     printf("         (only for maximal item sets, option -tm, "
                     "not with option -Ab)\n");
+    printf("-j       filter closed item sets with tid set hashes "
+                    "(default: tree)\n");
+    printf("         (only for closed item sets, option -tc, "
+                    "and basic variant, option -Ae)\n");
     printf("-F#:#..  support border for filtering item sets   "
                     "(default: none)\n");
     printf("         (list of minimum support values, "
@@ -2926,6 +2994,8 @@ int main (int argc, char *argv[])
     printf("-P#      write a pattern spectrum to a file\n");
     printf("-Z       print item set statistics "
                     "(number of item sets per size)\n");
+    printf("-B       write item sets in binary format "
+                    "(compressed)\n");
     printf("-g       write output in scanable form "
                     "(quote certain characters)\n");
     printf("-h#      record header  for output                "
@@ -2956,7 +3026,7 @@ int main (int argc, char *argv[])
     return 0;                   /* print a usage message */
   }                             /* and abort the program */
   #endif  /* #ifndef QUIET */
-  /* free option characters: j [A-Z]\[ACFIPRSTZ] */
+  /* free option characters: [A-Z]\[ABCFIPRSTZ] */
 
   /* --- evaluate arguments --- */
   for (i = 1; i < argc; i++) {  /* traverse the arguments */
@@ -2985,10 +3055,12 @@ int main (int argc, char *argv[])
           case 'i': mode  &= ~ECL_REORDER;           break;
           case 'y': cmfilt = (int) strtol(s, &s, 0); break;
           case 'u': mode  &= ~ECL_TAIL;              break;
+          case 'j': mode  |=  ECL_HASHCM;            break;
           case 'F': bdrcnt = getbdr(s, &s, &border); break;
           case 'R': optarg = &fn_sel;                break;
           case 'P': optarg = &fn_psp;                break;
           case 'Z': stats  = 1;                      break;
+          case 'B': binary = 1;                      break;
           case 'g': scan   = 1;                      break;
           case 'h': optarg = &hdr;                   break;
           case 'k': optarg = &sep;                   break;
@@ -3087,6 +3159,8 @@ int main (int argc, char *argv[])
     mode |= (pack < 16) ? pack : 16;
   if (target & ISR_RULES) fn_psp = NULL;
   else conf = 100;              /* no pattern spectrum for rules */
+  if ((target & ISR_RULES) && binary)
+    error(E_TARGET, 'r');       /* binary format only for item sets */
   if (info == dflt) {           /* if default info. format is used, */
     if (target != ISR_RULES)    /* set default according to target */
          info = (supp < 0) ? " (%a)"     : " (%S)";
@@ -3162,7 +3236,8 @@ int main (int argc, char *argv[])
     error(E_NOMEM);             /* set a pattern spectrum if req. */
   if (isr_setfmt(report, scan, hdr, sep, imp, info) != 0)
     error(E_NOMEM);             /* set the output format strings */
-  k = isr_open(report, NULL, fn_out);
+  k = (binary) ? isr_openbin(report, NULL, fn_out)
+               : isr_open   (report, NULL, fn_out);
   if (k) error(k, isr_name(report));     /* open item set file */
   if (isr_tidopen(report, NULL, fn_tid) != 0)
     error(E_FOPEN, isr_tidname(report)); /* open trans. id file */
@@ -53,6 +53,7 @@
 #define ECL_HORZ    0x0100      /* horizontal extensions tests */
 #define ECL_VERT    0x0200      /* vertical   extensions tests */
 #define ECL_TIDS    0x0400      /* flag for trans. identifier output */
+#define ECL_HASHCM  0x0800      /* closed filter with tid set hashes */
 #define ECL_EXTCHK  (ECL_HORZ|ECL_VERT)
 #define ECL_DEFAULT (ECL_PERFECT|ECL_REORDER|ECL_TAIL)
 #ifdef NDEBUG
@@ -62,6 +62,10 @@
             2014.08.21 adapted to modified item set reporter interface
             2014.08.28 functions fpg_data() and fpg_repo() added
             2014.10.24 changed from LGPL license to MIT license
+            2026.10.18 cache-friendly array-based tree variant added
+            2026.10.18 batched node list traversal with prefetching
+            2026.10.18 option -B added (binary item set output)
+            2026.10.18 progress/cancellation polling in recursion
 ------------------------------------------------------------------------
   Reference for the FP-growth algorithm:
     J. Han, H. Pei, and Y. Yin.
@@ -132,6 +136,19 @@
 
 #define COPYERR     ((TDNODE*)-1)
 
+#ifndef FPG_PFWIN               /* window size for batched */
+#define FPG_PFWIN   16          /* traversal of node lists */
+#endif
+#ifdef __GNUC__                 /* if prefetching is available, */
+#define PREFETCH(p) __builtin_prefetch(p)  /* use builtin function */
+#else                           /* otherwise prefetching */
+#define PREFETCH(p)             /* is a no-op */
+#endif
+
+#define CFP_NIL     0           /* null node index (root is no child) */
+#define CFP_DMAX    USHRT_MAX   /* maximal item delta in a cfp tree */
+#define CFP_NMAX    UINT_MAX    /* maximal number of cfp tree nodes */
+
 #ifndef QUIET                   /* if not quiet version, */
 #define MSG         fprintf     /* print messages */
 #define XMSG        if (mode & FPG_VERBOSE) fprintf
@@ -203,6 +220,37 @@ typedef struct {                /* --- top-down freq. pat. tree --- */
   ITEM     items[1];            /* item identifier map */
 } TDTREE;                       /* (top-down tree) */
 
+typedef unsigned int   CFPIDX;  /* 32 bit node index in a cfp tree */
+typedef unsigned short CFPDLT;  /* item delta w.r.t. the parent node */
+
+typedef struct {                /* --- cfp tree node list --- */
+  ITEM     item;                /* associated item (item base code) */
+  SUPP     supp;                /* support (weight of transactions) */
+  CFPIDX   cnt;                 /* number of nodes with this item */
+  CFPIDX   *list;               /* indices of nodes with this item */
+} CFPHEAD;                      /* (cfp tree head) */
+
+typedef struct {                /* --- cache-friendly fp-tree --- */
+  ITEM     cnt;                 /* number of items / heads */
+  int      dir;                 /* processing direction */
+  CFPIDX   size;                /* number of nodes (incl. root) */
+  SUPP     *supps;              /* node supports (in DFS order) */
+  CFPIDX   *pars;               /* parent node indices */
+  CFPIDX   *links;              /* node links of all item heads */
+  CFPDLT   *dlts;               /* item deltas to the parent nodes */
+  CFPHEAD  heads[1];            /* header table (item lists) */
+} CFPTREE;                      /* (cache-friendly fp-tree) */
+
+typedef struct {                /* --- cfp tree construction buffer --- */
+  CFPIDX   *cnts;               /* number of nodes per item */
+  SUPP     *supp;               /* node supports */
+  CFPIDX   *par;                /* parent  node indices */
+  CFPIDX   *kid;                /* first child  indices */
+  CFPIDX   *sib;                /* next sibling indices */
+  CFPIDX   *nid;                /* node indices in DFS order */
+  ITEM     *item;               /* items associated with the nodes */
+} CFPBUF;                       /* (cfp tree construction buffer) */
+
 typedef struct {                /* --- recursion data --- */
   int      mode;                /* mode flags (e.g. FPG_PERFECT) */
   int      dir;                 /* direction for item loops */
@@ -213,6 +261,7 @@ typedef struct {                /* --- recursion data --- */
   FIM16    *fim16;              /* 16-items machine */
   ISREPORT *report;             /* item set reporter */
   ISTREE   *istree;             /* item set tree for fpg_tree() */
+  CFPBUF   *cfp;                /* buffer for building cfp trees */
 } RECDATA;                      /* (recursion data) */
 
 typedef struct {                /* --- fpgrowth execution data --- */
@@ -368,6 +417,36 @@ static void tdt_show (TDTREE *tdt, ITEMBASE *base, int ind)
   Frequent Pattern Growth (simple nodes with only successor/parent)
 ----------------------------------------------------------------------*/
 
+static void cis_batch (FPNODE *node, SUPP *s)
+{                               /* --- sum cond. supports in batches */
+  int    i, k;                  /* loop variable, number of paths */
+  SUPP   w[FPG_PFWIN];          /* supports of the collected nodes */
+  FPNODE *a[FPG_PFWIN];         /* current ancestors on the paths */
+  FPNODE *anc;                  /* to traverse the ancestors */
+
+  assert(s);                    /* check the function arguments */
+  for (k = 0; node && (k < FPG_PFWIN); node = node->succ) {
+    PREFETCH(a[k] = node->parent); w[k++] = node->supp; }
+  while (k > 0) {               /* collect a window of node links */
+    for (i = 0; i < k; ) {      /* climb the paths in rounds */
+      anc = a[i];               /* (one step per path and round) */
+      if (anc->id >= 0) {       /* if not at the root/packed items */
+        s[anc->id] += w[i];     /* compute the conditional support */
+        PREFETCH(a[i++] = anc->parent); }
+      else if (node) {          /* if a path is finished, */
+        PREFETCH(a[i] = node->parent); /* replace it with the path */
+        w[i++] = node->supp;    /* of the next node in the list */
+        node   = node->succ; }
+      else {                    /* if the node list is exhausted, */
+        a[i] = a[--k];          /* remove the finished path */
+        w[i] = w[k];            /* from the window */
+      }                         /* (while the parent is fetched, */
+    }                           /* the other paths are processed, */
+  }                             /* so that the memory accesses */
+}  /* cis_batch() */            /* of the paths overlap) */
+
+/*--------------------------------------------------------------------*/
+
 static int add_simple (FPTREE *fpt, const ITEM *ids, ITEM n, SUPP supp)
 {                               /* --- add an item set to the tree */
   ITEM   i;                     /* buffer for an item */
@@ -407,13 +486,18 @@ static int proj_simple (FPTREE *dst, FPTREE *src, ITEM id, RECDATA *rd)
   ITEM   *map, *d;              /* to build the item map */
   FPHEAD *h;                    /* to access the node headers */
   FPNODE *node, *anc;           /* to traverse the tree nodes */
+  FPNODE *ahd;                  /* node to prefetch the parent of */
 
   assert(dst                    /* check the function arguments */
   &&     src && (id >= 0) && rd);
   memset(s = rd->cis, 0, (size_t)id *sizeof(SUPP));
-  for (node = src->heads[id].list; node; node = node->succ)
-    for (anc = node->parent; anc->id >= 0; anc = anc->parent)
-      s[anc->id] += node->supp; /* compute the conditional support */
+  if (rd->mode & FPG_PREFETCH)  /* if to prefetch parent nodes, */
+    cis_batch(src->heads[id].list, s);    /* process node batches */
+  else {                        /* if to traverse nodes one by one */
+    for (node = src->heads[id].list; node; node = node->succ)
+      for (anc = node->parent; anc->id >= 0; anc = anc->parent)
+        s[anc->id] += node->supp;
+  }                             /* compute the conditional support */
   /* Using a two-dimensional table that is filled when a frequent */
   /* pattern tree is created proved to be slower than the above.  */
   pex = (rd->mode & FPG_PERFECT) ? src->heads[id].supp : SUPP_MAX;
@@ -432,7 +516,12 @@ static int proj_simple (FPTREE *dst, FPTREE *src, ITEM id, RECDATA *rd)
   if (n <= 0) return 0;         /* if the projection is empty, abort */
   dst->cnt       = n;           /* note the number of items and */
   dst->root.supp = 0;           /* init. root node and node heads */
+  ahd = (rd->mode & FPG_PREFETCH) ? src->heads[id].list : NULL;
+  for (i = 0; ahd && (i < FPG_PFWIN); i++) {
+    PREFETCH(ahd->parent); ahd = ahd->succ; }
   for (node = src->heads[id].list; node; node = node->succ) {
+    if (ahd) {                  /* prefetch the parent of a node */
+      PREFETCH(ahd->parent); ahd = ahd->succ; }   /* further ahead */
     d = map;                    /* traverse the item list */
     for (anc = node->parent; anc->id > TA_END; anc = anc->parent)
       if ((i = map[anc->id]) >= 0) *--d = i;
@@ -454,6 +543,10 @@ static int rec_simple (FPTREE *fpt, RECDATA *rd)
   ITEM   *s;                    /* to collect the tail items */
 
   assert(fpt && rd);            /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
+  if (isr_topk(rd->report))     /* raise support for top-k mining */
+    rd->smin = isr_tksupp(rd->report, rd->smin);
   if (rd->mode & FPG_TAIL) {    /* if to use head union tail pruning */
     for (s = rd->set, i = 0; i < fpt->cnt; i++)
       s[i] = fpt->heads[i].item;/* collect the tail items */
@@ -559,13 +652,18 @@ static int proj_smp16 (FPTREE *dst, FPTREE *src, ITEM id,
   ITEM   *map, *d;              /* to build the item map */
   FPHEAD *h;                    /* to access the node heads */
   FPNODE *node, *anc;           /* to traverse the tree nodes */
+  FPNODE *ahd;                  /* node to prefetch the parent of */
 
   assert(dst                    /* check the function arguments */
   &&     src && (id >= 0) && rd);
   memset(s = rd->cis, 0, (size_t)id *sizeof(SUPP));
-  for (node = src->heads[id].list; node; node = node->succ)
-    for (anc = node->parent; anc->id >= 0; anc = anc->parent)
-      s[anc->id] += node->supp; /* compute the conditional support */
+  if (rd->mode & FPG_PREFETCH)  /* if to prefetch parent nodes, */
+    cis_batch(src->heads[id].list, s);    /* process node batches */
+  else {                        /* if to traverse nodes one by one */
+    for (node = src->heads[id].list; node; node = node->succ)
+      for (anc = node->parent; anc->id >= 0; anc = anc->parent)
+        s[anc->id] += node->supp;
+  }                             /* compute the conditional support */
   /* Using a two-dimensional table that is filled when a frequent */
   /* pattern tree is created proved to be slower than the above.  */
   pex = (rd->mode & FPG_PERFECT) ? src->heads[id].supp : SUPP_MAX;
@@ -586,7 +684,12 @@ static int proj_smp16 (FPTREE *dst, FPTREE *src, ITEM id,
   if (n <= 0) return 0;         /* if the projection is empty, abort */
   dst->cnt       = n;           /* note the number of items and */
   dst->root.supp = 0;           /* init. root node and node heads */
+  ahd = (rd->mode & FPG_PREFETCH) ? src->heads[id].list : NULL;
+  for (i = 0; ahd && (i < FPG_PFWIN); i++) {
+    PREFETCH(ahd->parent); ahd = ahd->succ; }
   for (node = src->heads[id].list; node; node = node->succ) {
+    if (ahd) {                  /* prefetch the parent of a node */
+      PREFETCH(ahd->parent); ahd = ahd->succ; }   /* further ahead */
     d = map;                    /* traverse the item list */
     for (anc = node->parent; anc->id > TA_END; anc = anc->parent) {
       i = anc->id;              /* traverse path to the root */
@@ -612,6 +715,10 @@ static int rec_smp16 (FPTREE *fpt, RECDATA *rd)
   ITEM   *s;                    /* to collect the tail items */
 
   assert(fpt && rd);            /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
+  if (isr_topk(rd->report))     /* raise support for top-k mining */
+    rd->smin = isr_tksupp(rd->report, rd->smin);
   if (rd->mode & FPG_TAIL) {    /* if to use head union tail pruning */
     for (s = rd->set, i = 0; i < fpt->cnt; i++)
       s[i] = fpt->heads[i].item;/* collect the tail items */
@@ -1063,6 +1170,10 @@ static int rec_cmplx (CSTREE *cst, RECDATA *rd)
   ITEM   *s;                    /* to collect the tail items */
 
   assert(cst && rd);            /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
+  if (isr_topk(rd->report))     /* raise support for top-k mining */
+    rd->smin = isr_tksupp(rd->report, rd->smin);
   if (rd->mode & FPG_TAIL) {    /* if to use head union tail pruning */
     for (s = rd->set, i = 0; i < cst->cnt; i++)
       s[i] = cst->heads[i].item;/* collect the tail items */
@@ -1203,6 +1314,8 @@ int rec_single (FPTREE *fpt, ITEM n, RECDATA *rd)
   FPNODE *node, *anc;           /* to traverse the tree nodes */
 
   assert(fpt && rd);            /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
   i = (fpt->fim16) ? 1 : 0;     /* skip packed items if they exist */
   for (r = 0; i < n; i++) {     /* traverse the (other) items, */
     h = fpt->heads +i;          /* but skip infrequent items */
@@ -1462,6 +1575,10 @@ static int rec_topdn (TDTREE *tdt, RECDATA *rd)
   ITEM   *map;                  /* to build the item map */
 
   assert(tdt && rd);            /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
+  if (isr_topk(rd->report))     /* raise support for top-k mining */
+    rd->smin = isr_tksupp(rd->report, rd->smin);
   if (rd->mode & FPG_TAIL) {    /* if to use head union tail pruning */
     r = isr_tail(rd->report, tdt->items, tdt->cnt);
     if (r) return r;            /* if tail needs no processing, */
@@ -1573,6 +1690,297 @@ int fpg_topdn (TABAG *tabag, int target, SUPP smin, int mode,
   return r;                     /* return the error status */
 }  /* fpg_topdn() */
 
+/*----------------------------------------------------------------------
+  Frequent Pattern Growth (cache-friendly array-based trees)
+----------------------------------------------------------------------*/
+/* The nodes of a cfp tree are stored in flat arrays in depth-first  */
+/* order, parents are referred to by 32 bit indices and each node    */
+/* stores only the difference of its item to the item of its parent. */
+/* Since the items on a path increase from the root, the item of an  */
+/* ancestor is obtained by subtracting deltas, starting with the     */
+/* item of the node list (header) that is traversed. The node lists  */
+/* are index arrays, which are placed consecutively in one array.    */
+
+static int cfp_alloc (CFPTREE *cfp, CFPIDX size, const CFPIDX *cnts)
+{                               /* --- allocate the node arrays */
+  ITEM    i;                    /* loop variable */
+  CFPIDX  *p;                   /* to distribute the node links */
+  CFPHEAD *h;                   /* to traverse the item heads */
+
+  assert(cfp && (size > 0) && cnts); /* check the function arguments */
+  cfp->supps = (SUPP*)malloc((size_t)size *(sizeof(SUPP)
+                            +2*sizeof(CFPIDX) +sizeof(CFPDLT)));
+  if (!cfp->supps) return -1;   /* allocate the node arrays */
+  cfp->pars  = (CFPIDX*)(cfp->supps +size);
+  cfp->links = p = cfp->pars +size;   /* organize the memory block */
+  cfp->dlts  = (CFPDLT*)(cfp->links +size);
+  cfp->size  = size;            /* note the number of nodes */
+  for (i = 0; i < cfp->cnt; i++) {
+    h = cfp->heads +i;          /* traverse the item heads and */
+    h->list = p; p += cnts[i];  /* assign the sections of the */
+    h->cnt  = 0;                /* node link array to them */
+  }
+  return 0;                     /* return 'ok' */
+}  /* cfp_alloc() */
+
+/*--------------------------------------------------------------------*/
+
+static int proj_cfp (CFPTREE *dst, CFPTREE *src, ITEM id, RECDATA *rd)
+{                               /* --- project a cfp tree */
+  ITEM    i, k, n;              /* loop variables, item buffer */
+  SUPP    pex;                  /* minimum support for perf. exts. */
+  SUPP    w;                    /* support of the current node */
+  SUPP    *s;                   /* to sum the support values */
+  ITEM    *map, *d;             /* to build the item map */
+  CFPIDX  c, x, y, a;           /* node indices, number of nodes */
+  CFPIDX  *l, *e;               /* to traverse the node links */
+  CFPHEAD *h;                   /* to access the node heads */
+  CFPBUF  *b;                   /* buffer for tree construction */
+
+  assert(dst                    /* check the function arguments */
+  &&     src && (id >= 0) && rd);
+  memset(s = rd->cis, 0, (size_t)id *sizeof(SUPP));
+  l = src->heads[id].list;      /* get the node links of the item */
+  e = l +src->heads[id].cnt;    /* and traverse the nodes */
+  for ( ; l < e; l++) {         /* (ancestor items from deltas) */
+    w = src->supps[x = *l];     /* get the node support */
+    for (i = id; (a = src->pars[x]) != CFP_NIL; x = a)
+      s[i -= (ITEM)src->dlts[x]] += w;
+  }                             /* compute the conditional support */
+  pex = (rd->mode & FPG_PERFECT) ? src->heads[id].supp : SUPP_MAX;
+  map = rd->map;                /* get perfect extension support */
+  for (i = n = 0; i < id; i++){ /* traverse the items that */
+    if (s[i] <  rd->smin) {     /* precede the projection item, */
+      map[i] = -1; continue; }  /* eliminate infrequent items and */
+    if (s[i] >= pex) {          /* collect perfect extension items */
+      map[i] = -1; isr_addpex(rd->report,src->heads[i].item); continue;}
+    map[i] = n;                 /* build the item identifier map */
+    h = dst->heads +n++;        /* init. the destination header */
+    h->item = src->heads[i].item;
+    h->supp = s[i];             /* note the conditional item support */
+  }
+  if (n <= 0) return 0;         /* if the projection is empty, abort */
+  dst->cnt = n;                 /* note the number of items */
+  b = rd->cfp;                  /* build the projection with */
+  b->supp[0] = 0;               /* children/sibling links, */
+  b->kid [0] = CFP_NIL; c = 1;  /* starting with an empty root */
+  for (l = src->heads[id].list; l < e; l++) {
+    w = src->supps[x = *l];     /* traverse the item list */
+    d = map;                    /* and collect the path items */
+    for (i = id; (a = src->pars[x]) != CFP_NIL; x = a) {
+      i -= (ITEM)src->dlts[x];  /* compute the ancestor item and */
+      if ((k = map[i]) >= 0) *--d = k;
+    }                           /* collect the non-eliminated items */
+    b->supp[y = 0] += w;        /* update the root node support */
+    while (d < map) {           /* traverse the path items */
+      k = *d++;                 /* find the child with the item */
+      for (x = b->kid[y]; (x != CFP_NIL) && (b->item[x] != k); )
+        x = b->sib[x];          /* if there is no such child, */
+      if (x == CFP_NIL) {       /* create a new node */
+        b->item[x = c++] = k; b->supp[x] = 0;
+        b->par [x] = y; b->kid[x] = CFP_NIL;
+        b->sib [x] = b->kid[y]; b->kid[y] = x;
+        b->cnts[k]++;           /* add the node to the children */
+      }                         /* and count it for its item */
+      b->supp[y = x] += w;      /* update the node support */
+    }                           /* and go down in the tree */
+  }
+  if (cfp_alloc(dst, c, b->cnts) < 0)
+    return -1;                  /* allocate the node arrays */
+  for (i = 0; i < n; i++)       /* clear the node counters */
+    b->cnts[i] = 0;             /* for the next projection */
+  dst->supps[0] = b->supp[0];   /* init. the root node */
+  dst->pars [0] = CFP_NIL; dst->dlts[0] = 0;
+  b->item[0] = -1; b->nid[0] = 0;
+  for (c = 1, x = b->kid[0]; x != CFP_NIL; ) {
+    b->nid[x] = c;              /* traverse the nodes depth-first */
+    y = b->par[x];              /* and store them in this order */
+    dst->supps[c] = b->supp[x];
+    dst->pars [c] = b->nid[y];  /* store the node data and */
+    dst->dlts [c] = (CFPDLT)(b->item[x] -b->item[y]);
+    h = dst->heads +b->item[x]; /* add the node to its item list */
+    h->list[h->cnt++] = c++;    /* (node lists are ordered) */
+    if (b->kid[x] != CFP_NIL) { x = b->kid[x]; continue; }
+    while ((x != CFP_NIL) && (b->sib[x] == CFP_NIL))
+      x = b->par[x];            /* go to the next sibling, */
+    if (x != CFP_NIL) x = b->sib[x];
+  }                             /* going up in the tree if necessary */
+  return 1;                     /* return that result is not empty */
+}  /* proj_cfp() */
+
+/*--------------------------------------------------------------------*/
+
+static int rec_cfp (CFPTREE *cfp, RECDATA *rd)
+{                               /* --- find item sets recursively */
+  int     r;                    /* error status */
+  ITEM    i, k, z;              /* loop variables */
+  CFPIDX  x, a;                 /* to traverse the ancestors */
+  CFPHEAD *h;                   /* node list for current item */
+  CFPTREE *proj = NULL;         /* projected cfp tree */
+  ITEM    *s;                   /* to collect the tail items */
+
+  assert(cfp && rd);            /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
+  if (isr_topk(rd->report))     /* raise support for top-k mining */
+    rd->smin = isr_tksupp(rd->report, rd->smin);
+  if (rd->mode & FPG_TAIL) {    /* if to use head union tail pruning */
+    for (s = rd->set, i = 0; i < cfp->cnt; i++)
+      s[i] = cfp->heads[i].item;/* collect the tail items */
+    r = isr_tail(rd->report, s, i);
+    if (r) return r;            /* if tail needs no processing, */
+  }                             /* abort the recursion */
+  if ((cfp->cnt > 1)            /* if there is more than one item */
+  &&  isr_xable(rd->report,2)){ /* and another item can be added */
+    proj = (CFPTREE*)malloc(sizeof(CFPTREE)
+                          +(size_t)(cfp->cnt-2) *sizeof(CFPHEAD));
+    if (!proj) return -1;       /* create a cfp tree header */
+    proj->dir = cfp->dir;       /* of the maximally possible size */
+  }                             /* and copy the processing direction */
+  if (cfp->dir > 0) { z = cfp->cnt; i = 0; }
+  else              { z = -1;       i = cfp->cnt-1; }
+  for (r = 0; i != z; i += cfp->dir) {
+    h = cfp->heads +i;          /* traverse the frequent items */
+    r = isr_add(rd->report, h->item, h->supp);
+    if (r <  0) break;          /* add current item to the reporter */
+    if (r <= 0) continue;       /* check if item needs processing */
+    if (h->cnt <= 1) {          /* if projection would be a chain */
+      for (k = i, x = h->list[0]; (a = cfp->pars[x]) != CFP_NIL; x = a)
+        isr_addpex(rd->report, cfp->heads[k -= (ITEM)cfp->dlts[x]].item);
+    }                           /* add items as perfect extensions */
+    else if (proj) {            /* if another item can be added */
+      r = proj_cfp(proj, cfp, i, rd);
+      if (r > 0) { r = rec_cfp(proj, rd); free(proj->supps); }
+      if (r < 0) break;         /* project cfp tree and find */
+    }                           /* freq. item sets recursively */
+    r = isr_report(rd->report); /* report the current item set */
+    if (r < 0) break;           /* and check for an error */
+    isr_remove(rd->report, 1);  /* remove the current item */
+  }                             /* from the item set reporter */
+  if (proj) free(proj);         /* delete the projection header */
+  return r;                     /* return the error status */
+}  /* rec_cfp() */
+
+/*--------------------------------------------------------------------*/
+
+int fpg_cfp (TABAG *tabag, int target, SUPP smin, int mode,
+             ISREPORT *report)
+{                               /* --- search for frequent item sets */
+  int        r = 0;             /* result of recursion/functions */
+  ITEM       i, k, m;           /* loop variable, number of items */
+  ITEM       l, o;              /* current and previous path length */
+  TID        j, n;              /* loop variable, number of trans. */
+  SUPP       pex, w;            /* minimum support for perf. exts. */
+  size_t     e;                 /* number of item instances */
+  TRACT      *t;                /* to traverse the transactions */
+  ITEM       *s, *d, *q;        /* to build the item maps */
+  const ITEM *p;                /* to traverse transaction items */
+  const SUPP *f;                /* item frequencies in trans. bag */
+  SUPP       *ns;               /* node supports during construction */
+  CFPIDX     *np, *u;           /* parent indices, nodes on path */
+  ITEM       *ni;               /* node items during construction */
+  CFPIDX     c, x;              /* number of nodes, node index */
+  CFPTREE    *cfp;              /* created cfp tree */
+  CFPHEAD    *h;                /* to traverse the item heads */
+  CFPBUF     buf;               /* buffer for building projections */
+  RECDATA    rd;                /* structure for recursive search */
+
+  assert(tabag && report);      /* check the function arguments */
+  e = tbg_extent(tabag);        /* get the number of item instances */
+  k = tbg_itemcnt(tabag);       /* and the number of items */
+  if ((k > (ITEM)CFP_DMAX) || (e >= (size_t)CFP_NMAX))
+    return fpg_simple(tabag, target, smin, mode & ~FPG_FIM16, report);
+  /* Item deltas are stored as 16 bit and node indices as 32 bit  */
+  /* values; if these do not suffice, use simple nodes instead.   */
+  rd.mode = mode;               /* store search mode and item dir. */
+  rd.dir  = (target & (ISR_CLOSED|ISR_MAXIMAL)) ? -1 : +1;
+  rd.smin = (smin > 0) ? smin : 1;    /* check and adapt the support */
+  pex     = tbg_wgt(tabag);     /* check against the minimum support */
+  if (rd.smin > pex) return 0;  /* and get minimum for perfect exts. */
+  if (!(mode & FPG_PERFECT)) pex = SUPP_MAX;
+  n = tbg_cnt(tabag);           /* get the number of transactions */
+  if (k <= 0) return isr_report(report);
+  f = tbg_ifrqs(tabag, 0);      /* get the item frequencies */
+  if (!f) return -1;            /* in the transaction bag */
+  s = rd.set = (ITEM*)malloc((size_t)(k+k) *sizeof(ITEM)
+                            +(size_t) k    *sizeof(SUPP));
+  if (!s) return -1;            /* create item and support arrays */
+  rd.map = d = s+k;             /* note item map and set buffer */
+  rd.cis = (SUPP*)(d+k);        /* and the item support array */
+  for (i = m = 0; i < k; i++) { /* build the item identifier map */
+    if (f[i] <  rd.smin) { d[i] = -1;                        continue; }
+    if (f[i] >= pex)     { d[i] = -1; isr_addpex(report, i); continue; }
+    d[i] = m; s[m++] = i;       /* eliminate infrequent items and */
+  }                             /* collect perfect extension items */
+  if (m <= 0) {                 /* check whether there are items left */
+    r = isr_report(report); free(rd.set); return r; }
+  buf.cnts = (CFPIDX*)calloc((size_t)m, sizeof(CFPIDX));
+  if (!buf.cnts) { free(rd.set); return -1; }
+  cfp = (CFPTREE*)malloc(sizeof(CFPTREE) +(size_t)(m-1) *sizeof(CFPHEAD));
+  if (!cfp) { free(buf.cnts); free(rd.set); return -1; }
+  cfp->cnt = m;                 /* allocate the base tree structure */
+  cfp->dir = rd.dir;            /* and initialize its fields */
+  for (i = 0; i < m; i++) {     /* initialize the header table */
+    h = cfp->heads+i; h->supp = f[h->item = s[i]]; }
+  l  = tbg_max(tabag);          /* get the maximal transaction size */
+  ns = (SUPP*)malloc((e+1)      *(sizeof(SUPP)+sizeof(CFPIDX)
+                                 +sizeof(ITEM))
+                    +(size_t)(l+1) *(sizeof(CFPIDX)+sizeof(ITEM)));
+  if (!ns) { free(cfp); free(buf.cnts); free(rd.set); return -1; }
+  np = (CFPIDX*)(ns +e+1);      /* allocate construction arrays */
+  u  = np +e+1;                 /* (node supports, parents, items */
+  ni = (ITEM*)(u +l+1);         /* and the nodes/items of the */
+  q  = ni +e+1;                 /* previously added path) */
+  ns[0] = 0; np[0] = CFP_NIL;   /* initialize the root node */
+  ni[0] = -1; u[0] = 0; c = 1;  /* (transactions are sorted, so */
+  for (o = 0, j = n; --j >= 0; ) {    /* a path shares its prefix */
+    t = tbg_tract(tabag, j);    /* with the preceding path, which */
+    ns[0] += w = ta_wgt(t);     /* yields nodes in DFS order) */
+    for (l = 0, x = 0, p = ta_items(t); *p > TA_END; p++) {
+      if ((i = d[*p]) < 0) continue;
+      if ((++l <= o) && (q[l] == i)) x = u[l];
+      else {                    /* follow the preceding path */
+        o = 0;                  /* as long as items match, */
+        np[c] = x; ni[c] = i;   /* otherwise create a new node */
+        ns[c] = 0; buf.cnts[i]++;
+        q [l] = i; u[l] = x = c++;
+      }                         /* update the node support */
+      ns[x] += w;               /* and note the last node */
+    }                           /* for the next transaction */
+    o = l;                      /* note the length of the path */
+  }
+  if (cfp_alloc(cfp, c, buf.cnts) < 0) {
+    free(ns); free(cfp); free(buf.cnts); free(rd.set); return -1; }
+  for (i = 0; i < m; i++)       /* clear the node counters */
+    buf.cnts[i] = 0;            /* for the projections */
+  cfp->supps[0] = ns[0];        /* copy the root node */
+  cfp->pars [0] = CFP_NIL; cfp->dlts[0] = 0;
+  for (x = 1; x < c; x++) {     /* copy the nodes to the tree */
+    cfp->supps[x] = ns[x];      /* (convert items to deltas) */
+    cfp->pars [x] = np[x];
+    cfp->dlts [x] = (CFPDLT)(ni[x] -ni[np[x]]);
+    h = cfp->heads +ni[x]; h->list[h->cnt++] = x;
+  }                             /* add the node to its item list */
+  free(ns);                     /* delete the construction arrays */
+  buf.supp = (SUPP*)malloc((size_t)c *(sizeof(SUPP)
+                          +4*sizeof(CFPIDX) +sizeof(ITEM)));
+  if (buf.supp) {               /* create the projection buffer */
+    buf.par  = (CFPIDX*)(buf.supp +c);
+    buf.kid  = buf.par +c;      /* (no projection can have more */
+    buf.sib  = buf.kid +c;      /* nodes than the full tree) */
+    buf.nid  = buf.sib +c;
+    buf.item = (ITEM*)(buf.nid +c);
+    rd.cfp    = &buf;           /* note the construction buffer */
+    rd.report = report;         /* and the item set reporter */
+    r = rec_cfp(cfp, &rd);      /* find freq. item sets recursively */
+    if (r >= 0) r = isr_report(report);
+    free(buf.supp); }           /* report the empty item set */
+  else r = -1;                  /* and delete the buffer */
+  free(cfp->supps); free(cfp);  /* delete the cfp tree */
+  free(buf.cnts); free(rd.set); /* and the work arrays */
+  return r;                     /* return the error status */
+}  /* fpg_cfp() */
+
 /*----------------------------------------------------------------------
   Frequent Pattern Growth (on single tree, for rules)
 ----------------------------------------------------------------------*/
@@ -1692,6 +2100,7 @@ static FPGFN* fpgvars[] = {     /* --- table of fp-growth variants */
   fpg_cmplx,                    /* complex nodes (children/sibling) */
   fpg_single,                   /* top-down processing w/ single tree */
   fpg_topdn,                    /* top-down processing of the tree */
+  fpg_cfp,                      /* cache-friendly array-based trees */
 };
 
 /*--------------------------------------------------------------------*/
@@ -1950,9 +2359,10 @@ static void help (void)
                "(default)\n");
   printf("  d   top-down processing on a single prefix tree\n");
   printf("  t   top-down processing of the prefix trees\n");
+  printf("  a   cache-friendly array-based prefix trees\n");
   printf("Variant 'd' does not support mining closed/maximal item ");
-  printf("sets,\nvariant 't' does not support the use of a k-items ");
-  printf("machine, and\nonly variant 'c' supports item reordering ");
+  printf("sets,\nvariants 't' and 'a' do not support the use of a ");
+  printf("k-items machine, and\nonly variant 'c' supports item reordering ");
   printf("w.r.t. conditional support,\nbut closed/maximal item sets ");
   printf("can only be mined without reordering.\nThese restrictions ");
   printf("may be removed in future versions of this program.\n");
@@ -2080,6 +2490,7 @@ int main (int argc, char *argv[])
   int     scan     = 0;         /* flag for scanable item output */
   int     bdrcnt   = 0;         /* number of support values in border */
   int     stats    = 0;         /* flag for item set statistics */
+  int     binary   = 0;         /* flag for binary output format */
   PATSPEC *psp;                 /* collected pattern spectrum */
   ITEM    m;                    /* number of items */
   TID     n;                    /* number of transactions */
@@ -2146,6 +2557,9 @@ int main (int argc, char *argv[])
     printf("-u       do not use head union tail (hut) pruning "
                     "(default: use hut)\n");
     printf("         (only for maximal item sets, option -tm)\n");
+    printf("-j       do not prefetch parents of listed nodes  "
+                    "(default: prefetch)\n");
+    printf("         (only for algorithm variant s, option -As)\n");
     printf("-F#:#..  support border for filtering item sets   "
                     "(default: none)\n");
     printf("         (list of minimum support values, "
@@ -2156,6 +2570,8 @@ int main (int argc, char *argv[])
     printf("-P#      write a pattern spectrum to a file\n");
     printf("-Z       print item set statistics "
                     "(number of item sets per size)\n");
+    printf("-B       write item sets in binary format "
+                    "(compressed)\n");
     printf("-g       write item names in scanable form "
                     "(quote certain characters)\n");
     printf("-h#      record header  for output                "
@@ -2212,10 +2628,12 @@ int main (int argc, char *argv[])
           case 'l': pack   = (int) strtol(s, &s, 0); break;
           case 'i': mode  &= ~FPG_REORDER;           break;
           case 'u': mode  &= ~FPG_TAIL;              break;
+          case 'j': mode  &= ~FPG_PREFETCH;          break;
           case 'F': bdrcnt = getbdr(s, &s, &border); break;
           case 'R': optarg = &fn_sel;                break;
           case 'P': optarg = &fn_psp;                break;
           case 'Z': stats  = 1;                      break;
+          case 'B': binary = 1;                      break;
           case 'g': scan   = 1;                      break;
           case 'h': optarg = &hdr;                   break;
           case 'k': optarg = &sep;                   break;
@@ -2296,12 +2714,15 @@ int main (int argc, char *argv[])
     case 'c': algo = FPG_COMPLEX;            break;
     case 'd': algo = FPG_SINGLE;             break;
     case 't': algo = FPG_TOPDOWN;            break;
+    case 'a': algo = FPG_CFP;                break;
     default : error(E_VARIANT, (char)algo);  break;
   }                             /* (get fpgrowth algorithm code) */
   if (pack > 0)                 /* add packed items to search mode */
     mode |= (pack < 16) ? pack : 16;
   if (target & ISR_RULES) fn_psp = NULL;
   else conf = 100;              /* no pattern spectrum for rules */
+  if ((target & ISR_RULES) && binary)
+    error(E_TARGET, 'r');       /* binary format only for item sets */
   if (info == dflt) {           /* if default info. format is used, */
     if (target != ISR_RULES)    /* set default according to target */
          info = (supp < 0) ? " (%a)"     : " (%S)";
@@ -2371,7 +2792,8 @@ int main (int argc, char *argv[])
     error(E_NOMEM);             /* set a pattern spectrum if req. */
   if (isr_setfmt(report, scan, hdr, sep, imp, info) != 0)
     error(E_NOMEM);             /* set the output format strings */
-  k = isr_open(report, NULL, fn_out);
+  k = (binary) ? isr_openbin(report, NULL, fn_out)
+               : isr_open   (report, NULL, fn_out);
   if (k) error(k, isr_name(report)); /* open the item set file */
   if ((fpg_repo(report, target, eval, thresh, algo, mode) < 0)
   ||  (isr_setup(report) < 0))  /* prepare reporter for FP-growth */
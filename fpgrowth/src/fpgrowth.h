@@ -8,6 +8,8 @@
             2014.08.19 adapted to modified item set reporter interface
             2014.08.21 parameter 'body' added to function fpgrowth()
             2014.08.28 functions fpg_data() and fpg_repo() added
+            2026.10.18 cache-friendly array-based tree variant added
+            2026.10.18 mode flag FPG_PREFETCH added (batched traversal)
 ----------------------------------------------------------------------*/
 #ifndef __FPGROWTH__
 #define __FPGROWTH__
@@ -39,13 +41,15 @@
 #define FPG_COMPLEX 1           /* complex nodes (children/sibling) */
 #define FPG_SINGLE  2           /* top-down processing on single tree */
 #define FPG_TOPDOWN 3           /* top-down processing of the tree */
+#define FPG_CFP     4           /* cache-friendly array-based trees */
 
 /* --- operation modes --- */
 #define FPG_FIM16   0x001f      /* use 16 items machine (bit rep.) */
 #define FPG_PERFECT 0x0020      /* perfect extension pruning */
 #define FPG_REORDER 0x0040      /* reorder items in cond. databases */
 #define FPG_TAIL    0x0080      /* head union tail pruning */
-#define FPG_DEFAULT (FPG_PERFECT|FPG_REORDER|FPG_TAIL)
+#define FPG_PREFETCH 0x0100     /* prefetch in node list traversal */
+#define FPG_DEFAULT (FPG_PERFECT|FPG_REORDER|FPG_TAIL|FPG_PREFETCH)
 #ifdef NDEBUG
 #define FPG_NOCLEAN 0x8000      /* do not clean up memory */
 #else                           /* in function fpgrowth() */
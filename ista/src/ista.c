@@ -31,6 +31,11 @@
             2014.08.24 adapted to modified item set reporter interface
             2014.08.28 functions ista_data() and ista_repo() added
             2014.10.24 changed from LGPL license to MIT license
+            2026.10.18 option -B added (binary item set output)
+            2026.10.18 progress/cancellation polling per transaction
+            2026.10.18 parallel intersection of transaction shards
+            2026.10.18 worker threads started with tpl_exec()
+            2026.10.18 tree merge limited by cost of intersections
 ------------------------------------------------------------------------
   Reference for the IsTa algorithm:
     C. Borgelt, X. Yang, R. Nogales-Cadenas,
@@ -72,6 +77,9 @@
 #ifdef ISTA_MAIN
 #include "error.h"
 #endif
+#ifdef ISTA_THREADS
+#include "thdpool.h"
+#endif
 #ifdef STORAGE
 #include "storage.h"
 #endif
@@ -108,6 +116,13 @@
 
 #define SEC_SINCE(t)  ((double)(clock()-(t)) /(double)CLOCKS_PER_SEC)
 
+#ifdef ISTA_THREADS
+#ifndef ISTA_PARMIN             /* minimum number of transactions */
+#define ISTA_PARMIN 256         /* in the shard of a worker */
+#endif
+#define ISTA_POLL   16          /* transactions between stop checks */
+#endif
+
 /*----------------------------------------------------------------------
   Type Definitions
 ----------------------------------------------------------------------*/
@@ -118,6 +133,18 @@ typedef struct {                /* --- ista execution data --- */
   SUPP    *frqs;                /* (remaining) item frequencies */
 } ISTA;                         /* (ista execution data) */
 
+#ifdef ISTA_THREADS
+typedef struct worker {         /* --- worker thread data --- */
+  ISTA          a;              /* ista execution data of the thread */
+  TABAG         *tabag;         /* transaction bag to process */
+  TID           beg, end;       /* range of transactions (shard) */
+  SUPP          smin;           /* minimum support of an item set */
+  ISREPORT      *report;        /* item set reporter (progress) */
+  struct worker *src;           /* worker with the tree to merge */
+  volatile int  *stop;          /* flag for stopping all workers */
+} WORKER;                       /* (worker thread data) */
+#endif
+
 /*----------------------------------------------------------------------
   Constants
 ----------------------------------------------------------------------*/
@@ -231,15 +258,240 @@ static int cleanup (ISTA *data)
 
 /*--------------------------------------------------------------------*/
 
+static int trans (ISTA *a, TABAG *tabag, TID b, TID n, SUPP smin,
+                  ISREPORT *report)
+{                               /* --- intersect transactions */
+  int        r;                 /* result of function call */
+  int        mode = a->mode;    /* processing mode (for XMSG) */
+  ITEM       k, z;              /* prunable items, transaction size */
+  SUPP       w;                 /* transaction weight */
+  TRACT      *tract;            /* to traverse the transactions */
+  const ITEM *items;            /* to access the transaction items */
+
+  assert(a && tabag && (b >= 0) && (n >= b) && report);
+  for (k = 0; --n >= b; ) {     /* traverse the transactions */
+    tract = tbg_tract(tabag, n);
+    items = ta_items(tract); z = ta_size(tract); w = ta_wgt(tract);
+    r = (a->pat) ? pat_isect(a->pat, items, z, w, smin, a->frqs)
+                 : pxt_isect(a->pxt, items, z, w, smin, a->frqs);
+    if (r < 0) return -1;       /* intersect transaction and tree */
+    report->nodes++;            /* count the transaction as a node */
+    if (isr_poll(report) < 0)   /* call the progress function */
+      return -1;                /* and check for a cancellation */
+    while (*items >= 0)         /* count newly prunable items */
+      if ((a->frqs[*items++] -= w) < smin) k++;
+    if ((mode & ISTA_PRUNE)     /* if to prune prefix/patricia tree */
+    &&  (smin >= 4) && (k > 0) && ((n & 0x0f) == 0x0f)) {
+      r = (a->pat) ? pat_prunex(a->pat, smin, a->frqs)
+                   : pxt_prunex(a->pxt, smin, a->frqs);
+      if (r < 0) return -1;     /* if item sets could be pruned, */
+      k = 0;                    /* prune the prefix/patricia tree and */
+    }                           /* clear the prunable item counter */
+    if (((n & 0xff) == 0)       /* print number of rem. transactions */
+    ||  ((n < 0xff) && ((n & 0x0f) == 0)) || (n <= 0x0f))
+      XMSG(stderr, "%12"TID_FMT"\b\b\b\b\b\b\b\b\b\b\b\b", n);
+  }
+  return 0;                     /* return 'ok' */
+}  /* trans() */
+
+/* The progress function is called for every transaction and not   */
+/* only every ival search nodes (as with isr_tick()), because IsTa  */
+/* is meant for data with few transactions (possibly fewer than     */
+/* ival), each of which is much more costly to intersect than the   */
+/* progress call.                                                   */
+
+/*----------------------------------------------------------------------
+  Parallel Intersection
+----------------------------------------------------------------------*/
+#ifdef ISTA_THREADS
+
+static int wpoll (ISREPORT *rep, void *data)
+{                               /* --- check for a stop of the workers */
+  return (*(volatile int*)data) ? -1 : 0;
+}  /* wpoll() */
+
+/*--------------------------------------------------------------------*/
+
+static void swap (ISTA *a, ISTA *b)
+{                               /* --- exchange trees of two workers */
+  ISTA t = *a;                  /* buffer for the exchange */
+  a->pxt  = b->pxt;  b->pxt  = t.pxt;
+  a->pat  = b->pat;  b->pat  = t.pat;
+  a->frqs = b->frqs; b->frqs = t.frqs;
+}  /* swap() */                 /* (processing mode is kept) */
+
+/*--------------------------------------------------------------------*/
+
+static int worker (void *p)
+{                               /* --- worker function for a thread */
+  WORKER *w = (WORKER*)p;       /* type the argument pointer */
+  ISTA       *s;                /* execution data of merged worker */
+  ITEM       i;                 /* loop variable */
+  double     c, o;              /* costs of intersecting transactions */
+  size_t     lim;               /* maximum cost of merging the trees */
+  const SUPP *ifs;              /* item frequencies in all trans. */
+  int        r;                 /* error status */
+
+  assert(p);                    /* check the function argument */
+  if (*w->stop) r = -1;         /* check for a failed worker */
+  else if (!w->src)             /* if to process a shard of trans. */
+    r = trans(&w->a, w->tabag, w->beg, w->end, w->smin, w->report);
+  else {                        /* if to merge two trees */
+    s = &w->src->a;             /* get the tree to merge */
+    c = (double)(w->src->end -w->src->beg) *(((w->a.pat)
+      ? pat_tcost(w->a.pat) : pxt_tcost(w->a.pxt)) +1);
+    o = (double)(w->end -w->beg) *(((s->pat)
+      ? pat_tcost(s->pat)   : pxt_tcost(s->pxt))   +1);
+    if (o < c) c = o;           /* get the cost of intersecting the */
+    lim = (c < (double)(((size_t)-1)/2)) ? (size_t)c : ((size_t)-1)/2;
+    ifs = tbg_ifrqs(w->tabag, 0);  /* transactions of one tree with */
+    for (i = tbg_itemcnt(w->tabag); --i >= 0; ) /* the other tree */
+      s->frqs[i] += w->a.frqs[i] -ifs[i];
+    r = (w->a.pat) ? pat_merge(w->a.pat, s->pat, w->smin, s->frqs, lim)
+                   : pxt_merge(w->a.pxt, s->pxt, w->smin, s->frqs, lim);
+    if      (r == 0)            /* if the trees have been merged, */
+      memcpy(w->a.frqs, s->frqs, /* note the remaining item freqs. */
+             (size_t)tbg_itemcnt(w->tabag) *sizeof(SUPP));
+    else if ((r > 0) && (o <= c)) {   /* if the merge is too costly */
+      for (i = tbg_itemcnt(w->tabag); --i >= 0; )    /* and it is */
+        s->frqs[i] -= w->a.frqs[i] -ifs[i];  /* cheaper to continue */
+      swap(&w->a, s);           /* with the other tree, restore its */
+    }                           /* item frequencies and take it over */
+    if (s->pat) { pat_delete(s->pat);    s->pat = NULL; }
+    if (s->pxt) { pxt_delete(s->pxt, 1); s->pxt = NULL; }
+    if (r > 0)                  /* intersect the transactions of */
+      r = (o <= c)              /* the deleted tree with the kept one */
+        ? trans(&w->a, w->tabag, w->beg, w->end, w->smin, w->report)
+        : trans(&w->a, w->tabag, w->src->beg, w->src->end,
+                w->smin, w->report);
+  }                             /* (instead of merging the trees) */
+  if (r < 0) *w->stop = -1;     /* on failure stop all workers */
+  return r;                     /* return the error status */
+}  /* worker() */
+
+/* Since the transactions are processed backwards (see trans()), the */
+/* transactions of the first tree (lower indices) are intersected    */
+/* with the second tree (higher indices) in the same order as in the */
+/* sequential version, in which the second tree (the later part of   */
+/* the transactions) is usually much smaller when these transactions */
+/* are processed. Hence the merge is limited to the cost of the      */
+/* cheaper of the two alternatives, which are measured as the number */
+/* of nodes each tree visited on average for its last transactions.  */
+
+/*--------------------------------------------------------------------*/
+
+static int run (WORKER *work, int cnt, int step)
+{                               /* --- run workers and wait for them */
+  assert(work && (cnt > 0) && (step > 0));
+  return tpl_exec(work, (size_t)step *sizeof(WORKER),
+                  (cnt +step -1) /step, worker);
+}  /* run() */
+
+/* The workers with indices that are multiples of step are executed, */
+/* the first directly in the calling thread, all others in threads   */
+/* of their own (see tpl_exec()).                                    */
+
+/*--------------------------------------------------------------------*/
+
+static int parallel (ISTA *a, TABAG *tabag, SUPP smin,
+                     ISREPORT *report, int cpus)
+{                               /* --- intersect with worker threads */
+  int          i, k, e = 0;     /* loop variables, error status */
+  TID          n;               /* number of transactions */
+  ITEM         m;               /* number of items */
+  WORKER       *work, *w;       /* to traverse the workers */
+  volatile int stop = 0;        /* flag for stopping all workers */
+
+  assert(a && tabag && report && (cpus > 1));
+  n = tbg_cnt(tabag);           /* get the number of transactions */
+  if (cpus > n /ISTA_PARMIN)    /* limit the number of threads */
+    cpus = (int)(n /ISTA_PARMIN);     /* by the shard size */
+  if (cpus <= 1) return trans(a, tabag, 0, n, smin, report);
+  work = (WORKER*)calloc((size_t)cpus, sizeof(WORKER));
+  if (!work) return -1;         /* create the worker data */
+  m = tbg_itemcnt(tabag);       /* get the number of items */
+  for (i = 0; i < cpus; i++) {  /* traverse the workers */
+    w = work +i;                /* and initialize them */
+    w->a      = *a;             /* the first worker uses */
+    w->tabag  = tabag;          /* the tree of the caller */
+    w->beg    = (TID)(((double)n *(double) i)    /(double)cpus);
+    w->end    = (TID)(((double)n *(double)(i+1)) /(double)cpus);
+    w->smin   = smin;           /* get the range of transactions */
+    w->report = report;         /* (split trans. into shards) */
+    w->stop   = &stop;          /* and the flag for stopping */
+    if (i <= 0) continue;       /* the first worker is complete */
+    w->a.mode = a->mode & ~(ISTA_VERBOSE|ISTA_NOCLEAN);
+    w->a.pxt  = NULL; w->a.pat = NULL;
+    w->a.frqs = (SUPP*)malloc((size_t)m *sizeof(SUPP));
+    if (a->pat) w->a.pat = pat_create(m, pat_dir(a->pat));
+    else        w->a.pxt = pxt_create(m, pxt_dir(a->pxt), NULL);
+    w->report = isr_clone(report);
+    if (!w->a.frqs || (!w->a.pat && !w->a.pxt) || !w->report) {
+      e = -1; break; }          /* create a tree, frequencies */
+    memcpy(w->a.frqs, a->frqs, (size_t)m *sizeof(SUPP));
+    isr_setprog(w->report, wpoll, (void*)&stop, ISTA_POLL);
+  }                             /* let the workers check for a stop */
+  work->a.mode &= ~ISTA_VERBOSE;/* (first worker uses the caller's) */
+  if (e >= 0)                   /* intersect the transaction shards */
+    e = run(work, cpus, 1);     /* (one shard per worker) */
+  for (k = 1; (e >= 0) && (k < cpus); k += k) {
+    for (i = 0; i+k < cpus; i += k+k)     /* traverse pairs of */
+      work[i].src = work +i+k;  /* trees and note the tree to merge */
+    e = run(work, cpus-k, k+k); /* merge the pairs of trees */
+    for (i = 0; i+k < cpus; i += k+k)     /* note the merged */
+      work[i].end = work[i+k].end;        /* transaction ranges */
+  }
+  a->pxt  = work->a.pxt;        /* the first worker may have taken */
+  a->pat  = work->a.pat;        /* over the tree of another worker */
+  a->frqs = work->a.frqs;       /* (see worker()), so get its data */
+  for (i = 1; i < cpus; i++) {  /* traverse the workers (but first) */
+    w = work +i;                /* (the first uses caller's data) */
+    if (w->report && (w->report != report)) {
+      if (isr_merge(report, w->report) < 0) e = -1;
+      isr_delete(w->report, 0); /* merge the search node counters */
+    }                           /* and delete the reporter shards */
+    cleanup(&w->a);             /* delete the trees and frequencies */
+  }
+  free(work);                   /* delete the worker data */
+  return e;                     /* return the error status */
+}  /* parallel() */
+
+/*----------------------------------------------------------------------
+The transactions are split into as many shards as there are threads
+(each with at least ISTA_PARMIN transactions), each of which is
+intersected in the same way as in the sequential version, but with a
+prefix or patricia tree of its own. Since the item frequencies of the
+shards of other threads are never subtracted, the pruning is weaker
+(only item sets that cannot become frequent w.r.t. all transactions
+are pruned). Afterwards the trees are merged in pairs (with threads),
+where each merge intersects the closed item sets of two trees (see
+pxt_merge() and pat_merge()) and removes items that cannot become
+frequent with their frequencies in the transactions of the trees not
+yet merged, until only the tree of the first worker is left (which
+is then returned to the caller). If a merge is costlier (in terms of
+visited nodes) than intersecting the transactions of one tree with the
+other tree, it is aborted and the transactions are intersected instead
+(see worker()), so that the merges do not add more than a small factor
+to the cost of the sequential version. However, the shards are pruned
+less effectively and the transactions of the first shard are usually
+costlier to process in a thread of their own, because the sequential
+version processes them last, with the other item frequencies already
+subtracted. Hence multiple threads only pay off for data with many
+transactions and comparatively few closed item sets.
+The frequent closed item sets in the final tree (and thus the reported
+item sets) are the same as with a sequential intersection of all
+transactions, regardless of the order of the transactions.
+----------------------------------------------------------------------*/
+
+#endif  /* #ifdef ISTA_THREADS */
+/*--------------------------------------------------------------------*/
+
 int ista (TABAG *tabag, int target, SUPP smin, int eval, double thresh,
           int algo, int mode, ISREPORT *report)
 {                               /* --- intersecting transactions */
   int      r;                   /* result of function call, buffer */
-  ITEM     m, k, z;             /* number of items, buffers */
+  ITEM     m, k;                /* number of items, buffer */
   TID      n;                   /* number of transactions */
-  SUPP     w;                   /* total transaction weight */
-  TRACT    *tract;              /* to traverse the transactions */
-  const ITEM *items;            /* to access the transaction items */
   const SUPP *ifs;              /* to access the item frequencies */
   size_t   zc, zm;              /* number of tree nodes */
   clock_t  t;                   /* timer for measurements */
@@ -265,25 +517,13 @@ int ista (TABAG *tabag, int target, SUPP smin, int eval, double thresh,
     if (!a.pxt) return cleanup(&a);
   }                             /* create a prefix tree */
   n = tbg_cnt(tabag);           /* get the number of transactions */
-  for (k = 0; --n >= 0; ) {     /* traverse the transactions */
-    tract = tbg_tract(tabag, n);
-    items = ta_items(tract); z = ta_size(tract); w = ta_wgt(tract);
-    r = (a.pat) ? pat_isect(a.pat, items, z, w, smin, a.frqs)
-                : pxt_isect(a.pxt, items, z, w, smin, a.frqs);
-    if (r < 0) return cleanup(&a); /* intersect transaction and tree */
-    while (*items >= 0)         /* count newly prunable items */
-      if ((a.frqs[*items++] -= w) < smin) k++;
-    if ((mode & ISTA_PRUNE)     /* if to prune prefix/patricia tree */
-    &&  (smin >= 4) && (k > 0) && ((n & 0x0f) == 0x0f)) {
-      r = (a.pat) ? pat_prunex(a.pat, smin, a.frqs)
-                  : pxt_prunex(a.pxt, smin, a.frqs);
-      if (r < 0) return cleanup(&a); /* if item sets could be pruned, */
-      k = 0;                    /* prune the prefix/patricia tree and */
-    }                           /* clear the prunable item counter */
-    if (((n & 0xff) == 0)       /* print number of rem. transactions */
-    ||  ((n < 0xff) && ((n & 0x0f) == 0)) || (n <= 0x0f))
-      XMSG(stderr, "%12"TID_FMT"\b\b\b\b\b\b\b\b\b\b\b\b", n);
-  }
+  #ifdef ISTA_THREADS           /* if multi-threading is available */
+  if ((mode & ISTA_CPUS) > ISTA_CPU1)  /* and several threads are */
+    r = parallel(&a, tabag, smin, report, (mode & ISTA_CPUS) >> 8);
+  else                          /* requested, process shards of the */
+  #endif                        /* transactions with worker threads */
+  r = trans(&a, tabag, 0, n, smin, report);
+  if (r < 0) return cleanup(&a);/* intersect the transactions */
   free(a.frqs); a.frqs = NULL;  /* delete the item frequency array */
   if (a.pat) { zc = pat_nodecnt(a.pat); zm = pat_nodemax(a.pat); }
   else       { zc = pxt_nodecnt(a.pxt); zm = pxt_nodemax(a.pxt); }
@@ -430,6 +670,7 @@ int main (int argc, char *argv[])
   int     scan     = 0;         /* flag for scanable item output */
   int     bdrcnt   = 0;         /* number of support values in border */
   int     stats    = 0;         /* flag for item set statistics */
+  int     binary   = 0;         /* flag for binary output format */
   PATSPEC *psp;                 /* collected pattern spectrum */
   ITEM    m;                    /* number of items */
   TID     n;                    /* number of transactions */
@@ -486,6 +727,8 @@ int main (int argc, char *argv[])
     printf("-P#      write a pattern spectrum to a file\n");
     printf("-Z       print item set statistics "
                     "(number of item sets per size)\n");
+    printf("-B       write item sets in binary format "
+                    "(compressed)\n");
     printf("-g       write output in scanable form "
                     "(quote certain characters)\n");
     printf("-h#      record header  for output                "
@@ -536,6 +779,7 @@ int main (int argc, char *argv[])
           case 'R': optarg = &fn_sel;                break;
           case 'P': optarg = &fn_psp;                break;
           case 'Z': stats  = 1;                      break;
+          case 'B': binary = 1;                      break;
           case 'g': scan   = 1;                      break;
           case 'h': optarg = &hdr;                   break;
           case 'k': optarg = &sep;                   break;
@@ -633,7 +877,8 @@ int main (int argc, char *argv[])
     error(E_NOMEM);             /* set a pattern spectrum if req. */
   if (isr_setfmt(report, scan, hdr, sep, NULL, info) != 0)
     error(E_NOMEM);             /* set the output format strings */
-  k = isr_open(report, NULL, fn_out);
+  k = (binary) ? isr_openbin(report, NULL, fn_out)
+               : isr_open   (report, NULL, fn_out);
   if (k) error(k, isr_name(report)); /* open the item set file */
   if ((ista_repo(report, target, eval, thresh, algo, mode) < 0)
   ||  (isr_setup(report) < 0))  /* prepare reporter for IsTa and */
@@ -4,6 +4,7 @@
   Author  : Christian Borgelt
   History : 2014.08.24 file created
             2014.08.28 functions ista_data() and ista_repo() added
+            2026.10.18 mode field ISTA_CPUS added (number of threads)
 ----------------------------------------------------------------------*/
 #ifndef __ISTA__
 #define __ISTA__
@@ -24,6 +25,8 @@
 #define ISTA_PRUNE    0x0010    /* prune the prefix/patricia tree */
 #define ISTA_FILTER   0x0020    /* filter maximal sets with repo. */
 #define ISTA_MAXONLY  0x0040    /* add only maximal sets to repo. */
+#define ISTA_CPUS     0x3f00    /* number of threads (times ISTA_CPU1) */
+#define ISTA_CPU1     0x0100    /* one thread (unit of ISTA_CPUS) */
 #define ISTA_DEFAULT  ISTA_PRUNE
 #ifdef NDEBUG
 #define ISTA_NOCLEAN  0x8000    /* do not clean up memory */
@@ -8,6 +8,10 @@
             2012.07.16 pruning improved (full reduction of items)
             2013.04.01 adapted to type changes in module tract
             2013.10.15 checks of return code of isr_report() added
+            2026.10.18 function pat_merge() added (combine two trees)
+            2026.10.18 bug in prunex() fixed (sorting of keep list)
+            2026.10.18 nodes allocated in a memory arena (compaction)
+            2026.10.18 merge aborted if costlier than intersections
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -26,7 +30,144 @@
 #define pos(x,y)  ((x) < (y))   /* macros for item comparison */
 #define neg(x,y)  ((x) > (y))   /* (ascending and descending) */
 
+#define TCWGT     16            /* weight for average trans. cost */
+#define BINCNT    64            /* number of bins for node supports */
+#define BIN(s,m)  (((s) <= 0) ? 0 : ((s) >= (m)) ? BINCNT-1 \
+                  : (int)((double)(s)/(double)(m) *(BINCNT-1)))
+
 #define PATNODESIZE(n)  (sizeof(PATNODE) +(size_t)((n)-1)*sizeof(int))
+#define BLKSIZE   65536         /* size of the arena memory blocks */
+
+/*----------------------------------------------------------------------
+  Node Memory Management Functions
+----------------------------------------------------------------------*/
+
+static PATNODE* nalloc (PATTREE *pat, ITEM n)
+{                               /* --- allocate a node in the arena */
+  PATNODE *node;                /* allocated node */
+
+  assert(pat && (n > 0));       /* check the function arguments */
+  node = (PATNODE*)mst_alloc(pat->mem, PATNODESIZE(n));
+  if (!node) return NULL;       /* allocate memory for the node */
+  pat->used += PATNODESIZE(n);  /* sum the memory of the nodes */
+  return pat->top = node;       /* note and return the new node */
+}  /* nalloc() */
+
+/*--------------------------------------------------------------------*/
+
+static void nfree (PATTREE *pat, PATNODE *node)
+{                               /* --- free a node in the arena */
+  size_t z;                     /* size of the node */
+
+  assert(pat && node);          /* check the function arguments */
+  pat->used -= z = PATNODESIZE(node->cnt);
+  if (node != pat->top)         /* the memory of a node can only be */
+    pat->waste += z;            /* reused if it was allocated last, */
+  else {                        /* otherwise it is lost until the */
+    mst_free(pat->mem, node);   /* next compaction of the arena */
+    pat->top = NULL;            /* (see compact()) */
+  }
+}  /* nfree() */
+
+/*--------------------------------------------------------------------*/
+
+static PATNODE* resize (PATTREE *pat, PATNODE *node, ITEM o, ITEM n)
+{                               /* --- resize a node in the arena */
+  PATNODE *p;                   /* resized node */
+
+  assert(pat && node && (o > 0) && (n > 0));
+  if (n <= o) {                 /* if to shrink the node, */
+    pat->used  -= PATNODESIZE(o) -PATNODESIZE(n);
+    pat->waste += PATNODESIZE(o) -PATNODESIZE(n);
+    return node;                /* keep it in place and lose */
+  }                             /* the memory at its end */
+  if (node == pat->top) {       /* if node was allocated last, */
+    mst_free(pat->mem, node);   /* try to enlarge it in place */
+    p = (PATNODE*)mst_alloc(pat->mem, PATNODESIZE(n));
+    if (!p) {                   /* on failure reallocate the node */
+      mst_alloc(pat->mem, PATNODESIZE(o)); return NULL; }
+    if (p != node)              /* if the node could not be enlarged */
+      memcpy(p, node, PATNODESIZE(o)); } /* copy it to a new block */
+  else {                        /* if node was not allocated last */
+    p = (PATNODE*)mst_alloc(pat->mem, PATNODESIZE(n));
+    if (!p) return NULL;        /* allocate a new node and */
+    memcpy(p, node, PATNODESIZE(o));  /* copy the old node */
+    pat->waste += PATNODESIZE(o);     /* (the old node is lost) */
+  }
+  pat->used += PATNODESIZE(n) -PATNODESIZE(o);
+  return pat->top = p;          /* return the resized node */
+}  /* resize() */
+
+/* Like realloc(), resize() keeps the node unchanged on failure.  */
+/* However, the old and the new number of items have to be given, */
+/* because the number of items stored in the node may already     */
+/* have been changed by the caller.                               */
+
+/*--------------------------------------------------------------------*/
+
+static PATNODE* copy (PATNODE *node, MSSTACK *mem)
+{                               /* --- copy nodes into another arena */
+  PATNODE *out, **end = &out;   /* output node list and end pointer */
+  PATNODE *d;                   /* to traverse the copied nodes */
+
+  assert(mem);                  /* check the function arguments */
+  for ( ; node; node = node->sibling) {
+    d = (PATNODE*)mst_alloc(mem, PATNODESIZE(node->cnt));
+    if (!d) break;              /* allocate memory for a copy */
+    memcpy(d, node, PATNODESIZE(node->cnt));
+    *end = d; end = &d->sibling;/* copy the node and append it */
+    d->children = copy(node->children, mem);
+  }                             /* recursively copy the children */
+  *end = NULL;                  /* terminate the output list */
+  return out;                   /* and return the copied nodes */
+}  /* copy() */
+
+/*--------------------------------------------------------------------*/
+
+static void compact (PATTREE *pat)
+{                               /* --- compact the node arena */
+  MSSTACK *mem;                 /* new memory arena */
+  PATNODE *list;                /* copied root children */
+
+  assert(pat);                  /* check the function argument */
+  if ((pat->waste < BLKSIZE) || (pat->waste < pat->used))
+    return;                     /* check for enough lost memory */
+  mem = mst_create(BLKSIZE);    /* create a new memory arena */
+  if (!mem) return;             /* and copy the tree into it */
+  list = copy(pat->root.children, mem);
+  if (mst_error(mem)) { mst_delete(mem); return; }
+  mst_delete(pat->mem);         /* delete the old memory arena */
+  pat->mem   = mem;             /* and replace it by the new one */
+  pat->root.children = list;    /* set the copied root children */
+  pat->top   = NULL;            /* clear the last allocated node */
+  pat->waste = 0;               /* and the amount of lost memory */
+}  /* compact() */
+
+/*----------------------------------------------------------------------
+The nodes of a patricia tree are allocated from a memory arena (a stack
+allocator, see memsys.h), so that creating a node costs only a pointer
+update and the nodes are close together in memory. Since nodes cannot
+be freed individually (unless a node was allocated last), the memory of
+deleted nodes (and of nodes that are enlarged and thus moved) is lost
+until the tree is compacted. This is done after the tree was pruned
+(pat_prune(), pat_prunex()) or merged (pat_merge()), provided more
+memory is lost than is used by the nodes. The compaction copies the
+tree into a new arena in depth-first order, which is the order in which
+the nodes are visited by the intersection (isect()), the pruning and
+the reporting, so that traversing the tree accesses memory (almost)
+sequentially. A failed compaction is not an error: the tree is then
+simply kept in the old arena.
+----------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct {                /* --- cost limit of a merge --- */
+  size_t beg;                   /* visited nodes at start of merge */
+  size_t lim;                   /* maximum number of nodes to visit */
+  size_t cnt;                   /* number of closed sets to process */
+  size_t done;                  /* number of processed closed sets */
+} MLIM;                         /* (cost limit of a merge) */
 
 /*----------------------------------------------------------------------
   Main Functions
@@ -40,11 +181,16 @@ PATTREE* pat_create (ITEM size, int dir)
   pat = (PATTREE*)malloc(sizeof(PATTREE)+(size_t)(size-1)*sizeof(SUPP)
                                         +(size_t) size   *sizeof(ITEM));
   if (!pat) return NULL;        /* create a patricia tree and */
+  pat->mem = mst_create(BLKSIZE);    /* a memory arena for the nodes */
+  if (!pat->mem) { free(pat); return NULL; }
+  pat->top   = NULL;            /* there is no node yet */
+  pat->used  = pat->waste = 0;  /* and no memory is used */
   pat->size  = size;            /* initialize its fields */
   pat->cnt   = pat->max = 0;
   pat->dir   = (dir < 0) ? -1 : +1;
   pat->step  = 0; pat->last = 0;
   pat->min   = pat->supp = 0;
+  pat->visits = 0; pat->tcost = 0;
   pat->items = (ITEM*)(pat->mins +size);
   pat->root.supp     = 0; pat->root.step = 0;
   pat->root.children = pat->root.sibling = NULL;
@@ -55,13 +201,13 @@ PATTREE* pat_create (ITEM size, int dir)
 
 /*--------------------------------------------------------------------*/
 
-static void delete (PATNODE *node)
+static void delete (PATTREE *pat, PATNODE *node)
 {                               /* --- recursively delete nodes */
   PATNODE *tmp;                 /* buffer for deallocation */
 
   while (node) {                /* sibling list deletion loop */
-    delete(node->children);     /* recursively delete the children */
-    tmp = node; node = node->sibling; free(tmp);
+    delete(pat, node->children);/* recursively delete the children */
+    tmp = node; node = node->sibling; nfree(pat, tmp);
   }                             /* finally delete the node itself */
 }  /* delete() */
 
@@ -70,23 +216,23 @@ static void delete (PATNODE *node)
 void pat_delete (PATTREE *pat)
 {                               /* --- delete a patricia tree */
   assert(pat);                  /* check the function argument */
-  delete(pat->root.children);   /* delete the tree nodes */
-  free(pat);                    /* delete the base structure */
+  mst_delete(pat->mem);         /* delete the nodes (memory arena) */
+  free(pat);                    /* and the base structure */
 }  /* pat_delete() */
 
 /*--------------------------------------------------------------------*/
 
-static PATNODE* split (PATNODE *node, ITEM n)
+static PATNODE* split (PATTREE *pat, PATNODE *node, ITEM n)
 {                               /* --- split a node at the n-th item */
   ITEM    k;                    /* number of items in child node */
   PATNODE *child;               /* created child node */
 
-  assert(node                   /* check the function arguments */
+  assert(pat && node            /* check the function arguments */
   &&    (n > 0) && (n < node->cnt));
   k     = node->cnt -n;         /* get number of items in child */
-  child = (PATNODE*)malloc(PATNODESIZE(k));
-  if (!child) return NULL;      /* create a child node and */
-  child->step     = node->step; /* copy and init. the fields */
+  child = nalloc(pat, k);       /* create a child node and */
+  if (!child) return NULL;      /* copy and init. the fields */
+  child->step     = node->step;
   child->supp     = node->supp;
   child->sibling  = NULL;
   child->children = node->children;
@@ -94,15 +240,16 @@ static PATNODE* split (PATNODE *node, ITEM n)
   memcpy(child->items, node->items +n, (size_t)k *sizeof(ITEM));
   node->children  = child;
   node->cnt       = n;          /* shrink the original node */
-  return (PATNODE*)realloc(node, PATNODESIZE(n));
+  return resize(pat, node, n+k, n);
 }  /* split() */
 
 /*--------------------------------------------------------------------*/
 
-static PATNODE* expand (PATNODE *node, const ITEM *items, ITEM n)
+static PATNODE* expand (PATTREE *pat, PATNODE *node,
+                        const ITEM *items, ITEM n)
 {                               /* --- expand a node with add. items */
-  assert(node && items && (n > 0));  /* check the function arguments */
-  node = (PATNODE*)realloc(node, PATNODESIZE(node->cnt +n));
+  assert(pat && node && items && (n > 0));  /* check the arguments */
+  node = resize(pat, node, node->cnt, node->cnt +n);
   if (!node) return NULL;       /* resize the node */
   memcpy(node->items +node->cnt, items, (size_t)n *sizeof(ITEM));
   node->cnt += n;               /* copy the additional items */
@@ -138,20 +285,20 @@ int pat_add (PATTREE *pat, const ITEM *items, ITEM n, SUPP supp)
     if (i < node->cnt) {        /* if not all items were matched */
       if ((n <= 0) && (node->supp >= supp))
         return 0;               /* if items are covered, abort */
-      node = split(node, i);    /* split the current node */
+      node = split(pat, node, i);   /* split the current node */
       if (!node) return -1;     /* at the first unmatched item */
       *p = node;                /* and count the added node */
       if (++pat->cnt > pat->max) pat->max = pat->cnt; }
     else if (!node->children    /* if the node may be extended */
     &&      (n > 0) && (supp >= node->supp)) {
       node->supp = supp;        /* update the node support */
-      node = expand(node, items, n);
+      node = expand(pat, node, items, n);
       if (!node) return -1;     /* expand the tree node */
       *p = node; return  0;     /* with the remaining items */
     }                           /* and update the node pointer */
   }                             /* (may be changed due to realloc) */
-  node = (PATNODE*)malloc(PATNODESIZE(n));
-  if (!node) return -1;         /* create a new patricia tree node */
+  node = nalloc(pat, n);        /* create a new patricia tree node */
+  if (!node) return -1;         /* for the remaining items */
   node->step     = 0;           /* clear the update step and */
   node->supp     = supp;        /* store the support of the item set */
   node->sibling  = *p; *p = node;
@@ -178,8 +325,8 @@ static PATNODE** insert_##dir (PATNODE **ins, const ITEM *items,       \
     while ((node = *ins) && dir(node->items[0], i))                    \
       ins = &node->sibling;     /* find the insertion position */      \
     if (!node || (node->items[0] != i)) { /* if no node exists */      \
-      node = (PATNODE*)malloc(PATNODESIZE(n));                         \
-      if (!node) return NULL;   /* create a new patricia tree node */  \
+      node = nalloc(pat, n);    /* create a new patricia tree node */  \
+      if (!node) return NULL;   /* for the remaining items */          \
       node->step = pat->step;   /* store support of the item set */    \
       node->supp = pat->supp +supp;                                    \
       node->sibling  = *ins; *ins = node;                              \
@@ -193,7 +340,7 @@ static PATNODE** insert_##dir (PATNODE **ins, const ITEM *items,       \
       if (node->items[i] != *items)                                    \
         break;                  /* compare other items in the node */  \
     if (i < node->cnt) {        /* if not all items were matched, */   \
-      node = split(node, i);    /* split the current node */           \
+      node = split(pat, node, i);   /* split the current node */       \
       if (!node) return NULL;   /* at the first unmatched item */      \
       *ins = node;              /* store the split node (top part) */  \
       pat->cnt++;               /* (may be changed due to realloc) */  \
@@ -206,7 +353,7 @@ static PATNODE** insert_##dir (PATNODE **ins, const ITEM *items,       \
       return &node->children;   /* return new insertion position */    \
     if (!node->children         /* if the node may be extended */      \
     && (pat->supp +supp >= node->supp)) {                              \
-      node = expand(node, items, n);     /* expand the node */         \
+      node = expand(pat, node, items, n); /* expand the node */        \
       if (!node)   return NULL; /* with the remaining items */         \
       *ins = node; return &node->children;                             \
     }                           /* return new insertion position */    \
@@ -233,6 +380,7 @@ static int isect_##dir (PATNODE *node, PATNODE **ins, PATTREE *pat)    \
                                                                        \
   assert(node && ins && pat);   /* check the function arguments */     \
   for ( ; node; node = node->sibling) {                                \
+    pat->visits++;              /* count the visited node */           \
     if (node->step >= pat->step) { /* if the node has been visited */  \
       if (!dir(node->items[0], pat->last))                             \
         break;                  /* if last item processed, abort */    \
@@ -243,6 +391,7 @@ static int isect_##dir (PATNODE *node, PATNODE **ins, PATTREE *pat)    \
       i = node->items[0];       /* get the first item in the node */   \
       while ((p = *ins) && dir(p->items[0], i))                        \
         ins = &p->sibling;      /* advance the insertion position */   \
+      pat->visits += (size_t)node->cnt;   /* count the items */        \
       for (k = n = 0; k < node->cnt; k++)                              \
         if (pat->mins[i = node->items[k]])                             \
           pat->items[n++] = i;  /* collect the intersection items */   \
@@ -284,9 +433,10 @@ ISECT(neg)                      /* function for descending item order */
 int pat_isect (PATTREE *pat, const ITEM *items, ITEM n, SUPP supp,
                SUPP min, const SUPP *frqs)
 {                               /* --- intersect with an item set */
-  int  r;                       /* result of isect_dir() */
-  ITEM i;                       /* to traverse the items */
-  SUPP s;                       /* to compute limiting support */
+  int    r;                     /* result of isect_dir() */
+  ITEM   i;                     /* to traverse the items */
+  SUPP   s;                     /* to compute limiting support */
+  size_t v;                     /* number of visited nodes */
 
   assert(pat && (items || (n <= 0)));  /* check function arguments */
   pat->root.supp += supp;       /* update the empty set support */
@@ -309,9 +459,11 @@ int pat_isect (PATTREE *pat, const ITEM *items, ITEM n, SUPP supp,
   /* subtrees rooted at nodes with the item, which could still become */
   /* frequent, may not be processed, and then results may be lost.    */
   pat->step++;                  /* increment the update step */
+  v = pat->visits;              /* note the visited nodes */
   r = (pat->dir < 0)            /* intersect transaction with tree */
     ? isect_neg(pat->root.children, &pat->root.children, pat)
     : isect_pos(pat->root.children, &pat->root.children, pat);
+  pat->tcost += ((double)(pat->visits -v) -pat->tcost) /TCWGT;
   if (pat->cnt > pat->max) pat->max = pat->cnt;
   return r;                     /* return the error status */
 }  /* pat_isect() */
@@ -405,7 +557,7 @@ static PATNODE* merge_##dir (PATNODE *s1, PATNODE *s2, PATTREE *pat)   \
       for (i = 1; i < k; i++)   /* count the equal items */            \
         if (s1->items[i] != s2->items[i]) break;                       \
       if (i < s1->cnt) {        /* if not all items were matched, */   \
-        node = split(s1, i);    /* split node from first list */       \
+        node = split(pat, s1, i);   /* split node from first list */   \
         if (!node) {            /* if the node split failed */         \
           pat->err = -1; *end = s1; end = &s1->sibling;                \
           if (!(s1 = *end)) break; else continue;                      \
@@ -417,12 +569,12 @@ static PATNODE* merge_##dir (PATNODE *s1, PATNODE *s2, PATTREE *pat)   \
       if (i < s2->cnt) {        /* if not all items were matched, */   \
         s2->cnt -= i;           /* move the remaining items */         \
         memmove(s2->items, s2->items+i, (size_t)s2->cnt*sizeof(ITEM)); \
-        node = (PATNODE*)realloc(s2, PATNODESIZE(s2->cnt));            \
+        node = resize(pat, s2, s2->cnt+i, s2->cnt);                    \
         s2   = node->sibling; node->sibling = NULL;                    \
         s1->children = merge_##dir(s1->children, node, pat); }         \
       else {                    /* if all items were matched */        \
         s1->children = merge_##dir(s1->children, s2->children, pat);   \
-        node = s2; s2 = s2->sibling; free(node); pat->cnt--;           \
+        node = s2; s2 = s2->sibling; nfree(pat, node); pat->cnt--;     \
       }                         /* merge and delete second node */     \
       *end = s1; end = &s1->sibling; s1 = *end;                        \
       if (!s1 || !s2) break;    /* if an item occurs in both lists, */ \
@@ -477,24 +629,26 @@ static void prunex_##dir (PATNODE *node, PATTREE *pat)                 \
   while (n) {                   /* traverse the sibling list */        \
     if (n->children)            /* recursively prune the children */   \
       prunex_##dir(n, pat);     /* before pruning the node itself */   \
-    s |= (n->supp >= pat->mins[n->items[0]]);                          \
+    s |= (n->supp < pat->mins[n->items[0]]);                           \
+    /* If the first item of a node is removed, the keep list may */    \
+    /* no longer be sorted and then has to be sorted (and merged). */  \
     for (i = k = 0; i < n->cnt; i++)                                   \
       if (n->supp >= pat->mins[n->items[i]])                           \
         n->items[k++] = n->items[i];                                   \
     if (k > 0) {                /* collect items that may be freq. */  \
       while ((t = n->children)  /* while merger with child possible */ \
       &&     !t->sibling && (n->supp <= t->supp)) {                    \
-        x = (PATNODE*)realloc(n, PATNODESIZE(k +t->cnt));              \
+        x = resize(pat, n, n->cnt, k +t->cnt);                         \
         if (!x) break;          /* try to enlarge the node */          \
         n = x;                  /* on success get the new node */      \
         memcpy(n->items +k, t->items, (size_t)t->cnt *sizeof(ITEM));   \
         n->cnt = k += t->cnt;   /* append the child node items */      \
         n->children = t->children;                                     \
-        free(t); pat->cnt--;    /* unlink and delete the child node */ \
+        nfree(pat, t); pat->cnt--;  /* unlink and delete the child */  \
       }                         /* and decrement the node counter */   \
       if (k < n->cnt) {         /* if the node is too large, */        \
+        n = resize(pat, n, n->cnt, k);                                 \
         n->cnt = k;             /* set the new number of items */      \
-        n = (PATNODE*)realloc(n, PATNODESIZE(k));                      \
       }                         /* try to shrink the node */           \
       *p = n; p = &n->sibling;  /* move the current node */            \
       n = *p; }                 /* to the output node list */          \
@@ -502,7 +656,7 @@ static void prunex_##dir (PATNODE *node, PATTREE *pat)                 \
       node->children =          /* (and cannot become frequent) */     \
         merge_##dir(node->children, n->children, pat);                 \
       t = n; n = n->sibling;    /* merge the child nodes */            \
-      free(t); pat->cnt--;      /* with the pruned subtrees */         \
+      nfree(pat, t); pat->cnt--;/* with the pruned subtrees */         \
     }                           /* and delete the processed node */    \
   }                                                                    \
   *p = NULL;                    /* finally terminate the keep list, */ \
@@ -536,17 +690,17 @@ static void prunex_##dir (PATNODE *node, PATTREE *pat)                 \
     if (k > 0) {                /* collect items that may be freq. */  \
       while ((t = n->children)  /* while merger with child possible */ \
       &&     !t->sibling && (n->supp <= t->supp)) {                    \
-        x = (PATNODE*)realloc(n, PATNODESIZE(k +t->cnt));              \
+        x = resize(pat, n, n->cnt, k +t->cnt);                         \
         if (!x) break;          /* try to enlarge the node */          \
         n = x;                  /* on success get the new node */      \
         memcpy(n->items +k, t->items, (size_t)t->cnt *sizeof(ITEM));   \
         n->cnt = k += t->cnt;   /* append the child node items */      \
         n->children = t->children;                                     \
-        free(t); pat->cnt--;    /* unlink and delete the child node */ \
+        nfree(pat, t); pat->cnt--;  /* unlink and delete the child */  \
       }                         /* and decrement the node counter */   \
       if (k < n->cnt) {         /* if the node is too large, */        \
+        n = resize(pat, n, n->cnt, k);                                 \
         n->cnt = k;             /* set the new number of items */      \
-        n = (PATNODE*)realloc(n, PATNODESIZE(k));                      \
       }                         /* try to shrink the node */           \
       *p = n; p = &n->sibling;  /* move the current node */            \
       n = *p; }                 /* to the output node list */          \
@@ -554,7 +708,7 @@ static void prunex_##dir (PATNODE *node, PATTREE *pat)                 \
       node->children =          /* (and cannot become frequent) */     \
         merge_##dir(node->children, n->children, pat);                 \
       t = n; n = n->sibling;    /* merge the child nodes */            \
-      free(t); pat->cnt--;      /* with the pruned subtrees */         \
+      nfree(pat, t); pat->cnt--;/* with the pruned subtrees */         \
     }                           /* and delete the processed node */    \
   }                             /* finally terminate the keep list */  \
   *p = NULL;                    /* and merge the two output lists */   \
@@ -581,6 +735,7 @@ int pat_prunex (PATTREE *pat, SUPP supp, const SUPP *frqs)
   else              prunex_pos(&pat->root, pat);
   if (pat->cnt > pat->max)      /* update the maximum number of nodes */
     pat->max = pat->cnt;        /* (just to be sure that max >= cnt) */
+  compact(pat);                 /* compact the node arena */
   return pat->err;              /* return the error status */
 }  /* pat_prunex() */
 
@@ -596,7 +751,7 @@ static void prune (PATNODE **node, SUPP supp, PATTREE *pat)
     if ((*node)->supp >= supp){ /* keep nodes with sufficient supp. */
       node = &(*node)->sibling; continue; }
     t = *node; *node = (*node)->sibling;
-    free(t); pat->cnt--;        /* nodes with insufficient support */
+    nfree(pat, t); pat->cnt--;  /* nodes with insufficient support */
   }                             /* are removed from sibling list */
 }  /* prune() */
 
@@ -606,7 +761,239 @@ void pat_prune (PATTREE *pat, SUPP supp)
 {                               /* --- prune item set repository */
   assert(pat && (supp >= 0));   /* check the function arguments */
   prune(&pat->root.children, supp, pat);
-}  /* pat_prune() */            /* recursively prune prefix tree */
+  compact(pat);                 /* recursively prune prefix tree */
+}  /* pat_prune() */            /* and compact the node arena */
+
+/*--------------------------------------------------------------------*/
+
+#define CROSS(dir) \
+static int cross_##dir (PATNODE *node, PATNODE **ins, SUPP supp,       \
+                        PATTREE *pat)                                  \
+{                               /* --- intersect with an item set */   \
+  ITEM    i, k, n;              /* item buffer, loop variables */      \
+  SUPP    s;                    /* support of the intersection */      \
+  PATNODE *p, **x;              /* to traverse/insert nodes */         \
+                                                                       \
+  assert(node && ins && pat);   /* check the function arguments */     \
+  for ( ; node; node = node->sibling) {                                \
+    pat->visits++;              /* count the visited node */           \
+    s = node->supp +supp;       /* compute the combined support */     \
+    if (s < pat->min) {         /* if the support is too low, */       \
+      if (!dir(node->items[0], pat->last))                             \
+        break;                  /* if last item processed, abort, */   \
+      continue;                 /* otherwise skip the subtree */       \
+    }                                                                  \
+    i = node->items[0];         /* get the first item in the node */   \
+    while ((p = *ins) && dir(p->items[0], i))                          \
+      ins = &p->sibling;        /* advance the insertion position */   \
+    pat->visits += (size_t)node->cnt;   /* count the items */          \
+    for (k = n = 0; k < node->cnt; k++)                                \
+      if (s >= pat->mins[i = node->items[k]])                          \
+        pat->items[n++] = i;    /* collect the intersection items */   \
+    if (n <= 0) {               /* if the intersection is empty */     \
+      if (!dir(node->items[0], pat->last))                             \
+        break;                  /* if last item processed, abort */    \
+      if (node->children        /* if the node has child nodes */      \
+      && (cross_##dir(node->children, ins, supp, pat) < 0))            \
+        return -1; }            /* intersect subtree with item set */  \
+    else {                      /* if intersection is not empty */     \
+      x = insert_##dir(ins, pat->items, n, s, pat);                    \
+      if (!x) return -1;        /* insert the intersection */          \
+      if (!dir(node->items[0], pat->last))                             \
+        break;                  /* if last item processed, abort */    \
+      if (node->children        /* if the node has child nodes */      \
+      && (cross_##dir(node->children, x, supp, pat) < 0))              \
+        return -1;              /* recursively intersect subtree */    \
+    }                           /* with the rest of the item set */    \
+  }                                                                    \
+  return 0;                     /* return 'ok' */                      \
+}  /* cross() */
+
+/* The nodes visited by cross() belong to a different tree than the */
+/* insertion position, so that (unlike in isect()) the insertion of */
+/* an intersection can never change the current node. Since the     */
+/* (additive) transaction support pat->supp is zero, insert() keeps */
+/* the maximum of the supports of the intersections.                */
+
+/*--------------------------------------------------------------------*/
+
+CROSS(pos)                      /* function for ascending  item order */
+CROSS(neg)                      /* function for descending item order */
+
+/*--------------------------------------------------------------------*/
+
+static int unite (PATTREE *pat, PATNODE *node, ITEM *set, ITEM n,
+                  PATNODE **res, SUPP max, const SUPP *mins, MLIM *ml)
+{                               /* --- intersect with closed sets */
+  int     r, x = 0;             /* error status, perfect ext. flag */
+  ITEM    i;                    /* loop variable */
+  size_t  z;                    /* number of visited nodes */
+  PATNODE *c;                   /* to traverse the child nodes */
+
+  assert(pat && node && set && res);   /* check function arguments */
+  for (c = node->children; c; c = c->sibling) {
+    x |= (c->supp >= node->supp);   /* set perfect extension flag */
+    if (c->supp +max < pat->min)    /* skip item sets that cannot */
+      continue;                     /* give frequent intersections */
+    memcpy(set+n, c->items, (size_t)c->cnt *sizeof(ITEM));
+    r = unite(pat, c, set, n+c->cnt, res, max, mins, ml);
+    if (r != 0) return r;       /* add the items of the child node */
+  }                             /* and process the children */
+  if (x || (n <= 0)) return 0;  /* only closed sets need processing */
+  z = pat->visits -ml->beg;     /* get the cost of the merge so far */
+  if ((z > ml->lim)             /* and check it against the limit */
+  ||  ((ml->done > 0) && (ml->done >= (ml->cnt >> 3))
+  &&   ((double)z *(double)ml->cnt > (double)ml->lim *(double)ml->done)))
+    return 1;                   /* (also extrapolated to all sets) */
+  ml->done++;                   /* count the processed closed set */
+  for (i = 0; i < n; i++)       /* set the minimum support values */
+    pat->mins[set[i]] = mins[set[i]];   /* of the items in the set */
+  pat->last = set[n-1];         /* note the last item of the set */
+  r = (pat->dir < 0)            /* intersect the tree with the set */
+    ? cross_neg(pat->root.children, res, node->supp, pat)
+    : cross_pos(pat->root.children, res, node->supp, pat);
+  for (i = 0; i < n; i++)       /* exclude the items of the set */
+    pat->mins[set[i]] = SUPP_MAX;      /* from the intersection */
+  return r;                     /* return the error status */
+}  /* unite() */
+
+/*--------------------------------------------------------------------*/
+
+static void mark (PATNODE *node, SUPP *flags)
+{                               /* --- mark the items in a tree */
+  ITEM i;                       /* loop variable */
+
+  for ( ; node; node = node->sibling) {
+    for (i = 0; i < node->cnt; i++)
+      flags[node->items[i]] = 1;/* mark the items of the node */
+    if (node->children)         /* and recursively process */
+      mark(node->children, flags);  /* the child nodes */
+  }
+}  /* mark() */
+
+/*--------------------------------------------------------------------*/
+
+static void hist (PATNODE *node, size_t *bins, SUPP max)
+{                               /* --- collect node support histogram */
+  for ( ; node; node = node->sibling) {
+    bins[BIN(node->supp, max)]++;   /* count the node in its bin */
+    if (node->children)         /* and recursively process */
+      hist(node->children, bins, max);  /* the child nodes */
+  }
+}  /* hist() */
+
+/*--------------------------------------------------------------------*/
+
+static size_t cost (PATNODE *node, SUPP min, SUPP max,
+                    const size_t *bins, size_t lim, size_t *cnt)
+{                               /* --- estimate cost of intersections */
+  int    x = 0;                 /* perfect extension flag */
+  size_t n = 0;                 /* number of nodes to visit */
+  PATNODE *c;                   /* to traverse the child nodes */
+
+  assert(node && bins);         /* check the function arguments */
+  for (c = node->children; c && (n <= lim); c = c->sibling) {
+    x |= (c->supp >= node->supp);   /* set perfect extension flag */
+    if (c->supp +max >= min)    /* sum the costs of the closed sets */
+      n += cost(c, min, max, bins, lim-n, cnt);
+  }                             /* in the subtrees of the children */
+  if (x) return n;              /* skip sets with a perfect extension */
+  *cnt += 1;                    /* count the closed item set and */
+  return n +bins[BIN(min -node->supp, max)];
+}  /* cost() */                 /* add the nodes that may be visited */
+
+/* The cost of intersecting the tree with a closed item set is the   */
+/* number of nodes with enough support to yield a frequent item set, */
+/* which is read (overestimated) from the cumulated histogram bins.  */
+/* The recursion stops as soon as the cost exceeds lim; otherwise    */
+/* all closed item sets to be processed by unite() are counted.      */
+
+
+/*--------------------------------------------------------------------*/
+
+int pat_merge (PATTREE *pat, PATTREE *src, SUPP supp,
+               const SUPP *frqs, size_t lim)
+{                               /* --- merge with another pat. tree */
+  int     r = 0;                /* error status */
+  ITEM    i;                    /* loop variable */
+  SUPP    max = 0;              /* maximum support of a non-empty set */
+  SUPP    rem = 0;              /* maximum remaining item frequency */
+  size_t  z;                    /* number of nodes of the old tree */
+  ITEM    *set;                 /* buffer for the closed item sets */
+  SUPP    *mins;                /* minimum support values of items */
+  int     k;                    /* loop variable for bins */
+  size_t  bins[BINCNT];         /* histogram of node supports */
+  MLIM    ml;                   /* cost limit of the merge */
+  PATNODE *p, *res = NULL;      /* merged tree (list of root children) */
+
+  assert(pat && src && (supp > 0) && frqs
+  &&    (src->size == pat->size) && (src->dir == pat->dir));
+  memset(pat->mins, 0, (size_t)pat->size *sizeof(SUPP));
+  mark(pat->root.children, pat->mins);  /* mark the items */
+  mark(src->root.children, pat->mins);  /* in both trees */
+  for (i = 0; i < pat->size; i++)  /* get the maximum remaining */
+    if (pat->mins[i] && (frqs[i] > rem)) rem = frqs[i];
+  memset(pat->mins, 0, (size_t)pat->size *sizeof(SUPP));
+  pat->min = supp -rem;         /* item frequency, minimum support */
+  for (p = pat->root.children; p; p = p->sibling)
+    if (p->supp > max) max = p->supp;
+  memset(bins, 0, sizeof(bins));/* collect the node supports */
+  hist(pat->root.children, bins, max);
+  for (k = BINCNT; --k > 0; )   /* count the nodes with at least */
+    bins[k-1] += bins[k];       /* the support of each bin */
+  ml.cnt = 0;                   /* check the estimated cost and */
+  if (cost(&src->root, pat->min, max, bins, lim, &ml.cnt) > lim)
+    return 1;                   /* count the closed sets to process */
+  ml.beg = pat->visits; ml.lim = lim; ml.done = 0;
+  set = (ITEM*)malloc((size_t)(pat->size+1) *sizeof(ITEM)
+                     +(size_t) pat->size    *sizeof(SUPP));
+  if (!set) return -1;          /* create an item set buffer */
+  mins = (SUPP*)(set +pat->size+1);   /* and minimum support values */
+  for (i = 0; i < pat->size; i++)
+    pat->mins[i] = mins[i] = supp-frqs[i];
+  z = pat->cnt;                 /* note the number of nodes */
+  pat->supp = 0;                /* clear the transaction support */
+  pat->step++;                  /* and start a new update step */
+  pat->last = (pat->dir < 0) ? 0 : pat->size-1;
+  if (pat->root.children)       /* copy the item sets of both trees */
+    r = (pat->dir < 0) ? cross_neg(pat->root.children, &res, 0, pat)
+                       : cross_pos(pat->root.children, &res, 0, pat);
+  if ((r >= 0) && src->root.children)
+    r = (pat->dir < 0) ? cross_neg(src->root.children, &res, 0, pat)
+                       : cross_pos(src->root.children, &res, 0, pat);
+  for (i = 0; i < pat->size; i++)
+    pat->mins[i] = SUPP_MAX;    /* exclude all items */
+  if ((r >= 0) && pat->root.children)
+    r = unite(pat, &src->root, set, 0, &res, max, mins, &ml);
+  memset(pat->mins, 0, (size_t)pat->size *sizeof(SUPP));
+  free(set);                    /* delete the item set buffer */
+  if (pat->cnt > pat->max) pat->max = pat->cnt;
+  if (r != 0) {                 /* if the merge failed or was aborted */
+    delete(pat, res); pat->cnt = z;  /* delete the merged tree */
+    compact(pat); return r;     /* and compact the node arena */
+  }                             /* (its nodes are lost in the arena) */
+  delete(pat, pat->root.children);  /* delete the old tree and */
+  pat->root.children = res;     /* replace it by the merged one */
+  pat->root.supp    += src->root.supp;
+  pat->cnt          -= z;       /* sum the empty set supports */
+  compact(pat);                 /* and adapt the number of nodes, */
+  return 0;                     /* then compact the node arena */
+}  /* pat_merge() */
+
+/*----------------------------------------------------------------------
+The function pat_merge() combines the closed item sets of two patricia
+trees that were built from disjoint sets of transactions in the same
+way as pxt_merge() combines two prefix trees (see pfxtree.c): the item
+sets of both trees are copied into a new tree, after which the first
+tree is intersected with each closed item set of the second tree,
+removing items that cannot become frequent with the remaining item
+frequencies frqs (transactions not in the trees). If the estimated
+number of nodes visited by these intersections exceeds lim, or if the
+merge actually visits more than lim nodes (counted in pat->visits, see
+pat_tcost() for the average number of nodes visited per transaction),
+1 is returned without changing the tree. The second tree is not changed
+and may be deleted afterwards.
+----------------------------------------------------------------------*/
 
 /*--------------------------------------------------------------------*/
 
@@ -6,9 +6,13 @@
             2012.07.09 first version completed (without pruning yet)
             2012.07.13 pruning added (implementation of pat_prunex())
             2013.04.01 adapted to type changes in module tract
+            2026.10.18 function pat_merge() added (combine two trees)
+            2026.10.18 nodes allocated in a memory arena (compaction)
+            2026.10.18 node visit counter added (merge cost limit)
 ----------------------------------------------------------------------*/
 #ifndef __PATTREE__
 #define __PATTREE__
+#include "memsys.h"
 #include "tract.h"
 #ifndef ISR_CLOMAX
 #define ISR_CLOMAX
@@ -31,12 +35,18 @@ typedef struct {                /* --- a prefix tree --- */
   ITEM           size;          /* number of items / array size */
   size_t         cnt;           /* current number of nodes */
   size_t         max;           /* maximum number of nodes */
+  MSSTACK        *mem;          /* memory arena for the nodes */
+  PATNODE        *top;          /* node allocated last in arena */
+  size_t         used;          /* memory used by the nodes */
+  size_t         waste;         /* memory lost in arena (freed) */
   int            dir;           /* direction of item order */
   TID            step;          /* last update step (for pat_isect) */
   ITEM           last;          /* last item        (for pat_isect) */
   SUPP           supp;          /* current support  (for pat_isect) */
   SUPP           min;           /* minimum support   for reporting */
   int            err;           /* error indicator  (for pat_prunex) */
+  size_t         visits;        /* number of visited nodes */
+  double         tcost;         /* visited nodes per transaction */
   ITEM           *items;        /* item buffer for intersection */
   ISREPORT       *rep;          /* item set reporter for reporting */
   PATNODE        root;          /* root node of the prefix tree */
@@ -62,6 +72,8 @@ extern int      pat_super   (PATTREE *pat, const ITEM *items, ITEM n,
                              SUPP supp);
 extern int      pat_prunex  (PATTREE *pat, SUPP supp, const SUPP *frqs);
 extern void     pat_prune   (PATTREE *pat, SUPP supp);
+extern int      pat_merge   (PATTREE *pat, PATTREE *src, SUPP supp,
+                             const SUPP *frqs, size_t lim);
 
 extern int      pat_report  (PATTREE *pat, int max, SUPP supp,
                              ISREPORT *rep);
@@ -77,5 +89,6 @@ extern void     pat_show    (PATTREE *pat, ITEMBASE *base);
 #define pat_nodemax(t)   ((t)->max)
 #define pat_dir(t)       ((t)->dir)
 #define pat_supp(t)      ((t)->root.supp)
+#define pat_tcost(t)     ((t)->tcost)
 
 #endif
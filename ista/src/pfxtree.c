@@ -22,6 +22,8 @@
             2012.04.29 special maximal item set functions added
             2013.04.01 adapted to type changes in module tract
             2013.10.15 checks of return code of isr_report() added
+            2026.10.18 function pxt_merge() added (combine two trees)
+            2026.10.18 merge aborted if costlier than intersections
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -40,6 +42,21 @@
 #define pos(x,y)  ((x) < (y))   /* macros for item comparison */
 #define neg(x,y)  ((x) > (y))   /* (ascending and descending) */
 
+#define TCWGT     16            /* weight for average trans. cost */
+#define BINCNT    64            /* number of bins for node supports */
+#define BIN(s,m)  (((s) <= 0) ? 0 : ((s) >= (m)) ? BINCNT-1 \
+                  : (int)((double)(s)/(double)(m) *(BINCNT-1)))
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct {                /* --- cost limit of a merge --- */
+  size_t beg;                   /* visited nodes at start of merge */
+  size_t lim;                   /* maximum number of nodes to visit */
+  size_t cnt;                   /* number of closed sets to process */
+  size_t done;                  /* number of processed closed sets */
+} MLIM;                         /* (cost limit of a merge) */
+
 /*----------------------------------------------------------------------
   Main Functions
 ----------------------------------------------------------------------*/
@@ -58,6 +75,7 @@ PFXTREE* pxt_create (ITEM size, int dir, MEMSYS *mem)
   pxt->step = 0;                /* note item count and order direction */
   pxt->last = 0;                /* and initialize the other fields */
   pxt->min  = pxt->supp = 0;
+  pxt->visits = 0; pxt->tcost = 0;
   pxt->rep  = NULL;
   pxt->root.item     = -1;      /* initialize the root node */
   pxt->root.supp     = 0; pxt->root.step = 0;
@@ -143,6 +161,7 @@ static int isect_##dir (PFXNODE *node, PFXNODE **ins, PFXTREE *pxt)    \
   assert(node && ins && pxt);   /* check the function arguments */     \
   for ( ; node; node = node->sibling) {                                \
     i = node->item;             /* traverse the node list */           \
+    pxt->visits++;              /* count the visited node */           \
     if (node->step >= pxt->step) { /* if the node has been visited */  \
       if (!dir(i, pxt->last)) break;                                   \
       if (node->children        /* if the node has child nodes */      \
@@ -191,8 +210,10 @@ ISECT(neg)                      /* function for descending item order */
 int pxt_isect (PFXTREE *pxt, const ITEM *items, ITEM n, SUPP supp,
                SUPP min, const SUPP *frqs)
 {                               /* --- intersect with an item set */
-  ITEM i;                       /* to traverse the items */
-  SUPP s;                       /* to compute limiting support */
+  int    r;                     /* result of isect_dir() */
+  ITEM   i;                     /* to traverse the items */
+  SUPP   s;                     /* to compute limiting support */
+  size_t v;                     /* number of visited nodes */
 
   assert(pxt && (items || (n <= 0)));  /* check function arguments */
   pxt->root.supp += supp;       /* update the empty set support */
@@ -215,10 +236,13 @@ int pxt_isect (PFXTREE *pxt, const ITEM *items, ITEM n, SUPP supp,
   /* subtrees rooted at nodes with the item, which could still become */
   /* become frequent, may not be processed, thus losing results.      */
   pxt->step++;                  /* increment the update step */
-  return (pxt->dir < 0)         /* intersect tree with item set */
+  v = pxt->visits;              /* note the visited nodes */
+  r = (pxt->dir < 0)            /* intersect tree with item set */
     ? isect_neg(pxt->root.children, &pxt->root.children, pxt)
     : isect_pos(pxt->root.children, &pxt->root.children, pxt);
-}  /* pxt_isect() */
+  pxt->tcost += ((double)(pxt->visits -v) -pxt->tcost) /TCWGT;
+  return r;                     /* update the average cost and */
+}  /* pxt_isect() */            /* return the error status */
 
 /*--------------------------------------------------------------------*/
 
@@ -410,6 +434,232 @@ void pxt_prune (PFXTREE *pxt, SUPP supp)
 
 /*--------------------------------------------------------------------*/
 
+#define CROSS(dir) \
+static int cross_##dir (PFXNODE *node, PFXNODE **ins, SUPP supp,       \
+                        PFXTREE *pxt)                                  \
+{                               /* --- intersect with an item set */   \
+  ITEM    i;                    /* buffer for current item */          \
+  SUPP    s;                    /* support of the intersection */      \
+  PFXNODE *d;                   /* to allocate new nodes */            \
+                                                                       \
+  assert(node && ins && pxt);   /* check the function arguments */     \
+  for ( ; node; node = node->sibling) {                                \
+    i = node->item;             /* traverse the node list */           \
+    pxt->visits++;              /* count the visited node */           \
+    s = node->supp +supp;       /* compute the combined support */     \
+    if (s < pxt->min) {         /* if the support is too low, */       \
+      if (!dir(i, pxt->last)) break; }    /* skip the subtree */       \
+    else if (s < pxt->mins[i]) {/* if item is not in intersection */   \
+      if (!dir(i, pxt->last)) break;  /* (or cannot become frequent) */\
+      if (node->children        /* if there are child nodes */         \
+      && (cross_##dir(node->children, ins, supp, pxt) < 0))            \
+        return -1; }            /* intersect subtree with item set */  \
+    else {                      /* if item is in the intersection */   \
+      while ((d = *ins) && dir(d->item, i))                            \
+        ins = &d->sibling;      /* find the insertion position */      \
+      if (!d || (d->item != i)){/* if node does not exist */           \
+        d = (PFXNODE*)ms_alloc(pxt->mem);                              \
+        if (!d) return -1;      /* allocate a new node and */          \
+        d->item = i;            /* store the matched item */           \
+        d->step = 0;            /* clear the update step */            \
+        d->supp = s;            /* and set the combined support */     \
+        d->sibling  = *ins; *ins = d;                                  \
+        d->children = NULL; }   /* insert node into sibling list */    \
+      else if (d->supp < s)     /* if a node already exists, */        \
+        d->supp = s;            /* keep the maximum of the supports */ \
+      if (!dir(i, pxt->last)) break;                                   \
+      if (node->children        /* if there are child nodes */         \
+      && (cross_##dir(node->children, &d->children, supp, pxt) < 0))   \
+        return -1;              /* recursively intersect subtree */    \
+    }                           /* with the rest of the item set */    \
+  }                                                                    \
+  return 0;                     /* return 'ok' */                      \
+}  /* cross() */
+
+/*--------------------------------------------------------------------*/
+
+CROSS(pos)                      /* function for ascending  item order */
+CROSS(neg)                      /* function for descending item order */
+
+/*--------------------------------------------------------------------*/
+
+static int unite (PFXTREE *pxt, PFXNODE *node, ITEM *set, ITEM n,
+                  PFXNODE **res, SUPP max, const SUPP *mins, MLIM *ml)
+{                               /* --- intersect with closed sets */
+  int     r, x = 0;             /* error status, perfect ext. flag */
+  ITEM    i;                    /* loop variable */
+  size_t  z;                    /* number of visited nodes */
+  PFXNODE *c;                   /* to traverse the child nodes */
+
+  assert(pxt && node && set && res);   /* check function arguments */
+  for (c = node->children; c; c = c->sibling) {
+    x |= (c->supp >= node->supp);   /* set perfect extension flag */
+    if (c->supp +max < pxt->min)    /* skip item sets that cannot */
+      continue;                     /* give frequent intersections */
+    set[n] = c->item;           /* add the item of the child node */
+    r = unite(pxt, c, set, n+1, res, max, mins, ml);
+    if (r != 0) return r;       /* recursively process the children */
+  }
+  if (x || (n <= 0)) return 0;  /* only closed sets need processing */
+  z = pxt->visits -ml->beg;     /* get the cost of the merge so far */
+  if ((z > ml->lim)             /* and check it against the limit */
+  ||  ((ml->done > 0) && (ml->done >= (ml->cnt >> 3))
+  &&   ((double)z *(double)ml->cnt > (double)ml->lim *(double)ml->done)))
+    return 1;                   /* (also extrapolated to all sets) */
+  ml->done++;                   /* count the processed closed set */
+  for (i = 0; i < n; i++)       /* set the minimum support values */
+    pxt->mins[set[i]] = mins[set[i]];   /* of the items in the set */
+  pxt->last = set[n-1];         /* note the last item of the set */
+  r = (pxt->dir < 0)            /* intersect the tree with the set */
+    ? cross_neg(pxt->root.children, res, node->supp, pxt)
+    : cross_pos(pxt->root.children, res, node->supp, pxt);
+  for (i = 0; i < n; i++)       /* exclude the items of the set */
+    pxt->mins[set[i]] = SUPP_MAX;      /* from the intersection */
+  return r;                     /* return the error status */
+}  /* unite() */
+
+/*--------------------------------------------------------------------*/
+
+static void mark (PFXNODE *node, SUPP *flags)
+{                               /* --- mark the items in a tree */
+  for ( ; node; node = node->sibling) {
+    flags[node->item] = 1;      /* mark the item of the node */
+    if (node->children)         /* and recursively process */
+      mark(node->children, flags);  /* the child nodes */
+  }
+}  /* mark() */
+
+/*--------------------------------------------------------------------*/
+
+static void hist (PFXNODE *node, size_t *bins, SUPP max)
+{                               /* --- collect node support histogram */
+  for ( ; node; node = node->sibling) {
+    bins[BIN(node->supp, max)]++;   /* count the node in its bin */
+    if (node->children)         /* and recursively process */
+      hist(node->children, bins, max);  /* the child nodes */
+  }
+}  /* hist() */
+
+/*--------------------------------------------------------------------*/
+
+static size_t cost (PFXNODE *node, SUPP min, SUPP max,
+                    const size_t *bins, size_t lim, size_t *cnt)
+{                               /* --- estimate cost of intersections */
+  int    x = 0;                 /* perfect extension flag */
+  size_t n = 0;                 /* number of nodes to visit */
+  PFXNODE *c;                   /* to traverse the child nodes */
+
+  assert(node && bins);         /* check the function arguments */
+  for (c = node->children; c && (n <= lim); c = c->sibling) {
+    x |= (c->supp >= node->supp);   /* set perfect extension flag */
+    if (c->supp +max >= min)    /* sum the costs of the closed sets */
+      n += cost(c, min, max, bins, lim-n, cnt);
+  }                             /* in the subtrees of the children */
+  if (x) return n;              /* skip sets with a perfect extension */
+  *cnt += 1;                    /* count the closed item set and */
+  return n +bins[BIN(min -node->supp, max)];
+}  /* cost() */                 /* add the nodes that may be visited */
+
+/* The cost of intersecting the tree with a closed item set is the   */
+/* number of nodes with enough support to yield a frequent item set, */
+/* which is read (overestimated) from the cumulated histogram bins.  */
+/* The recursion stops as soon as the cost exceeds lim; otherwise    */
+/* all closed item sets to be processed by unite() are counted.      */
+
+
+/*--------------------------------------------------------------------*/
+
+int pxt_merge (PFXTREE *pxt, PFXTREE *src, SUPP supp,
+               const SUPP *frqs, size_t lim)
+{                               /* --- merge with another prefix tree */
+  int     r = 0;                /* error status */
+  ITEM    i;                    /* loop variable */
+  SUPP    max = 0;              /* maximum support of a non-empty set */
+  SUPP    rem = 0;              /* maximum remaining item frequency */
+  ITEM    *set;                 /* buffer for the closed item sets */
+  SUPP    *mins;                /* minimum support values of items */
+  int     k;                    /* loop variable for bins */
+  size_t  bins[BINCNT];         /* histogram of node supports */
+  MLIM    ml;                   /* cost limit of the merge */
+  PFXNODE *p, *res = NULL;      /* merged tree (list of root children) */
+
+  assert(pxt && src && (supp > 0) && frqs
+  &&    (src->size == pxt->size) && (src->dir == pxt->dir));
+  memset(pxt->mins, 0, (size_t)pxt->size *sizeof(SUPP));
+  mark(pxt->root.children, pxt->mins);  /* mark the items */
+  mark(src->root.children, pxt->mins);  /* in both trees */
+  for (i = 0; i < pxt->size; i++)  /* get the maximum remaining */
+    if (pxt->mins[i] && (frqs[i] > rem)) rem = frqs[i];
+  memset(pxt->mins, 0, (size_t)pxt->size *sizeof(SUPP));
+  pxt->min = supp -rem;         /* item frequency, minimum support */
+  for (p = pxt->root.children; p; p = p->sibling)
+    if (p->supp > max) max = p->supp;
+  memset(bins, 0, sizeof(bins));/* collect the node supports */
+  hist(pxt->root.children, bins, max);
+  for (k = BINCNT; --k > 0; )   /* count the nodes with at least */
+    bins[k-1] += bins[k];       /* the support of each bin */
+  ml.cnt = 0;                   /* check the estimated cost and */
+  if (cost(&src->root, pxt->min, max, bins, lim, &ml.cnt) > lim)
+    return 1;                   /* count the closed sets to process */
+  ml.beg = pxt->visits; ml.lim = lim; ml.done = 0;
+  set = (ITEM*)malloc((size_t)(pxt->size+1) *sizeof(ITEM)
+                     +(size_t) pxt->size    *sizeof(SUPP));
+  if (!set) return -1;          /* create an item set buffer */
+  mins = (SUPP*)(set +pxt->size+1);   /* and minimum support values */
+  for (i = 0; i < pxt->size; i++)
+    pxt->mins[i] = mins[i] = supp-frqs[i];
+  pxt->last = (pxt->dir < 0) ? 0 : pxt->size-1;
+  if (pxt->root.children)       /* copy the item sets of both trees */
+    r = (pxt->dir < 0) ? cross_neg(pxt->root.children, &res, 0, pxt)
+                       : cross_pos(pxt->root.children, &res, 0, pxt);
+  if ((r >= 0) && src->root.children)
+    r = (pxt->dir < 0) ? cross_neg(src->root.children, &res, 0, pxt)
+                       : cross_pos(src->root.children, &res, 0, pxt);
+  for (i = 0; i < pxt->size; i++)
+    pxt->mins[i] = SUPP_MAX;    /* exclude all items */
+  if ((r >= 0) && pxt->root.children)
+    r = unite(pxt, &src->root, set, 0, &res, max, mins, &ml);
+  memset(pxt->mins, 0, (size_t)pxt->size *sizeof(SUPP));
+  free(set);                    /* delete the item set buffer */
+  if (r != 0) { delete(res, pxt->mem); return r; }
+  delete(pxt->root.children, pxt->mem);
+  pxt->root.children = res;     /* replace the tree by the merged one */
+  pxt->root.supp    += src->root.supp;
+  return 0;                     /* sum the empty set supports */
+}  /* pxt_merge() */
+
+/*----------------------------------------------------------------------
+The function pxt_merge() combines the closed item sets of two prefix
+trees that were built from disjoint sets of transactions. Every closed
+item set of the union of the transactions is either a closed item set
+of one of the two trees or the intersection of a closed item set of the
+first tree with a closed item set of the second tree. Its support is the
+sum of the maximum supports of its supersets in the two trees. Hence
+the item sets of both trees are copied into a new tree, after which the
+first tree is intersected with each closed item set of the second tree
+(nodes without a perfect extension), where the support of the closed
+item set is added to the supports of the intersections and the maximum
+support is kept for each node. The array frqs must contain the item
+frequencies in all transactions that are not in the two trees: like in
+pxt_prunex(), an item is removed from an intersection if the support
+of the intersection plus the remaining frequency of the item is less
+than the minimum support supp, since it cannot become frequent then.
+Since there may be many more closed item sets than transactions, the
+merge may be much costlier than intersecting one of the trees with the
+transactions the other tree was built from. Hence the merge may visit
+at most lim nodes (which are counted in pxt->visits by the intersection
+functions, so that the caller can compute lim from the average number
+of nodes visited per transaction, see pxt_tcost()). The cost of the
+merge is estimated beforehand from a histogram of the node supports of
+the first tree (the nodes that can yield intersections with enough
+support) and the merge is aborted as soon as it visited more than lim
+nodes. In both cases the function returns 1 without changing the tree
+and the caller should rather intersect transactions with one of the
+trees. The second tree is not changed and may be deleted afterwards.
+----------------------------------------------------------------------*/
+
+/*--------------------------------------------------------------------*/
+
 static int closed (PFXTREE *pxt, PFXNODE *node)
 {                               /* --- report closed item sets */
   int  r, x = 0;                /* error status, perfect ext. flag */
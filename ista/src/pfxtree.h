@@ -13,6 +13,8 @@
             2010.08.18 function pxt_nodecnt() added (number of nodes)
             2012.04.29 function pxt_super() added (check for superset)
             2013.04.01 adapted to type changes in module tract
+            2026.10.18 function pxt_merge() added (combine two trees)
+            2026.10.18 node visit counter added (merge cost limit)
 ----------------------------------------------------------------------*/
 #ifndef __PFXTREE__
 #define __PFXTREE__
@@ -42,6 +44,8 @@ typedef struct {                /* --- a prefix tree --- */
   ITEM           last;          /* last item        (for pxt_isect) */
   SUPP           supp;          /* current support  (for pxt_isect) */
   SUPP           min;           /* minimum support   for reporting */
+  size_t         visits;        /* number of visited nodes */
+  double         tcost;         /* visited nodes per transaction */
   ISREPORT       *rep;          /* item set reporter for reporting */
   PFXNODE        root;          /* root node of the prefix tree */
   SUPP           mins[1];       /* minimum support values */
@@ -67,6 +71,8 @@ extern int      pxt_super   (PFXTREE *pxt, const ITEM *items, ITEM n,
                              SUPP supp);
 extern int      pxt_prunex  (PFXTREE *pxt, SUPP supp, const SUPP *frqs);
 extern void     pxt_prune   (PFXTREE *pxt, SUPP supp);
+extern int      pxt_merge   (PFXTREE *pxt, PFXTREE *src, SUPP supp,
+                             const SUPP *frqs, size_t lim);
 
 extern int      pxt_report  (PFXTREE *pxt, int max, SUPP supp,
                              ISREPORT *rep);
@@ -83,5 +89,6 @@ extern void     pxt_show    (PFXTREE *pxt, ITEMBASE *base);
 #define pxt_nodemax(t)   (ms_umax((t)->mem))
 #define pxt_dir(t)       ((t)->dir)
 #define pxt_supp(t)      ((t)->root.supp)
+#define pxt_tcost(t)     ((t)->tcost)
 
 #endif
@@ -6,6 +6,7 @@
             2011.08.03 bug in re_fetprob fixed (roundoff error corr.)
             2012.02.15 function re_supp() added (rule support)
             2013.03.29 adapted to type changes in module tract (SUPP)
+            2026.10.18 function re_bound() added (optimistic bounds)
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -446,3 +447,31 @@ int re_dir (int id)
   assert((id >= 0) && (id <= RE_FNCNT));
   return reinfo[id].dir;        /* retrieve direction from table */
 }  /* re_dir() */
+
+/*--------------------------------------------------------------------*/
+
+double re_bound (int id, SUPP supp, SUPP head, SUPP base)
+{                               /* --- get an optimistic bound */
+  double t;                     /* temporary buffer */
+
+  assert((id >= 0) && (id <= RE_FNCNT));
+  switch (id) {                 /* evaluate the measure identifier */
+    case RE_NONE:     return 0;
+    case RE_SUPP:     return (double)supp;
+    case RE_LIFT:     return (head > 0) ? (double)base/(double)head : 0;
+    case RE_LIFTDIFF: t = (head > 0) ? (double)base/(double)head -1 : 0;
+                      return (t > 1) ? t : 1;
+    case RE_CONF:     case RE_CONFDIFF: case RE_LIFTQUOT:
+    case RE_CERT:     case RE_CHI2:     case RE_YATES:
+    case RE_INFO:     return 1;
+    default:          break;    /* measures with a known bound */
+  }                             /* in the range of the measure */
+  return (reinfo[id].dir < 0) ? 0 : INFINITY;
+}  /* re_bound() */             /* measures without a usable bound */
+
+/* re_bound() returns a value that no rule can exceed (or, for      */
+/* measures to minimize, fall below) if its support is at most supp */
+/* and its head support is at least head. It is meant for pruning   */
+/* the search in top-k rule mining: since the rule confidence is at */
+/* most 1, the lift of a rule is bounded by base/head, and a rule   */
+/* support cannot exceed the support of the item set it stems from. */
@@ -6,6 +6,7 @@
             2012.02.15 function re_supp() added (rule support)
             2013.03.29 adapted to type changes in module tract (SUPP)
             2014.05.15 functions re_cprob() and re_import() added
+            2026.10.18 function re_bound() added (optimistic bounds)
 ----------------------------------------------------------------------*/
 #ifndef __RULEVAL__
 #define __RULEVAL__
@@ -78,5 +79,6 @@ extern double re_fetsupp   (SUPP supp, SUPP body, SUPP head, SUPP base);
 
 extern RULEVALFN* re_function (int id);
 extern int        re_dir      (int id);
+extern double     re_bound    (int id, SUPP supp, SUPP head, SUPP base);
 
 #endif
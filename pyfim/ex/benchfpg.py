@@ -0,0 +1,27 @@
+#!/usr/bin/python
+#-----------------------------------------------------------------------
+# File    : benchfpg.py
+# Contents: benchmark for node list traversal in fpgrowth projections
+#           (large sparse prefix trees, with and without prefetching)
+# History : 2026.10.18 file created
+#-----------------------------------------------------------------------
+from sys    import argv
+from time   import time
+from random import seed, randint, choices
+from fim    import fpgrowth
+
+#-----------------------------------------------------------------------
+
+items = int(argv[1]) if len(argv) > 1 else   2000
+cnt   = int(argv[2]) if len(argv) > 2 else 200000
+supp  = int(argv[3]) if len(argv) > 3 else    150
+seed(7)                         # create a sparse random database
+wgts   = [ 1.0/(i+1)**0.5 for i in range(items) ]
+tracts = [ choices(range(items), weights=wgts, k=randint(8, 30))
+           for k in range(cnt) ]
+print('%d transactions over %d items, supp=%d' % (cnt, items, supp))
+for mode in [ 'j', '', 'lj', 'l' ]:
+    t = time()                  # mine with the different modes
+    n = sum(fpgrowth(tracts, supp=-supp, algo='s', mode=mode,
+                     report='#').values())
+    print('mode=%-4s %8d sets %8.3fs' % ('\'' +mode +'\'', n, time()-t))
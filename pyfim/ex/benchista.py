@@ -0,0 +1,37 @@
+#!/usr/bin/python
+#-----------------------------------------------------------------------
+# File    : benchista.py
+# Contents: benchmark for the parallel intersection in ista()
+#           (segmented data, where merging the shard trees pays off,
+#           and uniform random data, where it does not)
+# History : 2026.10.18 file created
+#-----------------------------------------------------------------------
+from sys    import argv
+from time   import time, process_time
+from random import seed, sample, randint
+from fim    import ista
+
+#-----------------------------------------------------------------------
+
+data  = argv[1]      if len(argv) > 1 else 'seg'
+cnt   = int(argv[2]) if len(argv) > 2 else 8000
+supp  = int(argv[3]) if len(argv) > 3 else   20
+seed(3)                         # create a random database
+if data == 'seg':               # segments with items of their own
+    segs = 4; n = cnt //segs    # (e.g. a drifting vocabulary)
+    tracts = []                 # each transaction is one of ten
+    for s in range(segs):       # item groups plus three noise items
+        o = s *200              # (noise items are frequent, but not
+        tracts += [ list(range(o +g*10, o +g*10 +10))  # together)
+                  + sample(range(o +100, o +200), 3)
+                    for g in [ randint(0, 9) for k in range(n) ] ]
+else:                           # uniform random transactions
+    tracts = [ sample(range(80), randint(5, 15)) for k in range(cnt) ]
+print('%s: %d transactions, supp=%d' % (data, len(tracts), supp))
+for algo in [ 'x', 'p' ]:
+    for cpus in [ 1, 2, 4, 8 ]:
+        t = time(); c = process_time()
+        n = sum(ista(tracts, target='c', supp=-supp, algo=algo,
+                     cpus=cpus, report='#').values())
+        print('algo=%s cpus=%d %8d sets %8.3fs (cpu %8.3fs)'
+              % (algo, cpus, n, time()-t, process_time()-c))
@@ -5,6 +5,7 @@
 # Author  : Christian Borgelt
 # History : 2012.??.?? file created
 #           2013.10.31 added carpenter and closed item set mining
+#           2026.10.18 added item set evaluation (item set tree)
 #-----------------------------------------------------------------------
 from sys        import argv, stderr
 from os         import remove, devnull
@@ -167,5 +168,20 @@ if __name__ == '__main__':
         stderr.write('ref ok\n' if pypats == ref    else 'ref fail\n')
         stderr.write('\n')
 
+    stderr.write('evaluated item sets (item set tree):\n')
+    ref = None
+    for p,f in [('apriori',  apriori),
+                ('eclat',    eclat),
+                ('fpgrowth', fpgrowth)]:
+        stderr.write(p +' ... '); t = time()
+        for r in range(runs):
+            pypats = f(tracts, supp=-2, zmin=2, eval='l', thresh=10,
+                       report='a')
+        stderr.write('done [%.3fs].\n' % (time()-t))
+        pypats = set([(tuple(sorted(list(s))), x[0]) for s,x in pypats])
+        if ref is None: ref = pypats
+        stderr.write('ref ok\n' if pypats == ref else 'ref fail\n')
+    stderr.write('\n')
+
     remove('data.txt')
     remove('tmp.txt')
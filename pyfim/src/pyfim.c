@@ -37,6 +37,23 @@
             2014.10.15 bug in function fim() fixed (call to eclat fn.)
             2014.10.17 bug in function patspec() fixed (rem. FPG_FIM16)
             2014.10.24 changed from LGPL license to MIT license
+            2026.10.18 array-based FP-growth variant added (algo='a')
+            2026.10.18 mode 'j' added to fpgrowth() (no prefetching)
+            2026.10.18 parameter 'cpus' added to apriori() (counting)
+            2026.10.18 mode 'M' added to apriori() (no pair matrix)
+            2026.10.18 report flag '+' and function expand() added
+            2026.10.18 function readbin() added (binary item set files)
+            2026.10.18 parameter 'topk' added to eclat() and fpgrowth()
+            2026.10.18 parameter 'topk' added to arules() (rule eval.)
+            2026.10.18 parameters 'max_results' and 'max_memory' added
+            2026.10.18 parameter 'progress' and interrupt checks added
+            2026.10.18 parameter 'cpus' added to sam() (parallel search)
+            2026.10.18 parameter 'cpus' added to relim()
+            2026.10.18 parameter 'cpus' added to carpenter()
+            2026.10.18 parameter 'cpus' added to ista()
+            2026.10.18 border rejected together with report flag '+'
+            2026.10.18 progress calls timed with a wall clock
+            2026.10.18 parameter 'cpus' of ista() marked as experimental
 ----------------------------------------------------------------------*/
 #include <assert.h>
 #if defined _WIN32 && !defined HAVE_ROUND
@@ -44,6 +61,7 @@
 #endif
 #include <Python.h>
 #include <float.h>
+#include <time.h>
 #include <signal.h>
 #ifdef _WIN32
 #include <windows.h>
@@ -75,6 +93,7 @@
 #include "carpenter.h"
 #include "ista.h"
 #include "accretion.h"
+#include "repread.h"
 #ifdef STORAGE
 #include "storage.h"
 #endif
@@ -86,10 +105,25 @@
 #define ERR_TYPE(s)  PyErr_SetString(PyExc_TypeError,  s);  return NULL
 #define ERR_MEM()    PyErr_SetString(PyExc_MemoryError,""); return NULL
 
+#define LIM_NONE    -1          /* no result or memory limit */
+#define LIM_OK       0          /* limits given, but not reached */
+#define LIM_RESULTS  1          /* maximum number of results reached */
+#define LIM_MEMORY   2          /* maximum memory size reached */
+#define LIM_CANCEL   3          /* search cancelled by progress fn. */
+
+#define PROG_IVAL   1024        /* search nodes between polls */
+#define PROG_TIME   0.25        /* time between progress calls (sec.) */
+
+#define EST_EQUIV   1000        /* equiv. number of surrogates */
+#define EST_SMPLS   100         /* initial number of samples */
+#define EST_SMAX    (1 << 20)   /* maximum number of samples */
+#define EST_TIME    1.0         /* time budget for estimate (sec.) */
+
 #if PY_MAJOR_VERSION >= 3
 #define PyInt_Check     PyLong_Check
 #define PyInt_AsLong    PyLong_AsLong
 #define PyInt_FromLong  PyLong_FromLong
+#define PyString_FromString  PyUnicode_FromString
 #else
 #define Py_hash_t       long    /* type was introduced with Python 3 */
 #endif
@@ -112,6 +146,11 @@ typedef struct {                /* --- item set report data --- */
   int       err;                /* error flag */
   int       cnt;                /* number of value indicators */
   CCHAR     *rep;               /* indicators of values to report */
+  double    *vals;              /* top-k values of reported sets */
+  size_t    size;               /* size of the value array */
+  PyObject  *prog;              /* progress function (or NULL) */
+  double    last;               /* time of last progress call */
+  int       mt;                 /* whether called by several threads */
 } REPDATA;                      /* (item set report data) */
 
 typedef struct {                /* --- thread worker data --- */
@@ -127,6 +166,19 @@ typedef struct {                /* --- thread worker data --- */
   volatile long *comp;          /* number of completed data sets */
 } WORKDATA;                     /* (thread worker data) */
 
+typedef struct {                /* --- perf. ext. expansion iterator */
+  PyObject_HEAD                 /* Python object header */
+  PyObject   *src;              /* iterator over compressed item sets */
+  PyObject   *gen;              /* current generator (item set) */
+  PyObject   *pexs;             /* current perfect extensions */
+  PyObject   *vals;             /* values associated to generator */
+  Py_ssize_t zmin, zmax;        /* range of item set sizes */
+  Py_ssize_t n;                 /* number of perfect extensions */
+  Py_ssize_t k, kmax;           /* current/max. number of added exts. */
+  Py_ssize_t size;              /* size of the index array */
+  Py_ssize_t *idx;              /* indices of added perfect exts. */
+} PEXITER;                      /* (perfect extension iterator) */
+
 /*----------------------------------------------------------------------
   Global Variables
 ----------------------------------------------------------------------*/
@@ -179,23 +231,44 @@ static BOOL WINAPI sighandler (DWORD type)
 { if (type == SIGINT) aborted = -1; return TRUE; }
 
 static void siginstall (void)
-{ SetConsoleCtrlHandler(sighandler, TRUE); }
+{ aborted = 0; SetConsoleCtrlHandler(sighandler, TRUE); }
 
 static void sigremove (void)
 { SetConsoleCtrlHandler(sighandler, FALSE); }
 
 #else /*--------------------------------------------------------------*/
 
+static void (*sigprev)(int) = SIG_DFL; /* previous signal handler */
+
 static void sighandler (int type)
 { if (type == SIGINT) aborted = -1; }
 
 static void siginstall (void)
-{ signal(SIGINT, sighandler); }
+{ aborted = 0; sigprev = signal(SIGINT, sighandler); }
 
 static void sigremove (void)
-{ }
+{ if (sigprev != SIG_ERR) signal(SIGINT, sigprev); }
 
 #endif
+/*----------------------------------------------------------------------
+  Timer Function
+----------------------------------------------------------------------*/
+
+static double wallclk (void)
+{                               /* --- get wall clock time (seconds) */
+  #ifdef _WIN32                 /* if Microsoft Windows system */
+  return (double)GetTickCount64() /1000.0;
+  #else                         /* if Linux/Unix system */
+  struct timespec ts;           /* monotonic clock time */
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec +(double)ts.tv_nsec *1e-9;
+  #endif                        /* return the time in seconds */
+}  /* wallclk() */
+
+/* The wall clock time is used instead of clock(), because clock()  */
+/* yields the processor time of the whole process, which advances   */
+/* the faster, the more threads are searching in parallel.          */
+
 /*----------------------------------------------------------------------
   Frequent Item Set Mining Functions
 ----------------------------------------------------------------------*/
@@ -290,7 +363,8 @@ static TABAG* tbg_fromPyObj (PyObject *tracts)
 
 /*--------------------------------------------------------------------*/
 
-static void* isr_pyborder (ISREPORT *rep, PyObject *border)
+static void* isr_pyborder (ISREPORT *rep, PyObject *border,
+                           CCHAR *report)
 {                               /* --- set reporter filtering border */
   int        e = 0;             /* error flag for number conversion */
   Py_ssize_t n;                 /* loop variable, sequence length */
@@ -303,6 +377,8 @@ static void* isr_pyborder (ISREPORT *rep, PyObject *border)
     ERR_TYPE("border must be a list or tuple of numbers"); }
   n = PySequence_Length(border);/* check for a sequence */
   if (n <= 0) return 0;         /* empty sequences need no processing */
+  if (report[0] == '+') {       /* border filters only generators */
+    ERR_VALUE("border cannot be combined with report flag '+'"); }
   while (n > 0) { --n;          /* traverse the sequence elements */
     o = PySequence_GetItem(border, n);
     if      (PyLong_Check(o))   /* if element is a long integer */
@@ -322,6 +398,25 @@ static void* isr_pyborder (ISREPORT *rep, PyObject *border)
 
 /*--------------------------------------------------------------------*/
 
+static void tkval (REPDATA *rd, double val)
+{                               /* --- note a top-k value */
+  size_t n;                     /* number of reported sets/rules */
+  double *p;                    /* enlarged value array */
+
+  assert(rd);                   /* check the function arguments */
+  n = (size_t)PyList_GET_SIZE(rd->res);
+  if (n > rd->size) {           /* if the value array is full */
+    p = (double*)realloc(rd->vals, (n +((n > 1024) ? n >> 1 : 1024))
+                                   *sizeof(double));
+    if (!p) { rd->err = -1; return; }
+    rd->vals = p;               /* enlarge the value array */
+    rd->size = n +((n > 1024) ? n >> 1 : 1024);
+  }                             /* (needed to filter at the end) */
+  rd->vals[n-1] = val;          /* store the support/evaluation */
+}  /* tkval() */
+
+/*--------------------------------------------------------------------*/
+
 static void isr_iset2PyObj (ISREPORT *rep, void *data)
 {                               /* --- report an item set */
   int      i;                   /* loop variable */
@@ -329,8 +424,10 @@ static void isr_iset2PyObj (ISREPORT *rep, void *data)
   RSUPP    supp, base;          /* item set support and base support */
   SUPP     s;                   /* support value for reporting */
   double   e, x;                /* evaluation and scaling factor */
+  const ITEM *pexs;             /* perfect extension items */
   PyObject *pair;               /* pair of item set and values */
   PyObject *iset;               /* found item set (as a tuple) */
+  PyObject *pext = NULL;        /* perfect extensions (as a tuple) */
   PyObject *obj;                /* current item, to create objects */
   PyObject *vals;               /* values associated to item set */
   REPDATA  *rd = data;          /* report data structure */
@@ -344,8 +441,19 @@ static void isr_iset2PyObj (ISREPORT *rep, void *data)
     Py_INCREF(obj);             /* get the corresp. Python object */
     PyTuple_SET_ITEM(iset, k, obj);
   }                             /* store the item in the set */
+  if (isr_mode(rep) & ISR_PEXLIST) {
+    n = ((isr_mode(rep) & ISR_NOEXPAND) ? 0 : isr_pexcnt(rep));
+    pext = PyTuple_New(n);      /* create a perfect extension tuple */
+    if (!pext) { Py_DECREF(iset); rd->err = -1; return; }
+    pexs = isr_pexs(rep);       /* get the perfect extensions */
+    for (k = 0; k < n; k++) {   /* traverse the perfect extensions */
+      obj = (PyObject*)isr_itemobj(rep, pexs[n-1-k]);
+      Py_INCREF(obj);           /* get the corresp. Python object */
+      PyTuple_SET_ITEM(pext, k, obj);
+    }                           /* store the item in the tuple */
+  }                             /* (closed/maximal: already in set) */
   vals = PyTuple_New(rd->cnt);  /* create a value tuple */
-  if (!vals) { Py_DECREF(iset); rd->err = -1; return; }
+  if (!vals) { Py_DECREF(iset); Py_XDECREF(pext); rd->err = -1; return; }
   supp = isr_supp(rep);         /* get the item set support */
   base = isr_suppx(rep, 0);     /* and the total transaction weight */
   s = 0; e = 0;                 /* initialize the report variables */
@@ -362,20 +470,36 @@ static void isr_iset2PyObj (ISREPORT *rep, void *data)
     }                           /* get the requested value */
     if (x == 0) obj = PyInt_FromLong((long)s);
     else        obj = PyFloat_FromDouble(e *x);
-    if (!obj) { Py_DECREF(iset); Py_DECREF(vals); rd->err = -1; return;}
+    if (!obj) { Py_DECREF(iset); Py_XDECREF(pext); Py_DECREF(vals);
+                rd->err = -1; return; }
     PyTuple_SET_ITEM(vals, i, obj);
   }                             /* store the created value */
-  pair = PyTuple_New(2);        /* create a pair of set and values */
-  if (!pair) { Py_DECREF(iset); Py_DECREF(vals); rd->err = -1; return; }
+  pair = PyTuple_New((pext) ? 3 : 2); /* create a pair or triplet */
+  if (!pair) { Py_DECREF(iset); Py_XDECREF(pext); Py_DECREF(vals);
+               rd->err = -1; return; }
   PyTuple_SET_ITEM(pair, 0, iset);
-  PyTuple_SET_ITEM(pair, 1, vals);
+  if (pext) PyTuple_SET_ITEM(pair, 1, pext);
+  PyTuple_SET_ITEM(pair, (pext) ? 2 : 1, vals);
   if (PyList_Append(rd->res, pair) != 0)
     rd->err = -1;               /* append the pair to the result list */
   Py_DECREF(pair);              /* remove internal reference to pair */
+  if (isr_topk(rep) && (rd->err >= 0))
+    tkval(rd, (double)supp);    /* if top-k mining, note the support */
 }  /* isr_iset2PyObj() */
 
 /*--------------------------------------------------------------------*/
 
+static void isr_iset2PyMT (ISREPORT *rep, void *data)
+{                               /* --- report an item set (threads) */
+  PyGILState_STATE gil;         /* state of global interpreter lock */
+
+  gil = PyGILState_Ensure();    /* acquire the interpreter lock */
+  isr_iset2PyObj(rep, data);    /* report the item set */
+  PyGILState_Release(gil);      /* and release the lock again */
+}  /* isr_iset2PyMT() */
+
+/*--------------------------------------------------------------------*/
+
 static double lift (RSUPP supp, RSUPP body, RSUPP head, RSUPP base)
 {                               /* --- compute lift value of a rule */
   return ((body <= 0) || (head <= 0)) ? 0
@@ -454,6 +578,8 @@ static void isr_rule2PyObj (ISREPORT *rep, void *data,
   if (PyList_Append(rd->res, rule) != 0)
     rd->err = -1;               /* append the pair to the result list */
   Py_DECREF(rule);              /* remove internal reference to rule */
+  if (isr_topk(rep) && (rd->err >= 0))  /* if top-k mining, */
+    tkval(rd, isr_tkdir(rep) *isr_eval(rep)); /* note evaluation */
 }  /* isr_rule2PyObj() */
 
 /*--------------------------------------------------------------------*/
@@ -704,10 +830,18 @@ static int repinit (REPDATA *data, ISREPORT *isrep, CCHAR *report,
                     int target)
 {                               /* --- initialize reporting */
   assert(data && isrep && report); /* check the function arguments */
-  data->err = 0;                /* initialize the error indicator */
+  data->err   = 0;              /* initialize the error indicator */
+  data->mt    = 0;              /* (single-threaded reporting) */
+  data->vals  = NULL;           /* and the top-k value array */
+  data->size  = 0;
+  data->res   = NULL;
   if ((report[0] == '#')        /* if to get a pattern spectrum */
   ||  (report[0] == '='))       /* #: dictionary, =: list of triplets */
     return isr_addpsp(isrep, NULL);
+  if (report[0] == '+') {       /* if to list perfect extensions */
+    if (!(target & ISR_RULES)) isr_setpexl(isrep, 1);
+    report++;                   /* (compressed output, item sets only) */
+  }                             /* skip the flag character */
   data->cnt = (int)strlen(data->rep = report);
   data->res = PyList_New(0);    /* create an empty output list */
   if (!data->res) return -1;    /* and set the reporting function */
@@ -718,9 +852,110 @@ static int repinit (REPDATA *data, ISREPORT *isrep, CCHAR *report,
 
 /*--------------------------------------------------------------------*/
 
+static int repshard (void *data, void **shard, int op)
+{                               /* --- report data of a shard */
+  REPDATA  *rd = (REPDATA*)data;/* report data of the parent */
+  REPDATA  *sd;                 /* report data of the shard */
+  Py_ssize_t n;                 /* number of item sets in result */
+  PyGILState_STATE gil;         /* state of global interpreter lock */
+  int      r = 0;               /* error status */
+
+  assert(shard);                /* check the function arguments */
+  gil = PyGILState_Ensure();    /* acquire the interpreter lock */
+  if      (op == ISR_SPLIT) {   /* if to create shard report data */
+    sd = (REPDATA*)malloc(sizeof(REPDATA));
+    if (sd) { *sd = *rd; sd->vals = NULL; sd->size = 0;
+              sd->res = PyList_New(0); }
+    if (sd && !sd->res) { free(sd); sd = NULL; }
+    *shard = sd; r = (sd) ? 0 : -1; }
+  else if (op == ISR_JOIN) {    /* if to merge shard report data */
+    sd = (REPDATA*)*shard;      /* append the item sets of the shard */
+    n  = PyList_GET_SIZE(rd->res);  /* to the result of the parent */
+    if (PyList_SetSlice(rd->res, n, n, sd->res) != 0) r = -1;
+    n  = PyList_GET_SIZE(sd->res);  /* and clear the shard's list */
+    if (PyList_SetSlice(sd->res, 0, n, NULL)    != 0) r = -1;
+    if (sd->err < 0) { r = -1; sd->err = 0; } }
+  else {                        /* if to delete shard report data */
+    sd = (REPDATA*)*shard;      /* delete the result list */
+    Py_XDECREF(sd->res);        /* and the report data */
+    free(sd); *shard = NULL;
+  }
+  PyGILState_Release(gil);      /* release the interpreter lock */
+  return r;                     /* return the error status */
+}  /* repshard() */
+
+/* Each reporter shard collects its item sets in a list of its own, */
+/* which is appended to the result when the shard is merged. Hence  */
+/* the order of the item sets depends only on the order of merging. */
+
+/*--------------------------------------------------------------------*/
+
+static void repmt (REPDATA *data, ISREPORT *isrep)
+{                               /* --- prepare multi-threaded reporting */
+  assert(data && isrep);        /* check the function arguments */
+  data->mt = -1;                /* note multi-threaded reporting */
+  if (!data->res) return;       /* acquire the interpreter lock */
+  isr_setrepo(isrep, isr_iset2PyMT, data);
+  isr_setshard(isrep, repshard);/* for reporting an item set and */
+}  /* repmt() */                /* collect item sets per shard */
+
+/* This function must be called before the reporter is cloned into  */
+/* shards for worker threads (only item sets, no rules). The caller */
+/* has to release the global interpreter lock during the search.    */
+
+/*--------------------------------------------------------------------*/
+
+static int topkfilt (REPDATA *data, ISREPORT *isrep, CCHAR *report)
+{                               /* --- filter results of top-k mining */
+  Py_ssize_t i, k, n;           /* loop variables, number of sets */
+  ITEM       z;                 /* loop variable for sizes */
+  RSUPP      s, smin;           /* loop variable, final min. support */
+  double     min;               /* final minimum value to qualify */
+  PATSPEC    *psp;              /* pattern spectrum to filter */
+  PyObject   *res;              /* filtered result list */
+  PyObject   *obj;              /* to traverse the item sets */
+
+  assert(data && isrep && report); /* check the function arguments */
+  smin = isr_smin(isrep);       /* get the final minimum support */
+  if ((report[0] == '#') || (report[0] == '=')) {
+    psp = isr_getpsp(isrep);    /* if pattern spectrum requested */
+    for (z = psp_minsize(psp); z <= psp_max(psp); z++)
+      for (s = psp_min4sz(psp, z); (s < smin)
+      &&  (s <= psp_max4sz(psp, z)); s++)
+        psp_setfrq(psp, z, s, 0);   /* clear all signatures with */
+    return 0;                   /* a support less than the final */
+  }                             /* minimum support of top-k mining */
+  min = (isr_tkdir(isrep)) ? isr_tkeval(isrep) : (double)smin;
+  n   = PyList_GET_SIZE(data->res);
+  for (i = k = 0; i < n; i++)   /* count the qualifying sets/rules */
+    if (data->vals[i] >= min) k++;
+  if (k >= n) return 0;         /* check whether sets were dropped */
+  res = PyList_New(k);          /* create a new result list */
+  if (!res) return data->err = -1;
+  for (i = k = 0; i < n; i++) { /* traverse the reported sets/rules */
+    if (data->vals[i] < min) continue;
+    obj = PyList_GET_ITEM(data->res, i);
+    Py_INCREF(obj); PyList_SET_ITEM(res, k++, obj);
+  }                             /* collect the qualifying item sets */
+  Py_DECREF(data->res);         /* replace the result list */
+  data->res = res;              /* by the filtered list */
+  return 0;                     /* return 'ok' */
+}  /* topkfilt() */
+
+/* The item set reporter raises the minimum support during top-k   */
+/* mining, but item sets reported before the minimum support was   */
+/* raised to its final value have to be removed from the result.   */
+/* For rules the same holds for the (directed) rule evaluation.    */
+
+/*--------------------------------------------------------------------*/
+
 static int repterm (REPDATA *data, ISREPORT *isrep, CCHAR *report)
 {                               /* --- terminate reporting */
   assert(data && isrep && report); /* check the function arguments */
+  if (isr_topk(isrep)) {        /* if top-k mining was carried out, */
+    if (data->err >= 0) topkfilt(data, isrep, report);
+    if (data->vals) { free(data->vals); data->vals = NULL; }
+  }                             /* filter the reported item sets */
   if ((report[0] == '#')        /* if to get a pattern spectrum */
   ||  (report[0] == '=')) {     /* #: dictionary, =: list of triplets */
     data->res = psp_toPyObj(isr_getpsp(isrep), 1.0, report[0]);
@@ -729,9 +964,185 @@ static int repterm (REPDATA *data, ISREPORT *isrep, CCHAR *report)
   return data->err;             /* return the error status */
 }  /* repterm() */
 
+/*--------------------------------------------------------------------*/
+
+static int progress (ISREPORT *isrep, void *data)
+{                               /* --- progress/cancellation function */
+  REPDATA  *rd = (REPDATA*)data;/* report data with progress function */
+  PyObject *res;                /* result of progress function */
+  PyGILState_STATE gil = PyGILState_UNLOCKED;
+  double   t;                   /* current time */
+  int      r;                   /* truth value of result */
+
+  assert(isrep && data);        /* check the function arguments */
+  if (aborted) return -1;       /* check for an abort interrupt */
+  if (!rd->prog) return 0;      /* check for a progress function */
+  if (rd->mt) gil = PyGILState_Ensure();
+  t = wallclk();                /* check the time since the last call */
+  if (t -rd->last < PROG_TIME){ /* (under the interpreter lock, */
+    if (rd->mt) PyGILState_Release(gil);  /* as the time of the last */
+    return 0;                   /* call is shared by all threads) */
+  }
+  rd->last = t;                 /* note the time of this call */
+  res = PyObject_CallFunction(rd->prog, "nnn",
+          (Py_ssize_t)isr_nodes(isrep), (Py_ssize_t)isr_repcnt(isrep),
+          (Py_ssize_t)ms_total());
+  r = (res) ? PyObject_IsTrue(res) : -1;
+  Py_XDECREF(res);              /* call the progress function with */
+  if (rd->mt) PyGILState_Release(gil);   /* the search counters */
+  return (r != 0) ? -1 : 0;     /* and check whether to cancel */
+}  /* progress() */
+
+/* The search functions poll this function every PROG_IVAL search  */
+/* nodes (IsTa: every transaction), which suffices to react quickly */
+/* to an abort interrupt. The Python progress function, however,   */
+/* is called at most every PROG_TIME seconds (wall clock time), so  */
+/* that its costs remain negligible.                                */
+
+/*--------------------------------------------------------------------*/
+
+static void runinit (REPDATA *data, ISREPORT *isrep,
+                     long maxres, long maxmem, PyObject *prog)
+{                               /* --- prepare a mining run */
+  assert(data && isrep);        /* check the function arguments */
+  isr_setmax(isrep, (size_t)maxres);
+  ms_limit((size_t)maxmem);     /* set the limits (0: no limit) */
+  data->prog = prog;            /* note the progress function */
+  data->last = wallclk();       /* and the start time */
+  isr_setprog(isrep, progress, data, PROG_IVAL);
+  siginstall();                 /* install the signal handler */
+}  /* runinit() */
+
+/*--------------------------------------------------------------------*/
+
+static int runterm (REPDATA *data, ISREPORT *isrep, int lim, int r)
+{                               /* --- terminate a mining run */
+  int over;                     /* whether memory limit was exceeded */
+
+  assert(data && isrep);        /* check the function arguments */
+  over = ms_over();             /* note whether the memory limit */
+  ms_limit(0);                  /* was exceeded and remove it */
+  sigremove();                  /* remove the signal handler */
+  if ((r >= 0) || (lim < LIM_OK)) return lim;
+  if (aborted || PyErr_Occurred()) return lim;
+  if (isr_stopped(isrep)) return LIM_CANCEL;
+  if (over)               return LIM_MEMORY;
+  if (isr_atmax(isrep))   return LIM_RESULTS;
+  return lim;                   /* determine the limit that was hit */
+}  /* runterm() */
+
+/* If mining failed, but a limit was reached or the search was      */
+/* cancelled by the progress function, the failure is not an error: */
+/* the mining was merely stopped and the results reported so far    */
+/* are kept. An abort interrupt or an exception raised in a Python  */
+/* function, however, is passed on to the caller (see runerr()).    */
+
+/*--------------------------------------------------------------------*/
+
+static PyObject* runerr (void)
+{                               /* --- report an error of a run */
+  if (aborted) {                /* if an abort interrupt was received */
+    aborted = 0; PyErr_SetNone(PyExc_KeyboardInterrupt); }
+  else if (!PyErr_Occurred())   /* if no exception is pending, */
+    PyErr_SetString(PyExc_MemoryError, "");  /* it is a memory error */
+  return NULL;                  /* return 'failure' */
+}  /* runerr() */
+
+/*--------------------------------------------------------------------*/
+
+static double estcnt (PyObject *tracts, RSUPP smin, ITEM zmin,
+                      ITEM zmax)
+{                               /* --- estimate number of patterns */
+  TABAG   *tabag;               /* transaction bag to analyze */
+  PATSPEC *psp;                 /* estimated pattern spectrum */
+  size_t  smpls;                /* number of samples per set size */
+  double  t;                    /* timer for the time budget */
+  double  cnt = -1;             /* estimated number of patterns */
+
+  assert(tracts);               /* check the function argument */
+  tabag = tbg_fromPyObj(tracts);/* turn the given transactions */
+  if (!tabag) { PyErr_Clear(); return -1; }
+  if (tbg_recode(tabag, (SUPP)smin, -1, -1, -2) < 0) {
+    tbg_delete(tabag, 1); return -1; }
+  if (zmin < 1) zmin = 1;       /* recode and filter the items */
+  tbg_filter(tabag, zmin, NULL, 0);
+  if ((tbg_itemcnt(tabag) <= 0) || (tbg_cnt(tabag) <= 0)) {
+    tbg_delete(tabag, 1); return 0; }
+  t = wallclk();                /* start the timer */
+  for (smpls = EST_SMPLS; smpls <= EST_SMAX; smpls += smpls) {
+    psp = psp_create(zmin, zmax, (SUPP)smin, tbg_cnt(tabag));
+    if (!psp) break;            /* create a pattern spectrum */
+    if (psp_tbgest(tabag, psp, EST_EQUIV, 0.5, smpls) != 0) {
+      psp_delete(psp); break; } /* estimate the pattern spectrum */
+    cnt = (double)psp_total(psp) /EST_EQUIV;
+    psp_delete(psp);            /* get the number of patterns */
+    if (wallclk() -t > EST_TIME /3) break;
+  }                             /* stop if the time budget is spent */
+  tbg_delete(tabag, 1);         /* delete the transaction bag */
+  return cnt;                   /* return the estimated count */
+}  /* estcnt() */
+
+/* The estimate is computed for independent items (as for surrogate */
+/* data), with the number of samples doubled in each run. Since the */
+/* next run takes about twice as long, the estimation is stopped as */
+/* soon as a third of the time budget has been used.                */
+
+/*--------------------------------------------------------------------*/
+
+static int setval (PyObject *dict, const char *key, PyObject *obj)
+{                               /* --- set a dictionary value */
+  int r;                        /* result of function call */
+  if (!obj) return -1;          /* check the value to store */
+  r = PyDict_SetItemString(dict, key, obj);
+  Py_DECREF(obj);               /* store the value in the dictionary */
+  return r;                     /* (the dictionary holds a reference) */
+}  /* setval() */
+
+/*--------------------------------------------------------------------*/
+
+static PyObject* limres (PyObject *res, ISREPORT *isrep, int lim,
+                         CCHAR *report, PyObject *tracts)
+{                               /* --- add the limit status */
+  static const char *names[] = { "ok", "max_results", "max_memory",
+                                 "cancelled" };
+  PyObject *stat;               /* status dictionary */
+  PyObject *obj;                /* created result tuple */
+  size_t   cnt;                 /* number of reported patterns */
+  double   est;                 /* estimated number of patterns */
+
+  if (!res || (lim < LIM_OK))   /* if no limits/progress fn. given, */
+    return res;                 /* return the plain result */
+  cnt  = (isrep) ? isr_repcnt(isrep) : 0;
+  stat = PyDict_New();          /* create a status dictionary */
+  if (!stat
+  ||  (setval(stat, "status", PyString_FromString(names[lim])) != 0)
+  ||  (setval(stat, "count",  PyLong_FromSize_t(cnt))          != 0)) {
+    Py_XDECREF(stat); Py_DECREF(res); return NULL; }
+  if ((lim > LIM_OK) && isrep && tracts
+  &&  ((report[0] == '#') || (report[0] == '='))) {
+    est = estcnt(tracts, isr_smin(isrep),
+                 isr_zmin(isrep), isr_zmax(isrep));
+    if (est >= 0) {             /* estimate the number of patterns */
+      if (est < (double)cnt) est = (double)cnt;
+      if (setval(stat, "estimate", PyFloat_FromDouble(est)) != 0) {
+        Py_DECREF(stat); Py_DECREF(res); return NULL; }
+    }                           /* store the estimated number */
+  }                             /* if mining was stopped early */
+  obj = PyTuple_Pack(2, res, stat);
+  Py_DECREF(res); Py_DECREF(stat);
+  return obj;                   /* return result and status */
+}  /* limres() */
+
+/* If limits or a progress function were given, the result is      */
+/* together with a status dictionary, which states whether a limit  */
+/* was reached and how many patterns were reported. If the mining   */
+/* was stopped early and a pattern spectrum was requested, it also  */
+/* contains an estimate of the total number of patterns.            */
+
 /*--------------------------------------------------------------------*/
 /* fim (tracts, target='s', supp=10, zmin=1, zmax=None,               */
-/*      report='a', eval='x', agg='x', thresh=10, border=None)        */
+/*      report='a', eval='x', agg='x', thresh=10, border=None,        */
+/*      max_results=0, max_memory=0, progress=None)                   */
 /*--------------------------------------------------------------------*/
 
 static PyObject* py_fim (PyObject *self,
@@ -739,7 +1150,7 @@ static PyObject* py_fim (PyObject *self,
 {                               /* --- frequent item set mining */
   char     *ckwds[] = { "tracts", "target", "supp", "zmin", "zmax",
                         "report", "eval", "agg", "thresh", "border",
-                         NULL };
+                        "max_results", "max_memory", "progress", NULL };
   CCHAR    *starg  = "s";       /* target type as a string */
   int      target  = ISR_SETS;  /* target type */
   double   supp    = 10;        /* minimum support of an item set */
@@ -756,6 +1167,10 @@ static PyObject* py_fim (PyObject *self,
   int      mode    = FPG_DEFAULT|FPG_FIM16; /* operation mode/flags */
   long     prune   = LONG_MIN;  /* min. size for evaluation filtering */
   PyObject *border = NULL;      /* support border for filtering */
+  long     maxres  =  0;        /* maximum number of results */
+  long     maxmem  =  0;        /* maximum memory of MEMSYS blocks */
+  PyObject *prog   = NULL;      /* progress function */
+  int      lim;                 /* status of the limits */
   PyObject *tracts;             /* transaction database */
   TABAG    *tabag;              /* transaction bag */
   ISREPORT *isrep;              /* item set reporter */
@@ -764,10 +1179,17 @@ static PyObject* py_fim (PyObject *self,
   int      r;                   /* result buffer */
 
   /* --- evaluate the function arguments --- */
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|sdllsssdO", ckwds,
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|sdllsssdOllO", ckwds,
         &tracts, &starg, &supp, &zmin, &zmax, &report,
-        &seval, &sagg, &thresh, &border))
+        &seval, &sagg, &thresh, &border,
+        &maxres, &maxmem, &prog))
     return NULL;                /* parse the function arguments */
+  if ((maxres < 0) || (maxmem < 0)) {
+    ERR_VALUE("limits must not be negative"); }
+  if (prog == Py_None) prog = NULL;
+  if (prog && !PyCallable_Check(prog)) {
+    ERR_TYPE("progress must be callable"); }
+  lim = ((maxres > 0) || (maxmem > 0) || prog) ? LIM_OK : LIM_NONE;
   target = get_target(starg, "ascmg");
   if (target < 0) return NULL;  /* translate the target string */
   if (zmin   < 0)    { ERR_VALUE("zmin must not be negative"); }
@@ -789,7 +1211,7 @@ static PyObject* py_fim (PyObject *self,
   r = fpg_data(tabag, target, smin, (ITEM)zmin, eval, algo, mode, 2);
   if (r) tbg_delete(tabag, 1);  /* prepare data for FP-growth */
   if (r == -1) { ERR_MEM(); }   /* check for error and no items */
-  if (r <   0) return PyList_New(0);
+  if (r <   0) return limres(PyList_New(0), NULL, lim, report, NULL);
 
   /* --- create item set reporter --- */
   isrep = isr_create(tbg_base(tabag)); /* create item set reporter */
@@ -797,7 +1219,7 @@ static PyObject* py_fim (PyObject *self,
   isr_setsize(isrep, (zmin > ITEM_MAX) ? ITEM_MAX : (ITEM)zmin,
                      (zmax > ITEM_MAX) ? ITEM_MAX : (ITEM)zmax);
   isr_setsupp(isrep, (RSUPP)smin, RSUPP_MAX);
-  if (border && !isr_pyborder(isrep, border)) {
+  if (border && !isr_pyborder(isrep, border, report)) {
     isr_delete(isrep, 0); tbg_delete(tabag, 1); return NULL; }
   if ((repinit(&data, isrep, report, ISR_SETS) != 0)
   ||  (fpg_repo(isrep, target, eval, thresh, algo, mode) < 0)
@@ -805,29 +1227,38 @@ static PyObject* py_fim (PyObject *self,
     isr_delete(isrep, 0); tbg_delete(tabag, 1); ERR_MEM(); }
 
   /* --- frequent item set mining --- */
+  runinit(&data, isrep, maxres, maxmem, prog);
   r = fpgrowth(tabag, target, smin, smin, 1, eval, agg, thresh,
               (prune < ITEM_MIN) ? ITEM_MIN :
               (prune > ITEM_MAX) ? ITEM_MAX : (ITEM)prune,
                algo, mode, 0, isrep);
+  lim = runterm(&data, isrep, lim, r);
+  if (lim > LIM_OK) r = 0;      /* (keep partial results) */
   if (r >= 0) r = repterm(&data, isrep, report);
+  if (r >= 0) {                 /* if limits were given, */
+    data.res = limres(data.res, isrep, lim, report, tracts);
+    if (!data.res) r = -1;      /* add a status dictionary */
+  }
 
   /* --- clean up --- */
   isr_delete(isrep, 0);         /* delete the item set reporter */
   tbg_delete(tabag, 1);         /* and the transaction bag */
-  if (r < 0) { Py_DECREF(data.res); ERR_MEM(); }
+  if (r < 0) { Py_XDECREF(data.res); return runerr(); }
   return data.res;              /* return the created result */
 }  /* py_fim() */
 
 /*--------------------------------------------------------------------*/
 /* arules (tracts, supp=10, conf=80, zmin=1, zmax=None, report='aC',  */
-/*         eval='x', thresh=10, mode='')                              */
+/*         eval='x', thresh=10, mode='', topk=0,                      */
+/*         max_results=0, max_memory=0, progress=None)                */
 /*--------------------------------------------------------------------*/
 
 static PyObject* py_arules (PyObject *self,
                             PyObject *args, PyObject *kwds)
 {                               /* --- association rule mining */
   char     *ckwds[] = { "tracts", "supp", "conf", "zmin", "zmax",
-                        "report", "eval", "thresh", "mode", NULL };
+                        "report", "eval", "thresh", "mode", "topk",
+                        "max_results", "max_memory", "progress", NULL };
   double   supp    = 10;        /* minimum support    of a rule */
   SUPP     smin    =  1;        /* minimum support of an item set */
   SUPP     body    =  1;        /* minimum support of a rule body */
@@ -841,6 +1272,11 @@ static PyObject* py_arules (PyObject *self,
   int      algo    = FPG_SINGLE;/* algorithm variant */
   CCHAR    *smode  = "";        /* operation mode/flags as a string */
   int      mode    = FPG_DEFAULT|FPG_FIM16; /* operation mode/flags */
+  long     topk    =  0;        /* number of rules to find */
+  long     maxres  =  0;        /* maximum number of results */
+  long     maxmem  =  0;        /* maximum memory of MEMSYS blocks */
+  PyObject *prog   = NULL;      /* progress function */
+  int      lim;                 /* status of the limits */
   PyObject *tracts;             /* transaction database */
   TABAG    *tabag;              /* transaction bag */
   ISREPORT *isrep;              /* item set reporter */
@@ -849,16 +1285,30 @@ static PyObject* py_arules (PyObject *self,
   int      r;                   /* result buffer */
 
   /* --- evaluate the function arguments --- */
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|ddllssds", ckwds,
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|ddllssdslllO", ckwds,
         &tracts, &supp, &conf, &zmin, &zmax, &report,
-        &seval, &thresh, &smode))
+        &seval, &thresh, &smode, &topk,
+        &maxres, &maxmem, &prog))
     return NULL;                /* parse the function arguments */
+  if ((maxres < 0) || (maxmem < 0)) {
+    ERR_VALUE("limits must not be negative"); }
+  if (prog == Py_None) prog = NULL;
+  if (prog && !PyCallable_Check(prog)) {
+    ERR_TYPE("progress must be callable"); }
+  lim = ((maxres > 0) || (maxmem > 0) || prog) ? LIM_OK : LIM_NONE;
   if ((conf < 0) || (conf > 100)) { ERR_VALUE("invalid confidence"); }
   if (zmin < 0)    { ERR_VALUE("zmin must not be negative"); }
   if (zmax < 0)    zmax = LONG_MAX; /* check size range */
   if (zmax < zmin) { ERR_VALUE("zmax must not be less than zmin"); }
   eval = get_evalx(seval);      /* get evaluation measure and */
   if (eval < 0) return NULL;    /* check whether it is valid */
+  if (topk < 0)    { ERR_VALUE("topk must not be negative"); }
+  if (topk > 0) {               /* if to find the top-k rules */
+    if ((report[0] == '#') || (report[0] == '=')) {
+      ERR_VALUE("no pattern spectrum for top-k rule mining"); }
+    if (eval <= RE_NONE) eval = RE_CONF;
+    if (eval >= RE_FNCNT) { ERR_VALUE("invalid top-k rule measure"); }
+  }                             /* rank by confidence by default */
   thresh *= 0.01;               /* scale evaluation threshold */
 
   /* --- create transaction bag --- */
@@ -873,7 +1323,7 @@ static PyObject* py_arules (PyObject *self,
   r = fpg_data(tabag, ISR_RULES, smin, (ITEM)zmin, eval, algo, mode, 2);
   if (r) tbg_delete(tabag, 1);  /* prepare data for FP-growth */
   if (r == -1) { ERR_MEM(); }   /* check for error and no items */
-  if (r <   0) return PyList_New(0);
+  if (r <   0) return limres(PyList_New(0), NULL, lim, report, NULL);
 
   /* --- create item set reporter --- */
   isrep = isr_create(tbg_base(tabag)); /* create item set reporter */
@@ -881,27 +1331,36 @@ static PyObject* py_arules (PyObject *self,
   isr_setsize(isrep, (zmin > ITEM_MAX) ? ITEM_MAX : (ITEM)zmin,
                      (zmax > ITEM_MAX) ? ITEM_MAX : (ITEM)zmax);
   isr_setsupp(isrep, (RSUPP)smin, RSUPP_MAX);
-  if ((repinit(&data, isrep, report, ISR_RULES) != 0)
+  if ((isr_settopkr(isrep, (size_t)topk, re_dir(eval)) != 0)
+  ||  (repinit(&data, isrep, report, ISR_RULES) != 0)
   ||  (fpg_repo(isrep, ISR_RULES, eval, thresh, algo, mode) < 0)
   ||  (isr_setup(isrep) < 0)) { /* set up the item set reporter */
     isr_delete(isrep, 0); tbg_delete(tabag, 1); ERR_MEM(); }
 
   /* --- association rule mining --- */
+  runinit(&data, isrep, maxres, maxmem, prog);
   r = fpgrowth(tabag, ISR_RULES, smin, body, conf,
                eval, FPG_NONE, thresh, 0, algo, mode, 0, isrep);
+  lim = runterm(&data, isrep, lim, r);
+  if (lim > LIM_OK) r = 0;      /* (keep partial results) */
   if (r >= 0) r = repterm(&data, isrep, report);
+  if (r >= 0) {                 /* if limits were given, */
+    data.res = limres(data.res, isrep, lim, report, tracts);
+    if (!data.res) r = -1;      /* add a status dictionary */
+  }
 
   /* --- clean up --- */
   isr_delete(isrep, 0);         /* delete the item set reporter */
   tbg_delete(tabag, 1);         /* and the transaction bag */
-  if (r < 0) { Py_DECREF(data.res); ERR_MEM(); }
+  if (r < 0) { Py_XDECREF(data.res); return runerr(); }
   return data.res;              /* return the created result */
 }  /* py_arules() */
 
 /*--------------------------------------------------------------------*/
 /* apriori (tracts, target='s', supp=10, conf=80, zmin=1, zmax=None,  */
 /*          report='a', eval='x', agg='x', thresh=10, prune=None,     */
-/*          algo='', mode='', border=None)                            */
+/*          algo='', mode='', border=None, cpus=1,                    */
+/*          max_results=0, max_memory=0, progress=None)               */
 /*--------------------------------------------------------------------*/
 
 static PyObject* py_apriori (PyObject *self,
@@ -910,7 +1369,8 @@ static PyObject* py_apriori (PyObject *self,
   char     *ckwds[] = { "tracts", "target", "supp", "conf",
                         "zmin", "zmax", "report",
                         "eval", "agg", "thresh", "prune",
-                        "algo", "mode", "border", "conf", NULL };
+                        "algo", "mode", "border", "cpus",
+                        "max_results", "max_memory", "progress", NULL };
   CCHAR    *starg  = "s";       /* target type as a string */
   int      target  = ISR_SETS;  /* target type */
   double   supp    = 10;        /* minimum support of an item set */
@@ -931,6 +1391,11 @@ static PyObject* py_apriori (PyObject *self,
   int      mode    = APR_DEFAULT;  /* operation mode/flags */
   long     prune   = LONG_MIN;  /* min. size for evaluation filtering */
   PyObject *border = NULL;      /* support border for filtering */
+  int      cpus    =  1;        /* number of threads for counting */
+  long     maxres  =  0;        /* maximum number of results */
+  long     maxmem  =  0;        /* maximum memory of MEMSYS blocks */
+  PyObject *prog   = NULL;      /* progress function */
+  int      lim;                 /* status of the limits */
   PyObject *tracts;             /* transaction database */
   TABAG    *tabag;              /* transaction bag */
   ISREPORT *isrep;              /* item set reporter */
@@ -939,10 +1404,17 @@ static PyObject* py_apriori (PyObject *self,
   int      r;                   /* result of function call */
 
   /* --- evaluate the function arguments --- */
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|sddllsssdlssO", ckwds,
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|sddllsssdlssOillO", ckwds,
         &tracts, &starg, &supp, &conf, &zmin, &zmax, &report,
-        &seval, &sagg, &thresh, &prune, &salgo, &smode, &border))
+        &seval, &sagg, &thresh, &prune, &salgo, &smode, &border, &cpus,
+        &maxres, &maxmem, &prog))
     return NULL;                /* parse the function arguments */
+  if ((maxres < 0) || (maxmem < 0)) {
+    ERR_VALUE("limits must not be negative"); }
+  if (prog == Py_None) prog = NULL;
+  if (prog && !PyCallable_Check(prog)) {
+    ERR_TYPE("progress must be callable"); }
+  lim = ((maxres > 0) || (maxmem > 0) || prog) ? LIM_OK : LIM_NONE;
   target = get_target(starg, "ascmgr");
   if (target < 0) return NULL;  /* translate the target string */
   if (zmin   < 0)    { ERR_VALUE("zmin must not be negative"); }
@@ -972,7 +1444,10 @@ static PyObject* py_apriori (PyObject *self,
     else if (*s == 't') mode &= ~APR_TATREE;
     else if (*s == 'T') mode &= ~APR_TATREE;
     else if (*s == 'y') mode |=  APR_POST;
+    else if (*s == 'M') mode &= ~APR_PAIRS;
   }                             /* adapt the operation mode */
+  if (cpus <= 0) cpus = cpucnt();  /* get the number of threads */
+  if (cpus >  1) mode |= (cpus < APR_CPUS) ? cpus : APR_CPUS;
 
   /* --- create transaction bag --- */
   tabag = tbg_fromPyObj(tracts);/* turn the given transactions */
@@ -986,7 +1461,7 @@ static PyObject* py_apriori (PyObject *self,
   r = apriori_data(tabag, target, smin, (ITEM)zmin, eval, algo, mode,2);
   if (r) tbg_delete(tabag, 1);  /* prepare data for Apriori */
   if (r == -1) { ERR_MEM(); }   /* check for error and no items */
-  if (r <   0) return PyList_New(0);
+  if (r <   0) return limres(PyList_New(0), NULL, lim, report, NULL);
 
   /* --- create item set reporter --- */
   isrep = isr_create(tbg_base(tabag)); /* create item set reporter */
@@ -994,7 +1469,7 @@ static PyObject* py_apriori (PyObject *self,
   isr_setsize(isrep, (zmin > ITEM_MAX) ? ITEM_MAX : (ITEM)zmin,
                      (zmax > ITEM_MAX) ? ITEM_MAX : (ITEM)zmax);
   isr_setsupp(isrep, (RSUPP)smin, RSUPP_MAX);
-  if (border && !isr_pyborder(isrep, border)) {
+  if (border && !isr_pyborder(isrep, border, report)) {
     isr_delete(isrep, 0); tbg_delete(tabag, 1); return NULL; }
   if ((repinit(&data, isrep, report, target) != 0)
   ||  (apriori_repo(isrep, target, eval, thresh, algo, mode) < 0)
@@ -1002,23 +1477,31 @@ static PyObject* py_apriori (PyObject *self,
     isr_delete(isrep, 0); tbg_delete(tabag, 1); ERR_MEM(); }
 
   /* --- frequent item set mining --- */
+  runinit(&data, isrep, maxres, maxmem, prog);
   r = apriori(tabag, target, smin, body, conf, eval, agg, thresh,
               (prune < ITEM_MIN) ? ITEM_MIN :
               (prune > ITEM_MAX) ? ITEM_MAX : (ITEM)prune,
               algo, mode, 0.01, 0, isrep);
+  lim = runterm(&data, isrep, lim, r);
+  if (lim > LIM_OK) r = 0;      /* (keep partial results) */
   if (r >= 0) r = repterm(&data, isrep, report);
+  if (r >= 0) {                 /* if limits were given, */
+    data.res = limres(data.res, isrep, lim, report, tracts);
+    if (!data.res) r = -1;      /* add a status dictionary */
+  }
 
   /* --- clean up --- */
   isr_delete(isrep, 0);         /* delete the item set reporter */
   tbg_delete(tabag, 1);         /* and the transaction bag */
-  if (r < 0) { Py_DECREF(data.res); ERR_MEM(); }
+  if (r < 0) { Py_XDECREF(data.res); return runerr(); }
   return data.res;              /* return the created result */
 }  /* py_apriori() */
 
 /*--------------------------------------------------------------------*/
 /* eclat (tracts, target='s', supp=10, conf=80, zmin=1, zmax=None,    */
 /*        report='a', eval='x', agg='x', thresh=10, prune=None,       */
-/*        algo='a', mode='', border=None)                             */
+/*        algo='a', mode='', border=None, topk=0,                     */
+/*        max_results=0, max_memory=0, progress=None)                 */
 /*--------------------------------------------------------------------*/
 
 static PyObject* py_eclat (PyObject *self,
@@ -1027,7 +1510,8 @@ static PyObject* py_eclat (PyObject *self,
   char     *ckwds[] = { "tracts", "target", "supp", "conf",
                         "zmin", "zmax", "report",
                         "eval", "agg", "thresh", "prune",
-                        "algo", "mode", "border", NULL };
+                        "algo", "mode", "border", "topk",
+                        "max_results", "max_memory", "progress", NULL };
   CCHAR    *starg  = "s";       /* target type as a string */
   int      target  = ISR_SETS;  /* target type */
   double   supp    = 10;        /* minimum support of an item set */
@@ -1048,6 +1532,11 @@ static PyObject* py_eclat (PyObject *self,
   int      mode    = ECL_DEFAULT|ECL_FIM16; /* operation mode/flags */
   long     prune   = LONG_MIN;  /* min. size for evaluation filtering */
   PyObject *border = NULL;      /* support border for filtering */
+  long     topk    =  0;        /* number of item sets to find */
+  long     maxres  =  0;        /* maximum number of results */
+  long     maxmem  =  0;        /* maximum memory of MEMSYS blocks */
+  PyObject *prog   = NULL;      /* progress function */
+  int      lim;                 /* status of the limits */
   PyObject *tracts;             /* transaction database */
   TABAG    *tabag;              /* transaction bag */
   ISREPORT *isrep;              /* item set reporter */
@@ -1057,12 +1546,22 @@ static PyObject* py_eclat (PyObject *self,
   int      r;                   /* result buffer */
 
   /* --- evaluate the function arguments --- */
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|sddllsssdlssO", ckwds,
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|sddllsssdlssOlllO", ckwds,
         &tracts, &starg, &supp, &conf, &zmin, &zmax, &report,
-        &seval, &sagg, &thresh, &prune, &salgo, &smode, &border))
+        &seval, &sagg, &thresh, &prune, &salgo, &smode, &border, &topk,
+        &maxres, &maxmem, &prog))
     return NULL;                /* parse the function arguments */
+  if ((maxres < 0) || (maxmem < 0)) {
+    ERR_VALUE("limits must not be negative"); }
+  if (prog == Py_None) prog = NULL;
+  if (prog && !PyCallable_Check(prog)) {
+    ERR_TYPE("progress must be callable"); }
+  lim = ((maxres > 0) || (maxmem > 0) || prog) ? LIM_OK : LIM_NONE;
   target = get_target(starg, "ascmgr");
   if (target < 0) return NULL;  /* translate the target string */
+  if (topk   < 0)    { ERR_VALUE("topk must not be negative"); }
+  if ((topk  > 0) && (target & ~ISR_CLOSED)) {
+    ERR_VALUE("top-k mining only for frequent and closed item sets"); }
   if (zmin   < 0)    { ERR_VALUE("zmin must not be negative"); }
   if (zmax   < 0)    zmax = ITEM_MAX; /* check size range */
   if (zmax   < zmin) { ERR_VALUE("zmax must not be less than zmin"); }
@@ -1107,6 +1606,7 @@ static PyObject* py_eclat (PyObject *self,
     else if (*s == 'u') mode &= ~ECL_TAIL;
     else if (*s == 'y') mode |=  ECL_HORZ;
     else if (*s == 'Y') mode |=  ECL_VERT;
+    else if (*s == 'h') mode |=  ECL_HASHCM;
   }                             /* adapt the operation mode */
 
   /* --- create transaction bag --- */
@@ -1127,7 +1627,7 @@ static PyObject* py_eclat (PyObject *self,
   r = eclat_data(tabag, target, smin, (ITEM)zmin, eval, algo, mode, 2);
   if (r) tbg_delete(tabag, 1);  /* prepare data for Eclat */
   if (r == -1) { ERR_MEM(); }   /* check for error and no items */
-  if (r <   0) return PyList_New(0);
+  if (r <   0) return limres(PyList_New(0), NULL, lim, report, NULL);
 
   /* --- create item set reporter --- */
   isrep = isr_create(tbg_base(tabag)); /* create item set reporter */
@@ -1135,31 +1635,40 @@ static PyObject* py_eclat (PyObject *self,
   isr_setsize(isrep, (zmin > ITEM_MAX) ? ITEM_MAX : (ITEM)zmin,
                      (zmax > ITEM_MAX) ? ITEM_MAX : (ITEM)zmax);
   isr_setsupp(isrep, (RSUPP)smin, RSUPP_MAX);
-  if (border && !isr_pyborder(isrep, border)) {
+  if (border && !isr_pyborder(isrep, border, report)) {
     isr_delete(isrep, 0); tbg_delete(tabag, 1); return NULL; }
-  if ((repinit(&data, isrep, report, target) != 0)
+  if ((isr_settopk(isrep, (size_t)topk) != 0)
+  ||  (repinit(&data, isrep, report, target) != 0)
   ||  (eclat_repo(isrep, target, eval, thresh, algo, mode) < 0)
   ||  (isr_setup(isrep) < 0)) { /* set up the item set reporter */
     isr_delete(isrep, 0); tbg_delete(tabag, 1); ERR_MEM(); }
 
   /* --- frequent item set mining --- */
+  runinit(&data, isrep, maxres, maxmem, prog);
   r = eclat(tabag, target, smin, body, conf, eval, agg, thresh,
             (prune < ITEM_MIN) ? ITEM_MIN :
             (prune > ITEM_MAX) ? ITEM_MAX : (ITEM)prune,
             algo, mode, 0, isrep);
+  lim = runterm(&data, isrep, lim, r);
+  if (lim > LIM_OK) r = 0;      /* (keep partial results) */
   if (r >= 0) r = repterm(&data, isrep, report);
+  if (r >= 0) {                 /* if limits were given, */
+    data.res = limres(data.res, isrep, lim, report, tracts);
+    if (!data.res) r = -1;      /* add a status dictionary */
+  }
 
   /* --- clean up --- */
   isr_delete(isrep, 0);         /* delete the item set reporter */
   tbg_delete(tabag, 1);         /* and the transaction bag */
-  if (r < 0) { Py_DECREF(data.res); ERR_MEM(); }
+  if (r < 0) { Py_XDECREF(data.res); return runerr(); }
   return data.res;              /* return the created result */
 }  /* py_eclat() */
 
 /*--------------------------------------------------------------------*/
 /* fpgrowth (tracts, target='s', supp=10, conf=80, zmin=1, zmax=None, */
 /*           report='a', eval='x', agg='x', thresh=10, prune=None,    */
-/*           algo='s', mode='', border=None)                          */
+/*           algo='s', mode='', border=None, topk=0,                  */
+/*           max_results=0, max_memory=0, progress=None)              */
 /*--------------------------------------------------------------------*/
 
 static PyObject* py_fpgrowth (PyObject *self,
@@ -1168,7 +1677,8 @@ static PyObject* py_fpgrowth (PyObject *self,
   char     *ckwds[] = { "tracts", "target", "supp", "conf",
                         "zmin", "zmax", "report",
                         "eval", "agg", "thresh", "prune",
-                        "algo", "mode", "border", NULL };
+                        "algo", "mode", "border", "topk",
+                        "max_results", "max_memory", "progress", NULL };
   CCHAR    *starg  = "s";       /* target type as a string */
   int      target  = ISR_SETS;  /* target type */
   double   supp    = 10;        /* minimum support of an item set */
@@ -1189,6 +1699,11 @@ static PyObject* py_fpgrowth (PyObject *self,
   int      mode    = FPG_DEFAULT|FPG_FIM16; /* operation mode/flags */
   long     prune   = LONG_MIN;  /* min. size for evaluation filtering */
   PyObject *border = NULL;      /* support border for filtering */
+  long     topk    =  0;        /* number of item sets to find */
+  long     maxres  =  0;        /* maximum number of results */
+  long     maxmem  =  0;        /* maximum memory of MEMSYS blocks */
+  PyObject *prog   = NULL;      /* progress function */
+  int      lim;                 /* status of the limits */
   PyObject *tracts;             /* transaction database */
   TABAG    *tabag;              /* transaction bag */
   ISREPORT *isrep;              /* item set reporter */
@@ -1197,12 +1712,22 @@ static PyObject* py_fpgrowth (PyObject *self,
   int      r;                   /* result buffer */
 
   /* --- evaluate the function arguments --- */
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|sddllsssdlssO", ckwds,
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|sddllsssdlssOlllO", ckwds,
         &tracts, &starg, &supp, &conf, &zmin, &zmax, &report,
-        &seval, &sagg, &thresh, &prune, &salgo, &smode, &border))
+        &seval, &sagg, &thresh, &prune, &salgo, &smode, &border, &topk,
+        &maxres, &maxmem, &prog))
     return NULL;                /* parse the function arguments */
+  if ((maxres < 0) || (maxmem < 0)) {
+    ERR_VALUE("limits must not be negative"); }
+  if (prog == Py_None) prog = NULL;
+  if (prog && !PyCallable_Check(prog)) {
+    ERR_TYPE("progress must be callable"); }
+  lim = ((maxres > 0) || (maxmem > 0) || prog) ? LIM_OK : LIM_NONE;
   target = get_target(starg, "ascmgr");
   if (target < 0) return NULL;  /* translate the target string */
+  if (topk   < 0)    { ERR_VALUE("topk must not be negative"); }
+  if ((topk  > 0) && (target & ~ISR_CLOSED)) {
+    ERR_VALUE("top-k mining only for frequent and closed item sets"); }
   if (zmin   < 0)    { ERR_VALUE("zmin must not be negative"); }
   if (zmax   < 0)    zmax = LONG_MAX;  /* check size range */
   if (zmax   < zmin) { ERR_VALUE("zmax must not be less than zmin"); }
@@ -1217,6 +1742,7 @@ static PyObject* py_fpgrowth (PyObject *self,
   else if (strcmp(salgo, "complex") == 0) salgo = "c";
   else if (strcmp(salgo, "single")  == 0) salgo = "d";
   else if (strcmp(salgo, "topdown") == 0) salgo = "t";
+  else if (strcmp(salgo, "array")   == 0) salgo = "a";
   if (strlen(salgo) != 1)       /* translate the algorithm string */
     algo = -1;                  /* if it failed, set error code */
   else {                        /* if translation worked, */
@@ -1225,6 +1751,7 @@ static PyObject* py_fpgrowth (PyObject *self,
       case 'c': algo = FPG_COMPLEX; break;
       case 'd': algo = FPG_SINGLE;  break;
       case 't': algo = FPG_TOPDOWN; break;
+      case 'a': algo = FPG_CFP;     break;
       default : algo = -1;          break;
     }                           /* set an error code for all */
   }                             /* other algorithm indicators */
@@ -1234,6 +1761,7 @@ static PyObject* py_fpgrowth (PyObject *self,
     else if (*s == 'x') mode &= ~FPG_PERFECT;
     else if (*s == 'i') mode &= ~FPG_REORDER;
     else if (*s == 'u') mode &= ~FPG_TAIL;
+    else if (*s == 'j') mode &= ~FPG_PREFETCH;
   }                             /* adapt the operation mode */
 
   /* --- create transaction bag --- */
@@ -1248,7 +1776,7 @@ static PyObject* py_fpgrowth (PyObject *self,
   r = fpg_data(tabag, target, smin, (ITEM)zmin, eval, algo, mode, 2);
   if (r) tbg_delete(tabag, 1);  /* prepare data for FP-growth */
   if (r == -1) { ERR_MEM(); }   /* check for error and no items */
-  if (r <   0) return PyList_New(0);
+  if (r <   0) return limres(PyList_New(0), NULL, lim, report, NULL);
 
   /* --- create item set reporter --- */
   isrep = isr_create(tbg_base(tabag)); /* create item set reporter */
@@ -1256,30 +1784,39 @@ static PyObject* py_fpgrowth (PyObject *self,
   isr_setsize(isrep, (zmin > ITEM_MAX) ? ITEM_MAX : (ITEM)zmin,
                      (zmax > ITEM_MAX) ? ITEM_MAX : (ITEM)zmax);
   isr_setsupp(isrep, (RSUPP)smin, RSUPP_MAX);
-  if (border && !isr_pyborder(isrep, border)) {
+  if (border && !isr_pyborder(isrep, border, report)) {
     isr_delete(isrep, 0); tbg_delete(tabag, 1); return NULL; }
-  if ((repinit(&data, isrep, report, target) != 0)
+  if ((isr_settopk(isrep, (size_t)topk) != 0)
+  ||  (repinit(&data, isrep, report, target) != 0)
   ||  (fpg_repo(isrep, target, eval, thresh, algo, mode) < 0)
   ||  (isr_setup(isrep) < 0)) { /* set up the item set reporter */
     isr_delete(isrep, 0); tbg_delete(tabag, 1); ERR_MEM(); }
 
   /* --- frequent item set mining --- */
+  runinit(&data, isrep, maxres, maxmem, prog);
   r = fpgrowth(tabag, target, smin, body, conf, eval, agg, thresh,
               (prune < ITEM_MIN) ? ITEM_MIN :
               (prune > ITEM_MAX) ? ITEM_MAX : (ITEM)prune,
                algo, mode, 0, isrep);
+  lim = runterm(&data, isrep, lim, r);
+  if (lim > LIM_OK) r = 0;      /* (keep partial results) */
   if (r >= 0) r = repterm(&data, isrep, report);
+  if (r >= 0) {                 /* if limits were given, */
+    data.res = limres(data.res, isrep, lim, report, tracts);
+    if (!data.res) r = -1;      /* add a status dictionary */
+  }
 
   /* --- clean up --- */
   isr_delete(isrep, 0);         /* delete the item set reporter */
   tbg_delete(tabag, 1);         /* and the transaction bag */
-  if (r < 0) { Py_DECREF(data.res); ERR_MEM(); }
+  if (r < 0) { Py_XDECREF(data.res); return runerr(); }
   return data.res;              /* return the created result */
 }  /* py_fpgrowth() */
 
 /*--------------------------------------------------------------------*/
 /* sam (tracts, target='s', supp=10, zmin=1, zmax=None, report='a',   */
-/*      eval='x', thresh=10, algo='b', mode='', border=None)          */
+/*      eval='x', thresh=10, algo='b', mode='', border=None, cpus=1,  */
+/*      max_results=0, max_memory=0, progress=None)                   */
 /*--------------------------------------------------------------------*/
 
 static PyObject* py_sam (PyObject *self,
@@ -1287,7 +1824,8 @@ static PyObject* py_sam (PyObject *self,
 {                               /* --- SaM algorithm */
   char     *ckwds[] = { "tracts", "target", "supp", "zmin", "zmax",
                         "report", "eval", "thresh", "algo", "mode",
-                        "border", NULL };
+                        "border", "cpus",
+                        "max_results", "max_memory", "progress", NULL };
   CCHAR    *starg  = "s";       /* target type as a string */
   int      target  = ISR_SETS;  /* target type */
   double   supp    = 10;        /* minimum support of an item set */
@@ -1303,6 +1841,12 @@ static PyObject* py_sam (PyObject *self,
   CCHAR    *smode  = "", *s;    /* operation mode/flags as a string */
   int      mode    = SAM_DEFAULT|SAM_FIM16; /* operation mode/flags */
   PyObject *border = NULL;      /* support border for filtering */
+  int      cpus    =  1;        /* number of threads for the search */
+  PyThreadState *ts = NULL;     /* saved Python thread state */
+  long     maxres  =  0;        /* maximum number of results */
+  long     maxmem  =  0;        /* maximum memory of MEMSYS blocks */
+  PyObject *prog   = NULL;      /* progress function */
+  int      lim;                 /* status of the limits */
   PyObject *tracts;             /* transaction database */
   TABAG    *tabag;              /* transaction bag */
   ISREPORT *isrep;              /* item set reporter */
@@ -1311,10 +1855,17 @@ static PyObject* py_sam (PyObject *self,
   int      r;                   /* result buffer */
 
   /* --- evaluate the function arguments --- */
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|sdllsssdssO", ckwds,
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|sdllssdssOillO", ckwds,
         &tracts, &starg, &supp, &zmin, &zmax, &report,
-        &seval, &thresh, &salgo, &smode, &border))
+        &seval, &thresh, &salgo, &smode, &border, &cpus,
+        &maxres, &maxmem, &prog))
     return NULL;                /* parse the function arguments */
+  if ((maxres < 0) || (maxmem < 0)) {
+    ERR_VALUE("limits must not be negative"); }
+  if (prog == Py_None) prog = NULL;
+  if (prog && !PyCallable_Check(prog)) {
+    ERR_TYPE("progress must be callable"); }
+  lim = ((maxres > 0) || (maxmem > 0) || prog) ? LIM_OK : LIM_NONE;
   target = get_target(starg, "ascm");
   if (target < 0) return NULL;  /* translate the target string */
   if (zmin   < 0)    { ERR_VALUE("zmin must not be negative"); }
@@ -1344,6 +1895,9 @@ static PyObject* py_sam (PyObject *self,
     if      (*s == 'l') mode &= ~SAM_FIM16;
     else if (*s == 'x') mode &= ~SAM_PERFECT;
   }                             /* adapt the operation mode */
+  if (cpus <= 0) cpus = cpucnt();  /* get the number of threads */
+  if (cpus > SAM_CPUS/SAM_CPU1) cpus = SAM_CPUS/SAM_CPU1;
+  if (cpus > 1) mode |= cpus *SAM_CPU1;
 
   /* --- create transaction bag --- */
   tabag = tbg_fromPyObj(tracts);/* turn the given transactions */
@@ -1355,7 +1909,7 @@ static PyObject* py_sam (PyObject *self,
                eval, algo, mode, 2);
   if (r) tbg_delete(tabag, 1);  /* prepare data for SaM */
   if (r == -1) { ERR_MEM(); }   /* check for error and no items */
-  if (r <   0) return PyList_New(0);
+  if (r <   0) return limres(PyList_New(0), NULL, lim, report, NULL);
 
   /* --- create item set reporter --- */
   isrep = isr_create(tbg_base(tabag)); /* create item set reporter */
@@ -1363,7 +1917,7 @@ static PyObject* py_sam (PyObject *self,
   isr_setsize(isrep, (zmin > ITEM_MAX) ? ITEM_MAX : (ITEM)zmin,
                      (zmax > ITEM_MAX) ? ITEM_MAX : (ITEM)zmax);
   isr_setsupp(isrep, (RSUPP)smin, RSUPP_MAX);
-  if (border && !isr_pyborder(isrep, border)) {
+  if (border && !isr_pyborder(isrep, border, report)) {
     isr_delete(isrep, 0); tbg_delete(tabag, 1); return NULL; }
   if ((repinit(&data, isrep, report, target) != 0)
   ||  (sam_repo(isrep, target, eval, thresh, algo, mode) < 0)
@@ -1371,20 +1925,33 @@ static PyObject* py_sam (PyObject *self,
     isr_delete(isrep, 0); tbg_delete(tabag, 1); ERR_MEM(); }
 
   /* --- frequent item set mining --- */
+  runinit(&data, isrep, maxres, maxmem, prog);
+  if (cpus > 1) {               /* if to search with several threads, */
+    repmt(&data, isrep);        /* make reporting thread-safe and */
+    ts = PyEval_SaveThread();   /* release the interpreter lock */
+  }
   r = sam(tabag, target, smin, 0.0, 0, -1.0, eval, thresh,
           algo, mode, 8192, isrep);
+  if (ts) PyEval_RestoreThread(ts);
+  lim = runterm(&data, isrep, lim, r);
+  if (lim > LIM_OK) r = 0;      /* (keep partial results) */
   if (r >= 0) r = repterm(&data, isrep, report);
+  if (r >= 0) {                 /* if limits were given, */
+    data.res = limres(data.res, isrep, lim, report, tracts);
+    if (!data.res) r = -1;      /* add a status dictionary */
+  }
 
   /* --- clean up --- */
   isr_delete(isrep, 0);         /* delete the item set reporter */
   tbg_delete(tabag, 1);         /* and the transaction bag */
-  if (r < 0) { Py_DECREF(data.res); ERR_MEM(); }
+  if (r < 0) { Py_XDECREF(data.res); return runerr(); }
   return data.res;              /* return the created result */
 }  /* py_sam() */
 
 /*--------------------------------------------------------------------*/
 /* relim (tracts, target='s', supp=10, zmin=1, zmax=None, report='a', */
-/*        eval='x', thresh=10, algo='s', mode='', border=None)        */
+/*        eval='x', thresh=10, algo='s', mode='', border=None,        */
+/*        cpus=1, max_results=0, max_memory=0, progress=None)         */
 /*--------------------------------------------------------------------*/
 
 static PyObject* py_relim (PyObject *self,
@@ -1392,7 +1959,8 @@ static PyObject* py_relim (PyObject *self,
 {                               /* --- RElim algorithm */
   char     *ckwds[] = { "tracts", "target", "supp", "zmin", "zmax",
                         "report", "eval", "thresh", "algo", "mode",
-                        "border", NULL };
+                        "border", "cpus",
+                        "max_results", "max_memory", "progress", NULL };
   CCHAR    *starg  = "s";       /* target type as a string */
   int      target  = ISR_SETS;  /* target type */
   double   supp    = 10;        /* minimum support of an item set */
@@ -1408,6 +1976,12 @@ static PyObject* py_relim (PyObject *self,
   CCHAR    *smode  = "", *s;    /* operation mode/flags as a string */
   int      mode    = REM_DEFAULT|REM_FIM16; /* operation mode/flags */
   PyObject *border = NULL;      /* support border for filtering */
+  int      cpus    =  1;        /* number of threads for the search */
+  PyThreadState *ts = NULL;     /* saved Python thread state */
+  long     maxres  =  0;        /* maximum number of results */
+  long     maxmem  =  0;        /* maximum memory of MEMSYS blocks */
+  PyObject *prog   = NULL;      /* progress function */
+  int      lim;                 /* status of the limits */
   PyObject *tracts;             /* transaction database */
   TABAG    *tabag;              /* transaction bag */
   ISREPORT *isrep;              /* item set reporter */
@@ -1416,10 +1990,17 @@ static PyObject* py_relim (PyObject *self,
   int      r;                   /* result buffer */
 
   /* --- evaluate the function arguments --- */
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|sdllsssdssO", ckwds,
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|sdllssdssOillO", ckwds,
         &tracts, &starg, &supp, &zmin, &zmax, &report,
-        &seval, &thresh, &salgo, &smode, &border))
+        &seval, &thresh, &salgo, &smode, &border, &cpus,
+        &maxres, &maxmem, &prog))
     return NULL;                /* parse the function arguments */
+  if ((maxres < 0) || (maxmem < 0)) {
+    ERR_VALUE("limits must not be negative"); }
+  if (prog == Py_None) prog = NULL;
+  if (prog && !PyCallable_Check(prog)) {
+    ERR_TYPE("progress must be callable"); }
+  lim = ((maxres > 0) || (maxmem > 0) || prog) ? LIM_OK : LIM_NONE;
   target = get_target(starg, "ascm");
   if (target < 0) return NULL;  /* translate the target string */
   if (zmin   < 0)    { ERR_VALUE("zmin must not be negative"); }
@@ -1443,6 +2024,9 @@ static PyObject* py_relim (PyObject *self,
     if      (*s == 'l') mode &= ~REM_FIM16;
     else if (*s == 'x') mode &= ~REM_PERFECT;
   }                             /* adapt the operation mode */
+  if (cpus <= 0) cpus = cpucnt();  /* get the number of threads */
+  if (cpus > REM_CPUS/REM_CPU1) cpus = REM_CPUS/REM_CPU1;
+  if (cpus > 1) mode |= cpus *REM_CPU1;
 
   /* --- create transaction bag --- */
   tabag = tbg_fromPyObj(tracts);/* turn the given transactions */
@@ -1454,7 +2038,7 @@ static PyObject* py_relim (PyObject *self,
                  eval, algo, mode, 2);
   if (r) tbg_delete(tabag, 1);  /* prepare data for RElim */
   if (r == -1) { ERR_MEM(); }   /* check for error and no items */
-  if (r <   0) return PyList_New(0);
+  if (r <   0) return limres(PyList_New(0), NULL, lim, report, NULL);
 
   /* --- create item set reporter --- */
   isrep = isr_create(tbg_base(tabag)); /* create item set reporter */
@@ -1462,7 +2046,7 @@ static PyObject* py_relim (PyObject *self,
   isr_setsize(isrep, (zmin > ITEM_MAX) ? ITEM_MAX : (ITEM)zmin,
                      (zmax > ITEM_MAX) ? ITEM_MAX : (ITEM)zmax);
   isr_setsupp(isrep, (RSUPP)smin, RSUPP_MAX);
-  if (border && !isr_pyborder(isrep, border)) {
+  if (border && !isr_pyborder(isrep, border, report)) {
     isr_delete(isrep, 0); tbg_delete(tabag, 1); return NULL; }
   if ((repinit(&data, isrep, report, target) != 0)
   ||  (relim_repo(isrep, target, eval, thresh, algo, mode) < 0)
@@ -1470,21 +2054,34 @@ static PyObject* py_relim (PyObject *self,
     isr_delete(isrep, 0); tbg_delete(tabag, 1); ERR_MEM(); }
 
   /* --- frequent item set mining --- */
+  runinit(&data, isrep, maxres, maxmem, prog);
+  if (cpus > 1) {               /* if to search with several threads, */
+    repmt(&data, isrep);        /* make reporting thread-safe and */
+    ts = PyEval_SaveThread();   /* release the interpreter lock */
+  }
   r = relim(tabag, target, smin, 0.0, 0, -1.0, eval, thresh,
             algo, mode, 32, isrep);
+  if (ts) PyEval_RestoreThread(ts);
+  lim = runterm(&data, isrep, lim, r);
+  if (lim > LIM_OK) r = 0;      /* (keep partial results) */
   if (r >= 0) r = repterm(&data, isrep, report);
+  if (r >= 0) {                 /* if limits were given, */
+    data.res = limres(data.res, isrep, lim, report, tracts);
+    if (!data.res) r = -1;      /* add a status dictionary */
+  }
 
   /* --- clean up --- */
   isr_delete(isrep, 0);         /* delete the item set reporter */
   tbg_delete(tabag, 1);         /* and the transaction bag */
-  if (r < 0) { Py_DECREF(data.res); ERR_MEM(); }
+  if (r < 0) { Py_XDECREF(data.res); return runerr(); }
   return data.res;              /* return the created result */
 }  /* py_relim() */
 
 /*--------------------------------------------------------------------*/
 /* carpenter (tracts, target='s', supp=10, zmin=1, zmax=None,         */
 /*            report='a', eval='x', thresh=10, algo='a', mode='',     */
-/*            border=None)                                            */
+/*            border=None, cpus=1,                                    */
+/*            max_results=0, max_memory=0, progress=None)             */
 /*--------------------------------------------------------------------*/
 
 static PyObject* py_carpenter (PyObject *self,
@@ -1492,7 +2089,8 @@ static PyObject* py_carpenter (PyObject *self,
 {                               /* --- Carpenter algorithm */
   char     *ckwds[] = { "tracts", "target", "supp", "zmin", "zmax",
                         "report", "eval", "thresh", "algo", "mode",
-                        "border", NULL };
+                        "border", "cpus",
+                        "max_results", "max_memory", "progress", NULL };
   CCHAR    *starg  = "c";       /* target type as a string */
   int      target  = ISR_CLOSED;/* target type */
   double   supp    = 10;        /* minimum support of an item set */
@@ -1508,6 +2106,12 @@ static PyObject* py_carpenter (PyObject *self,
   CCHAR    *smode  = "", *s;    /* operation mode/flags as a string */
   int      mode    = CARP_DEFAULT; /* operation mode/flags */
   PyObject *border = NULL;      /* support border for filtering */
+  int      cpus    =  1;        /* number of threads for the search */
+  PyThreadState *ts = NULL;     /* saved Python thread state */
+  long     maxres  =  0;        /* maximum number of results */
+  long     maxmem  =  0;        /* maximum memory of MEMSYS blocks */
+  PyObject *prog   = NULL;      /* progress function */
+  int      lim;                 /* status of the limits */
   PyObject *tracts;             /* transaction database */
   TABAG    *tabag;              /* transaction bag */
   ISREPORT *isrep;              /* item set reporter */
@@ -1516,10 +2120,17 @@ static PyObject* py_carpenter (PyObject *self,
   int      r;                   /* result buffer */
 
   /* --- evaluate the function arguments --- */
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|sdllssdssO", ckwds,
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|sdllssdssOillO", ckwds,
         &tracts, &starg, &supp, &zmin, &zmax, &report,
-        &seval, &thresh, &salgo, &smode, &border))
+        &seval, &thresh, &salgo, &smode, &border, &cpus,
+        &maxres, &maxmem, &prog))
     return NULL;                /* parse the function arguments */
+  if ((maxres < 0) || (maxmem < 0)) {
+    ERR_VALUE("limits must not be negative"); }
+  if (prog == Py_None) prog = NULL;
+  if (prog && !PyCallable_Check(prog)) {
+    ERR_TYPE("progress must be callable"); }
+  lim = ((maxres > 0) || (maxmem > 0) || prog) ? LIM_OK : LIM_NONE;
   target = get_target(starg, "cm");
   if (target < 0) return NULL;  /* translate the target string */
   if ((target != ISR_CLOSED) && (target != IST_MAXIMAL)) {
@@ -1555,6 +2166,9 @@ static PyObject* py_carpenter (PyObject *self,
     else if (*s == 'y') mode &= ~CARP_MAXONLY;
     else if (*s == 'p') mode &= ~CARP_COLLATE;
   }                             /* adapt the operation mode */
+  if (cpus <= 0) cpus = cpucnt();  /* get the number of threads */
+  if (cpus > CARP_CPUS/CARP_CPU1) cpus = CARP_CPUS/CARP_CPU1;
+  if (cpus > 1) mode |= cpus *CARP_CPU1;
 
   /* --- create transaction bag --- */
   tabag = tbg_fromPyObj(tracts);/* turn the given transactions */
@@ -1565,7 +2179,7 @@ static PyObject* py_carpenter (PyObject *self,
   r = carp_data(tabag, target, smin, (ITEM)zmin, eval, algo, mode, 2);
   if (r) tbg_delete(tabag, 1);  /* prepare data for Carpenter */
   if (r == -1) { ERR_MEM(); }   /* check for error and no items */
-  if (r <   0) return PyList_New(0);
+  if (r <   0) return limres(PyList_New(0), NULL, lim, report, NULL);
 
   /* --- create item set reporter --- */
   isrep = isr_create(tbg_base(tabag)); /* create item set reporter */
@@ -1573,7 +2187,7 @@ static PyObject* py_carpenter (PyObject *self,
   isr_setsize(isrep, (zmin > ITEM_MAX) ? ITEM_MAX : (ITEM)zmin,
                      (zmax > ITEM_MAX) ? ITEM_MAX : (ITEM)zmax);
   isr_setsupp(isrep, (RSUPP)smin, RSUPP_MAX);
-  if (border && !isr_pyborder(isrep, border)) {
+  if (border && !isr_pyborder(isrep, border, report)) {
     isr_delete(isrep, 0); tbg_delete(tabag, 1); return NULL; }
   if ((repinit(&data, isrep, report, target) != 0)
   ||  (carp_repo(isrep, target, eval, thresh, algo, mode) < 0)
@@ -1581,19 +2195,32 @@ static PyObject* py_carpenter (PyObject *self,
     isr_delete(isrep, 0); tbg_delete(tabag, 1); ERR_MEM(); }
 
   /* --- frequent item set mining --- */
+  runinit(&data, isrep, maxres, maxmem, prog);
+  if (cpus > 1) {               /* if to search with several threads, */
+    repmt(&data, isrep);        /* make reporting thread-safe and */
+    ts = PyEval_SaveThread();   /* release the interpreter lock */
+  }
   r = carpenter(tabag, target, smin, eval, thresh, algo, mode, isrep);
+  if (ts) PyEval_RestoreThread(ts);
+  lim = runterm(&data, isrep, lim, r);
+  if (lim > LIM_OK) r = 0;      /* (keep partial results) */
   if (r >= 0) r = repterm(&data, isrep, report);
+  if (r >= 0) {                 /* if limits were given, */
+    data.res = limres(data.res, isrep, lim, report, tracts);
+    if (!data.res) r = -1;      /* add a status dictionary */
+  }
 
   /* --- clean up --- */
   isr_delete(isrep, 0);         /* delete the item set reporter */
   tbg_delete(tabag, 1);         /* and the transaction bag */
-  if (r < 0) { Py_DECREF(data.res); ERR_MEM(); }
+  if (r < 0) { Py_XDECREF(data.res); return runerr(); }
   return data.res;              /* return the created result */
 }  /* py_carpenter() */
 
 /*--------------------------------------------------------------------*/
 /* ista (tracts, target='s', supp=10, zmin=1, zmax=None, report='a',  */
-/*       eval='x', thresh=10, algo='x', mode='', border=None)         */
+/*       eval='x', thresh=10, algo='x', mode='', border=None,         */
+/*       cpus=1, max_results=0, max_memory=0, progress=None)          */
 /*--------------------------------------------------------------------*/
 
 static PyObject* py_ista (PyObject *self,
@@ -1601,7 +2228,8 @@ static PyObject* py_ista (PyObject *self,
 {                               /* --- IsTa algorithm */
   char     *ckwds[] = { "tracts", "target", "supp", "zmin", "zmax",
                         "report", "eval", "thresh", "algo", "mode",
-                        "border", NULL };
+                        "border", "cpus",
+                        "max_results", "max_memory", "progress", NULL };
   CCHAR    *starg  = "c";       /* target type as a string */
   int      target  = ISR_CLOSED;/* target type */
   double   supp    = 10;        /* minimum support of an item set */
@@ -1617,6 +2245,12 @@ static PyObject* py_ista (PyObject *self,
   CCHAR    *smode  = "", *s;    /* operation mode/flags as a string */
   int      mode    = ISTA_DEFAULT; /* operation mode/flags */
   PyObject *border = NULL;      /* support border for filtering */
+  int      cpus    =  1;        /* number of threads for the search */
+  PyThreadState *ts = NULL;     /* saved Python thread state */
+  long     maxres  =  0;        /* maximum number of results */
+  long     maxmem  =  0;        /* maximum memory of MEMSYS blocks */
+  PyObject *prog   = NULL;      /* progress function */
+  int      lim;                 /* status of the limits */
   PyObject *tracts;             /* transaction database */
   TABAG    *tabag;              /* transaction bag */
   ISREPORT *isrep;              /* item set reporter */
@@ -1625,10 +2259,17 @@ static PyObject* py_ista (PyObject *self,
   int      r;                   /* result buffer */
 
   /* --- evaluate the function arguments --- */
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|sdllssdssO", ckwds,
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|sdllssdssOillO", ckwds,
         &tracts, &starg, &supp, &zmin, &zmax, &report,
-        &seval, &thresh, &salgo, &smode, &border))
+        &seval, &thresh, &salgo, &smode, &border, &cpus,
+        &maxres, &maxmem, &prog))
     return NULL;                /* parse the function arguments */
+  if ((maxres < 0) || (maxmem < 0)) {
+    ERR_VALUE("limits must not be negative"); }
+  if (prog == Py_None) prog = NULL;
+  if (prog && !PyCallable_Check(prog)) {
+    ERR_TYPE("progress must be callable"); }
+  lim = ((maxres > 0) || (maxmem > 0) || prog) ? LIM_OK : LIM_NONE;
   target = get_target(starg, "cm");
   if (target < 0) return NULL;  /* translate the target string */
   if ((target != ISR_CLOSED) && (target != IST_MAXIMAL)) {
@@ -1659,6 +2300,9 @@ static PyObject* py_ista (PyObject *self,
     if      (*s == 'p') mode &= ~ISTA_PRUNE;
     else if (*s == 'z') mode |=  ISTA_FILTER;
   }                             /* adapt the operation mode */
+  if (cpus <= 0) cpus = cpucnt();  /* get the number of threads */
+  if (cpus > ISTA_CPUS/ISTA_CPU1) cpus = ISTA_CPUS/ISTA_CPU1;
+  if (cpus > 1) mode |= cpus *ISTA_CPU1;
 
   /* --- create transaction bag --- */
   tabag = tbg_fromPyObj(tracts);/* turn the given transactions */
@@ -1669,7 +2313,7 @@ static PyObject* py_ista (PyObject *self,
   r = ista_data(tabag, target, smin, (ITEM)zmin, eval, algo, mode, 2);
   if (r) tbg_delete(tabag, 1);  /* prepare data for IsTa */
   if (r == -1) { ERR_MEM(); }   /* check for error and no items */
-  if (r <   0) return PyList_New(0);
+  if (r <   0) return limres(PyList_New(0), NULL, lim, report, NULL);
 
   /* --- create item set reporter --- */
   isrep = isr_create(tbg_base(tabag)); /* create item set reporter */
@@ -1677,7 +2321,7 @@ static PyObject* py_ista (PyObject *self,
   isr_setsize(isrep, (zmin > ITEM_MAX) ? ITEM_MAX : (ITEM)zmin,
                      (zmax > ITEM_MAX) ? ITEM_MAX : (ITEM)zmax);
   isr_setsupp(isrep, (RSUPP)smin, RSUPP_MAX);
-  if (border && !isr_pyborder(isrep, border)) {
+  if (border && !isr_pyborder(isrep, border, report)) {
     isr_delete(isrep, 0); tbg_delete(tabag, 1); return NULL; }
   if ((repinit(&data, isrep, report, target) != 0)
   ||  (ista_repo(isrep, target, eval, thresh, algo, mode) < 0)
@@ -1685,13 +2329,25 @@ static PyObject* py_ista (PyObject *self,
     isr_delete(isrep, 0); tbg_delete(tabag, 1); ERR_MEM(); }
 
   /* --- frequent item set mining --- */
+  runinit(&data, isrep, maxres, maxmem, prog);
+  if (cpus > 1) {               /* if to search with several threads, */
+    repmt(&data, isrep);        /* make reporting thread-safe and */
+    ts = PyEval_SaveThread();   /* release the interpreter lock */
+  }
   r = ista(tabag, target, smin, eval, thresh, algo, mode, isrep);
+  if (ts) PyEval_RestoreThread(ts);
+  lim = runterm(&data, isrep, lim, r);
+  if (lim > LIM_OK) r = 0;      /* (keep partial results) */
   if (r >= 0) r = repterm(&data, isrep, report);
+  if (r >= 0) {                 /* if limits were given, */
+    data.res = limres(data.res, isrep, lim, report, tracts);
+    if (!data.res) r = -1;      /* add a status dictionary */
+  }
 
   /* --- clean up --- */
   isr_delete(isrep, 0);         /* delete the item set reporter */
   tbg_delete(tabag, 1);         /* and the transaction bag */
-  if (r < 0) { Py_DECREF(data.res); ERR_MEM(); }
+  if (r < 0) { Py_XDECREF(data.res); return runerr(); }
   return data.res;              /* return the created result */
 }  /* py_ista() */
 
@@ -1757,7 +2413,7 @@ static PyObject* py_apriacc (PyObject *self,
   isr_setsize(isrep, (zmin > ITEM_MAX) ? ITEM_MAX : (ITEM)zmin,
                      (zmax > ITEM_MAX) ? ITEM_MAX : (ITEM)zmax);
   isr_setsupp(isrep, (RSUPP)smin, RSUPP_MAX);
-  if (border && !isr_pyborder(isrep, border)) {
+  if (border && !isr_pyborder(isrep, border, report)) {
     isr_delete(isrep, 0); tbg_delete(tabag, 1); return NULL; }
   if ((repinit(&data, isrep, report, ISR_SETS) != 0)
   ||  (apriori_repo(isrep,ISR_MAXIMAL,stat,siglvl,APR_BASIC,mode) < 0)
@@ -1841,7 +2497,7 @@ static PyObject* py_accretion (PyObject *self,
   isr_setsize(isrep, (zmin > ITEM_MAX) ? ITEM_MAX : (ITEM)zmin,
                      (zmax > ITEM_MAX) ? ITEM_MAX : (ITEM)zmax);
   isr_setsupp(isrep, (RSUPP)smin, RSUPP_MAX);
-  if (border && !isr_pyborder(isrep, border)) {
+  if (border && !isr_pyborder(isrep, border, report)) {
     isr_delete(isrep, 0); tbg_delete(tabag, 1); return NULL; }
   if ((repinit(&data, isrep, report, ISR_SETS) != 0)
   ||  (acc_repo(isrep, ISR_MAXIMAL, mode) < 0)
@@ -2140,6 +2796,235 @@ static PyObject* py_estpsp (PyObject *self,
   return pypsp;                 /* the created pattern spectrum */
 }  /* py_estpsp() */
 
+/*--------------------------------------------------------------------*/
+/* readbin (fname)                                                    */
+/*--------------------------------------------------------------------*/
+
+static PyObject* py_readbin (PyObject *self,
+                             PyObject *args, PyObject *kwds)
+{                               /* --- read a binary item set file */
+  char     *ckwds[] = { "fname", NULL };
+  CCHAR    *fname;              /* name of the file to read */
+  REPREAD  *rrd;                /* reader for binary item set files */
+  ITEM     i, n;                /* loop variable, number of items */
+  int      r;                   /* result of function call */
+  PyObject *names = NULL;       /* item names (as Python strings) */
+  PyObject *res, *pair;         /* result list, current pair */
+  PyObject *iset, *vals, *obj;  /* item set, values, current object */
+
+  /* --- evaluate the function arguments --- */
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "s", ckwds, &fname))
+    return NULL;                /* parse the function arguments */
+
+  /* --- open the file and get the item names --- */
+  rrd = rrd_create();           /* create a binary file reader */
+  if (!rrd) { ERR_MEM(); }      /* and open the given file */
+  r = rrd_open(rrd, NULL, fname);
+  if (r == E_FOPEN) { rrd_delete(rrd);
+    return PyErr_SetFromErrnoWithFilename(PyExc_IOError, fname); }
+  res = (r) ? NULL : PyList_New(0);
+  n   = rrd_ncnt(rrd);          /* create the result list */
+  if (res && (n > 0)) {         /* if there are item names */
+    names = PyTuple_New(n);     /* create a tuple of item names */
+    for (i = 0; names && (i < n); i++) {
+      obj = PyString_FromString(rrd_name(rrd, i));
+      if (!obj) { Py_CLEAR(names); break; }
+      PyTuple_SET_ITEM(names, i, obj);
+    }                           /* convert the item names */
+    if (!names) Py_CLEAR(res);  /* to Python strings */
+  }
+
+  /* --- read the item sets --- */
+  while (res && ((r = rrd_read(rrd)) == 0)) {
+    iset = PyTuple_New(n = rrd_cnt(rrd));
+    for (i = 0; iset && (i < n); i++) {
+      if (!names) obj = PyInt_FromLong((long)rrd_item(rrd, i));
+      else if (rrd_item(rrd, i) < rrd_ncnt(rrd)) {
+        obj = PyTuple_GET_ITEM(names, rrd_item(rrd, i));
+        Py_INCREF(obj); }       /* get the item name or */
+      else obj = NULL;          /* the item identifier */
+      if (!obj) { Py_CLEAR(iset); break; }
+      PyTuple_SET_ITEM(iset, i, obj);
+    }                           /* build the item set tuple */
+    obj  = (rrd_flags(rrd) & ISR_BINDBL)
+         ? PyFloat_FromDouble(rrd_supp(rrd))
+         : PyInt_FromLong((long)rrd_supp(rrd));
+    vals = (!obj) ? NULL        /* build the tuple of values */
+         : (rrd_flags(rrd) & ISR_BINEVAL)
+         ? Py_BuildValue("(Nd)", obj, rrd_eval(rrd))
+         : Py_BuildValue("(N)",  obj);
+    pair = (iset && vals) ? PyTuple_Pack(2, iset, vals) : NULL;
+    Py_XDECREF(iset); Py_XDECREF(vals);
+    if (!pair || (PyList_Append(res, pair) != 0))
+      Py_CLEAR(res);            /* build the pair of item set and */
+    Py_XDECREF(pair);           /* values and append it to the list */
+  }
+
+  /* --- clean up --- */
+  Py_XDECREF(names);            /* delete the item names */
+  rrd_delete(rrd);              /* and the binary file reader */
+  if (!res) {                   /* check for an error */
+    if (!PyErr_Occurred()) {
+      if (r == E_NOMEM) { ERR_MEM(); }
+      ERR_VALUE("invalid or truncated binary item set file"); }
+    return NULL;                /* (Python errors take precedence) */
+  }
+  if (r < 0) {                  /* check for a read error */
+    Py_DECREF(res);             /* (delete the partial result) */
+    if (r == E_NOMEM) { ERR_MEM(); }
+    ERR_VALUE("invalid or truncated binary item set file");
+  }                             /* (the loop ends with RRD_EOF) */
+  return res;                   /* return the list of item sets */
+}  /* py_readbin() */
+
+/*--------------------------------------------------------------------*/
+/* Perfect Extension Expansion                                        */
+/*--------------------------------------------------------------------*/
+
+static void pxi_delete (PEXITER *pxi)
+{                               /* --- delete an expansion iterator */
+  Py_XDECREF(pxi->src);         /* drop the source iterator */
+  Py_XDECREF(pxi->gen);         /* and the current triplet */
+  Py_XDECREF(pxi->pexs);        /* of generator, perfect extensions */
+  Py_XDECREF(pxi->vals);        /* and the associated values */
+  if (pxi->idx) free(pxi->idx); /* delete the index array */
+  PyObject_Del(pxi);            /* and the iterator object */
+}  /* pxi_delete() */
+
+/*--------------------------------------------------------------------*/
+
+static int pxi_fetch (PEXITER *pxi)
+{                               /* --- get the next generator */
+  Py_ssize_t z;                 /* size of the generator */
+  Py_ssize_t *p;                /* (re)allocated index array */
+  PyObject   *t;                /* next compressed item set */
+
+  assert(pxi && !pxi->gen);     /* check the function argument */
+  while (1) {                   /* get generators until one qualifies */
+    t = PyIter_Next(pxi->src);  /* get the next compressed item set */
+    if (!t) return -1;          /* (error or end of iteration) */
+    if (!PyTuple_Check(t) || (PyTuple_GET_SIZE(t) != 3)
+    ||  !PyTuple_Check(PyTuple_GET_ITEM(t, 0))
+    ||  !PyTuple_Check(PyTuple_GET_ITEM(t, 1))) {
+      Py_DECREF(t);             /* check the triplet structure */
+      PyErr_SetString(PyExc_TypeError,
+        "item sets must be triplets (items, perfect exts., values)");
+      return -1;                /* set an error message */
+    }                           /* and abort the function */
+    z         = PyTuple_GET_SIZE(PyTuple_GET_ITEM(t, 0));
+    pxi->n    = PyTuple_GET_SIZE(PyTuple_GET_ITEM(t, 1));
+    pxi->k    = (pxi->zmin > z) ? pxi->zmin -z : 0;
+    pxi->kmax = (pxi->zmax < z +pxi->n) ? pxi->zmax -z : pxi->n;
+    if (pxi->k > pxi->kmax) {   /* if no expansion has a valid size, */
+      Py_DECREF(t); continue; } /* skip the generator */
+    if (pxi->n > pxi->size) {   /* if the index array is too small */
+      p = (Py_ssize_t*)realloc(pxi->idx,
+                               (size_t)pxi->n *sizeof(Py_ssize_t));
+      if (!p) { Py_DECREF(t); PyErr_NoMemory(); return -1; }
+      pxi->idx = p; pxi->size = pxi->n;
+    }                           /* enlarge the index array */
+    pxi->gen  = PyTuple_GET_ITEM(t, 0); Py_INCREF(pxi->gen);
+    pxi->pexs = PyTuple_GET_ITEM(t, 1); Py_INCREF(pxi->pexs);
+    pxi->vals = PyTuple_GET_ITEM(t, 2); Py_INCREF(pxi->vals);
+    Py_DECREF(t);               /* note the triplet components */
+    for (z = 0; z < pxi->k; z++)
+      pxi->idx[z] = z;          /* select the first perfect exts. */
+    return 0;                   /* return 'ok' */
+  }
+}  /* pxi_fetch() */
+
+/*--------------------------------------------------------------------*/
+
+static PyObject* pxi_next (PEXITER *pxi)
+{                               /* --- get the next expanded set */
+  Py_ssize_t i, z;              /* loop variable, generator size */
+  PyObject   *iset;             /* expanded item set (as a tuple) */
+  PyObject   *pair;             /* pair of item set and values */
+  PyObject   *obj;              /* to traverse the items */
+
+  assert(pxi);                  /* check the function argument */
+  if (!pxi->gen && (pxi_fetch(pxi) != 0))
+    return NULL;                /* get the next generator if needed */
+  z    = PyTuple_GET_SIZE(pxi->gen);
+  iset = PyTuple_New(z +pxi->k);/* create an item set tuple */
+  if (!iset) return NULL;       /* of the expanded size */
+  for (i = 0; i < z; i++) {     /* copy the generator items */
+    obj = PyTuple_GET_ITEM(pxi->gen, i);
+    Py_INCREF(obj); PyTuple_SET_ITEM(iset, i, obj);
+  }                             /* and then the selected */
+  for (i = 0; i < pxi->k; i++){ /* perfect extensions */
+    obj = PyTuple_GET_ITEM(pxi->pexs, pxi->idx[i]);
+    Py_INCREF(obj); PyTuple_SET_ITEM(iset, z+i, obj);
+  }
+  pair = PyTuple_New(2);        /* create a pair of set and values */
+  if (!pair) { Py_DECREF(iset); return NULL; }
+  PyTuple_SET_ITEM(pair, 0, iset);
+  Py_INCREF(pxi->vals);         /* the values are shared by */
+  PyTuple_SET_ITEM(pair, 1, pxi->vals);   /* all expanded sets */
+  for (i = pxi->k; --i >= 0; )  /* find the last index that */
+    if (pxi->idx[i] < pxi->n -pxi->k +i)  /* can be advanced */
+      break;                    /* (next combination of this size) */
+  if (i >= 0) {                 /* if there is another combination */
+    pxi->idx[i]++;              /* advance the found index and */
+    while (++i < pxi->k)        /* reset all following indices */
+      pxi->idx[i] = pxi->idx[i-1] +1; }
+  else if (++pxi->k <= pxi->kmax) {
+    for (i = 0; i < pxi->k; i++)/* if the size can be increased, */
+      pxi->idx[i] = i; }        /* select the first perfect exts. */
+  else {                        /* if all expansions are done */
+    Py_CLEAR(pxi->gen); Py_CLEAR(pxi->pexs); Py_CLEAR(pxi->vals); }
+  return pair;                  /* return the expanded item set */
+}  /* pxi_next() */
+
+/*--------------------------------------------------------------------*/
+
+static PyTypeObject pxi_type = {/* --- perf. ext. expansion iterator */
+  PyVarObject_HEAD_INIT(NULL, 0)
+  .tp_name      = "fim.pexiter",
+  .tp_basicsize = sizeof(PEXITER),
+  .tp_dealloc   = (destructor)pxi_delete,
+  .tp_flags     = Py_TPFLAGS_DEFAULT,
+  .tp_doc       = "iterator over item sets with expanded perfect exts.",
+  .tp_iter      = PyObject_SelfIter,
+  .tp_iternext  = (iternextfunc)pxi_next,
+};
+
+/*--------------------------------------------------------------------*/
+/* expand (isets, zmin=1, zmax=None)                                  */
+/*--------------------------------------------------------------------*/
+
+static PyObject* py_expand (PyObject *self,
+                            PyObject *args, PyObject *kwds)
+{                               /* --- expand perfect extensions */
+  char     *ckwds[] = { "isets", "zmin", "zmax", NULL };
+  long     zmin     =  1;       /* minimum size of an item set */
+  long     zmax     = -1;       /* maximum size of an item set */
+  PyObject *isets;              /* compressed item sets */
+  PyObject *src;                /* iterator over compressed sets */
+  PEXITER  *pxi;                /* created expansion iterator */
+
+  /* --- evaluate the function arguments --- */
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|ll", ckwds,
+                                   &isets, &zmin, &zmax))
+    return NULL;                /* parse the function arguments */
+  if (zmin  <  0)    zmin = 0;  /* check the size range */
+  if (zmax  <  0)    zmax = ITEM_MAX;
+  if (zmax  <  zmin) { ERR_VALUE("zmax must not be less than zmin"); }
+  src = PyObject_GetIter(isets);/* get an iterator over */
+  if (!src) return NULL;        /* the compressed item sets */
+
+  /* --- create the expansion iterator --- */
+  pxi = PyObject_New(PEXITER, &pxi_type);
+  if (!pxi) { Py_DECREF(src); return NULL; }
+  pxi->src  = src;              /* note the source iterator */
+  pxi->gen  = pxi->pexs = pxi->vals = NULL;
+  pxi->zmin = (Py_ssize_t)zmin; /* note the item set size range */
+  pxi->zmax = (Py_ssize_t)zmax; /* and clear the current state */
+  pxi->n    = pxi->k = pxi->kmax = pxi->size = 0;
+  pxi->idx  = NULL;             /* (index array created on demand) */
+  return (PyObject*)pxi;        /* return the created iterator */
+}  /* py_expand() */
+
 /*--------------------------------------------------------------------*/
 /* Python Function List                                               */
 /*--------------------------------------------------------------------*/
@@ -2147,7 +3032,8 @@ static PyObject* py_estpsp (PyObject *self,
 static PyMethodDef fim_methods[] = {
   { "fim", (PyCFunction)py_fim, METH_VARARGS|METH_KEYWORDS,
     "fim (tracts, target='s', supp=10, zmin=1, zmax=None, report='a',\n"
-    "     eval='x', agg='x', thresh=10, border=None)\n"
+    "     eval='x', agg='x', thresh=10, border=None,\n"
+    "     max_results=0, max_memory=0, progress=None)\n"
     "Find frequent item sets (simplified interface).\n"
     "tracts  transaction database to mine (mandatory)\n"
     "        The database must be an iterable of transactions;\n"
@@ -2172,6 +3058,8 @@ static PyMethodDef fim_methods[] = {
     "        E     value of item set evaluation measure as a percentage\n"
     "        =     pattern spectrum as a list (instead of patterns)\n"
     "        #     pattern spectrum as a dictionary\n"
+    "        +     (prefix) triplets with separate perfect exts.\n"
+    "              (cannot be combined with a support border)\n"
     "eval    measure for item set evaluation        (default: x)\n"
     "        x     none       no measure / zero (default)\n"
     "        b     ldratio    binary logarithm of support quotient       (+)\n"
@@ -2208,6 +3096,20 @@ static PyMethodDef fim_methods[] = {
     "border  support border for filtering item sets (default: None)\n"
     "        Must be a list or tuple of (absolute) minimum support values\n"
     "        per item set size (by which the list/tuple is indexed).\n"
+    "max_results  maximum number of patterns     (default: 0, no limit)\n"
+    "max_memory   maximum bytes of memory blocks (default: 0, no limit)\n"
+    "        If a limit is given, a pair (result, status) is returned,\n"
+    "        where status is a dictionary with the keys 'status'\n"
+    "        ('ok', 'max_results' or 'max_memory') and 'count'\n"
+    "        (number of reported patterns). If mining was stopped\n"
+    "        and report is '#' or '=', the key 'estimate' gives an\n"
+    "        estimate of the total number of patterns.\n"
+    "progress     progress function              (default: None)\n"
+    "        Called as progress(nodes, sets, bytes) with the number of\n"
+    "        visited search nodes, the number of reported patterns and\n"
+    "        the bytes in memory blocks. If it returns a true value,\n"
+    "        the search is cancelled and the status is 'cancelled'.\n"
+    "        If it is given, a pair (result, status) is returned.\n"
     "returns a list of pairs (i.e. tuples with two elements),\n"
     "        each consisting of a tuple with a found frequent item set\n"
     "        and a tuple listing the values selected with 'report' *or*\n"
@@ -2215,7 +3117,8 @@ static PyMethodDef fim_methods[] = {
   },
   { "arules", (PyCFunction)py_arules, METH_VARARGS|METH_KEYWORDS,
     "arules (tracts, supp=10, conf=80, zmin=1, zmax=None, report='aC',\n"
-    "        eval='x', thresh=10, mode='')\n"
+    "        eval='x', thresh=10, mode='', topk=0,\n"
+    "        max_results=0, max_memory=0, progress=None)\n"
     "Find association rules (simplified interface).\n"
     "tracts  transaction database to mine (mandatory)\n"
     "        The database must be an iterable of transactions;\n"
@@ -2276,6 +3179,24 @@ static PyMethodDef fim_methods[] = {
     "thresh  threshold for evaluation measure       (default: 10%)\n"
     "mode    operation mode indicators/flags        (default: None)\n"
     "        o     use original rule support definition (body & head)\n"
+    "topk    number of rules to find (default: 0, i.e. all)\n"
+    "        If positive, only the rules with the topk best values of\n"
+    "        the evaluation measure (confidence if eval is 'x') are\n"
+    "        reported (ties are included); thresh acts as a bound.\n"
+    "max_results  maximum number of patterns     (default: 0, no limit)\n"
+    "max_memory   maximum bytes of memory blocks (default: 0, no limit)\n"
+    "        If a limit is given, a pair (result, status) is returned,\n"
+    "        where status is a dictionary with the keys 'status'\n"
+    "        ('ok', 'max_results' or 'max_memory') and 'count'\n"
+    "        (number of reported patterns). If mining was stopped\n"
+    "        and report is '#' or '=', the key 'estimate' gives an\n"
+    "        estimate of the total number of patterns.\n"
+    "progress     progress function              (default: None)\n"
+    "        Called as progress(nodes, sets, bytes) with the number of\n"
+    "        visited search nodes, the number of reported patterns and\n"
+    "        the bytes in memory blocks. If it returns a true value,\n"
+    "        the search is cancelled and the status is 'cancelled'.\n"
+    "        If it is given, a pair (result, status) is returned.\n"
     "returns a list of triplets (i.e. tuples with three elements),\n"
     "        each consisting of a head/consequent item, a tuple with\n"
     "        a body/antecedent item set, and a tuple listing the values\n"
@@ -2284,7 +3205,8 @@ static PyMethodDef fim_methods[] = {
   { "apriori", (PyCFunction)py_apriori, METH_VARARGS|METH_KEYWORDS,
     "apriori (tracts, target='s', supp=10, zmin=1, zmax=None, report='a',\n"
     "         eval='x', agg='x', thresh=10, prune=None, algo='b', mode='',\n"
-    "         border=None)\n"
+    "         border=None, cpus=1, max_results=0, max_memory=0,\n"
+    "         progress=None)\n"
     "Find frequent item sets with the Apriori algorithm.\n"
     "tracts  transaction database to mine (mandatory)\n"
     "        The database must be an iterable of transactions;\n"
@@ -2311,6 +3233,8 @@ static PyMethodDef fim_methods[] = {
     "        E     value of item set evaluation measure as a percentage\n"
     "        =     pattern spectrum as a list (instead of patterns)\n"
     "        #     pattern spectrum as a dictionary\n"
+    "        +     (prefix) triplets with separate perfect exts.\n"
+    "              (cannot be combined with a support border)\n"
     "eval    measure for item set evaluation        (default: x)\n"
     "        x     none       no measure / zero (default)\n"
     "        b     ldratio    binary logarithm of support quotient       (+)\n"
@@ -2353,12 +3277,29 @@ static PyMethodDef fim_methods[] = {
     "mode    operation mode indicators/flags        (default: None)\n"
     "        x     do not use perfect extension pruning\n"
     "        t/T   do not organize transactions as a prefix tree\n"
+    "        M     do not count item pairs with a triangular matrix\n"
     "        y     a-posteriori pruning of infrequent item sets\n"
     "        z     invalidate evaluation below expected support\n"
     "        o     use original rule support definition (body & head)\n"
     "border  support border for filtering item sets (default: None)\n"
     "        Must be a list or tuple of (absolute) minimum support values\n"
     "        per item set size (by which the list/tuple is indexed).\n"
+    "cpus    number of threads for support counting (default: 1)\n"
+    "        A value <= 0 means all cpus reported as available.\n"
+    "max_results  maximum number of patterns     (default: 0, no limit)\n"
+    "max_memory   maximum bytes of memory blocks (default: 0, no limit)\n"
+    "        If a limit is given, a pair (result, status) is returned,\n"
+    "        where status is a dictionary with the keys 'status'\n"
+    "        ('ok', 'max_results' or 'max_memory') and 'count'\n"
+    "        (number of reported patterns). If mining was stopped\n"
+    "        and report is '#' or '=', the key 'estimate' gives an\n"
+    "        estimate of the total number of patterns.\n"
+    "progress     progress function              (default: None)\n"
+    "        Called as progress(nodes, sets, bytes) with the number of\n"
+    "        visited search nodes, the number of reported patterns and\n"
+    "        the bytes in memory blocks. If it returns a true value,\n"
+    "        the search is cancelled and the status is 'cancelled'.\n"
+    "        If it is given, a pair (result, status) is returned.\n"
     "returns if report is not in ['#','=']:\n"
     "          if the target is association rules:\n"
     "            a list of triplets (i.e. tuples with three elements),\n"
@@ -2376,7 +3317,8 @@ static PyMethodDef fim_methods[] = {
   { "eclat", (PyCFunction)py_eclat, METH_VARARGS|METH_KEYWORDS,
     "eclat (tracts, target='s', supp=10, zmin=1, zmax=None, report='a',\n"
     "       eval='x', agg='x', thresh=10, prune=None, algo='a', mode='',\n"
-    "       border=None)\n"
+    "       border=None, topk=0, max_results=0, max_memory=0,\n"
+    "       progress=None)\n"
     "Find frequent item sets with the Eclat algorithm.\n"
     "tracts  transaction database to mine (mandatory)\n"
     "        The database must be an iterable of transactions;\n"
@@ -2403,6 +3345,8 @@ static PyMethodDef fim_methods[] = {
     "        E     value of item set evaluation measure as a percentage\n"
     "        =     pattern spectrum as a list (instead of patterns)\n"
     "        #     pattern spectrum as a dictionary\n"
+    "        +     (prefix) triplets with separate perfect exts.\n"
+    "              (cannot be combined with a support border)\n"
     "eval    measure for item set evaluation        (default: x)\n"
     "        x     none       no measure / zero (default)\n"
     "        b     ldratio    binary logarithm of support quotient       (+)\n"
@@ -2456,11 +3400,30 @@ static PyMethodDef fim_methods[] = {
     "        i     do not sort items w.r.t. conditional support\n"
     "        u     do not head union tail (hut) pruning (maximal)\n"
     "        y     check extensions for closed/maximal item sets\n"
+    "        h     filter closed item sets with tid set hashes (basic)\n"
     "        z     invalidate evaluation below expected support\n"
     "        o     use original rule support definition (body & head)\n"
     "border  support border for filtering item sets (default: None)\n"
     "        Must be a list or tuple of (absolute) minimum support values\n"
     "        per item set size (by which the list/tuple is indexed).\n"
+    "topk    number of item sets to find (default: 0, i.e. all)\n"
+    "        If positive, only the item sets with the topk highest\n"
+    "        support values are reported (ties are included); supp\n"
+    "        acts as a lower bound (target 's' or 'c' only).\n"
+    "max_results  maximum number of patterns     (default: 0, no limit)\n"
+    "max_memory   maximum bytes of memory blocks (default: 0, no limit)\n"
+    "        If a limit is given, a pair (result, status) is returned,\n"
+    "        where status is a dictionary with the keys 'status'\n"
+    "        ('ok', 'max_results' or 'max_memory') and 'count'\n"
+    "        (number of reported patterns). If mining was stopped\n"
+    "        and report is '#' or '=', the key 'estimate' gives an\n"
+    "        estimate of the total number of patterns.\n"
+    "progress     progress function              (default: None)\n"
+    "        Called as progress(nodes, sets, bytes) with the number of\n"
+    "        visited search nodes, the number of reported patterns and\n"
+    "        the bytes in memory blocks. If it returns a true value,\n"
+    "        the search is cancelled and the status is 'cancelled'.\n"
+    "        If it is given, a pair (result, status) is returned.\n"
     "returns if report is not in ['#','=']:\n"
     "          if the target is association rules:\n"
     "            a list of triplets (i.e. tuples with three elements),\n"
@@ -2478,7 +3441,8 @@ static PyMethodDef fim_methods[] = {
   { "fpgrowth", (PyCFunction)py_fpgrowth, METH_VARARGS|METH_KEYWORDS,
     "fpgrowth (tracts, target='s', supp=10, zmin=1, zmax=None, report='a',\n"
     "          eval='x', agg='x', thresh=10, prune=Nobe, algo='s', mode='',\n"
-    "          border=None)\n"
+    "          border=None, topk=0, max_results=0, max_memory=0,\n"
+    "          progress=None)\n"
     "Find frequent item sets with the FP-growth algorithm.\n"
     "tracts  transaction database to mine (mandatory)\n"
     "        The database must be an iterable of transactions;\n"
@@ -2505,6 +3469,8 @@ static PyMethodDef fim_methods[] = {
     "        E     value of item set evaluation measure as a percentage\n"
     "        =     pattern spectrum as a list (instead of patterns)\n"
     "        #     pattern spectrum as a dictionary\n"
+    "        +     (prefix) triplets with separate perfect exts.\n"
+    "              (cannot be combined with a support border)\n"
     "eval    measure for item set evaluation        (default: x)\n"
     "        x     none       no measure / zero (default)\n"
     "        b     ldratio    binary logarithm of support quotient       (+)\n"
@@ -2547,17 +3513,37 @@ static PyMethodDef fim_methods[] = {
     "        c     complex    complex tree nodes (children and siblings)\n"
     "        d     single     top-down processing on a single prefix tree\n"
     "        t     topdown    top-down processing of the prefix trees\n"
+    "        a     array      cache-friendly array-based prefix trees\n"
     "        Variant d does not support closed/maximal item set mining.\n"
     "mode    operation mode indicators/flags        (default: None)\n"
     "        l     do not use a 16-items machine\n"
     "        x     do not use perfect extension pruning\n"
     "        i     do not sort items w.r.t. conditional support\n"
     "        u     do not head union tail (hut) pruning (maximal)\n"
+    "        j     do not prefetch parents of listed nodes (variant s)\n"
     "        z     invalidate evaluation below expected support\n"
     "        o     use original rule support definition (body & head)\n"
     "border  support border for filtering item sets (default: None)\n"
     "        Must be a list or tuple of (absolute) minimum support values\n"
     "        per item set size (by which the list/tuple is indexed).\n"
+    "topk    number of item sets to find (default: 0, i.e. all)\n"
+    "        If positive, only the item sets with the topk highest\n"
+    "        support values are reported (ties are included); supp\n"
+    "        acts as a lower bound (target 's' or 'c' only).\n"
+    "max_results  maximum number of patterns     (default: 0, no limit)\n"
+    "max_memory   maximum bytes of memory blocks (default: 0, no limit)\n"
+    "        If a limit is given, a pair (result, status) is returned,\n"
+    "        where status is a dictionary with the keys 'status'\n"
+    "        ('ok', 'max_results' or 'max_memory') and 'count'\n"
+    "        (number of reported patterns). If mining was stopped\n"
+    "        and report is '#' or '=', the key 'estimate' gives an\n"
+    "        estimate of the total number of patterns.\n"
+    "progress     progress function              (default: None)\n"
+    "        Called as progress(nodes, sets, bytes) with the number of\n"
+    "        visited search nodes, the number of reported patterns and\n"
+    "        the bytes in memory blocks. If it returns a true value,\n"
+    "        the search is cancelled and the status is 'cancelled'.\n"
+    "        If it is given, a pair (result, status) is returned.\n"
     "returns if report is not in ['#','=']:\n"
     "          if the target is association rules:\n"
     "            a list of triplets (i.e. tuples with three elements),\n"
@@ -2574,7 +3560,8 @@ static PyMethodDef fim_methods[] = {
   },
   { "sam", (PyCFunction)py_sam, METH_VARARGS|METH_KEYWORDS,
     "sam (tracts, target='s', supp=10, zmin=1, zmax=None, report='a',\n"
-    "     eval='x', thresh=10, algo='b', mode='', border=None)\n"
+    "     eval='x', thresh=10, algo='b', mode='', border=None, cpus=1,\n"
+    "     max_results=0, max_memory=0, progress=None)\n"
     "Find frequent item sets with the SaM algorithm.\n"
     "tracts  transaction database to mine (mandatory)\n"
     "        The database must be an iterable of transactions;\n"
@@ -2598,6 +3585,8 @@ static PyMethodDef fim_methods[] = {
     "        E     value of item set evaluation measure as a percentage\n"
     "        =     pattern spectrum as a list (instead of patterns)\n"
     "        #     pattern spectrum as a dictionary\n"
+    "        +     (prefix) triplets with separate perfect exts.\n"
+    "              (cannot be combined with a support border)\n"
     "eval    measure for item set evaluation        (default: x)\n"
     "        x     none       no measure / zero (default)\n"
     "        b     ldratio    binary logarithm of support quotient\n"
@@ -2613,6 +3602,25 @@ static PyMethodDef fim_methods[] = {
     "border  support border for filtering item sets (default: None)\n"
     "        Must be a list or tuple of (absolute) minimum support values\n"
     "        per item set size (by which the list/tuple is indexed).\n"
+    "cpus    number of threads for the search       (default: 1)\n"
+    "        A value <= 0 means all cpus reported as available.\n"
+    "        Threads are used only for the algorithms s, b and d and\n"
+    "        only for all frequent item sets (target 's').\n"
+    "        With several threads, max_results is checked per thread.\n"
+    "max_results  maximum number of patterns     (default: 0, no limit)\n"
+    "max_memory   maximum bytes of memory blocks (default: 0, no limit)\n"
+    "        If a limit is given, a pair (result, status) is returned,\n"
+    "        where status is a dictionary with the keys 'status'\n"
+    "        ('ok', 'max_results' or 'max_memory') and 'count'\n"
+    "        (number of reported patterns). If mining was stopped\n"
+    "        and report is '#' or '=', the key 'estimate' gives an\n"
+    "        estimate of the total number of patterns.\n"
+    "progress     progress function              (default: None)\n"
+    "        Called as progress(nodes, sets, bytes) with the number of\n"
+    "        visited search nodes, the number of reported patterns and\n"
+    "        the bytes in memory blocks. If it returns a true value,\n"
+    "        the search is cancelled and the status is 'cancelled'.\n"
+    "        If it is given, a pair (result, status) is returned.\n"
     "returns a list of pairs (i.e. tuples with two elements),\n"
     "        each consisting of a tuple with a found frequent item set\n"
     "        and a tuple listing the values selected with 'report' *or*\n"
@@ -2620,7 +3628,8 @@ static PyMethodDef fim_methods[] = {
   },
   { "relim", (PyCFunction)py_relim, METH_VARARGS|METH_KEYWORDS,
     "relim (tracts, target='s', supp=10, zmin=1, zmax=None, report='a',\n"
-    "       eval='x', thresh=10, algo='s', mode='', border=None)\n"
+    "       eval='x', thresh=10, algo='s', mode='', border=None,\n"
+    "       cpus=1, max_results=0, max_memory=0, progress=None)\n"
     "Find frequent item sets with the RElim algorithm.\n"
     "tracts  transaction database to mine (mandatory)\n"
     "        The database must be an iterable of transactions;\n"
@@ -2644,6 +3653,8 @@ static PyMethodDef fim_methods[] = {
     "        E     value of item set evaluation measure as a percentage\n"
     "        =     pattern spectrum as a list (instead of patterns)\n"
     "        #     pattern spectrum as a dictionary\n"
+    "        +     (prefix) triplets with separate perfect exts.\n"
+    "              (cannot be combined with a support border)\n"
     "eval    measure for item set evaluation        (default: x)\n"
     "        x     none       no measure / zero (default)\n"
     "        b     ldratio    binary logarithm of support quotient\n"
@@ -2657,6 +3668,25 @@ static PyMethodDef fim_methods[] = {
     "border  support border for filtering item sets (default: None)\n"
     "        Must be a list or tuple of (absolute) minimum support values\n"
     "        per item set size (by which the list/tuple is indexed).\n"
+    "cpus    number of threads for the search       (default: 1)\n"
+    "        A value <= 0 means all cpus reported as available.\n"
+    "        Threads are used only for all frequent item sets\n"
+    "        (target 's'); the result is the same as with one thread.\n"
+    "        With several threads, max_results is checked per thread.\n"
+    "max_results  maximum number of patterns     (default: 0, no limit)\n"
+    "max_memory   maximum bytes of memory blocks (default: 0, no limit)\n"
+    "        If a limit is given, a pair (result, status) is returned,\n"
+    "        where status is a dictionary with the keys 'status'\n"
+    "        ('ok', 'max_results' or 'max_memory') and 'count'\n"
+    "        (number of reported patterns). If mining was stopped\n"
+    "        and report is '#' or '=', the key 'estimate' gives an\n"
+    "        estimate of the total number of patterns.\n"
+    "progress     progress function              (default: None)\n"
+    "        Called as progress(nodes, sets, bytes) with the number of\n"
+    "        visited search nodes, the number of reported patterns and\n"
+    "        the bytes in memory blocks. If it returns a true value,\n"
+    "        the search is cancelled and the status is 'cancelled'.\n"
+    "        If it is given, a pair (result, status) is returned.\n"
     "returns a list of pairs (i.e. tuples with two elements),\n"
     "        each consisting of a tuple with a found frequent item set\n"
     "        and a tuple listing the values selected with 'report' *or*\n"
@@ -2664,7 +3694,8 @@ static PyMethodDef fim_methods[] = {
   },
   { "carpenter", (PyCFunction)py_carpenter, METH_VARARGS|METH_KEYWORDS,
     "carpenter (tracts, target='s', supp=10, zmin=1, zmax=None, report='a',\n"
-    "           eval='x', thresh=10, algo='a', mode='', border=None)\n"
+    "           eval='x', thresh=10, algo='a', mode='', border=None,\n"
+    "           cpus=1, max_results=0, max_memory=0, progress=None)\n"
     "Find frequent item sets with the Carpenter algorithm.\n"
     "tracts  transaction database to mine (mandatory)\n"
     "        The database must be an iterable of transactions;\n"
@@ -2687,6 +3718,8 @@ static PyMethodDef fim_methods[] = {
     "        E     value of item set evaluation measure as a percentage\n"
     "        =     pattern spectrum as a list (instead of patterns)\n"
     "        #     pattern spectrum as a dictionary\n"
+    "        +     (prefix) triplets with separate perfect exts.\n"
+    "              (cannot be combined with a support border)\n"
     "eval    measure for item set evaluation        (default: x)\n"
     "        x     none       no measure / zero (default)\n"
     "        b     ldratio    binary logarithm of support quotient\n"
@@ -2703,6 +3736,24 @@ static PyMethodDef fim_methods[] = {
     "border  support border for filtering item sets (default: None)\n"
     "        Must be a list or tuple of (absolute) minimum support values\n"
     "        per item set size (by which the list/tuple is indexed).\n"
+    "cpus    number of threads for the search       (default: 1)\n"
+    "        A value <= 0 means all cpus reported as available.\n"
+    "        Each thread collects item sets in a repository of its own;\n"
+    "        the repositories are merged before the sets are reported.\n"
+    "max_results  maximum number of patterns     (default: 0, no limit)\n"
+    "max_memory   maximum bytes of memory blocks (default: 0, no limit)\n"
+    "        If a limit is given, a pair (result, status) is returned,\n"
+    "        where status is a dictionary with the keys 'status'\n"
+    "        ('ok', 'max_results' or 'max_memory') and 'count'\n"
+    "        (number of reported patterns). If mining was stopped\n"
+    "        and report is '#' or '=', the key 'estimate' gives an\n"
+    "        estimate of the total number of patterns.\n"
+    "progress     progress function              (default: None)\n"
+    "        Called as progress(nodes, sets, bytes) with the number of\n"
+    "        visited search nodes, the number of reported patterns and\n"
+    "        the bytes in memory blocks. If it returns a true value,\n"
+    "        the search is cancelled and the status is 'cancelled'.\n"
+    "        If it is given, a pair (result, status) is returned.\n"
     "returns a list of pairs (i.e. tuples with two elements),\n"
     "        each consisting of a tuple with a found frequent item set\n"
     "        and a tuple listing the values selected with 'report' *or*\n"
@@ -2710,7 +3761,8 @@ static PyMethodDef fim_methods[] = {
   },
   { "ista", (PyCFunction)py_ista, METH_VARARGS|METH_KEYWORDS,
     "ista (tracts, target='s', supp=10, zmin=1, zmax=None, report='a',\n"
-    "      eval='x', thresh=10, algo='x', mode='', border=None)\n"
+    "      eval='x', thresh=10, algo='x', mode='', border=None,\n"
+    "      cpus=1, max_results=0, max_memory=0, progress=None)\n"
     "Find frequent item sets with the IsTa algorithm.\n"
     "tracts  transaction database to mine (mandatory)\n"
     "        The database must be an iterable of transactions;\n"
@@ -2733,6 +3785,8 @@ static PyMethodDef fim_methods[] = {
     "        E     value of item set evaluation measure as a percentage\n"
     "        =     pattern spectrum as a list (instead of patterns)\n"
     "        #     pattern spectrum as a dictionary\n"
+    "        +     (prefix) triplets with separate perfect exts.\n"
+    "              (cannot be combined with a support border)\n"
     "eval    measure for item set evaluation        (default: x)\n"
     "        x     none       no measure / zero (default)\n"
     "        b     ldratio    binary logarithm of support quotient\n"
@@ -2748,6 +3802,28 @@ static PyMethodDef fim_methods[] = {
     "border  support border for filtering item sets (default: None)\n"
     "        Must be a list or tuple of (absolute) minimum support values\n"
     "        per item set size (by which the list/tuple is indexed).\n"
+    "cpus    number of threads for the search       (default: 1)\n"
+    "        A value <= 0 means all cpus reported as available.\n"
+    "        Each thread intersects a shard of the transactions;\n"
+    "        the resulting trees are merged by intersecting them.\n"
+    "        (experimental: this only pays off if the shards yield\n"
+    "        few closed item sets compared to their transactions,\n"
+    "        e.g. if most items occur only in some of the shards;\n"
+    "        otherwise it may take about twice the CPU time)\n"
+    "max_results  maximum number of patterns     (default: 0, no limit)\n"
+    "max_memory   maximum bytes of memory blocks (default: 0, no limit)\n"
+    "        If a limit is given, a pair (result, status) is returned,\n"
+    "        where status is a dictionary with the keys 'status'\n"
+    "        ('ok', 'max_results' or 'max_memory') and 'count'\n"
+    "        (number of reported patterns). If mining was stopped\n"
+    "        and report is '#' or '=', the key 'estimate' gives an\n"
+    "        estimate of the total number of patterns.\n"
+    "progress     progress function              (default: None)\n"
+    "        Called as progress(nodes, sets, bytes) with the number of\n"
+    "        visited search nodes, the number of reported patterns and\n"
+    "        the bytes in memory blocks. If it returns a true value,\n"
+    "        the search is cancelled and the status is 'cancelled'.\n"
+    "        If it is given, a pair (result, status) is returned.\n"
     "returns a list of pairs (i.e. tuples with two elements),\n"
     "        each consisting of a tuple with a found frequent item set\n"
     "        and a tuple listing the values selected with 'report' *or*\n"
@@ -2776,6 +3852,8 @@ static PyMethodDef fim_methods[] = {
     "        P     p-value of item set test as a percentage\n"
     "        =     pattern spectrum as a list (instead of patterns)\n"
     "        #     pattern spectrum as a dictionary\n"
+    "        +     (prefix) triplets with separate perfect exts.\n"
+    "              (cannot be combined with a support border)\n"
     "stat    test statistic for item set evaluation (default: c)\n"
     "        x     none     no statistic / zero\n"
     "        c/n/p chi2     chi^2 measure (default)\n"
@@ -2822,6 +3900,8 @@ static PyMethodDef fim_methods[] = {
     "        P     p-value of item set test as a percentage\n"
     "        =     pattern spectrum as a list (instead of patterns)\n"
     "        #     pattern spectrum as a dictionary\n"
+    "        +     (prefix) triplets with separate perfect exts.\n"
+    "              (cannot be combined with a support border)\n"
     "stat    test statistic for item set evaluation (default: c)\n"
     "        x     none     no statistic / zero\n"
     "        c/p/n chi2     chi^2 measure (default)\n"
@@ -2904,6 +3984,32 @@ static PyMethodDef fim_methods[] = {
     "        (size, support) to the corresponding occurrence counters\n"
     "        or as a list of triplets (size, support, count)"
   },
+  { "readbin", (PyCFunction)py_readbin, METH_VARARGS|METH_KEYWORDS,
+    "readbin (fname)\n"
+    "Read a binary item set file.\n"
+    "fname   name of the file to read               (mandatory)\n"
+    "        The file must have been written in binary format\n"
+    "        (command line option -B of the mining programs).\n"
+    "returns a list of pairs (i.e. tuples with two elements), each\n"
+    "        consisting of a tuple with an item set and a tuple with\n"
+    "        its support and (if stored in the file) its evaluation.\n"
+    "        Items are returned as names if the file contains names,\n"
+    "        otherwise as integer item identifiers."
+  },
+  { "expand", (PyCFunction)py_expand, METH_VARARGS|METH_KEYWORDS,
+    "expand (isets, zmin=1, zmax=None)\n"
+    "Expand the perfect extensions of item sets (lazily).\n"
+    "isets   compressed item sets                   (mandatory)\n"
+    "        as returned by a mining function with report='+...',\n"
+    "        that is, an iterable of triplets (items, pexs, values),\n"
+    "        where pexs is a tuple of perfect extensions of items.\n"
+    "zmin    minimum number of items per item set   (default: 1)\n"
+    "zmax    maximum number of items per item set   (default: no limit)\n"
+    "        (should be the same values as used for mining)\n"
+    "returns an iterator over pairs (set, values), which yields the\n"
+    "        item set combined with each subset of its perfect exts.\n"
+    "        (the values of the generator are shared by all sets)"
+  },
   { NULL }                      /* sentinel */
 };
 
@@ -2922,11 +4028,17 @@ static struct PyModuleDef fimdef = {
 };
 
 PyObject* PyInit_fim (void)
-{ return PyModule_Create(&fimdef); }
+{                               /* --- initialize the module */
+  if (PyType_Ready(&pxi_type) < 0) return NULL;
+  return PyModule_Create(&fimdef);
+}  /* PyInit_fim() */
 
 #else
 
 PyMODINIT_FUNC initfim (void)
-{ Py_InitModule3("fim", fim_methods, FIM_DESC); }
+{                               /* --- initialize the module */
+  if (PyType_Ready(&pxi_type) < 0) return;
+  Py_InitModule3("fim", fim_methods, FIM_DESC);
+}  /* initfim() */
 
 #endif
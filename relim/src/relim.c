@@ -50,6 +50,13 @@
             2014.08.02 option -c renamed to -i (min. supp. with insert.)
             2014.08.28 functions relim_data() and relim_repo() added
             2014.10.24 changed from LGPL license to MIT license
+            2026.10.18 option -B added (binary item set output)
+            2026.10.18 progress/cancellation polling in recursion
+            2026.10.18 projection arrays allocated on a memory stack
+            2026.10.18 parallel search with worker threads added
+            2026.10.18 t-norm selected with a switch (no function pointer)
+            2026.10.18 bug with empty transactions in relim_ins/lim fixed
+            2026.10.18 worker threads moved to module thdpool
 ------------------------------------------------------------------------
   Reference for the RElim algorithm:
     C. Borgelt.
@@ -61,6 +68,7 @@
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <stdarg.h>
 #include <limits.h>
 #include <float.h>
@@ -83,6 +91,9 @@
 #ifdef RELIM_MAIN
 #include "error.h"
 #endif
+#ifdef REM_THREADS
+#include "thdpool.h"
+#endif
 #ifdef STORAGE
 #include "storage.h"
 #endif
@@ -124,10 +135,23 @@
 
 #define SEC_SINCE(t)  ((double)(clock()-(t)) /(double)CLOCKS_PER_SEC)
 
+#define STKBLK      (1 << 20)   /* block size of projection stack */
+#define LSTIDX(i)   (((i) < 0) ? 0 : (i)+1)
+                                /* list index for a first item */
+
+#ifdef REM_THREADS
+#ifndef REM_PARMIN              /* minimum number of list elements */
+#define REM_PARMIN  256         /* in a projection for a thread */
+#endif
+#define REM_POLL    1024        /* search nodes between stop checks */
+#define TOPLEVEL(d) ((d)->pool) /* top level of a parallel search */
+#else                           /* if no multi-threading */
+#define TOPLEVEL(d) 0           /* always sequential search */
+#endif
+
 /*----------------------------------------------------------------------
   Type Definitions
 ----------------------------------------------------------------------*/
-typedef double TNORM (double a, double b);
 
 typedef struct tsle {           /* --- trans. suffix list element --- */
   struct tsle *succ;            /* successor element in list */
@@ -172,13 +196,30 @@ typedef struct {                /* --- recursion data --- */
   SUPP         supp;            /* minimum support of an item set */
   double       sins;            /* minimum support with insertions */
   double       min;             /* minimum transaction weight */
-  TNORM        *tnorm;          /* t-norm for comb. item penalties */
+  int          tnorm;           /* t-norm for comb. item penalties */
   FIM16        *fim16;          /* 16 items machine */
   ITEM         sort;            /* threshold for list sorting */
   ITEMBASE     *base;           /* underlying item base */
   ISREPORT     *report;         /* item set reporter */
+  MSSTACK      *stk;            /* memory stack for projections */
+  #ifdef REM_THREADS            /* if multi-threading is available */
+  THDPOOL      *pool;           /* pool of worker threads (or NULL) */
+  #endif
 } RECDATA;                      /* (recursion data) */
 
+#ifdef REM_THREADS
+typedef int RECFN (TSLIST *lists, ITEM k, TID n, RECDATA *rd);
+
+typedef struct {                /* --- task of a worker thread --- */
+  RECFN        *recfn;          /* recursion function to execute */
+  RECDATA      rd;              /* recursion data of the worker */
+  TSLIST       *buf;            /* buffer for the projection */
+  size_t       size;            /* size of the buffer in bytes */
+  ITEM         k;               /* number of lists in projection */
+  TID          n;               /* number of list elements */
+} TASK;                         /* (task of a worker thread) */
+#endif
+
 /*----------------------------------------------------------------------
   Constants
 ----------------------------------------------------------------------*/
@@ -286,13 +327,16 @@ static double t_hama (double a, double b)
 
 /*--------------------------------------------------------------------*/
 
-static TNORM *tnorms[] = {      /* t-norms (triangular norms) */
-  /* T_MIN    0 */  t_min,      /* minimum */
-  /* T_NILP   1 */  t_nilp,     /* nil-potent minimum */
-  /* T_PROD   2 */  t_prod,     /* product */
-  /* T_LUKA   3 */  t_luka,     /* Lukasiewicz */
-  /* T_HAMA   4 */  t_hama,     /* Hamacher product */
-};
+static double t_eval (int tnorm, double a, double b)
+{                               /* --- evaluate a t-norm */
+  switch (tnorm) {              /* select the t-norm with a switch, */
+    case T_NILP: return t_nilp(a, b);  /* so that the compiler can */
+    case T_PROD: return t_prod(a, b);  /* inline it into the loops */
+    case T_LUKA: return t_luka(a, b);  /* and hoist the selection */
+    case T_HAMA: return t_hama(a, b);  /* out of them (instead of */
+    default:     return t_min (a, b);  /* an indirect call for each */
+  }                             /* transaction list element) */
+}  /* t_eval() */
 
 /*----------------------------------------------------------------------
   Comparing and Sorting
@@ -362,6 +406,136 @@ SORT(sort_ext, TXLE)
                                 if (!a || !b) break; }
 SORT(sort_wgt, TZLE)
 
+/*----------------------------------------------------------------------
+  Parallel Search
+----------------------------------------------------------------------*/
+#ifdef REM_THREADS
+
+static int task (void *data)
+{                               /* --- search a projection */
+  TASK *t = (TASK*)data;        /* type the argument pointer */
+  int  r = 0;                   /* error status */
+
+  assert(data);                 /* check the function argument */
+  if (t->k > 0)                 /* if there is a projection, search it */
+    r = t->recfn(t->buf, t->k, t->n, &t->rd);
+  if (r >= 0)                   /* report the prefix (with the perfect */
+    r = isr_report(t->rd.report);  /* extensions found in the search) */
+  return r;                     /* return the error status */
+}  /* task() */
+
+/*--------------------------------------------------------------------*/
+
+static int spawn (TSLIST *proj, ITEM k, TSLE *elems, TID n,
+                  RECDATA *rd)
+{                               /* --- hand a projection to a worker */
+  ITEM    i;                    /* loop variable for lists */
+  TID     t;                    /* loop variable for elements */
+  size_t  z;                    /* size of the projection */
+  TPLWORK *w;                   /* worker to hand the projection to */
+  TASK    *x;                   /* task data of the worker */
+  TSLIST  *buf;                 /* (reallocated) projection buffer */
+  TSLE    *dst;                 /* list elements in the buffer */
+
+  assert(rd && rd->pool);       /* check the function arguments */
+  w = tpl_next(rd->pool);       /* get the worker that is next in */
+  if (!w) return -1;            /* turn (collecting its result) */
+  x = (TASK*)tpl_data(w);       /* get the task data of the worker */
+  x->k = (proj) ? k : 0;        /* note the size of the projection */
+  x->n = (proj) ? n : 0;        /* (no projection: only report) */
+  z = (size_t)x->k *sizeof(TSLIST) +(size_t)x->n *sizeof(TSLE);
+  if (z > x->size) {            /* if the buffer is too small */
+    buf = (TSLIST*)realloc(x->buf, z);
+    if (!buf) { tpl_stop(rd->pool); return -1; }
+    x->buf = buf; x->size = z;  /* enlarge the projection buffer */
+  }
+  dst = (TSLE*)(x->buf +x->k);  /* get the element array */
+  for (i = 0; i < x->k; i++) {  /* traverse the transaction lists */
+    x->buf[i].occ  = proj[i].occ;
+    x->buf[i].head = (proj[i].head) ? dst +(proj[i].head -elems) : NULL;
+  }                             /* copy the list heads */
+  for (t = 0; t < x->n; t++) {  /* traverse the list elements */
+    dst[t].items = elems[t].items;
+    dst[t].occ   = elems[t].occ;
+    dst[t].succ  = (elems[t].succ) ? dst +(elems[t].succ -elems) : NULL;
+  }                             /* copy the list elements */
+  if (proj) memset(proj, 0, (size_t)k *sizeof(TSLIST));
+  isr_prefix(x->rd.report, rd->report);
+  if ((x->n >= REM_PARMIN)      /* copy the current item set and */
+  &&  (tpl_start(w) == 0))      /* hand a large enough projection */
+    return 0;                   /* to a worker thread */
+  return (tpl_run(w) < 0) ? -1 : 0;
+}  /* spawn() */                /* otherwise search it directly */
+
+/* The function spawn() is called on the top level of the recursion */
+/* instead of the recursion and the reporting of the current item   */
+/* set. It copies the projection into the buffer of the worker that */
+/* is next in turn, relocating the list pointers, and clears the    */
+/* projection, as a recursion would. Small projections are searched */
+/* directly by the calling thread, but in the reporter shard of the */
+/* worker. Since the workers are used in turn and a worker is only  */
+/* reused after its result was merged, the results are merged in    */
+/* the order in which the items are processed, so that the output   */
+/* is the same as that of a sequential search.                      */
+
+/*--------------------------------------------------------------------*/
+
+static int parallel (TSLIST *lists, ITEM k, TID n, RECFN *recfn,
+                     RECDATA *rd, int cpus)
+{                               /* --- search with multiple threads */
+  int     i, r;                 /* loop variable, error status */
+  THDPOOL *pool;                /* pool of worker threads */
+  TASK    *tasks, *t;           /* task data of the workers */
+
+  assert(lists && recfn && rd && (cpus > 1));
+  if ((n < REM_PARMIN)          /* threads only for large databases */
+  ||  (isr_target(rd->report) & (ISR_CLOSED|ISR_MAXIMAL|ISR_GENERAS)))
+    return recfn(lists, k, n, rd);  /* (and without filtering) */
+  pool = tpl_create(rd->report, cpus, task, REM_POLL);
+  if (!pool) return recfn(lists, k, n, rd);
+  tasks = (TASK*)calloc((size_t)cpus, sizeof(TASK));
+  if (!tasks) { tpl_delete(pool); return recfn(lists, k, n, rd); }
+  for (i = 0; i < tpl_cnt(pool); i++) {
+    t = tasks +i;               /* traverse the workers */
+    t->recfn     = recfn;       /* copy the recursion data */
+    t->rd        = *rd;         /* (workers do not spawn threads) */
+    t->rd.pool   = NULL;        /* and use the reporter shard */
+    t->rd.report = tpl_report(tpl_worker(pool, i));
+    t->rd.stk    = mst_create(STKBLK);
+    t->rd.fim16  = NULL;        /* create a private memory stack */
+    if (t->rd.stk && rd->fim16)
+      t->rd.fim16 = m16_create(-1, rd->supp, t->rd.report);
+    if (!t->rd.stk || (rd->fim16 && !t->rd.fim16)) {
+      if (t->rd.stk) mst_delete(t->rd.stk);
+      break;                    /* and 16 items machine; on failure */
+    }                           /* delete the created objects */
+    tpl_setdata(tpl_worker(pool, i), t);
+  }
+  tpl_setcnt(pool, i);          /* note the number of workers */
+  rd->pool = (i > 0) ? pool : NULL;
+  r = recfn(lists, k, n, rd);   /* execute the top level and */
+  rd->pool = NULL;              /* hand off the projections */
+  if (r < 0) tpl_stop(pool);    /* on failure stop all workers */
+  if ((i > 0) && (tpl_drain(pool) < 0))
+    r = -1;                     /* collect the remaining results */
+  while (--i >= 0) {            /* traverse the workers */
+    t = tasks +i;               /* delete the 16 items machine, */
+    if (t->rd.fim16) m16_delete(t->rd.fim16);
+    mst_delete(t->rd.stk);      /* the memory stack */
+    if (t->buf) free(t->buf);   /* and the projection buffer */
+  }
+  tpl_delete(pool);             /* delete the pool of workers */
+  free(tasks);                  /* and the task data */
+  return r;                     /* return the error status */
+}  /* parallel() */
+
+/* Only the top level of the recursion is split into tasks, one for */
+/* each frequent item. Since the calling thread merely builds the   */
+/* projections and reassigns the transaction suffixes, there are as */
+/* many workers as threads. The workers only check for a stop.      */
+
+#endif  /* #ifdef REM_THREADS */
+
 /*----------------------------------------------------------------------
   Recursive Elimination: Basic Version
 ----------------------------------------------------------------------*/
@@ -376,9 +550,12 @@ static int recurse (TSLIST *lists, ITEM k, TID n, RECDATA *rd)
   SUPP   pex;                   /* minimum support for perfect exts. */
 
   assert(lists && (k > 0));     /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
   if ((k > 1)                   /* if there is more than one item */
   &&  isr_xable(rd->report,2)){ /* and another item can be added */
-    proj = (TSLIST*)malloc((size_t)(k-1) *sizeof(TSLIST)
+    proj = (TSLIST*)mst_alloc(rd->stk,
+                           (size_t)(k-1) *sizeof(TSLIST)
                           +(size_t) n    *sizeof(TSLE));
     if (!proj) return -1;       /* allocate list and element arrays */
     elems = (TSLE*)(proj +k-1); /* and organize the memory */
@@ -407,9 +584,17 @@ static int recurse (TSLIST *lists, ITEM k, TID n, RECDATA *rd)
             dst->succ  = tal->head;   /* the number of occurrences */
             tal->head  = dst++; /* add the new element at the head */
           }                     /* of the corresponding list */
-          r = recurse(proj, k, (TID)(dst-elems), rd);
-          if (r < 0) break;     /* find frequent item sets */
-        }                       /* recursively in the projection */
+          if (!TOPLEVEL(rd)) {  /* if not to hand off the projection */
+            r = recurse(proj, k, (TID)(dst-elems), rd);
+            if (r < 0) break;   /* find frequent item sets */
+          }                     /* recursively in the projection */
+        }
+        #ifdef REM_THREADS      /* if on top level of parallel search */
+        if (TOPLEVEL(rd))       /* hand the projection to a worker */
+          r = spawn((cur->head && proj) ? proj : NULL, k, elems,
+                    (cur->head && proj) ? (TID)(dst-elems) : 0, rd);
+        else                    /* otherwise report the current set */
+        #endif
         r = isr_report(rd->report);
         if (r < 0) break;       /* report the current item set */
         isr_remove(rd->report, 1);
@@ -426,7 +611,7 @@ static int recurse (TSLIST *lists, ITEM k, TID n, RECDATA *rd)
       tal->head = src;          /* based on their first items */
     }                           /* and skip this first item */
   }
-  if (proj) free(proj);         /* delete the list and element arrays */
+  if (proj) mst_free(rd->stk, proj); /* delete list/element arrays */
   return r;                     /* return the error status */
 }  /* recurse() */
 
@@ -468,9 +653,20 @@ int relim_base (TABAG *tabag, int target, SUPP supp,
     dst->succ = tal->head;      /* skip one element transactions */
     tal->head = dst++;          /* add the new element to the */
   }                             /* list for the first item */
+  rd.stk = mst_create(STKBLK);  /* create a memory stack */
+  if (!rd.stk) { free(lists); return -1; }    /* for projections */
+  rd.fim16  = NULL;             /* no 16 items machine */
   rd.report = report;           /* note the item set reporter */
+  #ifdef REM_THREADS            /* if multi-threading is available */
+  rd.pool = NULL;               /* and several threads are requested, */
+  if ((mode & REM_CPUS) > REM_CPU1)  /* search with worker threads */
+    r = parallel(lists, k, (TID)(dst-elems), recurse, &rd,
+                 (mode & REM_CPUS) >> 8);
+  else                          /* otherwise execute the recursive */
+  #endif                        /* elimination directly */
   r = recurse(lists, k, (TID)(dst-elems), &rd);
-  free(lists);                  /* execute recursive elimination */
+  mst_delete(rd.stk);           /* execute recursive elimination */
+  free(lists);                  /* and deallocate working memory */
   if (r >= 0)                   /* if no error occurred, */
     r = isr_report(report);     /* report the empty item set */
   return r;                     /* return the error status */
@@ -491,9 +687,12 @@ static int rec_m16 (TSLIST *lists, ITEM k, TID n, RECDATA *rd)
   SUPP   pex;                   /* minimum support for perfect exts. */
 
   assert(lists && (k > 0));     /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
   if ((k > 1)                   /* if there is more than one item */
   &&  isr_xable(rd->report,2)){ /* and another item can be added */
-    proj = (TSLIST*)malloc((size_t)(k-1) *sizeof(TSLIST)
+    proj = (TSLIST*)mst_alloc(rd->stk,
+                           (size_t)(k-1) *sizeof(TSLIST)
                           +(size_t)(n+1) *sizeof(TSLE));
     if (!proj) return -1;       /* allocate list and element arrays */
     elems = (TSLE*)(proj +k-1); /* and organize the memory */
@@ -530,9 +729,17 @@ static int rec_m16 (TSLIST *lists, ITEM k, TID n, RECDATA *rd)
             dst->succ  = tal->head;   /* the number of occurrences */
             tal->head  = dst++; /* add the new element at the head */
           }                     /* of the corresponding list */
-          r = rec_m16(proj, k, (TID)(dst-elems), rd);
-          if (r < 0) break;     /* find frequent item sets */
-        }                       /* recursively in the projection */
+          if (!TOPLEVEL(rd)) {  /* if not to hand off the projection */
+            r = rec_m16(proj, k, (TID)(dst-elems), rd);
+            if (r < 0) break;   /* find frequent item sets */
+          }                     /* recursively in the projection */
+        }
+        #ifdef REM_THREADS      /* if on top level of parallel search */
+        if (TOPLEVEL(rd))       /* hand the projection to a worker */
+          r = spawn((cur->head && proj) ? proj : NULL, k, elems,
+                    (cur->head && proj) ? (TID)(dst-elems) : 0, rd);
+        else                    /* otherwise report the current set */
+        #endif
         r = isr_report(rd->report);
         if (r < 0) break;       /* report the current item set */
         isr_remove(rd->report, 1);
@@ -556,13 +763,17 @@ static int rec_m16 (TSLIST *lists, ITEM k, TID n, RECDATA *rd)
       tal->head = src;          /* based on their first items */
     }                           /* and skip this first item */
   }
+  #ifdef REM_THREADS            /* if on top level of parallel search */
+  if (TOPLEVEL(rd) && (tpl_drain(rd->pool) < 0))
+    r = -1;                     /* merge the results of the workers */
+  #endif                        /* before the packed items are mined */
   if ((r >= 0) && (lists->occ >= rd->supp)) {
     for (src = lists->head; src; src = src->succ)
       m16_add(rd->fim16, (BITTA)(src->items[0] & ~TA_END), src->occ);
     r = m16_mine(rd->fim16);    /* traverse and add packed items */
   }                             /* and mine with 16 items machine */
   lists->head = NULL; lists->occ = 0;
-  if (proj) free(proj);         /* delete the list and element arrays */
+  if (proj) mst_free(rd->stk, proj); /* delete list/element arrays */
   return r;                     /* return the error status */
 }  /* rec_m16() */
 
@@ -613,10 +824,20 @@ int relim_m16 (TABAG *tabag, int target, SUPP supp,
     dst->succ = tal->head;      /* skip one element transactions */
     tal->head = dst++;          /* add the new element to the */
   }                             /* list for the first item */
+  rd.stk = mst_create(STKBLK);  /* create a memory stack */
+  if (!rd.stk) { m16_delete(rd.fim16); free(lists); return -1; }
   rd.report = report;           /* note the item set reporter */
+  #ifdef REM_THREADS            /* if multi-threading is available */
+  rd.pool = NULL;               /* and several threads are requested, */
+  if ((mode & REM_CPUS) > REM_CPU1)  /* search with worker threads */
+    r = parallel(lists, k, (TID)(dst -elems), rec_m16, &rd,
+                 (mode & REM_CPUS) >> 8);
+  else                          /* otherwise execute the recursive */
+  #endif                        /* elimination directly */
   r = rec_m16(lists, k, (TID)(dst -elems), &rd);
   m16_delete(rd.fim16);         /* execute recursive elimination */
-  free(lists);                  /* and deallocate working memory */
+  mst_delete(rd.stk);           /* and deallocate working memory */
+  free(lists);
   if (r >= 0)                   /* if no error occurred, */
     r = isr_report(report);     /* report the empty item set */
   return r;                     /* return the error status */
@@ -638,9 +859,12 @@ static int rec_ins (TXLIST *lists, ITEM k, TID n, RECDATA *rd)
   double pex;                   /* minimum weight for perfect exts. */
 
   assert(lists && (k > 0));     /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
   if ((k > 1)                   /* if there is more than one item */
   &&  isr_xable(rd->report,2)){ /* and another item can be added */
-    proj = (TXLIST*)malloc((size_t)k *sizeof(TXLIST)
+    proj = (TXLIST*)mst_alloc(rd->stk,
+                           (size_t)k *sizeof(TXLIST)
                           +(size_t)n *sizeof(TXLE));
     if (!proj) return -1;       /* allocate list and element arrays */
     elems = (TXLE*)(proj +k);   /* and organize the memory */
@@ -656,7 +880,7 @@ static int rec_ins (TXLIST *lists, ITEM k, TID n, RECDATA *rd)
     if (pen > 0) {              /* if insertion penalty is positive */
       for (i = k+1; --i >= 0;){ /* traverse the preceding lists */
         for (src = lists[i].head; src; src = src->succ) {
-          cur->wgt  += wgt = rd->tnorm(src->wgt, pen);
+          cur->wgt  += wgt = t_eval(rd->tnorm, src->wgt, pen);
           if (!dst) continue;   /* sum the transaction weight */
           tal        = proj +i; /* for current and projected list */
           tal->wgt  += dst->wgt = wgt;
@@ -685,8 +909,8 @@ static int rec_ins (TXLIST *lists, ITEM k, TID n, RECDATA *rd)
           &&  (k <= rd->sort))  /* sort the transaction list */
             cur->head = sort_ext(cur->head);
           for (src = cur->head; src; src = src->succ) {
-            i   = *src->items+1;/* get first item and its list and */
-            tal = proj +i;      /* sum the transaction weights */
+            i   = LSTIDX(*src->items);  /* get first item and */
+            tal = proj +i;      /* its list and sum the weights */
             tal->occ  += dst->occ = src->occ;
             tal->wgt  += dst->wgt = src->wgt;
             dst->items = src->items +((i > 0) ? 1 : 0);
@@ -707,7 +931,7 @@ static int rec_ins (TXLIST *lists, ITEM k, TID n, RECDATA *rd)
     while (cur->head) {         /* while the list is not empty */
       src       = cur->head;    /* remove the first element */
       cur->head = src->succ;    /* from the transaction list */
-      i = *src->items +1;       /* get the first item and skip it */
+      i = LSTIDX(*src->items);  /* get the first item and skip it */
       if (i > 0) src->items++;  /* if it is not the sentinel */
       tal       = lists +i;     /* get the destination list */
       tal->occ += src->occ;     /* sum the number of occurrences */
@@ -716,7 +940,7 @@ static int rec_ins (TXLIST *lists, ITEM k, TID n, RECDATA *rd)
       tal->head = src;          /* based on their first items */
     }                           /* and skip this first item */
   }
-  if (proj) free(proj);         /* delete the list and element arrays */
+  if (proj) mst_free(rd->stk, proj); /* delete list/element arrays */
   return r;                     /* return the error status */
 }  /* rec_ins() */
 
@@ -738,9 +962,9 @@ int relim_ins (TABAG *tabag, int target, SUPP supp, double sins,
   rd.sins = (sins > 0) ? sins : DBL_MIN;
   rd.mode = mode & REM_PERFECT; /* check and adapt minimum support */
   rd.sort = sort;               /* and initialize the recursion data */
-  if ((tnorm < 0) || (tnorm >= (int)(sizeof(tnorms)/sizeof(*tnorms))))
+  if ((tnorm < T_MIN) || (tnorm > T_HAMA))
     tnorm = T_MIN;              /* check and adapt the t-norm */
-  rd.tnorm = tnorms[tnorm];     /* note the t-norm for item weights */
+  rd.tnorm = tnorm;             /* note the t-norm for item weights */
   if (tbg_wgt(tabag) < supp)    /* check the total transaction weight */
     return 0;                   /* against the minimum support */
   k = tbg_itemcnt(tabag);       /* get and check the number of items */
@@ -754,7 +978,7 @@ int relim_ins (TABAG *tabag, int target, SUPP supp, double sins,
   while (--n >= 0) {            /* traverse the transactions */
     t = tbg_tract(tabag, n);    /* initialize a new list element */
     dst->items = ta_items(t);   /* for each transaction */
-    i = *dst->items +1;         /* get the first item and skip it */
+    i = LSTIDX(*dst->items);    /* get the first item and skip it */
     if (i > 0) dst->items++;    /* if it is not the sentinel */
     tal       = lists +i;       /* sum transaction weights per item */
     tal->occ += dst->occ = ta_wgt(t);
@@ -762,10 +986,13 @@ int relim_ins (TABAG *tabag, int target, SUPP supp, double sins,
     dst->succ = tal->head;      /* add the new element to the */
     tal->head = dst++;          /* list for the first item */
   }                             /* and skip this item */
+  rd.stk = mst_create(STKBLK);  /* create a memory stack */
+  if (!rd.stk) { free(lists); return -1; }    /* for projections */
   rd.base   = tbg_base(tabag);  /* note the underlying item base */
   rd.report = report;           /* and the item set reporter */
   r = rec_ins(lists, k, (TID)(dst-elems), &rd);
-  free(lists);                  /* execute recursive elimination */
+  mst_delete(rd.stk);           /* execute recursive elimination */
+  free(lists);                  /* and deallocate working memory */
   if (r >= 0)                   /* if no error occurred, */
     r = isr_report(report);     /* report the empty item set */
   return r;                     /* return the error status */
@@ -787,9 +1014,12 @@ static int rec_lim (TZLIST *lists, ITEM k, TID n, RECDATA *rd)
   double pex;                   /* minimum weight for perfect exts. */
 
   assert(lists && (k > 0));     /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
   if ((k > 1)                   /* if there is more than one item */
   &&  isr_xable(rd->report,2)){ /* and another item can be added */
-    proj = (TZLIST*)malloc((size_t)k *sizeof(TZLIST)
+    proj = (TZLIST*)mst_alloc(rd->stk,
+                           (size_t)k *sizeof(TZLIST)
                           +(size_t)n *sizeof(TZLE));
     if (!proj) return -1;       /* allocate list and element arrays */
     elems = (TZLE*)(proj +k);   /* and organize the memory */
@@ -805,7 +1035,7 @@ static int rec_lim (TZLIST *lists, ITEM k, TID n, RECDATA *rd)
     if (pen > 0) {              /* if insertion penalty is positive */
       for (i = k; i >= 0; i--){ /* traverse the preceding lists */
         for (src = lists[i].head; src; src = src->succ) {
-          wgt = rd->tnorm(src->wgt, pen);
+          wgt = t_eval(rd->tnorm, src->wgt, pen);
           if (wgt < rd->min)    /* compute the penalized weight and */
             continue;           /* skip trans. with insuff. weight */
           cur->wgt  += w = wgt *(double)src->cnt;
@@ -839,7 +1069,7 @@ static int rec_lim (TZLIST *lists, ITEM k, TID n, RECDATA *rd)
           &&  (k <= rd->sort))  /* sort the transaction list */
             cur->head = sort_wgt(cur->head);
           for (src = cur->head; src; src = src->succ) {
-            i = *src->items +1; /* get first item and its list */
+            i = LSTIDX(*src->items);  /* get first item and its list */
             tal        = proj+i;/* sum the transaction weights */
             tal->occ  += dst->occ = src->occ;
             dst->cnt   = src->cnt;  /* copy and sum number of occs. */
@@ -863,7 +1093,7 @@ static int rec_lim (TZLIST *lists, ITEM k, TID n, RECDATA *rd)
     while (cur->head) {         /* while the list is not empty */
       src       = cur->head;    /* remove the first element */
       cur->head = src->succ;    /* from the transaction list */
-      i = *src->items +1;       /* get the first item and skip it */
+      i = LSTIDX(*src->items);  /* get the first item and skip it */
       if (i > 0) src->items++;  /* if it is not the sentinel */
       tal       = lists +i;     /* sum the number of occurrences */
       tal->occ += src->occ;     /* and the transaction weights */
@@ -872,7 +1102,7 @@ static int rec_lim (TZLIST *lists, ITEM k, TID n, RECDATA *rd)
       tal->head = src;          /* based on their first items */
     }                           /* and skip this first item */
   }
-  if (proj) free(proj);         /* delete list and element arrays */
+  if (proj) mst_free(rd->stk, proj); /* delete list/element arrays */
   return r;                     /* return the error status */
 }  /* rec_lim() */
 
@@ -896,9 +1126,9 @@ int relim_lim (TABAG *tabag, int target, SUPP supp, double sins,
   rd.min  = (min  > 0) ? min  : DBL_MIN;
   rd.mode = mode & REM_PERFECT; /* check and adapt minimum support */
   rd.sort = sort;               /* and initialize the recursion data */
-  if ((tnorm < 0) || (tnorm >= (int)(sizeof(tnorms)/sizeof(*tnorms))))
+  if ((tnorm < T_MIN) || (tnorm > T_HAMA))
     tnorm = T_MIN;              /* check and adapt the t-norm */
-  rd.tnorm = tnorms[tnorm];     /* note the t-norm for item weights */
+  rd.tnorm = tnorm;             /* note the t-norm for item weights */
   if (tbg_wgt(tabag) < supp)    /* check the total transaction weight */
     return 0;                   /* against the minimum support */
   rd.base  = tbg_base(tabag);   /* note the underlying item base */
@@ -913,7 +1143,7 @@ int relim_lim (TABAG *tabag, int target, SUPP supp, double sins,
   while (--n >= 0) {            /* traverse the transactions */
     t = tbg_tract(tabag, n);    /* initialize a new list element */
     dst->items = ta_items(t);   /* for each transaction */
-    i = *dst->items +1;         /* get the first item and skip it */
+    i = LSTIDX(*dst->items);    /* get the first item and skip it */
     if (i > 0) dst->items++;    /* if it is not the sentinel */
     tal       = lists +i;       /* sum the number of occurrences */
     tal->occ += dst->occ = dst->cnt = ta_wgt(t);
@@ -925,9 +1155,12 @@ int relim_lim (TABAG *tabag, int target, SUPP supp, double sins,
   n = (TID)(dst -elems);        /* shrink memory to needed size */
   lists = (TZLIST*)realloc(lists, (size_t)(k+1) *sizeof(TZLIST)
                                  +(size_t) n    *sizeof(TZLE));
+  rd.stk = mst_create(STKBLK);  /* create a memory stack */
+  if (!rd.stk) { free(lists); return -1; }    /* for projections */
   rd.report = report;           /* note the item set reporter */
   r = rec_lim(lists, k, n, &rd);/* execute recursive elimination */
-  free(lists);                  /* and deallocate the work arrays */
+  mst_delete(rd.stk);           /* and deallocate the work arrays */
+  free(lists);
   if (r >= 0)                   /* if no error occurred, */
     r = isr_report(report);     /* report the empty item set */
   return r;                     /* return the error status */
@@ -1148,6 +1381,7 @@ int main (int argc, char *argv[])
   int     scan     = 0;         /* flag for scanable item output */
   int     bdrcnt   = 0;         /* number of support values in border */
   int     stats    = 0;         /* flag for item set statistics */
+  int     binary   = 0;         /* flag for binary output format */
   PATSPEC *psp;                 /* collected pattern spectrum */
   ITEM    m;                    /* number of items */
   TID     n;                    /* number of transactions */
@@ -1209,6 +1443,8 @@ int main (int argc, char *argv[])
     printf("-P#      write a pattern spectrum to a file\n");
     printf("-Z       print item set statistics "
                     "(number of item sets per size)\n");
+    printf("-B       write item sets in binary format "
+                    "(compressed)\n");
     printf("-g       write output in scanable form "
                     "(quote certain characters)\n");
     printf("-h#      record header  for output                "
@@ -1262,6 +1498,7 @@ int main (int argc, char *argv[])
           case 'R': optarg = &fn_sel;                break;
           case 'P': optarg = &fn_psp;                break;
           case 'Z': stats  = 1;                      break;
+          case 'B': binary = 1;                      break;
           case 'g': scan   = 1;                      break;
           case 'h': optarg = &hdr;                   break;
           case 'k': optarg = &sep;                   break;
@@ -1379,7 +1616,8 @@ int main (int argc, char *argv[])
     error(E_NOMEM);             /* set a pattern spectrum if req. */
   if (isr_setfmt(report, scan, hdr, sep, NULL, info) != 0)
     error(E_NOMEM);             /* set the output format strings */
-  k = isr_open(report, NULL, fn_out);
+  k = (binary) ? isr_openbin(report, NULL, fn_out)
+               : isr_open   (report, NULL, fn_out);
   if (k) error(k, isr_name(report)); /* open the item set file */
   if ((relim_repo(report, target, eval, thresh, algo, mode) < 0)
   ||  (isr_setup(report) < 0))  /* prepare reporter for RElim and */
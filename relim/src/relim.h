@@ -5,6 +5,7 @@
   History : 2013.11.20 file created
             2014.08.22 interface of function relim() changed
             2014.08.28 functions relim_data() and relim_repo() added
+            2026.10.18 mode field REM_CPUS added (number of threads)
 ----------------------------------------------------------------------*/
 #ifndef __RELIM__
 #define __RELIM__
@@ -34,6 +35,8 @@
 /* --- operation modes --- */
 #define REM_FIM16   0x001f      /* use 16 items machine (bit rep.) */
 #define REM_PERFECT 0x0020      /* prune with perfect extensions */
+#define REM_CPUS    0x3f00      /* number of threads (times REM_CPU1) */
+#define REM_CPU1    0x0100      /* one thread (unit of REM_CPUS) */
 #define REM_DEFAULT REM_PERFECT
 #ifdef NDEBUG
 #define REM_NOCLEAN 0x8000      /* do not clean up memory */
@@ -41,6 +41,14 @@
             2014.08.22 adapted to modified item set reporter interface
             2014.08.28 functions sam_data() and sam_repo() added
             2014.10.24 changed from LGPL license to MIT license
+            2026.10.18 option -B added (binary item set output)
+            2026.10.18 memory errors in function sam_tree() reported
+            2026.10.18 progress/cancellation polling in recursion
+            2026.10.18 parallel search with worker threads (SAM_THREADS)
+            2026.10.18 worker threads moved to module thdpool
+            2026.10.18 projection arrays allocated on a memory stack
+            2026.10.18 transaction comparison with ta_cmpitems() (SSE2)
+            2026.10.18 penalized weights computed blockwise (vectorized)
 ------------------------------------------------------------------------
   Reference for the SaM algorithm:
     C. Borgelt and X. Wang.
@@ -52,6 +60,7 @@
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <stdarg.h>
 #include <limits.h>
 #include <float.h>
@@ -74,6 +83,9 @@
 #ifdef SAM_MAIN
 #include "error.h"
 #endif
+#ifdef SAM_THREADS
+#include "thdpool.h"
+#endif
 #ifdef STORAGE
 #include "storage.h"
 #endif
@@ -118,10 +130,19 @@
 
 #define SEC_SINCE(t)  ((double)(clock()-(t)) /(double)CLOCKS_PER_SEC)
 
+#define STKBLK      (1 << 20)   /* block size of projection stack */
+#define cmp         ta_cmpitems /* lexicographic item array comp. */
+
+#ifdef SAM_THREADS
+#ifndef SAM_PARMIN              /* minimum number of transactions */
+#define SAM_PARMIN  256         /* in a projection for a worker */
+#endif
+#define SAM_POLL    1024        /* search nodes between stop checks */
+#endif
+
 /*----------------------------------------------------------------------
   Type Definitions
 ----------------------------------------------------------------------*/
-typedef double TNORM (double a, double b);
 
 typedef struct {                /* --- transaction array element --- */
   const ITEM *items;            /* items in the transaction */
@@ -154,14 +175,30 @@ typedef struct {                /* --- recursion data --- */
   double    sins;               /* minimum support with insertions */
   double    twgt;               /* minimum transaction weight */
   MEMSYS    *mem;               /* memory system for tree version */
-  TNORM     *tnorm;             /* t-norm for comb. item penalties */
+  MSSTACK   *stk;               /* memory stack for projections */
+  int       tnorm;              /* t-norm for comb. item penalties */
   FIM16     *fim16;             /* 16 items machine */
   TID       merge;              /* threshold for source merging */
   void      *buf;               /* buffer for projection */
   ITEMBASE  *base;              /* underlying item base */
   ISREPORT  *report;            /* item set reporter */
+  #ifdef SAM_THREADS            /* if multi-threading is available */
+  THDPOOL   *pool;              /* pool of worker threads (or NULL) */
+  #endif
 } RECDATA;                      /* (recursion data) */
 
+#ifdef SAM_THREADS
+typedef int RECFN (TAAE *a, TID n, RECDATA *rd);
+
+typedef struct {                /* --- task of a worker thread --- */
+  RECFN       *recfn;           /* recursion function to execute */
+  RECDATA     rd;               /* recursion data of the worker */
+  TAAE        *buf;             /* copy of the projection to search */
+  TID         size;             /* size of the projection buffer */
+  TID         n;                /* number of transactions in buffer */
+} TASK;                         /* (task of a worker thread) */
+#endif
+
 /*----------------------------------------------------------------------
   Constants
 ----------------------------------------------------------------------*/
@@ -288,27 +325,136 @@ static double t_hama (double a, double b)
 
 /*--------------------------------------------------------------------*/
 
-static TNORM *tnorms[] = {      /* t-norms (triangular norms) */
-  /* T_MIN    0 */  t_min,      /* minimum */
-  /* T_NILP   1 */  t_nilp,     /* nil-potent minimum */
-  /* T_PROD   2 */  t_prod,     /* product */
-  /* T_LUKA   3 */  t_luka,     /* Lukasiewicz */
-  /* T_HAMA   4 */  t_hama,     /* Hamacher product */
-};
+static void tnvec (double *w, TID n, double p, int tnorm)
+{                               /* --- combine weights with penalty */
+  TID i;                        /* loop variable */
+
+  assert(w && (n >= 0));        /* check the function arguments */
+  switch (tnorm) {              /* one simple loop per t-norm, */
+    case T_NILP: for (i = 0; i < n; i++) w[i] = t_nilp(w[i], p); break;
+    case T_PROD: for (i = 0; i < n; i++) w[i] = t_prod(w[i], p); break;
+    case T_LUKA: for (i = 0; i < n; i++) w[i] = t_luka(w[i], p); break;
+    case T_HAMA: for (i = 0; i < n; i++) w[i] = t_hama(w[i], p); break;
+    default:     for (i = 0; i < n; i++) w[i] = t_min (w[i], p); break;
+  }                             /* so that the compiler can inline */
+}  /* tnvec() */                /* the t-norm and vectorize the loop */
 
 /*----------------------------------------------------------------------
-  Comparison Function
+The item insertion variants combine the weight of every transaction
+that lacks the current item with the insertion penalty of the item.
+Instead of calling the t-norm through a function pointer for each
+transaction inside the (data dependent) merge loop, the weights of
+all transactions that remain after the split are collected into a
+contiguous array and combined with the penalty in one pass, which
+can be executed with SIMD instructions. The merge then only reads
+the precomputed values, so the results are the same as before.
 ----------------------------------------------------------------------*/
 
-static int cmp (const ITEM *a, const ITEM *b)
-{                               /* --- compare two transactions */
-  assert(a && b);               /* check the function arguments */
-  for ( ; 1; a++, b++) {        /* lexicographic comparison loop */
-    if (*a < *b) return -1;     /* compare corresponding items */
-    if (*a > *b) return +1;     /* and if one is greater, abort */
-    if (*a <= TA_END) return 0; /* otherwise check for the sentinel */
-  }                             /* and abort if it is reached */
-}  /* cmp() */
+/*----------------------------------------------------------------------
+  Parallel Search
+----------------------------------------------------------------------*/
+#ifdef SAM_THREADS
+
+static int task (void *data)
+{                               /* --- search a projection */
+  TASK *t = (TASK*)data;        /* type the argument pointer */
+  int  r;                       /* error status */
+
+  assert(data);                 /* check the function argument */
+  r = t->recfn(t->buf, t->n, &t->rd);
+  if (r >= 0)                   /* search the projection and report */
+    r = isr_report(t->rd.report);  /* the prefix (with the perfect */
+  return r;                     /* extensions found in the search) */
+}  /* task() */
+
+/*--------------------------------------------------------------------*/
+
+static int spawn (TAAE *proj, TID n, RECDATA *rd)
+{                               /* --- hand a projection to a worker */
+  TPLWORK *w;                   /* worker to hand the projection to */
+  TASK    *t;                   /* task data of the worker */
+  TAAE    *buf;                 /* (reallocated) projection buffer */
+
+  assert(proj && (n > 0) && rd && rd->pool);
+  w = tpl_idle(rd->pool);       /* get an idle worker */
+  if (!w) return (tpl_stopped(rd->pool)) ? -1 : 0;
+  t = (TASK*)tpl_data(w);       /* get the task data of the worker */
+  if (n >= t->size) {           /* if the buffer is too small */
+    buf = (TAAE*)realloc(t->buf, (size_t)(n+2) *sizeof(TAAE));
+    if (!buf) return 0;         /* enlarge the projection buffer */
+    t->buf = buf; t->size = n+2;/* (search directly on failure) */
+  }
+  memcpy(t->buf, proj, (size_t)(n+1) *sizeof(TAAE));
+  t->n = n;                     /* copy the projection (and sentinel) */
+  isr_prefix(t->rd.report, rd->report);
+  return (tpl_start(w) < 0) ? 0 : 1;
+}  /* spawn() */                /* copy the current item set */
+
+/* The function spawn() returns 1 if the projection was handed to a */
+/* worker thread, which then also reports the current item set (so  */
+/* that perfect extensions found in the projection are considered). */
+/* It returns 0 if no worker is idle or no thread can be started,   */
+/* so that the projection has to be searched by the calling thread. */
+
+/*--------------------------------------------------------------------*/
+
+static int parallel (TAAE *a, TID n, RECFN *recfn, RECDATA *rd,
+                     int cpus)
+{                               /* --- search with multiple threads */
+  int     i, r;                 /* loop variable, error status */
+  THDPOOL *pool;                /* pool of worker threads */
+  TASK    *tasks, *t;           /* task data of the workers */
+
+  assert(a && recfn && rd && (cpus > 1));
+  if ((n < SAM_PARMIN)          /* threads only for large databases */
+  ||  (isr_target(rd->report) & (ISR_CLOSED|ISR_MAXIMAL|ISR_GENERAS)))
+    return recfn(a, n, rd);     /* (and without item set filtering) */
+  pool = tpl_create(rd->report, cpus-1, task, SAM_POLL);
+  if (!pool) return recfn(a, n, rd);
+  tasks = (TASK*)calloc((size_t)(cpus-1), sizeof(TASK));
+  if (!tasks) { tpl_delete(pool); return recfn(a, n, rd); }
+  for (i = 0; i < tpl_cnt(pool); i++) {
+    t = tasks +i;               /* traverse the workers */
+    t->recfn     = recfn;       /* copy the recursion data */
+    t->rd        = *rd;         /* (workers do not spawn threads) */
+    t->rd.pool   = NULL;        /* and use the reporter shard */
+    t->rd.report = tpl_report(tpl_worker(pool, i));
+    t->rd.stk    = mst_create(STKBLK);
+    t->rd.fim16  = NULL;        /* create a private memory stack */
+    if (t->rd.stk && rd->fim16)
+      t->rd.fim16 = m16_create(-1, rd->smin, t->rd.report);
+    if (!t->rd.stk || (rd->fim16 && !t->rd.fim16)) {
+      if (t->rd.stk) mst_delete(t->rd.stk);
+      break;                    /* and 16 items machine; on failure */
+    }                           /* delete the created objects */
+    tpl_setdata(tpl_worker(pool, i), t);
+  }
+  tpl_setcnt(pool, i);          /* note the number of workers */
+  rd->pool = (i > 0) ? pool : NULL;
+  r = recfn(a, n, rd);          /* search in the calling thread */
+  rd->pool = NULL;              /* and hand off projections */
+  if (r < 0) tpl_stop(pool);    /* on failure stop all workers */
+  if ((i > 0) && (tpl_drain(pool) < 0))
+    r = -1;                     /* collect the remaining results */
+  while (--i >= 0) {            /* traverse the workers */
+    t = tasks +i;               /* delete the 16 items machine, */
+    if (t->rd.fim16) m16_delete(t->rd.fim16);
+    mst_delete(t->rd.stk);      /* the memory stack */
+    if (t->buf) free(t->buf);   /* and the projection buffer */
+  }
+  tpl_delete(pool);             /* delete the pool of workers */
+  free(tasks);                  /* and the task data */
+  return r;                     /* return the error status */
+}  /* parallel() */
+
+/* Only the calling thread hands off projections (with at least     */
+/* SAM_PARMIN transactions) to worker threads and merges the shards */
+/* of finished workers, so that only it accesses the main reporter. */
+/* Since it continues with the remaining items on all levels of the */
+/* recursion, idle workers quickly get new projections to search.   */
+/* The workers only check for a stop request of the calling thread. */
+
+#endif  /* #ifdef SAM_THREADS */
 
 /*----------------------------------------------------------------------
   Split and Merge: Basic Version
@@ -324,8 +470,10 @@ static int recurse (TAAE *a, TID n, RECDATA *rd)
   SUPP pex;                     /* minimum support for perfect exts. */
 
   assert(a && (n > 0) && rd);   /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
   pex  = (rd->mode & SAM_PERFECT) ? isr_supp(rd->report) : SUPP_MAX;
-  proj = (TAAE*)malloc((size_t)(n+1) *sizeof(TAAE));
+  proj = (TAAE*)mst_alloc(rd->stk, (size_t)(n+1) *sizeof(TAAE));
   if (!proj) return -1;         /* allocate the projection array */
   while (a->items) {            /* split and merge loop */
     i = a->items[0];            /* get the next split item */
@@ -365,6 +513,13 @@ static int recurse (TAAE *a, TID n, RECDATA *rd)
     if (r <= 0) continue;       /* and check if it needs processing */
     if ((n > 0)                 /* if the projection is not empty */
     && isr_xable(rd->report,1)){/* and another item can be added, */
+      #ifdef SAM_THREADS        /* if multi-threading is available */
+      if (rd->pool && (n >= SAM_PARMIN)) {
+        r = spawn(proj, n, rd); /* try to hand off the projection */
+        if (r < 0) break;       /* to an idle worker thread */
+        if (r > 0) { isr_remove(rd->report, 1); continue; }
+      }                         /* (worker reports the current set) */
+      #endif
       r = recurse(proj, n, rd); /* search projection recursively */
       if (r < 0) break;         /* abort on a recursion error */
     }
@@ -372,7 +527,7 @@ static int recurse (TAAE *a, TID n, RECDATA *rd)
     if (r < 0) break;           /* and check for an error */
     isr_remove(rd->report, 1);  /* remove the current item */
   }                             /* from the item set reporter */
-  free(proj);                   /* deallocate the projection array */
+  mst_free(rd->stk, proj);      /* deallocate the projection array */
   return r;                     /* return the error status */
 }  /* recurse() */
 
@@ -395,8 +550,10 @@ int sam_base (TABAG *tabag, SUPP smin, int mode, ISREPORT *report)
   k = tbg_itemcnt(tabag);       /* get the number of items */
   if (k <= 0) return isr_report(report);
   n = tbg_cnt(tabag);           /* get the number of transactions */
-  a = (TAAE*)malloc((size_t)(n+1) *sizeof(TAAE));
-  if (!a) return -1;            /* create initial transaction array */
+  rd.stk = mst_create(STKBLK);  /* create a memory stack */
+  if (!rd.stk) return -1;       /* for the transaction arrays */
+  a = (TAAE*)mst_alloc(rd.stk, (size_t)(n+1) *sizeof(TAAE));
+  if (!a) { mst_delete(rd.stk); return -1; }
   for (i = n; --i >= 0; ) {     /* traverse the transactions */
     t = tbg_tract(tabag, i);    /* initialize a new array element */
     a[i].items = ta_items(t);   /* for each transaction and */
@@ -408,13 +565,19 @@ int sam_base (TABAG *tabag, SUPP smin, int mode, ISREPORT *report)
   rd.fim16   = NULL;            /* default: no 16 items machine */
   if (mode & SAM_FIM16) {       /* if to use a 16 items machine */
     rd.fim16 = m16_create(-1, rd.smin, report);
-    if (!rd.fim16) { free(a); return -1; }
+    if (!rd.fim16) { mst_delete(rd.stk); return -1; }
   }                             /* create a 16 items machine */
   rd.report = report;           /* note the item set reporter */
+  #ifdef SAM_THREADS            /* if multi-threading is available */
+  rd.pool = NULL;               /* and several threads are requested, */
+  if ((mode & SAM_CPUS) > SAM_CPU1)  /* search with worker threads */
+    r = parallel(a, n, recurse, &rd, (mode & SAM_CPUS) >> 8);
+  else                          /* otherwise execute the split and */
+  #endif                        /* merge recursion directly */
   r = recurse(a, n, &rd);       /* execute split and merge recursion */
   if (rd.fim16)                 /* if a 16 items machine was used, */
     m16_delete(rd.fim16);       /* delete the 16 items machine */
-  free(a);                      /* deallocate the transaction array */
+  mst_delete(rd.stk);           /* delete the transaction arrays */
   if (r >= 0)                   /* if no error occurred, */
     r = isr_report(report);     /* report the empty item set */
   return r;                     /* return the error status */
@@ -435,8 +598,10 @@ static int rec_opt (TAAE *a, TID n, RECDATA *rd)
   TID  k;                       /* number of remaining transactions */
 
   assert(a && (n > 0) && rd);   /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
   pex  = (rd->mode & SAM_PERFECT) ? isr_supp(rd->report) : SUPP_MAX;
-  proj = (TAAE*)malloc((size_t)(n+1) *sizeof(TAAE));
+  proj = (TAAE*)mst_alloc(rd->stk, (size_t)(n+1) *sizeof(TAAE));
   if (!proj) return -1;         /* allocate the projection array */
   for (k = n; a->items; ) {     /* split and merge loop */
     i = a->items[0];            /* get the next split item */
@@ -494,6 +659,13 @@ static int rec_opt (TAAE *a, TID n, RECDATA *rd)
     if (r <= 0) continue;       /* and check if it needs processing */
     if ((n > 0)                 /* if the projection is not empty */
     && isr_xable(rd->report,1)){/* and another item can be added */
+      #ifdef SAM_THREADS        /* if multi-threading is available */
+      if (rd->pool && (n >= SAM_PARMIN)) {
+        r = spawn(proj, n, rd); /* try to hand off the projection */
+        if (r < 0) break;       /* to an idle worker thread */
+        if (r > 0) { isr_remove(rd->report, 1); continue; }
+      }                         /* (worker reports the current set) */
+      #endif
       r = rec_opt(proj, n, rd); /* search projection recursively */
       if (r < 0) break;         /* abort on a recursion error */
     }
@@ -501,7 +673,7 @@ static int rec_opt (TAAE *a, TID n, RECDATA *rd)
     if (r < 0) break;           /* and check for an error */
     isr_remove(rd->report, 1);  /* remove the current item */
   }                             /* from the item set reporter */
-  free(proj);                   /* deallocate the projection array */
+  mst_free(rd->stk, proj);      /* deallocate the projection array */
   return r;                     /* return the error status */
 }  /* rec_opt() */
 
@@ -524,8 +696,10 @@ int sam_opt (TABAG *tabag, SUPP smin, int mode, ISREPORT *report)
   k = tbg_itemcnt(tabag);       /* get and check the number of items */
   if (k <= 0) return isr_report(report);
   n = tbg_cnt(tabag);           /* get the number of transactions */
-  a = (TAAE*)malloc((size_t)(n+1) *sizeof(TAAE));
-  if (!a) return -1;            /* create initial transaction array */
+  rd.stk = mst_create(STKBLK);  /* create a memory stack */
+  if (!rd.stk) return -1;       /* for the transaction arrays */
+  a = (TAAE*)mst_alloc(rd.stk, (size_t)(n+1) *sizeof(TAAE));
+  if (!a) { mst_delete(rd.stk); return -1; }
   for (i = n; --i >= 0; ) {     /* traverse the transactions */
     t = tbg_tract(tabag, i);    /* initialize a new array element */
     a[i].items = ta_items(t);   /* for each transaction and */
@@ -537,13 +711,19 @@ int sam_opt (TABAG *tabag, SUPP smin, int mode, ISREPORT *report)
   rd.fim16   = NULL;            /* default: no 16 items machine */
   if (mode & SAM_FIM16) {       /* if to use a 16 items machine */
     rd.fim16 = m16_create(-1, rd.smin, report);
-    if (!rd.fim16) { free(a); return -1; }
+    if (!rd.fim16) { mst_delete(rd.stk); return -1; }
   }                             /* create a 16 items machine */
   rd.report = report;           /* note the item set reporter */
+  #ifdef SAM_THREADS            /* if multi-threading is available */
+  rd.pool = NULL;               /* and several threads are requested, */
+  if ((mode & SAM_CPUS) > SAM_CPU1)  /* search with worker threads */
+    r = parallel(a, n, rec_opt, &rd, (mode & SAM_CPUS) >> 8);
+  else                          /* otherwise execute the split and */
+  #endif                        /* merge recursion directly */
   r = rec_opt(a, n, &rd);       /* execute split and merge recursion */
   if (rd.fim16)                 /* if a 16 items machine was used, */
     m16_delete(rd.fim16);       /* delete the 16 items machine */
-  free(a);                      /* deallocate the transaction array */
+  mst_delete(rd.stk);           /* delete the transaction arrays */
   if (r >= 0)                   /* if no error occurred, */
     r = isr_report(report);     /* report the empty item set */
   return r;                     /* return the error status */
@@ -565,8 +745,10 @@ static int rec_dsb (TAAE *a, TID n, RECDATA *rd)
   SUPP pex;                     /* minimum support for perfect exts. */
 
   assert(a && (n > 0) && rd);   /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
   pex  = (rd->mode & SAM_PERFECT) ? isr_supp(rd->report) : SUPP_MAX;
-  proj = (TAAE*)malloc((size_t)(n+n+2) *sizeof(TAAE));
+  proj = (TAAE*)mst_alloc(rd->stk, (size_t)(n+n+2) *sizeof(TAAE));
   if (!proj) return -1;         /* allocate the projection array */
   e = a+n; f = b = proj+n+n+1;  /* get the ends of the input arrays */
   b->items = NULL;              /* init. the second source (clear it) */
@@ -668,6 +850,13 @@ static int rec_dsb (TAAE *a, TID n, RECDATA *rd)
     if (r <= 0) continue;       /* check if item needs processing */
     if ((n > 0)                 /* if the projection is not empty */
     && isr_xable(rd->report,1)){/* and another item can be added */
+      #ifdef SAM_THREADS        /* if multi-threading is available */
+      if (rd->pool && (n >= SAM_PARMIN)) {
+        r = spawn(proj, n, rd); /* try to hand off the projection */
+        if (r < 0) break;       /* to an idle worker thread */
+        if (r > 0) { isr_remove(rd->report, 1); continue; }
+      }                         /* (worker reports the current set) */
+      #endif
       r = rec_dsb(proj, n, rd); /* search projection recursively */
       if (r < 0) break;         /* abort on a recursion error */
     }
@@ -675,7 +864,7 @@ static int rec_dsb (TAAE *a, TID n, RECDATA *rd)
     if (r < 0) break;           /* and check for an error */
     isr_remove(rd->report, 1);  /* remove the current item */
   }                             /* from the item set reporter */
-  free(proj);                   /* deallocate the projection array */
+  mst_free(rd->stk, proj);      /* deallocate the projection array */
   return r;                     /* return the error status */
 }  /* rec_dsb() */
 
@@ -700,8 +889,10 @@ int sam_dsb (TABAG *tabag, SUPP smin, TID merge, int mode,
   k = tbg_itemcnt(tabag);       /* get and check the number of items */
   if (k <= 0) return isr_report(report);
   n = tbg_cnt(tabag);           /* get the number of transactions */
-  a = (TAAE*)malloc((size_t)(n+2) *sizeof(TAAE));
-  if (!a) return -1;            /* create initial transaction array */
+  rd.stk = mst_create(STKBLK);  /* create a memory stack */
+  if (!rd.stk) return -1;       /* for the transaction arrays */
+  a = (TAAE*)mst_alloc(rd.stk, (size_t)(n+2) *sizeof(TAAE));
+  if (!a) { mst_delete(rd.stk); return -1; }
   for (i = n; --i >= 0; ) {     /* traverse the transactions */
     t = tbg_tract(tabag, i);    /* initialize a new array element */
     a[i].items = ta_items(t);   /* for each transaction and */
@@ -713,13 +904,19 @@ int sam_dsb (TABAG *tabag, SUPP smin, TID merge, int mode,
   rd.fim16   = NULL;            /* default: no 16 items machine */
   if (mode & SAM_FIM16) {       /* if to use a 16 items machine */
     rd.fim16 = m16_create(-1, rd.smin, report);
-    if (!rd.fim16) { free(a); return -1; }
+    if (!rd.fim16) { mst_delete(rd.stk); return -1; }
   }                             /* create a 16 items machine */
   rd.report = report;           /* note the item set reporter */
+  #ifdef SAM_THREADS            /* if multi-threading is available */
+  rd.pool = NULL;               /* and several threads are requested, */
+  if ((mode & SAM_CPUS) > SAM_CPU1)  /* search with worker threads */
+    r = parallel(a, n, rec_dsb, &rd, (mode & SAM_CPUS) >> 8);
+  else                          /* otherwise execute the split and */
+  #endif                        /* merge recursion directly */
   r = rec_dsb(a, n, &rd);       /* execute split and merge recursion */
   if (rd.fim16)                 /* if a 16 items machine was used, */
     m16_delete(rd.fim16);       /* delete the 16 items machine */
-  free(a);                      /* deallocate the transaction array */
+  mst_delete(rd.stk);           /* delete the transaction arrays */
   if (r >= 0)                   /* if no error occurred, */
     r = isr_report(report);     /* report the empty item set */
   return r;                     /* return the error status */
@@ -821,6 +1018,8 @@ static int rec_tree (TTNODE *node, RECDATA *rd)
   TTNODE *proj = NULL;          /* created projection */
 
   assert(node && rd);           /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
   pex = (rd->mode & SAM_PERFECT) ? isr_supp(rd->report) : SUPP_MAX;
   for ( ; node; node = merge(node->sibling, node->children)) {
     if (node->item < 0) {       /* if only packed items left */
@@ -855,7 +1054,7 @@ static int rec_tree (TTNODE *node, RECDATA *rd)
 
 int sam_tree (TABAG *tabag, SUPP smin, int mode, ISREPORT *report)
 {                               /* --- search for frequent item sets */
-  int     r = 0;                /* result of recursion */
+  int     r = -1;               /* result of recursion */
   ITEM    k;                    /* number of items */
   TID     i, n;                 /* loop variable, number of trans. */
   TRACT   *t;                   /* to traverse the transactions */
@@ -870,7 +1069,7 @@ int sam_tree (TABAG *tabag, SUPP smin, int mode, ISREPORT *report)
   k = tbg_itemcnt(tabag);       /* get and check the number of items */
   if (k <= 0) return isr_report(report);
   rd.mem = ms_create(sizeof(TTNODE), 65535);
-  if (!rd.mem) return 0;        /* create a memory mgmt. system */
+  if (!rd.mem) return -1;       /* create a memory mgmt. system */
   rd.fim16 = NULL;              /* default: no 16 items machine */
   if (mode & SAM_FIM16) {       /* if to use a 16 items machine */
     rd.fim16 = m16_create(-1, rd.smin, report);
@@ -903,15 +1102,22 @@ static int rec_ins (TXAE *a, TID n, ITEM k, RECDATA *rd)
   int    r = 0;                 /* function result, error status */
   TXAE   *proj;                 /* projected transaction database */
   TXAE   *s, *t, *d, *e;        /* to traverse the transactions */
+  TXAE   *b;                    /* start of trans. w/o current item */
+  double *pw;                   /* penalized transaction weights */
+  TID    m;                     /* number of trans. w/o current item */
   double pen, wgt;              /* insertion penalty and tra. weight */
   double sum;                   /* sum of transaction weights */
   SUPP   supp;                  /* support of current item */
   double pex;                   /* minimum weight for perfect exts. */
 
   assert(a && (n > 0) && rd);   /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
   pex  = (rd->mode & SAM_PERFECT) ? isr_wgt(rd->report) : INFINITY;
-  proj = (TXAE*)malloc((size_t)(n+1) *sizeof(TXAE));
-  if (!proj) return -1;         /* allocate the projection array and */
+  proj = (TXAE*)mst_alloc(rd->stk, (size_t)(n+1) *sizeof(TXAE)
+                                  +(size_t) n    *sizeof(double));
+  if (!proj) return -1;         /* allocate the projection array */
+  pw = (double*)(proj+n+1);     /* and the penalized weights */
   while (--k >= 0) {            /* split and merge loop */
     pen = ib_getpen(rd->base,k);/* get the item insertion penalty */
     d = t = (pen <= 0) ? proj : (TXAE*)rd->buf;
@@ -935,19 +1141,22 @@ static int rec_ins (TXAE *a, TID n, ITEM k, RECDATA *rd)
       while (t->items) *d++ = *t++;   /* copy remaining transactions */
       while (s->items) *d++ = *s++; } /* from the non-empty source */
     else {                      /* if item insertion is allowed */
-      e = proj; d = a;          /* -- merge the transaction arrays */
+      for (b = s, m = 0; b->items; b++)
+        pw[m++] = b->wgt;       /* collect the weights of the trans. */
+      tnvec(pw, m, pen, rd->tnorm);   /* w/o item and penalize them */
+      b = s; e = proj; d = a;   /* -- merge the transaction arrays */
       while (s->items && t->items) {       /* compare transactions */
         int c = cmp(s->items, t->items);   /* from the two sources */
         if      (c < 0)         /* if trans. with item is smaller, */
           *d++ = *e++ = *t++;   /* copy it to both destinations */
         else if (c > 0) {       /* if trans. w/o  item is smaller */
-          sum     += wgt = rd->tnorm(s->wgt, pen);
+          sum     += wgt = pw[s-b];
           e->wgt   = wgt;       /* copy it with a penalized weight */
           e->occ   = 0;         /* to the second destination and */
           e->items = s->items;  /* with full weight to the first */
           *d++ = *s++; e++; }   /* no occurrences (item is missing) */
         else {                  /* if the transactions are equal */
-          sum     += wgt = rd->tnorm(s->wgt, pen);
+          sum     += wgt = pw[s-b];
           d->wgt   = t->wgt +s->wgt; e->wgt = t->wgt +wgt;
           d->occ   = t->occ +s->occ; e->occ = t->occ;
           d->items = e->items = s->items;
@@ -957,7 +1166,7 @@ static int rec_ins (TXAE *a, TID n, ITEM k, RECDATA *rd)
       while (t->items)          /* copy remaining transactions */
         *d++ = *e++ = *t++;     /* containing the current item */
       while (s->items) {        /* while transactions w/o item left */
-        sum     += wgt = rd->tnorm(s->wgt, pen);
+        sum     += wgt = pw[s-b];
         e->wgt   = wgt;         /* copy it with a penalized weight */
         e->occ   = 0;           /* to the second destination and */
         e->items = s->items;    /* with full weight to the first */
@@ -981,7 +1190,7 @@ static int rec_ins (TXAE *a, TID n, ITEM k, RECDATA *rd)
     if (r < 0) break;           /* and check for an error */
     isr_remove(rd->report, 1);  /* and remove the current item */
   }                             /* from the item set reporter */
-  free(proj);                   /* deallocate the projection array */
+  mst_free(rd->stk, proj);      /* deallocate the projection array */
   return r;                     /* return the error status */
 }  /* rec_ins() */
 
@@ -1001,16 +1210,18 @@ int sam_ins (TABAG *tabag, SUPP smin, double sins, int tnorm,
   rd.mode   = mode;             /* check and adapt minimum support */
   rd.smin   = (smin > 0) ? smin : 0;
   rd.sins   = (sins > 0) ? sins : DBL_MIN;
-  if ((tnorm < 0) || (tnorm >= (int)(sizeof(tnorms)/sizeof(*tnorms))))
+  if ((tnorm < T_MIN) || (tnorm > T_HAMA))
     tnorm = T_MIN;              /* check and adapt the t-norm */
-  rd.tnorm = tnorms[tnorm];     /* note the t-norm for item weights */
+  rd.tnorm = tnorm;             /* note the t-norm for item weights */
   if (tbg_wgt(tabag) < rd.smin) /* check the total transaction weight */
     return 0;                   /* against the minimum support */
   k = tbg_itemcnt(tabag);       /* get and check the number of items */
   if (k <= 0) return isr_report(report);
   n = tbg_cnt(tabag);           /* get the number of transactions */
-  a = (TXAE*)malloc((size_t)(n+n+2) *sizeof(TXAE));
-  if (!a) return -1;            /* create initial transaction array */
+  rd.stk = mst_create(STKBLK);  /* create a memory stack */
+  if (!rd.stk) return -1;       /* for the transaction arrays */
+  a = (TXAE*)mst_alloc(rd.stk, (size_t)(n+n+2) *sizeof(TXAE));
+  if (!a) { mst_delete(rd.stk); return -1; }
   for (i = n; --i >= 0; ) {     /* traverse the transactions */
     t = tbg_tract(tabag, i);    /* initialize a new array element */
     a[i].items = ta_items(t);   /* store the item array (pointer) */
@@ -1021,7 +1232,7 @@ int sam_ins (TABAG *tabag, SUPP smin, double sins, int tnorm,
   rd.base    = tbg_base(tabag); /* note the underlying item base */
   rd.report  = report;          /* and the item set reporter */
   r = rec_ins(a, n, k, &rd);    /* execute split and merge recursion */
-  free(a);                      /* deallocate the transaction array */
+  mst_delete(rd.stk);           /* delete the transaction arrays */
   if (r >= 0)                   /* if no error occurred, */
     r = isr_report(report);     /* report the empty item set */
   return r;                     /* return the error status */
@@ -1037,15 +1248,22 @@ static int rec_lim (TZAE *a, TID n, ITEM k, RECDATA *rd)
   TZAE   *proj;                 /* projected transaction database */
   TZAE   *s, *t, *d, *e;        /* to traverse the transactions */
   TZAE   *x, *y;                /* ditto, for equal trans. merging */
+  TZAE   *b;                    /* start of trans. w/o current item */
+  double *pw;                   /* penalized transaction weights */
+  TID    m;                     /* number of trans. w/o current item */
   double pen, wgt;              /* insertion penalty and tra. weight */
   double sum;                   /* sum of transaction weights */
   SUPP   supp;                  /* support of current item */
   double pex;                   /* minimum weight for perfect exts. */
 
   assert(a && (n > 0) && rd);   /* check the function arguments */
+  if (isr_tick(rd->report) < 0) /* count the search node and */
+    return -1;                  /* check for a cancellation */
   pex  = (rd->mode & SAM_PERFECT) ? isr_wgt(rd->report) : INFINITY;
-  proj = (TZAE*)malloc((size_t)(n+1) *sizeof(TZAE));
-  if (!proj) return -1;         /* allocate the projection array and */
+  proj = (TZAE*)mst_alloc(rd->stk, (size_t)(n+1) *sizeof(TZAE)
+                                  +(size_t) n    *sizeof(double));
+  if (!proj) return -1;         /* allocate the projection array */
+  pw = (double*)(proj+n+1);     /* and the penalized weights */
   while (--k >= 0) {            /* split and merge loop */
     pen = ib_getpen(rd->base,k);/* get the item insertion penalty */
     d = t = (pen <= 0) ? proj : (TZAE*)rd->buf;
@@ -1061,13 +1279,16 @@ static int rec_lim (TZAE *a, TID n, ITEM k, RECDATA *rd)
     d->items = NULL;            /* store a sentinel at the end */
     if (sum >= pex) {           /* identify perfect extensions */
       isr_addpex(rd->report, k); continue; }
-    e = proj; d = a;            /* -- merge the transaction arrays */
+    for (b = s, m = 0; b->items; b++)
+      pw[m++] = b->wgt;         /* collect the weights of the trans. */
+    tnvec(pw, m, pen, rd->tnorm);     /* w/o item and penalize them */
+    b = s; e = proj; d = a;     /* -- merge the transaction arrays */
     while (s->items && t->items) {      /* compare transactions */
       int c = cmp(s->items, t->items);  /* from the two sources */
       if      (c < 0)           /* if trans. with item is smaller, */
         *d++ = *e++ = *t++;     /* copy it to both destinations */
       else if (c > 0) {         /* if trans. w/o  item is smaller */
-        wgt = rd->tnorm(s->wgt, pen); /* compute the penalized weight */
+        wgt = pw[s-b];          /* get the penalized weight */
         if (wgt >= rd->twgt) {  /* if it is greater than the minimum, */
           e->wgt = wgt;         /* copy transaction with penalized */
           e->cnt = s->cnt;      /* weight to the second destination */
@@ -1081,7 +1302,7 @@ static int rec_lim (TZAE *a, TID n, ITEM k, RECDATA *rd)
         if (pen > 0) {          /* if an insertion is allowed */
           while ((x->items == s->items)
           &&     (y->items == t->items)) {
-            wgt = rd->tnorm(x->wgt, pen); /* compute penalized weight */
+            wgt = pw[x-b];      /* get the penalized weight */
             if (wgt < rd->twgt) { x++; continue; }
             if      (wgt < y->wgt) {
               e->wgt = wgt;     /* copy weight from 1st source */
@@ -1101,7 +1322,7 @@ static int rec_lim (TZAE *a, TID n, ITEM k, RECDATA *rd)
             (e++)->items = s->items;
           }                     /* copy item array from 1st source */
           while (x->items == s->items) {
-            wgt = rd->tnorm(x->wgt, pen); /* compute penalized weight */
+            wgt = pw[x-b];      /* get the penalized weight */
             if (wgt < rd->twgt) { x++; continue; }
             e->items = s->items;/* copy the remaining transactions */
             e->wgt   = wgt;     /* with an unchanged item array */
@@ -1147,7 +1368,7 @@ static int rec_lim (TZAE *a, TID n, ITEM k, RECDATA *rd)
     while (t->items)            /* copy remaining transactions */
       *d++ = *e++ = *t++;       /* containing the current item */
     while (s->items) {          /* while trans. w/o current item left */
-      wgt = rd->tnorm(s->wgt, pen);    /* get penalized trans. weight */
+      wgt = pw[s-b];            /* get penalized trans. weight */
       if (wgt >= rd->twgt) {    /* if it is greater than the minimum, */
         e->items = s->items;    /* copy the transaction */
         e->cnt   = s->cnt;      /* with the penalized weight */
@@ -1162,19 +1383,19 @@ static int rec_lim (TZAE *a, TID n, ITEM k, RECDATA *rd)
     ||  (sum  < rd->sins))      /* or the weight are too low, */
       continue;                 /* skip the recursive processing */
     r = isr_addwgt(rd->report, k, supp, sum);
-    if (r <  0) { free(proj); return r; }
+    if (r <  0) { mst_free(rd->stk, proj); return r; }
     if (r <= 0) continue;       /* add current item to the reporter */
     n = (TID)(e -proj);         /* and check if it needs processing */
     if ((n > 0)                 /* if the projection is not empty */
     && isr_xable(rd->report,1)){/* and another item can be added */
       n = rec_lim(proj,n,k,rd); /* search projection recursively */
-      if (n < 0) { free(proj); return -1; }
+      if (n < 0) { mst_free(rd->stk, proj); return -1; }
     }
     r = isr_report(rd->report); /* report the current item set */
     if (r < 0) break;           /* and check for an error */
     isr_remove(rd->report, 1);  /* remove the current item */
   }                             /* from the item set reporter */
-  free(proj);                   /* deallocate the projection array */
+  mst_free(rd->stk, proj);      /* deallocate the projection array */
   return r;                     /* return the error status */
 }  /* rec_lim() */
 
@@ -1195,16 +1416,18 @@ int sam_lim (TABAG *tabag, SUPP smin, double sins, int tnorm,
   rd.smin   = (smin > 0) ? smin : 0;
   rd.sins   = (sins > 0) ? sins : DBL_MIN;
   rd.twgt   = (twgt > 0) ? twgt : DBL_MIN;
-  if ((tnorm < 0) || (tnorm >= (int)(sizeof(tnorms)/sizeof(*tnorms))))
+  if ((tnorm < T_MIN) || (tnorm > T_HAMA))
     tnorm = T_MIN;              /* check and adapt the t-norm */
-  rd.tnorm = tnorms[tnorm];     /* note the t-norm for item weights */
+  rd.tnorm = tnorm;             /* note the t-norm for item weights */
   if (tbg_wgt(tabag) < rd.smin) /* check the total transaction weight */
     return 0;                   /* against the minimum support */
   k = tbg_itemcnt(tabag);       /* get and check the number of items */
   if (k <= 0) return isr_report(report);
   n = tbg_cnt(tabag);           /* get the number of transactions */
-  a = (TZAE*)malloc((size_t)(n+n+2) *sizeof(TZAE));
-  if (!a) return -1;            /* create initial transaction array */
+  rd.stk = mst_create(STKBLK);  /* create a memory stack */
+  if (!rd.stk) return -1;       /* for the transaction arrays */
+  a = (TZAE*)mst_alloc(rd.stk, (size_t)(n+n+2) *sizeof(TZAE));
+  if (!a) { mst_delete(rd.stk); return -1; }
   for (i = 0; i < n; i++) {     /* traverse the transactions */
     t = tbg_tract(tabag, i);    /* initialize a new array element */
     a[i].items = ta_items(t);   /* for each transaction */
@@ -1216,7 +1439,7 @@ int sam_lim (TABAG *tabag, SUPP smin, double sins, int tnorm,
   rd.base    = tbg_base(tabag); /* note the underlying item base */
   rd.report  = report;          /* and the item set reporter */
   r = rec_lim(a, n, k, &rd);    /* execute split and merge recursion */
-  free(a);                      /* deallocate the transaction array */
+  mst_delete(rd.stk);           /* delete the transaction arrays */
   if (r >= 0)                   /* if no error occurred, */
     r = isr_report(report);     /* report the empty item set */
   return r;                     /* return the error status */
@@ -1445,6 +1668,7 @@ int main (int argc, char *argv[])
   int     scan     = 0;         /* flag for scanable item output */
   int     bdrcnt   = 0;         /* number of support values in border */
   int     stats    = 0;         /* flag for item set statistics */
+  int     binary   = 0;         /* flag for binary output format */
   PATSPEC *psp;                 /* collected pattern spectrum */
   ITEM    m;                    /* number of items */
   TID     n;                    /* number of transactions */
@@ -1509,6 +1733,8 @@ int main (int argc, char *argv[])
     printf("-P#      write a pattern spectrum to a file\n");
     printf("-Z       print item set statistics "
                     "(number of item sets per size)\n");
+    printf("-B       write item sets in binary format "
+                    "(compressed)\n");
     printf("-g       write output in scanable form "
                     "(quote certain characters)\n");
     printf("-h#      record header  for output                "
@@ -1563,6 +1789,7 @@ int main (int argc, char *argv[])
           case 'R': optarg = &fn_sel;                break;
           case 'P': optarg = &fn_psp;                break;
           case 'Z': stats  = 1;                      break;
+          case 'B': binary = 1;                      break;
           case 'g': scan   = 1;                      break;
           case 'h': optarg = &hdr;                   break;
           case 'k': optarg = &sep;                   break;
@@ -1685,7 +1912,8 @@ int main (int argc, char *argv[])
     error(E_NOMEM);             /* set a pattern spectrum if req. */
   if (isr_setfmt(report, scan, hdr, sep, NULL, info) != 0)
     error(E_NOMEM);             /* set the output format strings */
-  k = isr_open(report, NULL, fn_out);
+  k = (binary) ? isr_openbin(report, NULL, fn_out)
+               : isr_open   (report, NULL, fn_out);
   if (k) error(k, isr_name(report)); /* open the item set file */
   if ((sam_repo(report, target, eval, thresh, algo, mode) < 0)
   ||  (isr_setup(report) < 0))  /* prepare reporter for SaM and */
@@ -5,6 +5,7 @@
   History : 2013.11.20 file created
             2014.08.22 interface of function sam() changed
             2014.08.28 functions sam_data() and sam_repo() added
+            2026.10.18 mode field SAM_CPUS added (number of threads)
 ----------------------------------------------------------------------*/
 #ifndef __SAM__
 #define __SAM__
@@ -37,6 +38,8 @@
 /* --- operation modes --- */
 #define SAM_FIM16   0x001f      /* use 16 items machine (bit rep.) */
 #define SAM_PERFECT 0x0020      /* prune with perfect extensions */
+#define SAM_CPUS    0x3f00      /* number of threads (times SAM_CPU1) */
+#define SAM_CPU1    0x0100      /* one thread (unit of SAM_CPUS) */
 #define SAM_DEFAULT SAM_PERFECT
 #ifdef NDEBUG
 #define SAM_NOCLEAN 0x8000      /* do not clean up memory */
@@ -28,6 +28,8 @@ headers = ['util/src/arrays.h',
            'tract/src/patspec.h',
            'tract/src/clomax.h',
            'tract/src/report.h',
+           'tract/src/repread.h',
+           'tract/src/thdpool.h',
            'apriori/src/istree.h',
            'apriori/src/apriori.h',
            'eclat/src/eclat.h',
@@ -52,6 +54,8 @@ sources = ['util/src/arrays.c',
            'tract/src/patspec.c',
            'tract/src/clomax.c',
            'tract/src/report.c',
+           'tract/src/repread.c',
+           'tract/src/thdpool.c',
            'apriori/src/istree.c',
            'apriori/src/apriori.c',
            'eclat/src/eclat.c',
@@ -72,7 +76,12 @@ macros = [('NDEBUG', None),
           ('PSP_ESTIM', None),
           ('ISR_PATSPEC', None),
           ('ISR_CLOMAX', None),
-          ('ISR_NONAMES', None)]
+          ('ISR_NONAMES', None),
+          ('IST_THREADS', None),
+          ('SAM_THREADS', None),
+          ('REM_THREADS', None),
+          ('CARP_THREADS', None),
+          ('ISTA_THREADS', None)]
 
 with open('MANIFEST.in', 'wt') as out:
     for h in headers: out.write('include ' + h + '\n')
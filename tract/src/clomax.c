@@ -18,13 +18,20 @@
             2012.04.11 separate memory management system for each tree
             2014.07.16 insertion loop in cmt_add() simplified
             2014.07.23 check for a valid tree based on associated item
+            2026.10.18 hash filter for closed item sets added (CMHASH)
+            2026.10.18 generator index with set fingerprints (GENTAB)
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <limits.h>
 #include <assert.h>
 #include "clomax.h"
+#if defined __SSE2__ && defined __GNUC__ && !defined CM_NOSIMD
+#define CM_SSE2                 /* use SSE2 instructions if possible */
+#include <emmintrin.h>
+#endif
 #ifdef STORAGE
 #include "storage.h"
 #endif
@@ -41,6 +48,13 @@
 
 #define COPYERR   ((CMNODE*)-1) /* error indicator for xcopy */
 
+#define CMH_EMPTY  SIZE_MAX     /* marker for an empty table entry */
+#define CMH_INIT   1024         /* initial size of the hash table */
+
+#define GT_EMPTY   0x80         /* control byte of an empty entry */
+#define GT_GRPSIZE 16           /* number of entries per group */
+#define GT_INIT    64           /* initial number of entry groups */
+
 /*----------------------------------------------------------------------
   Prefix Tree Functions
 ----------------------------------------------------------------------*/
@@ -549,3 +563,345 @@ void cm_show (CLOMAX *cm, ITEMBASE *base, int ind)
 }  /* cm_show() */
 
 #endif
+/*----------------------------------------------------------------------
+  Closed Item Set Hash Filter Functions
+----------------------------------------------------------------------*/
+
+static size_t mix (uint64_t h)
+{                               /* --- mix the bits of a hash value */
+  h ^= h >> 33; h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33; h *= 0xc4ceb9fe1a85ec53ULL;
+  return (size_t)(h ^ (h >> 33));
+}  /* mix() */                  /* (64 bit finalizer of MurmurHash3) */
+
+/*--------------------------------------------------------------------*/
+
+static size_t cmh_hash (RSUPP supp, size_t sig)
+{                               /* --- hash support and signature */
+  return mix((uint64_t)sig ^ ((uint64_t)supp *0x9e3779b97f4a7c15ULL));
+}  /* cmh_hash() */
+
+/*--------------------------------------------------------------------*/
+
+CMHASH* cmh_create (ITEM size)
+{                               /* --- create a closed set hash filter */
+  CMHASH *cmh;                  /* created hash filter */
+  size_t i;                     /* loop variable */
+
+  assert(size > 0);             /* check the function argument */
+  cmh = (CMHASH*)malloc(sizeof(CMHASH));
+  if (!cmh) return NULL;        /* create the base structure */
+  cmh->size  = size;            /* and initialize its fields */
+  cmh->cnt   = 0;               /* there are no item sets yet */
+  cmh->mask  = CMH_INIT-1;
+  cmh->used  = 0;
+  cmh->psize = 16*CMH_INIT;     /* create the hash table, */
+  cmh->tab   = (CMHENT*)malloc(CMH_INIT *sizeof(CMHENT));
+  cmh->pool  = (ITEM*)  malloc(cmh->psize *sizeof(ITEM));
+  cmh->marks = (char*)  calloc((size_t)size, sizeof(char));
+  if (!cmh->tab || !cmh->pool || !cmh->marks) {
+    cmh_delete(cmh); return NULL; }  /* the item set pool */
+  for (i = 0; i <= cmh->mask; i++)   /* and the item flags */
+    cmh->tab[i].set = CMH_EMPTY;     /* and mark all entries */
+  return cmh;                   /* as empty */
+}  /* cmh_create() */
+
+/*--------------------------------------------------------------------*/
+
+void cmh_delete (CMHASH *cmh)
+{                               /* --- delete a closed set hash filter */
+  assert(cmh);                  /* check the function argument */
+  if (cmh->marks) free(cmh->marks);
+  if (cmh->pool)  free(cmh->pool);
+  if (cmh->tab)   free(cmh->tab);
+  free(cmh);                    /* delete the arrays */
+}  /* cmh_delete() */           /* and the base structure */
+
+/*--------------------------------------------------------------------*/
+
+int cmh_super (CMHASH *cmh, const ITEM *items, ITEM n,
+               RSUPP supp, size_t sig)
+{                               /* --- check for a known superset */
+  size_t       i;               /* index of a hash table entry */
+  ITEM         k, m;            /* loop variable, number of matches */
+  const ITEM   *s;              /* to traverse a stored item set */
+  const CMHENT *e;              /* to traverse the hash table */
+
+  assert(cmh && (items || (n <= 0)));  /* check function arguments */
+  for (k = 0; k < n; k++) cmh->marks[items[k]] = 1;
+  for (i = cmh_hash(supp, sig) & cmh->mask; ; i = (i+1) & cmh->mask) {
+    e = cmh->tab +i;            /* mark the items of the query set */
+    if (e->set == CMH_EMPTY) break;  /* and traverse the entries */
+    if ((e->supp != supp) || (e->sig != sig))
+      continue;                 /* skip sets with a different key */
+    s = cmh->pool +e->set;      /* get the stored item set */
+    if (*s < n) continue;       /* (a superset must not be smaller) */
+    for (m = 0, k = *s++; --k >= 0; )
+      m += cmh->marks[*s++];    /* count the query items */
+    if (m >= n) break;          /* in the stored item set */
+  }                             /* (all query items: superset found) */
+  for (k = 0; k < n; k++) cmh->marks[items[k]] = 0;
+  return (cmh->tab[i].set != CMH_EMPTY);
+}  /* cmh_super() */            /* return whether superset found */
+
+/* Sets with the same support and the same transaction id set   */
+/* signature almost surely have the same transaction id set, in  */
+/* which case the stored set is the closure of the query set. To */
+/* be safe against signature collisions, the superset relation   */
+/* is checked explicitly, so that the result is always exact.    */
+
+/*--------------------------------------------------------------------*/
+
+static int cmh_grow (CMHASH *cmh)
+{                               /* --- double the hash table size */
+  size_t i, k, z;               /* loop variable, index, new size */
+  CMHENT *tab;                  /* new hash table */
+
+  assert(cmh);                  /* check the function argument */
+  z   = 2*(cmh->mask+1);        /* double the hash table size */
+  tab = (CMHENT*)malloc(z *sizeof(CMHENT));
+  if (!tab) return -1;          /* create a new hash table */
+  for (i = 0; i < z; i++) tab[i].set = CMH_EMPTY;
+  for (i = 0; i <= cmh->mask; i++) {
+    if (cmh->tab[i].set == CMH_EMPTY) continue;
+    k = cmh_hash(cmh->tab[i].supp, cmh->tab[i].sig) & (z-1);
+    while (tab[k].set != CMH_EMPTY) k = (k+1) & (z-1);
+    tab[k] = cmh->tab[i];       /* traverse the old entries and */
+  }                             /* insert them into the new table */
+  free(cmh->tab);               /* delete the old hash table */
+  cmh->tab = tab; cmh->mask = z-1;
+  return 0;                     /* set the new hash table */
+}  /* cmh_grow() */             /* and return 'ok' */
+
+/*--------------------------------------------------------------------*/
+
+int cmh_add (CMHASH *cmh, const ITEM *items, ITEM n,
+             RSUPP supp, size_t sig)
+{                               /* --- add a closed item set */
+  size_t i, z;                  /* index of hash table entry, size */
+  ITEM   *p;                    /* reallocated item set pool */
+
+  assert(cmh && (items || (n <= 0)) && (n >= 0));
+  if ((2*(cmh->cnt+1) > cmh->mask+1) && (cmh_grow(cmh) != 0))
+    return -1;                  /* keep the load factor below 1/2 */
+  if (cmh->used +(size_t)n+1 > cmh->psize) {
+    z = cmh->psize +((cmh->psize > (size_t)n) ? cmh->psize : (size_t)n+1);
+    p = (ITEM*)realloc(cmh->pool, z *sizeof(ITEM));
+    if (!p) return -1;          /* enlarge the item set pool */
+    cmh->pool = p; cmh->psize = z;
+  }
+  i = cmh_hash(supp, sig) & cmh->mask;
+  while (cmh->tab[i].set != CMH_EMPTY) i = (i+1) & cmh->mask;
+  cmh->tab[i].supp = supp;      /* find an empty hash table entry */
+  cmh->tab[i].sig  = sig;       /* and store support, signature */
+  cmh->tab[i].set  = cmh->used; /* and position of the item set */
+  p = cmh->pool +cmh->used;     /* store the item set in the pool */
+  *p++ = n; memcpy(p, items, (size_t)n *sizeof(ITEM));
+  cmh->used += (size_t)n+1;     /* (size followed by the items) */
+  cmh->cnt  += 1;               /* count the added item set */
+  return 0;                     /* return 'ok' */
+}  /* cmh_add() */
+
+/*----------------------------------------------------------------------
+  Generator Index Functions
+----------------------------------------------------------------------*/
+
+GENTAB* gt_create (ITEM size)
+{                               /* --- create a generator index */
+  GENTAB *gt;                   /* created generator index */
+  ITEM   i;                     /* loop variable */
+  size_t k;                     /* loop variable */
+
+  assert(size > 0);             /* check the function argument */
+  gt = (GENTAB*)malloc(sizeof(GENTAB));
+  if (!gt) return NULL;         /* create the base structure */
+  gt->size  = size;             /* and initialize its fields */
+  gt->cnt   = 0;                /* there are no item sets yet */
+  gt->gmask = GT_INIT-1;        /* create the table and buffers */
+  gt->grps  = (GTGRP*) malloc(GT_INIT *sizeof(GTGRP));
+  gt->ifps  = (GTFP*)  malloc((size_t)(3*size+1) *sizeof(GTFP));
+  gt->hs    = (size_t*)malloc((size_t)size *sizeof(size_t));
+  if (!gt->grps || !gt->ifps || !gt->hs) {
+    gt_delete(gt); return NULL; }
+  gt->pfps = gt->ifps +size;    /* split the fingerprint array */
+  gt->sfps = gt->pfps +size+1;  /* into item, prefix and subset part */
+  for (k = 0; k < GT_INIT; k++) /* mark all entries as empty */
+    memset(gt->grps[k].ctrl, GT_EMPTY, GT_GRPSIZE);
+  for (i = 0; i < size; i++) {  /* compute the item fingerprints */
+    gt->ifps[i].a = mix((uint64_t)(i+1) *0x9e3779b97f4a7c15ULL);
+    gt->ifps[i].b = mix((uint64_t)(i+1) *0xc2b2ae3d27d4eb4fULL
+                       ^ 0x165667b19e3779f9ULL);
+  }                             /* (two independent hash values) */
+  gt->pfps[0].a = gt->pfps[0].b = 0;
+  return gt;                    /* return the created index */
+}  /* gt_create() */
+
+/*--------------------------------------------------------------------*/
+
+void gt_delete (GENTAB *gt)
+{                               /* --- delete a generator index */
+  assert(gt);                   /* check the function argument */
+  if (gt->hs)   free(gt->hs);
+  if (gt->ifps) free(gt->ifps);
+  if (gt->grps) free(gt->grps);
+  free(gt);                     /* delete the arrays */
+}  /* gt_delete() */            /* and the base structure */
+
+/*--------------------------------------------------------------------*/
+
+static unsigned int gt_match (const unsigned char *ctrl, int tag)
+{                               /* --- match a tag against a group */
+  #ifdef CM_SSE2                /* if to use SSE2 instructions */
+  __m128i v = _mm_loadu_si128((const __m128i*)ctrl);
+  return (unsigned int)_mm_movemask_epi8(
+                       _mm_cmpeq_epi8(v, _mm_set1_epi8((char)tag)));
+  #else                         /* if not to use SSE2 instructions */
+  unsigned int m = 0;           /* bit mask of matching entries */
+  int          i;               /* loop variable */
+  for (i = GT_GRPSIZE; --i >= 0; )
+    m = (m << 1) | (ctrl[i] == (unsigned char)tag);
+  return m;                     /* collect matching control bytes */
+  #endif                        /* in a bit mask (one bit per entry) */
+}  /* gt_match() */
+
+/* The control bytes of a group of 16 table entries are compared   */
+/* with the 7 bit hash tag (or the empty marker) all at once. Only  */
+/* entries with a matching tag need to be inspected further.        */
+
+/*--------------------------------------------------------------------*/
+
+static int lowbit (unsigned int m)
+{                               /* --- index of lowest set bit */
+  #ifdef __GNUC__               /* if GNU C is available, */
+  return __builtin_ctz(m);      /* use the builtin function */
+  #else                         /* otherwise count the */
+  int i;                        /* trailing zero bits */
+  for (i = 0; !(m & 1); m >>= 1) i++;
+  return i;                     /* return the bit index */
+  #endif
+}  /* lowbit() */
+
+/*--------------------------------------------------------------------*/
+
+static size_t gt_hash (const GTFP *fp, ITEM n)
+{                               /* --- hash an item set fingerprint */
+  return mix(fp->a ^ (fp->b >> 1) ^ (uint64_t)n);
+}  /* gt_hash() */
+
+/*--------------------------------------------------------------------*/
+
+static const GTENT* gt_find (GENTAB *gt, const GTFP *fp, ITEM n,
+                             size_t h)
+{                               /* --- find an item set */
+  size_t      g;                /* group index */
+  int         tag;              /* hash tag of the item set */
+  unsigned    m;                /* bit mask of matching entries */
+  const GTGRP *grp;             /* to traverse the entry groups */
+  const GTENT *e;               /* to access the table entries */
+
+  assert(gt && fp);             /* check the function arguments */
+  tag = (int)(h & 0x7f);        /* get the hash tag */
+  for (g = (h >> 7) & gt->gmask; ; g = (g+1) & gt->gmask) {
+    grp = gt->grps +g;          /* traverse the entry groups */
+    for (m = gt_match(grp->ctrl, tag); m; m &= m-1) {
+      e = grp->ents +lowbit(m); /* traverse the matching entries */
+      if ((e->fp.a == fp->a) && (e->fp.b == fp->b) && (e->n == n))
+        return e;               /* if fingerprint and size match, */
+    }                           /* return the found entry */
+    if (gt_match(grp->ctrl, GT_EMPTY))
+      return NULL;              /* if the group has an empty entry, */
+  }                             /* the item set is not in the table */
+}  /* gt_find() */
+
+/*--------------------------------------------------------------------*/
+
+static void gt_put (GENTAB *gt, const GTENT *ent, size_t h)
+{                               /* --- put an entry into the table */
+  size_t   g;                   /* group index */
+  unsigned m;                   /* bit mask of empty entries */
+  int      i;                   /* index of entry in group */
+
+  assert(gt && ent);            /* check the function arguments */
+  for (g = (h >> 7) & gt->gmask; ; g = (g+1) & gt->gmask) {
+    m = gt_match(gt->grps[g].ctrl, GT_EMPTY);
+    if (m) break;               /* find a group with an empty entry */
+  }                             /* (there is always one) */
+  i = lowbit(m);                /* store the hash tag and the entry */
+  gt->grps[g].ctrl[i] = (unsigned char)(h & 0x7f);
+  gt->grps[g].ents[i] = *ent;
+}  /* gt_put() */
+
+/*--------------------------------------------------------------------*/
+
+static int gt_grow (GENTAB *gt)
+{                               /* --- double the table size */
+  size_t i, n;                  /* loop variable, old number of groups */
+  int    k;                     /* loop variable */
+  GTGRP  *old;                  /* old entry groups */
+  GTENT  *e;                    /* to traverse the entries */
+
+  assert(gt);                   /* check the function argument */
+  n   = gt->gmask+1;            /* get the old number of groups */
+  old = gt->grps;               /* and note the old groups */
+  gt->grps = (GTGRP*)malloc(2*n *sizeof(GTGRP));
+  if (!gt->grps) { gt->grps = old; return -1; }
+  for (i = 0; i < 2*n; i++)     /* create a new table and */
+    memset(gt->grps[i].ctrl, GT_EMPTY, GT_GRPSIZE);
+  gt->gmask = 2*n-1;            /* mark all entries as empty */
+  for (i = 0; i < n; i++) {     /* reinsert the old entries */
+    for (k = 0; k < GT_GRPSIZE; k++) {
+      if (old[i].ctrl[k] == GT_EMPTY) continue;
+      e = old[i].ents +k;       /* traverse the non-empty entries */
+      gt_put(gt, e, gt_hash(&e->fp, e->n));
+    }                           /* and put them into the new table */
+  }
+  free(old);                    /* delete the old table */
+  return 0;                     /* return 'ok' */
+}  /* gt_grow() */
+
+/*--------------------------------------------------------------------*/
+
+int gt_isgen (GENTAB *gt, const ITEM *items, ITEM n,
+              ITEM item, RSUPP supp)
+{                               /* --- check for a generator */
+  ITEM        i;                /* loop variable */
+  GTFP        *fp;              /* fingerprint of the new item set */
+  GTFP        *s;               /* fingerprint of a subset */
+  const GTENT *e;               /* found table entry */
+  GTENT       ent;              /* new table entry */
+
+  assert(gt && (items || (n <= 0)) && (n >= 0) && (item >= 0));
+  gt_extend(gt, n, item);       /* compute the new fingerprint */
+  fp = gt->pfps +n+1;           /* and those of all subsets */
+  for (i = 0; i < n; i++) {     /* that lack one of the prefix items */
+    s = gt->sfps +i;            /* (fingerprints are sums of item */
+    s->a = fp->a -gt->ifps[items[i]].a;   /* fingerprints, so that */
+    s->b = fp->b -gt->ifps[items[i]].b;   /* a subset fingerprint */
+    gt->hs[i] = gt_hash(s, n);  /* is a simple difference) */
+    #ifdef __GNUC__             /* prefetch the first entry group */
+    __builtin_prefetch(gt->grps +((gt->hs[i] >> 7) & gt->gmask));
+    #endif                      /* (to overlap the memory accesses */
+  }                             /* for the different subsets) */
+  for (i = 0; i < n; i++) {     /* traverse the subsets */
+    e = gt_find(gt, gt->sfps +i, n, gt->hs[i]);
+    if (!e || (e->supp == supp))/* if a subset with one item less */
+      return 0;                 /* is not in the generator index */
+  }                             /* or has the same support, abort */
+  if ((8*(gt->cnt+1) > 7*(gt->gmask+1)*GT_GRPSIZE)
+  &&  (gt_grow(gt) != 0))       /* keep the load factor below 7/8 */
+    return -1;                  /* (enlarge the table if necessary) */
+  ent.fp = *fp; ent.supp = supp; ent.n = n+1;
+  gt_put(gt, &ent, gt_hash(fp, n+1));
+  gt->cnt += 1;                 /* add the new item set */
+  return 1;                     /* return 'set is a generator' */
+}  /* gt_isgen() */
+
+/* An item set is a generator if all of its subsets with one item  */
+/* less are generators and have a (strictly) larger support. Since */
+/* all subsets of a generator are generators, these subsets must   */
+/* already be in the index. The new item is never held out, because */
+/* the prefix itself is known to be a generator with larger support. */
+/* Item sets are identified by 128 bit fingerprints, which are the  */
+/* sums of random item fingerprints. A false match requires two     */
+/* independent 64 bit sums to collide, which is negligibly unlikely */
+/* even for billions of stored item sets.                           */
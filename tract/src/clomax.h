@@ -10,6 +10,8 @@
             2010.07.22 closed/maximal item set filter functions added
             2011.05.10 bug for RSUPP=double fixed (CMTREE.max)
             2014.07.23 check for a valid tree based on associated item
+            2026.10.18 hash filter for closed item sets added (CMHASH)
+            2026.10.18 generator index with set fingerprints (GENTAB)
 ----------------------------------------------------------------------*/
 /* This version uses a top-down structure for the repository trees  */
 /* and their processing. A frequent pattern tree structure was also */
@@ -17,6 +19,7 @@
 
 #ifndef __CLOMAX__
 #define __CLOMAX__
+#include <stdint.h>
 #include "memsys.h"
 #include "tract.h"
 
@@ -123,6 +126,49 @@ typedef struct {                /* --- closed/maximal filter --- */
   CMTREE  *trees[1];            /* conditional prefix trees */
 } CLOMAX;                       /* (closed/maximal filter) */
 
+typedef struct {                /* --- closed set hash table entry --- */
+  RSUPP   supp;                 /* support of the item set */
+  size_t  sig;                  /* signature of its trans. id set */
+  size_t  set;                  /* position of the set in the pool */
+} CMHENT;                       /* (closed set hash table entry) */
+
+typedef struct {                /* --- closed item set hash filter --- */
+  ITEM    size;                 /* number of items */
+  size_t  cnt;                  /* number of stored item sets */
+  size_t  mask;                 /* hash table size minus one */
+  CMHENT  *tab;                 /* hash table (open addressing) */
+  ITEM    *pool;                /* stored item sets (size, items) */
+  size_t  used;                 /* number of used pool elements */
+  size_t  psize;                /* size of the item set pool */
+  char    *marks;               /* flags for the items of a query */
+} CMHASH;                       /* (closed item set hash filter) */
+
+typedef struct {                /* --- item set fingerprint --- */
+  uint64_t a, b;                /* two independent 64 bit sums */
+} GTFP;                         /* (item set fingerprint) */
+
+typedef struct {                /* --- generator index entry --- */
+  GTFP    fp;                   /* fingerprint of the item set */
+  RSUPP   supp;                 /* support of the item set */
+  ITEM    n;                    /* number of items in the set */
+} GTENT;                        /* (generator index entry) */
+
+typedef struct {                /* --- group of index entries --- */
+  unsigned char ctrl[16];       /* control bytes (hash tags) */
+  GTENT   ents[16];             /* table entries (open addressing) */
+} GTGRP;                        /* (group of generator index entries) */
+
+typedef struct {                /* --- generator index --- */
+  ITEM    size;                 /* number of items */
+  size_t  cnt;                  /* number of stored item sets */
+  size_t  gmask;                /* number of entry groups minus one */
+  GTGRP   *grps;                /* groups of table entries */
+  GTFP    *ifps;                /* fingerprints of the single items */
+  GTFP    *pfps;                /* fingerprints of the prefixes */
+  GTFP    *sfps;                /* buffer for subset fingerprints */
+  size_t  *hs;                  /* buffer for subset hash values */
+} GENTAB;                       /* (generator index) */
+
 /*----------------------------------------------------------------------
   Prefix Tree Functions
 ----------------------------------------------------------------------*/
@@ -170,6 +216,27 @@ extern int     cm_update   (CLOMAX *cm, const ITEM *items, ITEM n,
 extern void    cm_show     (CLOMAX *cm, ITEMBASE *base, int ind);
 #endif
 
+/*----------------------------------------------------------------------
+  Closed Item Set Hash Filter Functions
+----------------------------------------------------------------------*/
+extern CMHASH* cmh_create  (ITEM size);
+extern void    cmh_delete  (CMHASH *cmh);
+extern size_t  cmh_cnt     (CMHASH *cmh);
+extern int     cmh_super   (CMHASH *cmh, const ITEM *items, ITEM n,
+                            RSUPP supp, size_t sig);
+extern int     cmh_add     (CMHASH *cmh, const ITEM *items, ITEM n,
+                            RSUPP supp, size_t sig);
+
+/*----------------------------------------------------------------------
+  Generator Index Functions
+----------------------------------------------------------------------*/
+extern GENTAB* gt_create   (ITEM size);
+extern void    gt_delete   (GENTAB *gt);
+extern size_t  gt_cnt      (GENTAB *gt);
+extern void    gt_extend   (GENTAB *gt, ITEM n, ITEM item);
+extern int     gt_isgen    (GENTAB *gt, const ITEM *items, ITEM n,
+                            ITEM item, RSUPP supp);
+
 /*----------------------------------------------------------------------
   Preprocessor Definitions
 ----------------------------------------------------------------------*/
@@ -186,4 +253,12 @@ extern void    cm_show     (CLOMAX *cm, ITEMBASE *base, int ind);
 #define cm_dir(f)          ((f)->dir)
 #define cm_tree(f,i)       ((f)->trees[i])
 
+#define cmh_cnt(h)         ((h)->cnt)
+
+#define gt_cnt(g)          ((g)->cnt)
+#define gt_extend(g,n,i)   ((g)->pfps[(n)+1].a = (g)->pfps[n].a \
+                                               +(g)->ifps[i].a, \
+                            (g)->pfps[(n)+1].b = (g)->pfps[n].b \
+                                               +(g)->ifps[i].b)
+
 #endif
@@ -18,6 +18,9 @@
             2013.11.12 item selection file changed to option -R#
             2014.08.27 adapted to modified item set reporter interface
             2014.10.24 changed from LGPL license to MIT license
+            2026.10.18 AVX2 block counting for densely filled machines
+            2026.10.18 option -B added (binary item set output)
+            2026.10.18 benchmark for the counting functions added
 ------------------------------------------------------------------------
   Reference for the basic scheme of the 16 items machine:
     T. Uno, M. Kiyomi, and H. Arimura.
@@ -54,6 +57,26 @@
 #include "storage.h"
 #endif
 
+#define int         1           /* to check definitions */
+#define long        2           /* for certain types */
+#define ptrdiff_t   3
+#define double      4
+#if SUPP==int && defined __GNUC__ && !defined M16_NOSIMD \
+&&  (defined __x86_64__ || defined __i386__)
+#define M16_AVX2                /* use AVX2 instructions if possible */
+#endif
+#undef int                      /* remove preprocessor definitions */
+#undef long                     /* needed for the type checking */
+#undef ptrdiff_t
+#undef double
+
+#ifdef M16_AVX2
+#include <immintrin.h>
+#ifndef M16_DENSE               /* min. fill for block counting */
+#define M16_DENSE   2           /* (as log2 of the number of possible */
+#endif                          /* trans. per list entry, i.e. 2^n/4) */
+#endif
+
 /*----------------------------------------------------------------------
   Preprocessor Definitions
 ----------------------------------------------------------------------*/
@@ -133,6 +156,10 @@ static const BITTA prjms[16] = {/* bit masks for trans. projection */
   0x00ff, 0x01ff, 0x03ff, 0x07ff,
   0x0fff, 0x1fff, 0x3fff, 0x7fff };
 
+#ifdef M16_AVX2
+static int avx2 = -1;           /* whether the CPU supports AVX2 */
+#endif
+
 /*----------------------------------------------------------------------
   Auxiliary Functions (for debugging)
 ----------------------------------------------------------------------*/
@@ -166,6 +193,62 @@ static void show (const char *text, FIM16 *fim, int ind)
   }                             /* and terminate the output line */
 }  /* show() */
 
+#endif
+/*----------------------------------------------------------------------
+  AVX2 Functions
+----------------------------------------------------------------------*/
+#ifdef M16_AVX2
+
+__attribute__((target("avx2")))
+static void count_avx2 (FIM16 *fim, int n)
+{                               /* --- count support of all items */
+  int      i, k, x;             /* loop variables, buffer */
+  unsigned b;                   /* bit mask of non-zero weights */
+  SUPP     *w, s;               /* to traverse the weights, support */
+  BITTA    *t;                  /* to collect the transactions */
+  __m256i  v, a, z;             /* weights, support sum, zero */
+  __m128i  c;                   /* for summing the vector elements */
+
+  assert(fim && (n > 3));       /* check the function arguments */
+  z = _mm256_setzero_si256();   /* get a zero vector */
+  for (x = n; --x > 2; ) {      /* traverse the (lower) items */
+    k = 1 << x;                 /* the trans. with highest bit x form */
+    w = fim->wgts +k;           /* the block [2^x, 2^(x+1)) and their */
+    for (a = z, i = 0; i < k; i += 8) {  /* projections the block */
+      v = _mm256_loadu_si256((const __m256i*)(w+i));   /* [0, 2^x) */
+      a = _mm256_add_epi32(a, v);
+      _mm256_storeu_si256((__m256i*)(fim->wgts+i), _mm256_add_epi32(v,
+        _mm256_loadu_si256((const __m256i*)(fim->wgts+i))));
+    }                           /* sum upper block, add it to lower */
+    c = _mm_add_epi32(_mm256_castsi256_si128(a),
+                      _mm256_extracti128_si256(a, 1));
+    c = _mm_add_epi32(c, _mm_shuffle_epi32(c, 0x4e));
+    c = _mm_add_epi32(c, _mm_shuffle_epi32(c, 0xb1));
+    fim->supps[x] = _mm_cvtsi128_si32(c);
+  }                             /* store the computed item support */
+  w = fim->wgts +4;             /* process item 2 (block of size 4) */
+  for (s = 0, i = 0; i < 4; i++) { s += w[i]; fim->wgts[i] += w[i]; }
+  fim->supps[2] = s;            /* finally count for items 0 and 1 */
+  fim->wgts [0] = 0;            /* (empty trans. are not recorded) */
+  fim->supps[1] = fim->wgts[2] +fim->wgts[3];
+  fim->supps[0] = fim->wgts[1] +fim->wgts[3];
+  for (x = 0; x < n-1; x++) {   /* rebuild the lower trans. lists */
+    t = fim->btas[x]; k = 1 << x;
+    if (x < 3) {                /* if a short block, collect directly */
+      for (i = k; i < k+k; i++) if (fim->wgts[i]) *t++ = (BITTA)i; }
+    else {                      /* if a longer block, find non-zero */
+      for (i = k; i < k+k; i += 8) {      /* weights in groups of 8 */
+        v = _mm256_loadu_si256((const __m256i*)(fim->wgts+i));
+        b = ~(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(
+               _mm256_cmpeq_epi32(v, z))) & 0xffu;
+        while (b) {             /* traverse the non-zero weights */
+          *t++ = (BITTA)(i +__builtin_ctz(b)); b &= b-1; }
+      }                         /* collect the transactions */
+    }                           /* (a list contains exactly those */
+    fim->ends[x] = t;           /* transactions of its highest bit */
+  }                             /* that have a non-zero weight) */
+}  /* count_avx2() */
+
 #endif
 /*----------------------------------------------------------------------
   16 Items Machine Functions
@@ -180,6 +263,9 @@ FIM16* m16_create (int dir, SUPP supp, ISREPORT *report)
   if (hibit[0] != 0)            /* init. highest bit map if necessary */
     for (k = i = 0; k < 16; k++)/* traverse all possible transactions */
       while (i < (1 << (k+1))) hibit[i++] = (unsigned char)k;
+  #ifdef M16_AVX2               /* check (once) for AVX2 support */
+  if (avx2 < 0) avx2 = (__builtin_cpu_supports("avx2")) ? 1 : 0;
+  #endif                        /* to choose the counting functions */
   n   = (dir > 0) ? 1 : 16;     /* get the number of sub-machines */
   fim = (FIM16*)calloc((size_t)n, sizeof(FIM16));
   if (!fim) return NULL;        /* allocate the base structure */
@@ -333,6 +419,13 @@ static void count (FIM16 *fim, int n)
   SUPP  w, s;                   /* trans. weight and item support */
 
   assert(fim && (n > 0));       /* check the function arguments */
+  #ifdef M16_AVX2               /* if AVX2 instructions available */
+  if (avx2 && (n > 3)) {        /* and the machine is densely filled, */
+    for (w = 0, s = n; --s >= 0; )   /* process blocks of weights */
+      w += (SUPP)(fim->ends[s] -fim->btas[s]);
+    if (w >= ((1 << n) >> M16_DENSE)) { count_avx2(fim, n); return; }
+  }                             /* (the block transform is cheaper */
+  #endif                        /* than following the trans. lists) */
   while (--n > 1) {             /* traverse the (lower) items */
     e = fim->ends[n]; t = fim->btas[n];
     for (s = 0; t < e; t++) {   /* traverse the item's transactions */
@@ -720,6 +813,7 @@ int main (int argc, char *argv[])
   int     mtar     =  0;        /* mode for transaction reading */
   int     scan     =  0;        /* flag for scanable item output */
   int     stats    =  0;        /* flag for item set statistics */
+  int     binary   =  0;        /* flag for binary output format */
   ITEM    m;                    /* number of items */
   TID     n;                    /* number of transactions */
   SUPP    w;                    /* total transaction weight */
@@ -765,6 +859,7 @@ int main (int argc, char *argv[])
                     "(default: 1)\n");
     printf("-R#      read an item selection from a file\n");
     printf("-Z       print item set statistics (counts per size)\n");
+    printf("-B       write item sets in binary format (compressed)\n");
     printf("-g       write output in scanable form "
                     "(quote certain characters)\n");
     printf("-h#      record header  for output                "
@@ -812,6 +907,7 @@ int main (int argc, char *argv[])
           case 'x': repeat =       strtol(s, &s, 0); break;
           case 'R': optarg = &fn_sel;                break;
           case 'Z': stats  = 1;                      break;
+          case 'B': binary = 1;                      break;
           case 'g': scan   = 1;                      break;
           case 'h': optarg = &hdr;                   break;
           case 'k': optarg = &sep;                   break;
@@ -930,7 +1026,8 @@ int main (int argc, char *argv[])
     error(E_NOMEM);             /* set the output format strings */
   if (isr_setup(report) != 0)   /* set up the item set reporter */
     error(E_NOMEM);             /* (prepare reporter for output) */
-  k = isr_open(report, NULL, fn_out);
+  k = (binary) ? isr_openbin(report, NULL, fn_out)
+               : isr_open   (report, NULL, fn_out);
   if (k) error(k, isr_name(report)); /* open the output file */
 
   /* --- find frequent item sets --- */
@@ -962,3 +1059,103 @@ int main (int argc, char *argv[])
 }  /* main() */
 
 #endif
+/*----------------------------------------------------------------------
+  Main Function (counting benchmark)
+----------------------------------------------------------------------*/
+#ifdef M16_BENCH
+
+static double bench (BITTA *tracts, TID n, SUPP smin, int dir,
+                     int repeat, size_t *cnt)
+{                               /* --- time mining of random trans. */
+  int      i;                   /* loop variable for repetitions */
+  TID      k;                   /* loop variable for transactions */
+  ITEMBASE *base;               /* underlying item base */
+  ISREPORT *rep;                /* item set reporter (no output) */
+  FIM16    *fim;                /* 16 items machine */
+  char     name[8];             /* buffer for item names */
+  clock_t  t, s = 0;            /* timer for measurements */
+
+  base = ib_create(0, 16);      /* create an item base */
+  if (!base) return -1;         /* with 16 numeric items */
+  for (i = 0; i < 16; i++) {
+    sprintf(name, "%d", i);
+    if (ib_add(base, name) < 0) { ib_delete(base); return -1; }
+  }                             /* set the number of transactions */
+  ib_setwgt(base, (SUPP)n);
+  rep = isr_create(base);       /* create an item set reporter */
+  if (!rep
+  ||  (isr_settarg(rep, ISR_ALL, 0, -1) != 0)
+  ||  (isr_setup(rep) != 0)     /* set target and (no) output file */
+  ||  (isr_open(rep, NULL, NULL) != 0)) {
+    if (rep) isr_delete(rep, 0);
+    ib_delete(base); return -1; }
+  isr_setsupp(rep, (RSUPP)smin, RSUPP_MAX);
+  fim = m16_create(dir, smin, rep);
+  if (!fim) { isr_delete(rep, 1); return -1; }
+  for (i = 0; i < repeat; i++) {/* repeated mining loop */
+    isr_reset(rep);             /* (re)init. the output counters */
+    for (k = 0; k < n; k++)     /* add the transactions */
+      m16_add(fim, tracts[k], 1);
+    t = clock();                /* time only the search */
+    if (m16_mine(fim) < 0) break;
+    s += clock() -t;            /* find frequent item sets */
+  }
+  *cnt = isr_repcnt(rep);       /* note the number of item sets */
+  m16_delete(fim);              /* delete the 16 items machine */
+  isr_delete(rep, 1);           /* and the reporter (and item base) */
+  if (i < repeat) return -1;    /* check for a mining error */
+  return (double)s /(double)CLOCKS_PER_SEC;
+}  /* bench() */
+
+/*--------------------------------------------------------------------*/
+
+int main (int argc, char *argv[])
+{                               /* --- benchmark support counting */
+  TID      k, n;                /* loop variable, number of trans. */
+  int      i, p, dir, repeat;   /* item probability, direction etc. */
+  SUPP     smin;                /* minimum support of an item set */
+  BITTA    *tracts, b;          /* random transactions */
+  unsigned r = 1;               /* state of pseudo-random generator */
+  size_t   c0, c1;              /* numbers of found item sets */
+  double   t0, t1;              /* times for scalar/vector counting */
+
+  n      = (argc > 1) ? (TID)atol(argv[1]) : 200000;
+  p      = (argc > 2) ? atoi(argv[2]) : 50;
+  smin   = (argc > 3) ? (SUPP)atol(argv[3]) : 1;
+  dir    = (argc > 4) ? atoi(argv[4]) : +1;
+  repeat = (argc > 5) ? atoi(argv[5]) : 10;
+  if (n      < 1) n      = 1;   /* get the benchmark parameters */
+  if (smin   < 1) smin   = 1;   /* (number of transactions, item */
+  if (repeat < 1) repeat = 1;   /* probability in percent etc.) */
+  tracts = (BITTA*)malloc((size_t)n *sizeof(BITTA));
+  if (!tracts) { fprintf(stderr, "not enough memory\n"); return -1; }
+  for (k = 0; k < n; k++) {     /* generate random transactions */
+    for (b = 0, i = 0; i < 16; i++) {
+      r = r *1103515245u +12345u;
+      if ((int)((r >> 16) % 100) < p) b = (BITTA)(b | (1 << i));
+    }                           /* each item is contained in a trans. */
+    tracts[k] = b;              /* with the given probability */
+  }
+  #ifdef M16_AVX2               /* if AVX2 instructions available */
+  avx2 = 0;                     /* time the scalar counting */
+  #endif
+  t0 = bench(tracts, n, smin, dir, repeat, &c0);
+  #ifdef M16_AVX2               /* check for AVX2 support */
+  avx2 = (__builtin_cpu_supports("avx2")) ? 1 : 0;
+  #endif                        /* and time the vector counting */
+  t1 = bench(tracts, n, smin, dir, repeat, &c1);
+  free(tracts);                 /* delete the transactions */
+  if ((t0 < 0) || (t1 < 0)) {   /* check for a mining error */
+    fprintf(stderr, "mining failed\n"); return -1; }
+  fprintf(stderr, "scalar: %zu sets in %.3fs\n", c0, t0);
+  #ifdef M16_AVX2               /* print the measured times */
+  if (avx2) fprintf(stderr, "avx2  : %zu sets in %.3fs (%.2fx)\n",
+                    c1, t1, (t1 > 0) ? t0/t1 : 0);
+  else      fprintf(stderr, "avx2  : not supported by the CPU\n");
+  #else
+  fprintf(stderr, "avx2  : not compiled in\n");
+  #endif
+  return (c0 != c1) ? 1 : 0;    /* check for the same results */
+}  /* main() */
+
+#endif
@@ -62,9 +62,22 @@
             2014.08.27 functions isr_settarg(), isr_target() etc. added
             2014.09.02 return type of reporting functions changed to int
             2014.09.18 functions isr_reprule(), isr_setrule() added
+            2026.10.18 perfect extensions reported as a list (ISR_PEXLIST)
+            2026.10.18 binary output with prefix sharing and compression
+            2026.10.18 reporter shards for parallel miners added
+            2026.10.18 number formatting with digit pair tables,
+                       compiled information format, benchmark main
+            2026.10.18 closed item set hash filter added (ISR_CMHASH)
+            2026.10.18 generator filter with a generator index (GENTAB)
+            2026.10.18 top-k mining with support raising (isr_settopk())
+            2026.10.18 top-k rule mining with evaluation heap added
+            2026.10.18 result limit with clean abort (isr_setmax())
+            2026.10.18 progress/cancellation hook added (isr_setprog())
+            2026.10.18 function isr_prefix() added (copy current set)
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <float.h>
 #include <assert.h>
@@ -73,6 +86,9 @@
 #ifndef ISR_NONAMES
 #include "scanner.h"
 #endif
+#ifdef ISR_BENCH
+#include <time.h>
+#endif
 #ifdef STORAGE
 #include "storage.h"
 #endif
@@ -93,6 +109,11 @@
 #define BS_WRITE    65536       /* size of internal write buffer */
 #define BS_INT         48       /* buffer size for integer output */
 #define BS_FLOAT       96       /* buffer size for float   output */
+#define LZ_MINLEN       4       /* minimum length of a match */
+#define LZ_LAST        12       /* min. number of trailing literals */
+#define LZ_MAXOFF   65535       /* maximum offset of a match */
+#define LZ_HBITS       13       /* number of bits of hash values */
+#define LZ_BOUND(n)   ((n) +(n)/255 +16)  /* max. compressed size */
 #define LN_2        0.69314718055994530942  /* ln(2) */
 
 /*----------------------------------------------------------------------
@@ -106,6 +127,13 @@ static const double pows[] = {  /* several powers of ten */
   1e+24, 1e+25, 1e+26, 1e+27, 1e+28, 1e+29, 1e+30, 1e+31,
   1e+32, 1e+33 };
 
+static const char digs[] =      /* two digit decimal numbers */
+  "0001020304050607080910111213141516171819"
+  "2021222324252627282930313233343536373839"
+  "4041424344454647484950515253545556575859"
+  "6061626364656667686970717273747576777879"
+  "8081828384858687888990919293949596979899";
+
 /*----------------------------------------------------------------------
   Basic Output Functions
 ----------------------------------------------------------------------*/
@@ -120,7 +148,8 @@ static void fastchk (ISREPORT *rep)
   else if (!rep->file)          /* if no output (and no filtering), */
     rep->fast = -1;             /* only count the item sets */
   else {                        /* if only an output file is written */
-    rep->fast = ((rep->zmin <= 1) && (rep->zmax >= ITEM_MAX)
+    rep->fast = (!rep->bin
+              &&  (rep->zmin <= 1) && (rep->zmax >= ITEM_MAX)
               && ((strcmp(rep->info, " (%a)") == 0)
               ||  (strcmp(rep->info, " (%d)") == 0))
               &&  (strcmp(rep->hdr,  "")      == 0)
@@ -146,9 +175,319 @@ static int getsd (const char *s, const char **end)
 
 /*--------------------------------------------------------------------*/
 
+static int fopcomp (ISREPORT *rep)
+{                               /* --- compile info. output format */
+  ISRFOP     *o;                /* to traverse the operations */
+  const char *s, *t;            /* to traverse the format */
+  int        k;                 /* number of significant digits */
+
+  assert(rep && rep->info);     /* check the function argument */
+  if (rep->fops) free(rep->fops);
+  rep->fops = o = (ISRFOP*)malloc((strlen(rep->info)+1) *sizeof(ISRFOP));
+  if (!o) return E_NOMEM;       /* create an operation array */
+  o->type = 0; o->len = 0; o->text = rep->info;
+  for (s = rep->info; *s; ) {   /* traverse the output format */
+    if (*s != '%') { s++; o->len++; continue; }
+    t = s++; k = getsd(s, &s);  /* get the number of signif. digits */
+    switch (*s++) {             /* evaluate the indicator character */
+      case '%': o->len++; o++;  /* end the text after the first '%' */
+        o->type = 0;     o->len = 0; o->text = s; break;
+      case 'n': case 'd': case 'a': case 'i': case 's': case 'S':
+      case 'x': case 'X': case 'w': case 'W': case 'r': case 'R':
+      case 'z': case 'e': case 'E': case 'p': case 'P':
+        if (o->len > 0) o++;    /* finish a preceding text */
+        o->type = s[-1]; o->len = k; o->text = NULL; o++;
+        o->type = 0;     o->len = 0; o->text = s; break;
+      case  0 : --s;            /* store a quantity operation */
+      default : o->len += (int)(s-t); break;
+    }                           /* otherwise copy the characters */
+  }                             /* (a text starts with the '%', */
+  if (o->len > 0) o++;          /* so that it is contiguous) */
+  o->type = -1;                 /* terminate the operation array */
+  return 0;                     /* return 'ok' */
+}  /* fopcomp() */
+
+/* The information format is compiled into a list of operations  */
+/* once, so that it need not be interpreted for every item set.  */
+/* Texts refer directly to the format string, which is why a '%%' */
+/* ends a text after its first character and the next one starts */
+/* after the second character.                                   */
+
+/*--------------------------------------------------------------------*/
+
+static char* fmtint (char *end, uint64_t num)
+{                               /* --- format an unsigned integer */
+  size_t k;                     /* index into the digit pair table */
+
+  assert(end);                  /* check the function argument */
+  while (num >= 100) {          /* while there are 3 or more digits */
+    k = (size_t)(num % 100) *2; num /= 100;
+    *--end = digs[k+1]; *--end = digs[k];
+  }                             /* store two digits at a time */
+  if (num < 10) *--end = (char)(num +'0');
+  else { k = (size_t)num *2; *--end = digs[k+1]; *--end = digs[k]; }
+  return end;                   /* store the leading digit(s) and */
+}  /* fmtint() */               /* return the start of the number */
+
+/* The digits are written backwards from the given buffer end, so    */
+/* that the number of digits need not be known in advance. Taking    */
+/* two digits from a table halves the number of (slow) divisions.    */
+
+/*--------------------------------------------------------------------*/
+
+static void enqueue (ISREPORT *rep)
+{                               /* --- queue a filled output buffer */
+  ISRCHUNK *c;                  /* new queue element */
+  char     *buf;                /* new output buffer */
+  size_t   n;                   /* number of bytes in the buffer */
+
+  assert(rep && rep->parent);   /* check the function argument */
+  n = (size_t)(rep->next -rep->buf);
+  if (n <= 0) return;           /* check for a non-empty buffer */
+  c   = (ISRCHUNK*)malloc(sizeof(ISRCHUNK));
+  buf = (char*)malloc(BS_WRITE *sizeof(char));
+  if (!c || !buf) {             /* create a queue element */
+    if (c)   free(c);           /* and a new output buffer */
+    if (buf) free(buf);         /* (the filled one is queued) */
+    rep->err  = E_NOMEM;        /* on failure note the error */
+    rep->next = rep->buf;       /* and drop the buffered output */
+    return;                     /* (cannot be reported otherwise, */
+  }                             /* as the output functions are void) */
+  c->succ = NULL;               /* note the filled output buffer */
+  c->buf  = rep->buf; c->len = n;
+  if (rep->tail) rep->tail->succ = c;
+  else           rep->head       = c;
+  rep->tail  = c;               /* append the filled buffer */
+  rep->qlen += n;               /* to the output queue */
+  rep->buf   = rep->next = buf; /* and replace it by a new one */
+  rep->end   = buf +BS_WRITE;
+}  /* enqueue() */
+
+/*----------------------------------------------------------------------
+  Binary Output Functions
+------------------------------------------------------------------------
+  A binary output file starts with the magic number ISR_BINMAGIC,
+  a version byte, a flags byte (ISR_BINEVAL, ISR_BINDBL), the width
+  of the support values in bytes and a reserved byte, followed by
+  the number of item names and the item names (each as a length and
+  the characters). Then follows a sequence of blocks, each of which
+  consists of its size, its compressed size (0: not compressed) and
+  its data. A block holds a sequence of item set records, each
+  consisting of the number of items shared with the preceding set
+  (which need not be in the same block), the number of new items,
+  the new items, the support and (optionally) the evaluation.
+  Counts, sizes and items are stored as variable length integers
+  (7 bits per byte, least significant first, high bit set if more
+  bytes follow), support and evaluation as fixed width values
+  (little endian). The block compression is a simple LZ77 variant:
+  a token with the number of literals (upper 4 bits) and the match
+  length minus LZ_MINLEN (lower 4 bits), where 15 means that more
+  bytes (255: another byte follows) are added, the literals and
+  the match offset (2 bytes); the last token has no match.
+----------------------------------------------------------------------*/
+
+static unsigned char* putvar (unsigned char *p, size_t x)
+{                               /* --- store a variable length int. */
+  while (x >= 0x80) {           /* while more than 7 bits are left, */
+    *p++ = (unsigned char)(x | 0x80); x >>= 7; }
+  *p++ = (unsigned char)x;      /* store 7 bits with a continuation */
+  return p;                     /* flag, then store the last bits */
+}  /* putvar() */
+
+/*--------------------------------------------------------------------*/
+
+static unsigned char* putfix (unsigned char *p, uint64_t x, int n)
+{                               /* --- store a fixed width integer */
+  while (--n >= 0) {            /* store the bytes of the value */
+    *p++ = (unsigned char)x; x >>= 8; }
+  return p;                     /* (in little endian byte order) */
+}  /* putfix() */
+
+/*--------------------------------------------------------------------*/
+
+static unsigned char* putlen (unsigned char *p, size_t n)
+{                               /* --- store a literal/match length */
+  for ( ; n >= 255; n -= 255)   /* store full bytes while possible */
+    *p++ = 255;                 /* and then the remaining value */
+  *p++ = (unsigned char)n; return p;
+}  /* putlen() */
+
+/*--------------------------------------------------------------------*/
+
+static size_t lzenc (unsigned char *dst, const unsigned char *src,
+                     size_t n)
+{                               /* --- compress a block (LZ77 style) */
+  uint32_t      htab[1 << LZ_HBITS]; /* last positions of 4-grams */
+  uint32_t      x, y;           /* 4-grams at current/ref. position */
+  size_t        i, a, r, h;     /* current/anchor/ref. pos., hash */
+  size_t        m, k;           /* match length, number of literals */
+  unsigned char *d = dst, *t;   /* to traverse the output, token */
+
+  assert(dst && src);           /* check the function arguments */
+  memset(htab, 0, sizeof(htab));/* clear the hash table */
+  for (i = a = 0; i +LZ_LAST < n; ) {
+    memcpy(&x, src+i, 4);       /* get the 4-gram at the position */
+    h = (size_t)((x *2654435761U) >> (32-LZ_HBITS));
+    r = htab[h]; htab[h] = (uint32_t)i;
+    if ((r >= i) || (i -r > LZ_MAXOFF)) { i++; continue; }
+    memcpy(&y, src+r, 4);       /* get the referenced 4-gram and */
+    if (x != y) { i++; continue; }   /* check for a match */
+    for (m = LZ_MINLEN; (i+m +LZ_LAST < n) && (src[r+m] == src[i+m]); )
+      m++;                      /* extend the match */
+    k = i -a; t = d++;          /* get the number of literals */
+    *t = (unsigned char)(((k < 15) ? k : 15) << 4);
+    if (k >= 15) d = putlen(d, k-15);
+    memcpy(d, src+a, k); d += k;/* store the literals */
+    *d++ = (unsigned char) (i-r);        /* store the offset */
+    *d++ = (unsigned char)((i-r) >> 8);  /* of the match */
+    k = m -LZ_MINLEN;           /* get the extra match length */
+    *t |= (unsigned char)((k < 15) ? k : 15);
+    if (k >= 15) d = putlen(d, k-15);
+    a = i += m;                 /* skip the matched bytes */
+  }
+  k = n -a; t = d++;            /* store the trailing literals */
+  *t = (unsigned char)(((k < 15) ? k : 15) << 4);
+  if (k >= 15) d = putlen(d, k-15);
+  memcpy(d, src+a, k); d += k;  /* (final token without a match) */
+  return (size_t)(d -dst);      /* return the compressed size */
+}  /* lzenc() */
+
+/*--------------------------------------------------------------------*/
+
+static void binhead (ISREPORT *rep)
+{                               /* --- write binary file header */
+  unsigned char buf[16], *p;    /* buffer for the header fields */
+  ITEM          i, n = 0;       /* loop variable, number of items */
+  #ifndef ISR_NONAMES           /* if item names are available */
+  const char    *name;          /* to traverse the item names */
+  size_t        len;            /* length of an item name */
+  #endif
+
+  assert(rep && rep->file);     /* check the function argument */
+  memcpy(buf, ISR_BINMAGIC, 4); /* store the magic number, */
+  buf[4] = ISR_BINVERS;         /* the version of the format, */
+  buf[5] = (unsigned char)rep->bflags;  /* the format flags, */
+  buf[6] = (unsigned char)((rep->bflags & ISR_BINDBL)
+                          ? sizeof(double) : sizeof(RSUPP));
+  buf[7] = 0;                   /* the width of support values */
+  #ifndef ISR_NONAMES           /* and the number of item names */
+  n = ib_cnt(rep->base);        /* (no names without name support) */
+  #endif
+  p = putvar(buf+8, (size_t)n); /* write the header fields */
+  fwrite(buf, 1, (size_t)(p-buf), rep->file);
+  for (i = 0; i < n; i++) {     /* traverse the item names */
+    #ifndef ISR_NONAMES         /* write the length and */
+    name = ib_name(rep->base, i);     /* the characters */
+    len  = strlen(name);        /* of each item name */
+    p = putvar(buf, len); fwrite(buf, 1, (size_t)(p-buf), rep->file);
+    fwrite(name, 1, len, rep->file);
+    #endif
+  }
+  rep->bin = +1;                /* note that the header was written */
+}  /* binhead() */
+
+/*--------------------------------------------------------------------*/
+
+static void binblk (ISREPORT *rep, const char *blk, size_t n)
+{                               /* --- write a binary output block */
+  unsigned char buf[32], *p;    /* buffer for the block header */
+  size_t        z = n;          /* compressed block size */
+  char          *zbuf;          /* reallocated compression buffer */
+
+  assert(rep && rep->file && blk); /* check the function arguments */
+  if (n <= 0) return;           /* check for a non-empty block */
+  if (LZ_BOUND(n) > rep->zsize){/* if the block may not fit, */
+    zbuf = (char*)realloc(rep->zbuf, LZ_BOUND(n) *sizeof(char));
+    if (zbuf) { rep->zbuf = zbuf; rep->zsize = LZ_BOUND(n); }
+  }                             /* enlarge the compression buffer */
+  if (LZ_BOUND(n) <= rep->zsize)/* compress the block if possible */
+    z = lzenc((unsigned char*)rep->zbuf, (const unsigned char*)blk, n);
+  p = putvar(buf, n);           /* write the block header */
+  p = putvar(p, (z < n) ? z : 0);
+  fwrite(buf, 1, (size_t)(p-buf), rep->file);
+  if (z < n) fwrite(rep->zbuf, 1, z, rep->file);
+  else       fwrite(blk,       1, n, rep->file);
+}  /* binblk() */               /* write the (compressed) block */
+
+/*--------------------------------------------------------------------*/
+
+static void binflush (ISREPORT *rep)
+{                               /* --- flush a binary output block */
+  assert(rep && rep->file);     /* check the function argument */
+  if (rep->bin < 0) binhead(rep);  /* write header if necessary */
+  binblk(rep, rep->buf, (size_t)(rep->next -rep->buf));
+  rep->next = rep->buf;         /* write the buffer as a block */
+}  /* binflush() */              /* and reinit. the write position */
+
+/*--------------------------------------------------------------------*/
+
+static int binout (ISREPORT *rep, const ITEM *items, ITEM n,
+                   RSUPP supp, double eval)
+{                               /* --- write an item set (binary) */
+  ITEM          k, p;           /* loop variable, prefix length */
+  size_t        z;              /* maximum size of the record */
+  unsigned char *s;             /* to traverse the write buffer */
+  uint64_t      b;              /* buffer for a double value */
+  double        x;              /* support as a double value */
+  char          *buf;           /* reallocated write buffer */
+
+  assert(rep && rep->file && (items || (n <= 0)));
+  for (p = 0; (p < n) && (p < rep->bcnt); p++)
+    if (items[p] != rep->bset[p]) break;
+  z = (size_t)(n-p) *5 +32;     /* determine the shared prefix */
+  if ((size_t)(rep->end -rep->next) < z) {
+    if (rep->parent) enqueue(rep);  /* if the record does not fit, */
+    else             binflush(rep); /* flush the buffer */
+    if ((size_t)(rep->end -rep->buf) < z) {
+      buf = (char*)realloc(rep->buf, z *sizeof(char));
+      if (!buf) return E_NOMEM; /* enlarge the write buffer */
+      rep->next = rep->buf = buf; rep->end = buf +z;
+      buf = (char*)realloc(rep->zbuf, LZ_BOUND(z) *sizeof(char));
+      if (!buf) return E_NOMEM; /* enlarge the compression buffer */
+      rep->zbuf = buf; rep->zsize = LZ_BOUND(z);
+    }                           /* (needed only for very large sets, */
+  }                             /* which should be extremely rare) */
+  s = putvar((unsigned char*)rep->next, (size_t)p);
+  s = putvar(s, (size_t)(n-p)); /* store the prefix length and */
+  for (k = p; k < n; k++) {     /* the number of new items */
+    s = putvar(s, (size_t)items[k]);
+    rep->bset[k] = items[k];    /* store the new items and */
+  }                             /* note them for the next record */
+  rep->bcnt = n;                /* note the size of the item set */
+  if (rep->bflags & ISR_BINDBL) {
+    x = (double)supp;           /* store the support as a double */
+    memcpy(&b, &x, sizeof(b)); s = putfix(s, b, 8); }
+  else                          /* or as an integer of type RSUPP */
+    s = putfix(s, (uint64_t)(int64_t)supp, (int)sizeof(RSUPP));
+  if (rep->bflags & ISR_BINEVAL) {
+    memcpy(&b, &eval, sizeof(b)); s = putfix(s, b, 8); }
+  rep->next = (char*)s;         /* store the evaluation if requested */
+  return 0;                     /* and advance the write position */
+}  /* binout() */
+
+/*--------------------------------------------------------------------*/
+
+static void binflg (ISREPORT *rep)
+{                               /* --- set binary format flags */
+  assert(rep);                  /* check the function argument */
+  rep->bflags = (((RSUPP)0.5 > 0) ? ISR_BINDBL  : 0)
+              | ((rep->evalfn)    ? ISR_BINEVAL : 0);
+}  /* binflg() */               /* (must not change after header) */
+
+/*--------------------------------------------------------------------*/
+
 static void isr_flush (ISREPORT *rep)
 {                               /* --- flush the output buffer */
   assert(rep);                  /* check the function arguments */
+  if (rep->parent) {            /* if this is a reporter shard, */
+    if (rep->next >= rep->end)  /* only queue a full output buffer */
+      enqueue(rep);             /* (a partially filled buffer is */
+    return;                     /* written when the shard is merged) */
+  }
+  if (rep->bin) {               /* if to write binary output, */
+    if (rep->file) binflush(rep);  /* compress and write a block */
+    return;                     /* (header is written before */
+  }                             /* the first block) */
   fwrite(rep->buf, sizeof(char),(size_t)(rep->next-rep->buf),rep->file);
   rep->next = rep->buf;         /* write the output buffer */
   #ifndef NDEBUG                /* in debug mode */
@@ -201,71 +540,56 @@ static void isr_putsn (ISREPORT *rep, const char *s, int n)
 
 int isr_intout (ISREPORT *rep, ptrdiff_t num)
 {                               /* --- print an integer number */
-  int  i = BS_INT, n;           /* loop variable, character counter */
-  char buf[BS_INT];             /* output buffer */
+  char buf[BS_INT], *s;         /* output buffer, start of number */
+  int  n;                       /* number of characters */
 
   assert(rep);                  /* check the function arguments */
-  if (num == 0) {               /* treat zero as a special case */
-    isr_putc(rep, '0'); return 1; }
-  if (num <= PTRDIFF_MIN) {     /* treat minimum as a special case */
-    #if PTRDIFF_MIN < 0x80000000/* if 64 bit system */
-    isr_putsn(rep, "-9223372036854775808", 20); return 20;
-    #else                       /* if 32 bit system */
-    isr_putsn(rep, "-2147483648", 11); return 11;
-    #endif                      /* directly return string and size */
-  }
-  n = 0;                        /* default: no sign printed */
-  if (num < 0) {                /* if the number is negative, */
-    num = -num; isr_putc(rep, '-'); n = 1; }  /* print a sign */
-  do {                          /* digit output loop */
-    buf[--i] = (char)((num % 10) +'0');  /* store the next digit */
-    num /= 10;                  /* and remove it from the number */
-  } while (num > 0);            /* while there are more digits */
-  isr_putsn(rep, buf+i, BS_INT-i);
-  n += BS_INT-i;                /* print the generated digits and */
-  return n;                     /* return the number of characters */
+  if (num >= 0)                 /* format the absolute value */
+    s = fmtint(buf+BS_INT, (uint64_t)num);
+  else {                        /* (the negation is done unsigned */
+    s = fmtint(buf+BS_INT, (uint64_t)0 -(uint64_t)num);
+    *--s = '-';                 /* so that the minimum needs no */
+  }                             /* special treatment) */
+  isr_putsn(rep, s, n = (int)(buf+BS_INT -s));
+  return n;                     /* print the formatted number and */
 }  /* isr_intout() */
 
 /*--------------------------------------------------------------------*/
 
 int mantout (ISREPORT *rep, double num, int digits, int ints)
 {                               /* --- format a non-negative mantissa */
-  int    i, n;                  /* loop variables, sign flag */
-  double x, y;                  /* integral and fractional part */
-  char   *s, *e, *d;            /* pointers into the output buffer */
-  char   buf[BS_FLOAT];         /* output buffer */
+  int      i, n;                /* loop variable, number of decimals */
+  double   x, y;                /* integral and fractional part */
+  uint64_t f;                   /* decimals as an integer number */
+  char     *s, *e, *d;          /* pointers into the output buffer */
+  char     buf[BS_FLOAT];       /* output buffer */
 
   assert(rep);                  /* check the function arguments */
   i = (int)dbl_bisect(num, pows, 36);
   if ((i >= 36) || (pows[i] == num)) i++;
   n = digits -(i-2);            /* compute the number of decimals */
   x = floor(num); y = num-x;    /* split into integer and fraction */
-  e = d = buf +40;              /* get buffer for the decimals */
+  assert(x < 1e19);             /* (integral part must fit 64 bits) */
+  f = 0;                        /* default: no decimals */
   if (n > 0) {                  /* if to print decimal digits, */
-    *e++ = '.';                 /* store a decimal point */
-    do { y *= 10;               /* compute the next decimal */
-      *e++ = (char)((int)y+'0');/* and store it in the buffer */
-      y   -= floor(y);          /* remove the printed decimal */
-    } while (--n > 0);          /* while there are more decimals */
-  }                             /* remove a decimal if necessary */
+    y *= pows[n+2];             /* shift them into the integral part */
+    f  = (uint64_t)floor(y); y -= (double)f;
+  }                             /* and split off the remainder */
   if ((y > 0.5) || ((y == 0.5)  /* if number needs to be rounded */
-  &&  ((e > d) ? *(e-1) & 1 : floor(x/2) >= x/2))) {
-    for (s = e; --s > d; ) {    /* traverse the decimal digits */
-      if (*s < '9') { (*s)++; break; }
-      *s = '0';                 /* if digit can be incremented, */
-    }                           /* abort, otherwise store a zero */
-    if ((s <= d) && ((x += 1) >= pows[i]))
-      if (--e <= d+1) e = d;    /* if all decimals have been adapted, */
-  }                             /* increment the integer part and */
-  if (e > d) {                  /* if there are decimal places, */
-    while (*--e == '0');        /* remove all trailing zeros */
-    if (e > d) e++;             /* if there are no decimals left, */
-  }                             /* also remove the decimal point */
-  s = d;                        /* adapt the decimals if necessary */
-  do {                          /* integral part output loop */
-    *--s = (char)(fmod(x, 10) +'0');
-    x = floor(x/10);            /* compute and store next digit */
-  } while (x > 0);              /* while there are more digits */
+  &&  ((n > 0) ? (f & 1) : (floor(x/2) < x/2)))) {
+    if (n > 0) f += 1;          /* round half to even, */
+    else       x += 1;          /* either the decimals */
+  }                             /* or the integral part */
+  if ((n > 0) && ((double)f >= pows[n+2])) {
+    f = 0; x += 1; }            /* carry into the integral part */
+  e = d = buf +40;              /* get buffer for the decimals */
+  if (f > 0) {                  /* if there are decimal places, */
+    s = fmtint(e = d+1+n, f);   /* format them with leading zeros */
+    while (s > d+1) *--s = '0'; /* and a decimal point */
+    *d = '.';                   /* then remove all trailing zeros */
+    while (*(e-1) == '0') e--;  /* (at least one digit is not zero, */
+  }                             /* so the decimal point is kept) */
+  s = fmtint(d, (uint64_t)x);   /* format the integral part */
   if ((n = (int)(d-s)) > ints)  /* check size of integral part */
     return -n;                  /* and abort if it is too large */
   isr_putsn(rep, s, n = (int)(e-s)); /* print the formatted number */
@@ -277,7 +601,7 @@ int mantout (ISREPORT *rep, double num, int digits, int ints)
 int isr_numout (ISREPORT *rep, double num, int digits)
 {                               /* --- print a floating point number */
   int  k, n, e;                 /* character counters and exponent */
-  char buf[BS_FLOAT];           /* output buffer */
+  char buf[BS_FLOAT], *s;       /* output buffer, start of exponent */
 
   assert(rep);                  /* check the function arguments */
   if (isnan(num)) {             /* check for 'not a number' */
@@ -291,7 +615,11 @@ int isr_numout (ISREPORT *rep, double num, int digits)
     isr_putc(rep, '0');   return n+1; }
   if (digits > 32) digits = 32; /* limit the number of sign. digits */
   if (digits > 11) {            /* if very high precision is needed */
-    k = sprintf(buf, "%.*g", digits, num);
+    for (k = (digits < 15) ? digits : 15; k < digits; k++) {
+      sprintf(buf, "%.*g", k, num);
+      if (strtod(buf, NULL) == num) break;
+    }                           /* find the shortest representation */
+    k = sprintf(buf, "%.*g", k, num);   /* that reads back exactly */
     isr_putsn(rep, buf, k);     /* format with standard printf, */
     return n+k;                 /* print the formatted number and */
   }                             /* return the number of characters */
@@ -312,22 +640,19 @@ int isr_numout (ISREPORT *rep, double num, int digits)
   }                             /* output the adapted number */
   n += k;                       /* compute number of printed chars. */
   if (e == 0) return n;         /* if no exponent, abort the function */
-  isr_putc(rep, 'e'); n += 2;   /* print an exponent indicator */
-  isr_putc(rep, (e < 0) ? '-' : '+');
-  if ((e = abs(e)) < 10) { isr_putc(rep, '0'); n++; }
-  k = BS_INT;                   /* get the end of the buffer */
-  do {                          /* exponent digit output loop */
-    buf[--k] = (char)((e % 10) +'0');    /* store the next digit */
-    e /= 10;                    /* and remove it from the number */
-  } while (e > 0);              /* while there are more digits */
-  isr_putsn(rep, buf+k, BS_INT-k);
-  return n+BS_INT-k;            /* print the generated digits and */
+  s = fmtint(buf+BS_INT, (uint64_t)abs(e));
+  if (s > buf+BS_INT-2) *--s = '0';  /* format the exponent digits */
+  *--s = (e < 0) ? '-' : '+';   /* (at least two), the exponent sign */
+  *--s = 'e';                   /* and an exponent indicator */
+  isr_putsn(rep, s, k = (int)(buf+BS_INT -s));
+  return n+k;                   /* print the formatted exponent and */
 }  /* isr_numout() */           /* return the number of characters */
 
 /* It is (significantly) faster to output a floating point number  */
 /* with the above routines than with sprintf. However, the above   */
 /* code produces slightly less accurate output for more than about */
-/* 14 significant digits. For those cases sprintf is used instead. */
+/* 14 significant digits. For those cases sprintf is used instead, */
+/* with the fewest digits (but at least 15) that read back exactly. */
 
 /*--------------------------------------------------------------------*/
 
@@ -359,127 +684,26 @@ int isr_wgtout (ISREPORT *rep, RSUPP supp, double wgt)
 
 static int isr_tidout (ISREPORT *rep, TID tid)
 {                               /* --- print a positive integer */
-  int  i = BS_INT;              /* loop variable */
-  char buf[BS_INT];             /* output buffer */
+  char buf[BS_INT], *s;         /* output buffer, start of number */
 
   assert(rep && (tid >= 0));    /* check the function arguments */
-  do {                          /* digit output loop */
-    buf[--i] = (char)((tid % 10) +'0');  /* store the next digit */
-    tid /= 10;                  /* and remove it from the number */
-  } while (tid > 0);            /* while there are more digits */
-  fwrite(buf +i, sizeof(char), (size_t)(BS_INT-i), rep->tidfile);
-  return BS_INT -i;             /* print the digits and */
+  s = fmtint(buf+BS_INT, (uint64_t)tid);
+  fwrite(s, sizeof(char), (size_t)(buf+BS_INT -s), rep->tidfile);
+  return (int)(buf+BS_INT -s);  /* print the digits and */
 }  /* isr_tidout() */
 
 /*--------------------------------------------------------------------*/
 
 static int isr_occout (ISREPORT *rep, ITEM occ)
 {                               /* --- print a positive integer */
-  int  i = BS_INT;              /* loop variable */
-  char buf[BS_INT];             /* output buffer */
+  char buf[BS_INT], *s;         /* output buffer, start of number */
 
   assert(rep && (occ >= 0));    /* check the function arguments */
-  do {                          /* digit output loop */
-    buf[--i] = (char)((occ % 10) +'0');  /* store the next digit */
-    occ /= 10;                  /* and remove it from the number */
-  } while (occ > 0);            /* while there are more digits */
-  fwrite(buf +i, sizeof(char), (size_t)(BS_INT-i), rep->tidfile);
-  return BS_INT -i;             /* print the digits and */
+  s = fmtint(buf+BS_INT, (uint64_t)occ);
+  fwrite(s, sizeof(char), (size_t)(buf+BS_INT -s), rep->tidfile);
+  return (int)(buf+BS_INT -s);  /* print the digits and */
 }  /* isr_occout() */
 
-/*----------------------------------------------------------------------
-  Generator Filtering Functions
-----------------------------------------------------------------------*/
-#ifdef ISR_CLOMAX
-
-static size_t is_hash (const void *set, int type)
-{                               /* --- compute item set hash value */
-  size_t     i;                 /* loop variable */
-  size_t     h;                 /* computed hash value */
-  const ITEM *p;                /* to access the items */
-
-  assert(set);                  /* check the function argument */
-  p = (const ITEM*)set;         /* type the item set pointer */
-  h = (size_t)*p++;             /* get the number of items */
-  i = (h >> 3) +1;              /* use Duff's device */
-  switch (h & 7) {              /* to compute the hash value */
-    do {    h = h *251 +(size_t)*p++;
-    case 7: h = h *251 +(size_t)*p++;
-    case 6: h = h *251 +(size_t)*p++;
-    case 5: h = h *251 +(size_t)*p++;
-    case 4: h = h *251 +(size_t)*p++;
-    case 3: h = h *251 +(size_t)*p++;
-    case 2: h = h *251 +(size_t)*p++;
-    case 1: h = h *251 +(size_t)*p++;
-    case 0: ; } while (--i > 0);
-  }                             /* semicolon is necessary */
-  return h;                     /* return the computed hash value */
-  /* This hash function treats an item set like a string, that is, */
-  /* the hash code depends on the order of the items. This is no   */
-  /* drawback, though, because the comparison also requires that   */
-  /* the items are in the same order in the item sets to compare.  */
-  /* However, an order-independent hash code could be used to make */
-  /* the function is_isgen() faster by avoiding recomputations.    */
-}  /* is_hash() */
-
-/*--------------------------------------------------------------------*/
-
-static int is_cmp (const void *a, const void *b, void *d)
-{                               /* --- compare two item sets */
-  ITEM n;                       /* loop variable, number of items */
-  ITEM *x, *y;                  /* to access the item sets */
-
-  assert(a && b);               /* check the function arguments */
-  x = (ITEM*)a; y = (ITEM*)b;   /* get/type the item set pointers */
-  n = *x++;                     /* if the item set sizes differ, */
-  if (n != *y++) return 1;      /* the item sets are not equal */
-  while (--n >= 0)              /* traverse and compare the items */
-    if (x[n] != y[n]) return 1; /* if an item differs, abort */
-  return 0;                     /* otherwise the item sets are equal */
-  /* Using memcmp() for the comparison is slower, because memcmp() */
-  /* also checks the order relationship, not just equality, which, */
-  /* however, is all that is needed inside the hash table.         */
-}  /* is_cmp() */
-
-/*--------------------------------------------------------------------*/
-
-static int is_isgen (ISREPORT *rep, ITEM item, RSUPP supp)
-{                               /* --- check for a generator */
-  ITEM   i;                     /* loop variable */
-  size_t z;                     /* key size */
-  ITEM   *p;                    /* to access the hash table key */
-  RSUPP  *s;                    /* to access the hash table data */
-  ITEM   a, b;                  /* buffers for items (hold-out) */
-
-  assert(rep && (item >= 0));   /* check the function arguments */
-  rep->iset[rep->cnt+1] = item; /* store the new item at the end */
-  if (rep->cnt > 0) {           /* if the current set is not empty */
-    rep->iset[0] = rep->cnt;    /* copy the item set to the buffer */
-    p = (ITEM*)memcpy(rep->iset+1, rep->items,
-                      (size_t)rep->cnt *sizeof(ITEM));
-    if (rep->mode & ISR_SORT)   /* sort the items according to code */
-      ia_qsort(p, (size_t)rep->cnt+1, rep->dir);
-    a = p[i = rep->cnt];        /* note the first hold-out item */
-    for (++i; --i >= 0; ) {     /* traverse the items in the set */
-      b = p[i]; p[i] = a; a = b;/* get next subset (next hold-out) */
-      if (a == item) continue;  /* do not exclude the new item */
-      s = (RSUPP*)st_lookup(rep->gentab, rep->iset, 0);
-      if (!s || (*s == supp))   /* if a subset with one item less */
-        break;                  /* is not in the generator repository */
-    }                           /* or has the same support, abort */
-    if (i >= 0) return 0;       /* if subset was found, no generator */
-    memmove(p+1, p, (size_t)rep->cnt *sizeof(ITEM));
-    p[0] = a;                   /* restore the full new item set */
-  }                             /* (with the proper item order) */
-  rep->iset[0] = rep->cnt+1;    /* store the new item set size */
-  z = (size_t)(rep->cnt+2) *sizeof(ITEM);  /* compute key size */
-  s = (RSUPP*)st_insert(rep->gentab, rep->iset, 0, z, sizeof(RSUPP));
-  if (!s) return -1;            /* add the new set to the repository */
-  *s = supp;                    /* and store its support as the data */
-  return 1;                     /* return 'set is a generator' */
-}  /* is_isgen() */
-
-#endif
 /*----------------------------------------------------------------------
   Main Functions
 ----------------------------------------------------------------------*/
@@ -508,11 +732,18 @@ ISREPORT* isr_create (ITEMBASE *base)
   rep->xmax    = ITEM_MAX;
   rep->smin    = 1;             /* set the default support range */
   rep->smax    = RSUPP_MAX;
+  rep->topk    = rep->tkcnt = 0;/* no top-k mining by default */
+  rep->tkheap  = NULL;
+  rep->tkdir   = 0;             /* no top-k rule mining by default */
+  rep->tkeval  = -DBL_MAX;
+  rep->tkevals = NULL;
   rep->border  = NULL;          /* clear the filtering border */
   rep->bdrsize = rep->bdrcnt = 0;
   rep->pfx     = rep->cnt = 0;  /* init. the number of items */
   rep->clomax  = NULL;          /* clear the filtering tools */
-  rep->gentab  = NULL;          /* (closed/maximal/generators) */
+  rep->cmhash  = NULL;          /* (closed/maximal/generators) */
+  rep->gentab  = NULL;
+  rep->sigs    = NULL;
   rep->sto     = RSUPP_MAX;     /* clear the storage flag and */
   rep->dir     = 0;             /* the item sorting direction */
   rep->iset    = NULL;          /* cleat the item set buffer */
@@ -522,6 +753,7 @@ ISREPORT* isr_create (ITEMBASE *base)
   rep->evalthh = rep->eval = 0; /* clear evaluation and its minimum */
   rep->repofn  = (ISREPOFN*)0;  /* clear item set report function */
   rep->repodat = NULL;          /* and the corresponding data */
+  rep->shdfn   = (ISSHDFN*)0;   /* clear shard data function */
   rep->rulefn  = (ISRULEFN*)0;  /* clear rule report function */
   rep->ruledat = NULL;          /* and the corresponding data */
   rep->scan    = 0;             /* clear scanable items flag */
@@ -534,6 +766,13 @@ ISREPORT* isr_create (ITEMBASE *base)
   rep->inames  = (const char**)(rep->pos +n+1);
   rep->sum     = 0;             /* clear the total name length */
   rep->repcnt  = 0;             /* init. the item set counter */
+  rep->repmax  = SIZE_MAX;      /* and the maximum (no limit) */
+  rep->nodes   = 0;             /* clear the search node counter */
+  rep->tick    = SIZE_MAX;      /* and the progress reporting */
+  rep->ival    = 0;             /* (no progress function) */
+  rep->progfn  = NULL;
+  rep->progdat = NULL;
+  rep->stop    = 0;
   rep->psp     = NULL;          /* clear pattern spectrum variable */
   rep->file    = NULL;          /* clear the output file and its name */
   rep->name    = NULL;          /* and the file write buffer */
@@ -547,6 +786,16 @@ ISREPORT* isr_create (ITEMBASE *base)
   rep->miscnt  = 0;
   rep->fast    = -1;            /* default: only count the item sets */
   rep->size    = 0;
+  rep->fops    = NULL;          /* info. format is not compiled yet */
+  rep->bin     = 0;             /* default: text output */
+  rep->bflags  = 0;             /* clear the binary format flags, */
+  rep->bset    = NULL;          /* the last item set buffer */
+  rep->bcnt    = 0;             /* and the compression buffer */
+  rep->zbuf    = NULL; rep->zsize = 0;
+  rep->parent  = NULL;          /* not a shard of another reporter */
+  rep->head    = rep->tail = NULL;
+  rep->qlen    = 0;             /* clear the output queue */
+  rep->err     = 0;             /* and its error status */
   rep->out     = NULL;          /* there is no output buffer yet */
   rep->pxpp    = (ITEM*)  malloc((size_t)(4*n+3) *sizeof(ITEM));
   rep->supps   = (RSUPP*) malloc((size_t)(n+1)   *sizeof(RSUPP));
@@ -598,15 +847,21 @@ int isr_delete (ISREPORT *rep, int delis)
   if (rep->out) free(rep->out); /* delete the item set output buffer */
   #ifdef ISR_CLOMAX             /* if closed/maximal filtering */
   if (rep->clomax) cm_delete(rep->clomax);
-  if (rep->gentab) st_delete(rep->gentab);
+  if (rep->cmhash) cmh_delete(rep->cmhash);
+  if (rep->gentab) gt_delete(rep->gentab);
   #endif                        /* delete the closed/maximal filter */
+  if (rep->sigs)   free(rep->sigs);
   #ifdef ISR_PATSPEC            /* if pattern spectrum functions */
   if (rep->psp)    psp_delete(rep->psp);
   #endif                        /* delete the pattern spectrum */
   if (rep->str)    free((void*)rep->str);
+  if (rep->fops)   free(rep->fops);
   if (rep->border) free(rep->border);
+  if (rep->tkheap) free(rep->tkheap);
+  if (rep->tkevals) free(rep->tkevals);
   #ifndef ISR_NONAMES
-  { ITEM i;                     /* loop variable */
+  if (!rep->parent) {           /* names are shared with shards */
+    ITEM i;                     /* loop variable */
     for (i = 0; rep->inames[i]; i++) {
       if (rep->inames[i] != ib_name(rep->base, i))
         free((void*)rep->inames[i]);
@@ -617,16 +872,230 @@ int isr_delete (ISREPORT *rep, int delis)
   if (rep->wgts)   free(rep->wgts);
   if (rep->supps)  free(rep->supps);
   if (rep->pxpp)   free(rep->pxpp);
-  if (rep->base && delis) ib_delete(rep->base);
+  if (rep->base && delis && !rep->parent) ib_delete(rep->base);
+  if (rep->parent && rep->shdfn)/* delete the report data of a shard */
+    rep->shdfn(NULL, &rep->repodat, ISR_DROP);
+  while (rep->head) {           /* delete unmerged shard output */
+    rep->tail = rep->head; rep->head = rep->head->succ;
+    free(rep->tail->buf); free(rep->tail);
+  }                             /* (the output file is the one */
+  if (rep->parent) rep->file = NULL; /* of the parent reporter) */
   r = isr_close(rep);           /* close the output files */
   s = isr_tidclose(rep);        /* (if output files are open) */
   if (rep->buf) free(rep->buf); /* delete the file write buffer */
+  if (rep->zbuf) free(rep->zbuf);  /* and the binary output */
+  if (rep->bset) free(rep->bset);  /* buffers (if any) */
   free(rep);                    /* delete the base structure */
   return (r) ? r : s;           /* return file closing result */
 }  /* isr_delete() */
 
 /*--------------------------------------------------------------------*/
 
+ISREPORT* isr_clone (ISREPORT *rep)
+{                               /* --- create a reporter shard */
+  ISREPORT *shard;              /* created reporter shard */
+  ITEM     i, n;                /* loop variable, number of items */
+
+  assert(rep && !rep->parent);  /* check the function argument */
+  shard = isr_create(rep->base);/* create a reporter for the items */
+  if (!shard) return NULL;      /* and note the parent reporter */
+  shard->parent = rep;          /* (item names are shared with it) */
+  n = ib_cnt(rep->base);        /* get the number of items */
+  #ifndef ISR_NONAMES           /* if to use item names */
+  for (i = 0; i < n; i++) {     /* traverse the items */
+    if (shard->inames[i] != ib_name(rep->base, i))
+      free((void*)shard->inames[i]);
+    shard->inames[i] = rep->inames[i];
+  }                             /* share the (formatted) item names */
+  #endif
+  shard->sum = rep->sum;        /* copy the total name length */
+  shard->supps[0] = rep->supps[0];   /* copy the empty set support */
+  shard->wgts [0] = rep->wgts [0];   /* and the empty set weight */
+  if ((isr_settarg(shard, rep->target, rep->mode, rep->dir) < 0)
+  ||  (isr_setfmtx(shard, rep->scan, rep->hdr, rep->sep, rep->imp,
+                   rep->info, rep->iwf) != 0)) {
+    isr_delete(shard, 0); return NULL; }
+  shard->sto  = rep->sto;       /* copy the target, the filter and */
+  shard->smin = rep->smin;      /* the output format and then */
+  shard->smax = rep->smax;      /* the support and size ranges */
+  shard->zmin = rep->zmin;
+  shard->zmax = rep->zmax;
+  shard->repmax = rep->repmax;  /* and the result limit */
+  if (rep->tkheap && (isr_settopk(shard, rep->topk) != 0)) {
+    isr_delete(shard, 0); return NULL; }
+  if (rep->tkevals
+  && (isr_settopkr(shard, rep->topk, rep->tkdir) != 0)) {
+    isr_delete(shard, 0); return NULL; }
+  for (i = 0; i < rep->bdrcnt; i++)
+    if (isr_setbdr(shard, i, rep->border[i]) < 0) {
+      isr_delete(shard, 0); return NULL; }
+  shard->evalfn  = rep->evalfn; /* copy the filtering border, */
+  shard->evaldat = rep->evaldat;/* the evaluation function */
+  shard->evaldir = rep->evaldir;/* and the reporting functions */
+  shard->evalthh = rep->evalthh;/* (these have to be thread-safe */
+  shard->repofn  = rep->repofn; /* if the shards are used by */
+  shard->repodat = rep->repodat;/* different threads) */
+  shard->rulefn  = rep->rulefn;
+  shard->ruledat = rep->ruledat;
+  if (rep->shdfn) {             /* if shards have own report data */
+    if (rep->shdfn(rep->repodat, &shard->repodat, ISR_SPLIT) != 0) {
+      isr_delete(shard, 0); return NULL; }
+    shard->shdfn = rep->shdfn;  /* create the report data */
+  }                             /* and note the data function */
+  #ifdef ISR_PATSPEC            /* if pattern spectrum functions */
+  if (rep->psp) {               /* if there is a pattern spectrum */
+    shard->psp = psp_create(psp_minsize(rep->psp),psp_maxsize(rep->psp),
+                            psp_minsupp(rep->psp),psp_maxsupp(rep->psp));
+    if (!shard->psp) { isr_delete(shard, 0); return NULL; }
+  }                             /* create a pattern spectrum */
+  #endif                        /* with the same limits */
+  if (rep->file) {              /* if there is an output file */
+    shard->buf = (char*)malloc(BS_WRITE *sizeof(char));
+    if (!shard->buf) { isr_delete(shard, 0); return NULL; }
+    shard->next = shard->buf;   /* create an output buffer */
+    shard->end  = shard->buf +BS_WRITE;
+    shard->file = rep->file;    /* note the file of the parent, */
+    shard->name = rep->name;    /* which is only used for checks */
+    if (rep->bin) {             /* if to write binary output */
+      shard->bset = (ITEM*)malloc((size_t)(n+1) *sizeof(ITEM));
+      if (!shard->bset) { isr_delete(shard, 0); return NULL; }
+      shard->bin    = +1;       /* create a buffer for the last set */
+      shard->bflags = rep->bflags;  /* and copy the format flags */
+    }                           /* (the header is written by */
+  }                             /* the parent reporter) */
+  if (isr_setup(shard) != 0) {  /* set up the reporter shard */
+    isr_delete(shard, 0); return NULL; }
+  return shard;                 /* return the created shard */
+}  /* isr_clone() */
+
+/*--------------------------------------------------------------------*/
+
+static void blkout (ISREPORT *rep, const char *blk, size_t n)
+{                               /* --- write a block of shard output */
+  assert(rep && rep->file && blk); /* check the function arguments */
+  if (rep->bin) binblk(rep, blk, n);
+  else          fwrite(blk, sizeof(char), n, rep->file);
+}  /* blkout() */
+
+/*--------------------------------------------------------------------*/
+
+static void topk (ISREPORT *rep, RSUPP supp, size_t n)
+{                               /* --- update the top-k supports */
+  size_t i, c;                  /* heap indices (parent, child) */
+  RSUPP  *heap;                 /* min-heap of top-k supports */
+
+  assert(rep && rep->tkheap);   /* check the function arguments */
+  heap = rep->tkheap;           /* get the support heap */
+  for ( ; n > 0; n--) {         /* traverse the reported sets */
+    if (rep->tkcnt < rep->topk){/* if the heap is not yet full */
+      for (i = rep->tkcnt++; i > 0; i = c) {
+        c = (i-1) >> 1;         /* get the parent of the new element */
+        if (heap[c] <= supp) break;
+        heap[i] = heap[c];      /* shift larger parents down */
+      }                         /* and store the new support */
+      heap[i] = supp; continue; /* at the position found */
+    }
+    if (supp <= heap[0]) break; /* if support does not qualify, abort */
+    for (i = 0; (c = i+i+1) < rep->tkcnt; i = c) {
+      if ((c+1 < rep->tkcnt) && (heap[c+1] < heap[c])) c++;
+      if (heap[c] >= supp) break;
+      heap[i] = heap[c];        /* sift the new support down */
+    }                           /* (replace the minimum, */
+    heap[i] = supp;             /* shift smaller children up) */
+  }
+  if ((rep->tkcnt >= rep->topk) && (heap[0] > rep->smin))
+    rep->smin = heap[0];        /* raise the minimum support */
+}  /* topk() */
+
+/*--------------------------------------------------------------------*/
+
+static int topkr (ISREPORT *rep, double eval)
+{                               /* --- update the top-k evaluations */
+  size_t i, c;                  /* heap indices (parent, child) */
+  double *heap;                 /* min-heap of top-k evaluations */
+
+  assert(rep && rep->tkevals);  /* check the function arguments */
+  eval *= rep->tkdir;           /* get the directed evaluation */
+  if (eval < rep->tkeval)       /* check whether the rule can be */
+    return -1;                  /* among the top-k rules */
+  heap = rep->tkevals;          /* get the evaluation heap */
+  if (rep->tkcnt < rep->topk) { /* if the heap is not yet full */
+    for (i = rep->tkcnt++; i > 0; i = c) {
+      c = (i-1) >> 1;           /* get the parent of the new element */
+      if (heap[c] <= eval) break;
+      heap[i] = heap[c];        /* shift larger parents down */
+    }                           /* and store the new evaluation */
+    heap[i] = eval; }           /* at the position found */
+  else if (eval > heap[0]) {    /* if better than the current worst */
+    for (i = 0; (c = i+i+1) < rep->tkcnt; i = c) {
+      if ((c+1 < rep->tkcnt) && (heap[c+1] < heap[c])) c++;
+      if (heap[c] >= eval) break;
+      heap[i] = heap[c];        /* sift the new evaluation down */
+    }                           /* (replace the minimum, */
+    heap[i] = eval;             /* shift smaller children up) */
+  }                             /* (ties are reported, not stored) */
+  if (rep->tkcnt >= rep->topk)  /* if the heap is full, */
+    rep->tkeval = heap[0];      /* raise the minimum evaluation */
+  return 0;                     /* return 'rule qualifies' */
+}  /* topkr() */
+
+/*--------------------------------------------------------------------*/
+
+int isr_merge (ISREPORT *rep, ISREPORT *shard)
+{                               /* --- merge a reporter shard */
+  ITEM     i;                   /* loop variable */
+  ISRCHUNK *c;                  /* to traverse the output queue */
+  int      r;                   /* result of merging */
+
+  assert(rep && shard && (shard->parent == rep));
+  for (i = ib_cnt(rep->base); i >= 0; i--)
+    rep->stats[i] += shard->stats[i];
+  rep->repcnt += shard->repcnt; /* sum the item set counters */
+  rep->nodes  += shard->nodes;  /* and the search node counters */
+  if (shard->tick != SIZE_MAX)  /* keep the polling interval */
+    shard->tick -= shard->nodes;/* of the shard and clear */
+  shard->nodes = 0;             /* its search node counter */
+  if (rep->tkheap) {            /* if top-k mining, add the supports */
+    while (shard->tkcnt > 0)    /* of the shard to the parent heap */
+      topk(rep, shard->tkheap[--shard->tkcnt], 1);
+  }                             /* (the shard's raised minimum */
+  if (rep->tkevals) {           /* if top-k rule mining */
+    while (shard->tkcnt > 0)    /* add the evaluations of the shard */
+      topkr(rep, shard->tkevals[--shard->tkcnt] *rep->tkdir);
+  }                             /* (evaluations are stored directed) */
+  r = shard->err;               /* support stays a valid bound) */
+  shard->err = 0;               /* of the shard and clear it */
+  if (shard->shdfn              /* merge the shard's report data */
+  && (shard->shdfn(rep->repodat, &shard->repodat, ISR_JOIN) != 0))
+    r = E_NOMEM;                /* (e.g. a list of item sets) */
+  #ifdef ISR_PATSPEC            /* if pattern spectrum functions */
+  if (rep->psp && shard->psp    /* add the pattern spectrum */
+  && (psp_addpsp(rep->psp, shard->psp) < 0))
+    r = E_NOMEM;                /* (add the signature frequencies) */
+  #endif
+  isr_reset(shard);             /* clear the counters of the shard */
+  if (!shard->file) return r;   /* check for shard output */
+  if (rep->file) {              /* if the output file is still open */
+    if (rep->bin) binflush(rep);/* flush the parent's output buffer */
+    else          isr_flush(rep);  /* (binary: also write header) */
+    for (c = shard->head; c; c = c->succ)
+      blkout(rep, c->buf, c->len); /* write the queued buffers */
+    blkout(rep, shard->buf, (size_t)(shard->next -shard->buf));
+    rep->bcnt = 0;              /* write the current buffer and */
+  }                             /* do not share a prefix afterwards */
+  while (shard->head) {         /* delete the output queue */
+    c = shard->head; shard->head = c->succ;
+    free(c->buf); free(c);      /* (output buffers are reallocated */
+  }                             /* by the output functions) */
+  shard->tail = NULL;           /* clear the output queue */
+  shard->qlen = 0;              /* and the output buffer */
+  shard->next = shard->buf;     /* next record of the shard must */
+  shard->bcnt = 0;              /* not share an item set prefix */
+  return r;                     /* return the error status */
+}  /* isr_merge() */
+
+/*--------------------------------------------------------------------*/
+
 int isr_settarg (ISREPORT *rep, int target, int mode, int dir)
 {                               /* --- set target and operation mode */
   assert(rep);                  /* check the function arguments */
@@ -637,18 +1106,28 @@ int isr_settarg (ISREPORT *rep, int target, int mode, int dir)
   else                           target = ISR_ALL;
   if (target & (ISR_CLOSED|ISR_MAXIMAL))
     mode |= ISR_NOEXPAND;       /* make reporting mode consistent */
+  mode |= rep->mode & ISR_PEXLIST; /* keep perf. ext. list flag */
   rep->target = target;         /* note target (closed/maximal etc) */
   rep->mode   = mode;           /* and reporting mode */
   #ifdef ISR_CLOMAX             /* if closed/maximal filtering */
   if (rep->clomax) { cm_delete(rep->clomax); rep->clomax = NULL; }
-  if (rep->gentab) { st_delete(rep->gentab); rep->gentab = NULL; }
+  if (rep->cmhash) { cmh_delete(rep->cmhash); rep->cmhash = NULL; }
+  if (rep->gentab) { gt_delete(rep->gentab); rep->gentab = NULL; }
+  if (rep->sigs)   { free(rep->sigs);         rep->sigs   = NULL; }
+  if (!(target & ISR_CLOSED) || (mode & ISR_NOFILTER))
+    rep->mode = mode &= ~ISR_CMHASH; /* hash filter only for closed */
   if ((target & (ISR_MAXIMAL|ISR_CLOSED|ISR_GENERAS))
   &&  !(mode & ISR_NOFILTER)) { /* if to filter the item sets */
     if (target & ISR_GENERAS) { /* if to filter for generators, */
-      size_t n = 1024*1024-1;   /* create an item set hash table */
-      rep->gentab = st_create(n, 0, is_hash, is_cmp, NULL, (OBJFN*)0);
+      rep->gentab = gt_create(ib_cnt(rep->base));
       if (!rep->gentab) return E_NOMEM; }
-    else {                      /* if to filter for closed/maximal */
+    else if (mode & ISR_CMHASH){/* if to filter with tid set hashes */
+      rep->cmhash = cmh_create(ib_cnt(rep->base));
+      rep->sigs   = (size_t*)malloc((size_t)(ib_cnt(rep->base)+1)
+                                   *sizeof(size_t));
+      if (!rep->cmhash || !rep->sigs) return E_NOMEM;
+      rep->sigs[0] = 0; }       /* create a hash filter and */
+    else {                      /* signatures for closed item sets */
       rep->clomax = cm_create(dir, ib_cnt(rep->base));
       if (!rep->clomax) return E_NOMEM;
     }                           /* create a closed/maximal filter */
@@ -672,6 +1151,109 @@ void isr_setsupp (ISREPORT *rep, RSUPP smin, RSUPP smax)
 
 /*--------------------------------------------------------------------*/
 
+void isr_setmax (ISREPORT *rep, size_t max)
+{                               /* --- set maximum number of sets */
+  assert(rep);                  /* check the function argument */
+  rep->repmax = (max > 0) ? max : SIZE_MAX;
+}  /* isr_setmax() */           /* (0: no limit) */
+
+/* If the maximum number of item sets (or rules) has been reported, */
+/* all further item sets are dropped and the report functions return */
+/* an error code, so that the search is terminated like on an error. */
+/* Whether the failure was caused by the limit (and not by an actual */
+/* error), can be checked with isr_atmax(). Exactly the maximum      */
+/* number of item sets is reported (unless the search ends earlier). */
+
+/*--------------------------------------------------------------------*/
+
+void isr_setprog (ISREPORT *rep, ISPROGFN *fn, void *data, size_t ival)
+{                               /* --- set progress function */
+  assert(rep);                  /* check the function arguments */
+  rep->progfn  = fn;            /* note the progress function */
+  rep->progdat = data;          /* and its data */
+  rep->ival    = (ival > 0) ? ival : 1;
+  rep->tick    = (fn) ? rep->nodes +rep->ival : SIZE_MAX;
+  rep->stop    = 0;             /* set the first call and */
+}  /* isr_setprog() */          /* clear the cancellation flag */
+
+/*--------------------------------------------------------------------*/
+
+int isr_poll (ISREPORT *rep)
+{                               /* --- call the progress function */
+  assert(rep);                  /* check the function argument */
+  if (rep->stop) return -1;     /* check for a cancelled search */
+  rep->tick = (rep->nodes < SIZE_MAX -rep->ival)
+            ?  rep->nodes +rep->ival : SIZE_MAX;
+  if (!rep->progfn || (rep->progfn(rep, rep->progdat) == 0))
+    return 0;                   /* call the progress function */
+  rep->stop = -1;               /* on cancellation set the flag */
+  rep->tick = 0;                /* and make all later ticks fail */
+  return -1;                    /* return a cancellation code */
+}  /* isr_poll() */
+
+/* The search functions call isr_tick() once for each search node   */
+/* (recursion step). This only increments a counter and compares   */
+/* it to the node count at which the next progress call is due, so */
+/* it is cheap enough for the innermost recursion. Every ival nodes */
+/* the progress function is called, which may inspect the counters */
+/* (isr_nodes(), isr_repcnt()) and return a non-zero value in order */
+/* to cancel the search. Then isr_tick() returns an error code, so */
+/* that the search is terminated like on an error. Whether it was   */
+/* cancelled can be checked afterwards with isr_stopped().          */
+
+/*--------------------------------------------------------------------*/
+
+int isr_settopk (ISREPORT *rep, size_t k)
+{                               /* --- set number of sets for top-k */
+  RSUPP *heap;                  /* min-heap of top-k supports */
+
+  assert(rep);                  /* check the function arguments */
+  heap = NULL;                  /* (k = 0: no top-k mining) */
+  if (k > 0) {                  /* if to find the top-k item sets */
+    heap = (RSUPP*)malloc(k *sizeof(RSUPP));
+    if (!heap) return E_NOMEM;  /* create a support heap */
+  }
+  if (rep->tkheap) free(rep->tkheap);
+  rep->tkheap = heap;           /* store the new heap */
+  rep->topk   = k;              /* and the number of item sets */
+  rep->tkcnt  = 0;              /* (heap is empty) */
+  return 0;                     /* return 'ok' */
+}  /* isr_settopk() */
+
+int isr_settopkr (ISREPORT *rep, size_t k, int dir)
+{                               /* --- set number of rules for top-k */
+  double *heap;                 /* min-heap of top-k evaluations */
+
+  assert(rep);                  /* check the function arguments */
+  heap = NULL;                  /* (k = 0: no top-k mining) */
+  if (k > 0) {                  /* if to find the top-k rules */
+    heap = (double*)malloc(k *sizeof(double));
+    if (!heap) return E_NOMEM;  /* create an evaluation heap */
+  }
+  if (rep->tkevals) free(rep->tkevals);
+  rep->tkevals = heap;          /* store the new heap, */
+  rep->tkdir   = (dir < 0) ? -1 : +1;
+  rep->tkeval  = -DBL_MAX;      /* the evaluation direction */
+  rep->topk    = k;             /* and the number of rules */
+  rep->tkcnt   = 0;             /* (heap is empty) */
+  return 0;                     /* return 'ok' */
+}  /* isr_settopkr() */
+
+/* In top-k mode the reporter keeps the supports of the best k item */
+/* sets reported so far in a min-heap. As soon as the heap is full, */
+/* the minimum support is raised to the smallest support in the    */
+/* heap, so that the search can prune with a higher threshold. The */
+/* reported item sets are a superset of the top-k item sets: sets  */
+/* reported before the minimum support was raised may have to be   */
+/* removed by the caller (all with support below isr_smin()). Ties */
+/* are kept, so that more than k item sets may qualify.            */
+/* For rules the same is done with the rule evaluations, which are  */
+/* multiplied by the direction, so that larger is always better.    */
+/* The current k-th best (directed) evaluation is available with    */
+/* isr_tkeval() and may be used by rule generators for pruning.     */
+
+/*--------------------------------------------------------------------*/
+
 void isr_setsize (ISREPORT *rep, ITEM zmin, ITEM zmax)
 {                               /* --- set size range for item set */
   assert(rep                    /* check the function arguments */
@@ -744,6 +1326,8 @@ int isr_setfmtx (ISREPORT *rep, int scan, CCHAR *hdr, CCHAR *sep,
   *d++ = 0;                     /* copy the information format */
   for (rep->iwf  = d, s = iwf;  *s; ) *d++ = *s++;
   *d++ = 0;                     /* copy the item weight format */
+  if (rep->fops) { free(rep->fops); rep->fops = NULL; }
+                                /* the compiled info. format is void */
   fastchk(rep);                 /* check for fast output */
   return 0;                     /* return 'ok' */
 }  /* isr_setfmtx() */
@@ -782,6 +1366,21 @@ void isr_setrule (ISREPORT *rep, ISRULEFN rulefn, void *data)
 
 /*--------------------------------------------------------------------*/
 
+void isr_setshard (ISREPORT *rep, ISSHDFN *shdfn)
+{                               /* --- set shard data function */
+  assert(rep && !rep->parent);  /* check the function arguments */
+  rep->shdfn = shdfn;           /* store the shard data function */
+}  /* isr_setshard() */
+
+/* The shard data function is called by isr_clone() (ISR_SPLIT) to  */
+/* create the report data of a new shard from that of the parent,   */
+/* by isr_merge() (ISR_JOIN) to move data collected by a shard to   */
+/* the parent, and by isr_delete() (ISR_DROP) to delete shard data. */
+/* It allows the reporting function of the parent to be used with   */
+/* shards, while the results are merged in the order of the merges. */
+
+/*--------------------------------------------------------------------*/
+
 int isr_open (ISREPORT *rep, FILE *file, const char *name)
 {                               /* --- open an output file */
   assert(rep);                  /* check the function arguments */
@@ -798,7 +1397,7 @@ int isr_open (ISREPORT *rep, FILE *file, const char *name)
   else if (!*name) {            /* if an empty name is given */
     file = stdout; rep->name = "<stdout>"; }
   else {                        /* if a proper name is given */
-    file = fopen(rep->name = name, "w");
+    file = fopen(rep->name = name, (rep->bin) ? "wb" : "w");
     if (!file) return E_FOPEN;  /* open file with given name */
   }                             /* and check for an error */
   rep->file = file;             /* store the new output file */
@@ -808,6 +1407,31 @@ int isr_open (ISREPORT *rep, FILE *file, const char *name)
 
 /*--------------------------------------------------------------------*/
 
+int isr_openbin (ISREPORT *rep, FILE *file, const char *name)
+{                               /* --- open a binary output file */
+  int r;                        /* result of isr_open() */
+
+  assert(rep);                  /* check the function arguments */
+  if (!rep->bset) {             /* if there is no item set buffer */
+    rep->bset = (ITEM*)malloc((size_t)(ib_cnt(rep->base)+1)
+                              *sizeof(ITEM));
+    if (!rep->bset) return E_NOMEM;
+  }                             /* create a buffer for the last set */
+  if (!rep->zbuf) {             /* if there is no compression buffer */
+    rep->zbuf = (char*)malloc(LZ_BOUND(BS_WRITE) *sizeof(char));
+    if (!rep->zbuf) return E_NOMEM;
+    rep->zsize = LZ_BOUND(BS_WRITE);
+  }                             /* create a compression buffer */
+  rep->bin  = -1;               /* binary output, no header yet */
+  rep->bcnt =  0;               /* there is no preceding item set */
+  binflg(rep);                  /* set the format flags */
+  r = isr_open(rep, file, name);/* open the output file */
+  if (r) rep->bin = 0;          /* on failure, fall back to text */
+  return r;                     /* return the result of isr_open() */
+}  /* isr_openbin() */
+
+/*--------------------------------------------------------------------*/
+
 int isr_close (ISREPORT *rep)
 {                               /* --- close the output file */
   int r;                        /* result of fclose()/fflush() */
@@ -819,6 +1443,7 @@ int isr_close (ISREPORT *rep)
   r |= ((rep->file == stdout) || (rep->file == stderr))
      ? fflush(rep->file) : fclose(rep->file);
   rep->file = NULL;             /* close the current output file */
+  rep->bin  = 0;                /* and reset to text output */
   fastchk(rep);                 /* check for fast output */
   return r;                     /* return the result of fclose() */
 }  /* isr_close() */
@@ -890,8 +1515,11 @@ int isr_setup (ISREPORT *rep)
   rep->pfx    = rep->cnt = 0;   /* initialize the item counters */
   rep->xmax   = ((rep->target & (ISR_CLOSED|ISR_MAXIMAL))
               && (rep->zmax < ITEM_MAX)) ? rep->zmax+1 : rep->zmax;
-  fastchk(rep);                 /* check for fast output */
-  return 0;                     /* return 'ok '*/
+  if (rep->bin < 0) binflg(rep);/* update the binary format flags */
+  rep->bcnt   = 0;              /* (if header not yet written) */
+  if (fopcomp(rep) != 0) return E_NOMEM;
+  fastchk(rep);                 /* compile the info. output format */
+  return 0;                     /* and check for fast output */
 }  /* isr_setup() */
 
 /*--------------------------------------------------------------------*/
@@ -902,11 +1530,12 @@ int isr_add (ISREPORT *rep, ITEM item, RSUPP supp)
   &&    (item < ib_cnt(rep->base)) && !isr_uses(rep, item));
   /* if (supp < rep->smin) return 0; */
   #ifdef ISR_CLOMAX             /* if closed/maximal filtering */
+  assert(!rep->cmhash);         /* (hash filter needs isr_addsig()) */
   if      (rep->clomax) {       /* if a closed/maximal filter exists */
     int r = cm_add(rep->clomax, item, supp);
     if (r <= 0) return r; }     /* add the item to the c/m filter */
   else if (rep->gentab) {       /* if a generator filter exists */
-    int r = is_isgen(rep, item, supp);
+    int r = gt_isgen(rep->gentab, rep->items, rep->cnt, item, supp);
     if (r <= 0) return r;       /* add item set to the gen. filter */
   }                             /* check if item needs processing */
   #endif
@@ -919,6 +1548,34 @@ int isr_add (ISREPORT *rep, ITEM item, RSUPP supp)
 
 /*--------------------------------------------------------------------*/
 
+int isr_addsig (ISREPORT *rep, ITEM item, RSUPP supp, size_t sig)
+{                               /* --- add an item (with tid set sig.) */
+  assert(rep && (item >= 0)     /* check the function arguments */
+  &&    (item < ib_cnt(rep->base)) && !isr_uses(rep, item));
+  #ifdef ISR_CLOMAX             /* if closed/maximal filtering */
+  if (rep->cmhash) {            /* if a closed set hash filter exists */
+    rep->items[rep->cnt] = item;/* check for a known closed superset */
+    if (cmh_super(rep->cmhash, rep->items, rep->cnt+1, supp, sig))
+      return 0;                 /* (same support and tid set sig.) */
+    rep->sigs[rep->cnt+1] = sig;/* note the signature of the */
+    rep->pxpp [item] |= ITEM_MIN; /* tid set of the extended set */
+    rep->supps[++rep->cnt] = supp;
+    rep->pxpp [  rep->cnt] &= ITEM_MIN;
+    return 1;                   /* store the item and its support */
+  }                             /* and clear the perf. ext. counter */
+  #endif
+  return isr_add(rep, item, supp);
+}  /* isr_addsig() */           /* otherwise add the item normally */
+
+/* A non-closed item set has the same transaction id set as its */
+/* closure, so a known superset with the same support and the   */
+/* same tid set signature shows that the extended set (and all  */
+/* its supersets in the current branch) cannot be closed. This  */
+/* replaces the prefix tree projections of the c/m filter by a  */
+/* single hash table lookup, which pays off for large outputs.  */
+
+/*--------------------------------------------------------------------*/
+
 int isr_addnc (ISREPORT *rep, ITEM item, RSUPP supp)
 {                               /* --- add an item (only support) */
   assert(rep && (item >= 0)     /* check the function arguments */
@@ -929,6 +1586,8 @@ int isr_addnc (ISREPORT *rep, ITEM item, RSUPP supp)
     int r = cm_addnc(rep->clomax, item, supp);
     if (r <= 0) return r;       /* add the item to the c/m filter */
   }                             /* check only for a memory error */
+  else if (rep->gentab)         /* keep the prefix fingerprints */
+    gt_extend(rep->gentab, rep->cnt, item);
   #endif
   rep->pxpp [item] |= ITEM_MIN; /* mark the item as used */
   rep->items[  rep->cnt] = item;/* store the item and its support */
@@ -952,7 +1611,7 @@ int isr_addwgt (ISREPORT *rep, ITEM item, RSUPP supp, double wgt)
     int r = cm_add(rep->clomax, item, supp);
     if (r <= 0) return r; }     /* add the item to the c/m filter */
   else if (rep->gentab) {       /* if a generator filter exists */
-    int r = is_isgen(rep, item, supp);
+    int r = gt_isgen(rep->gentab, rep->items, rep->cnt, item, supp);
     if (r <= 0) return r;       /* add item set to the gen. filter */
   }                             /* check if item needs processing */
   #endif
@@ -1022,6 +1681,44 @@ void isr_remove (ISREPORT *rep, ITEM n)
 
 /*--------------------------------------------------------------------*/
 
+void isr_prefix (ISREPORT *rep, ISREPORT *src)
+{                               /* --- copy the current item set */
+  ITEM i, k, n;                 /* loop variables, buffer for an item */
+  ITEM *p;                      /* to traverse the perfect extensions */
+
+  assert(rep && src             /* check the function arguments */
+  &&    (rep->base == src->base) && (rep != src));
+  isr_remove(rep, rep->cnt);    /* remove all items of the current */
+  for (i = rep->pxpp[0] & ~ITEM_MIN; --i >= 0; )
+    rep->pxpp[*rep->pexs++] &= ~ITEM_MIN;
+  rep->pxpp[0] &= ITEM_MIN;     /* set and all perfect extensions */
+  p = src->items;               /* (perf. exts. are stacked below) */
+  for (k = 0; 1; k++) {         /* traverse the prefix levels */
+    for (i = src->pxpp[k] & ~ITEM_MIN; --i >= 0; ) {
+      n = *--p;                 /* traverse the perfect extensions */
+      rep->pxpp[n] |= ITEM_MIN; /* of the current level, */
+      *--rep->pexs  = n;        /* mark them as used, store them, */
+      rep->pxpp[k]++;           /* and count them for the level */
+    }
+    if (k >= src->cnt) break;   /* check for the last level */
+    n = src->items[k];          /* get the next item of the set */
+    rep->pxpp [n]   |= ITEM_MIN;/* mark the item as used */
+    rep->items[k]    = n;       /* store the item, its support */
+    rep->supps[k+1]  = src->supps[k+1];  /* and its weight */
+    rep->wgts [k+1]  = src->wgts [k+1];
+    rep->pxpp [k+1] &= ITEM_MIN;/* clear the perfect ext. counter */
+    rep->cnt = k+1;             /* of the new level and */
+  }                             /* count the added item */
+}  /* isr_prefix() */
+
+/* The function isr_prefix() sets the current item set of a reporter */
+/* (usually a shard) to the current item set of another reporter,    */
+/* so that a thread can continue the search from this item set. The  */
+/* closed/maximal and generator filters are not updated, so it must  */
+/* only be used if the reporter does not filter the item sets.       */
+
+/*--------------------------------------------------------------------*/
+
 double isr_logrto (ISREPORT *rep, void *data)
 {                               /* --- logarithm of support ratio */
   ITEM   i;                     /* loop variable */
@@ -1079,18 +1776,47 @@ double isr_wgtsupp (ISREPORT *rep, void *data)
 
 /*--------------------------------------------------------------------*/
 
+static int foifmt (char *foinfo, RSUPP supp)
+{                               /* --- format info. for fastout() */
+  #define int    1              /* to check the definition of RSUPP */
+  #define double 2              /* for integer or double */
+  #if RSUPP==double             /* if the support is a double, */
+  #undef int                    /* format it with sprintf() */
+  #undef double
+  return sprintf(foinfo, " (%"RSUPP_FMT")\n", supp);
+  #else                         /* if the support is an integer */
+  #undef int
+  #undef double
+  char buf[BS_INT], *s;         /* buffer for the support digits */
+  int  n;                       /* number of support digits */
+
+  assert(foinfo && (supp >= 0));/* check the function arguments */
+  s = fmtint(buf+BS_INT, (uint64_t)supp);
+  foinfo[0] = ' '; foinfo[1] = '(';
+  memcpy(foinfo+2, s, (size_t)(n = (int)(buf+BS_INT -s)));
+  foinfo[n+2] = ')'; foinfo[n+3] = '\n';
+  return n+4;                   /* build the string " (supp)\n" */
+  #endif                        /* without interpreting a format */
+}  /* foifmt() */
+
+/*--------------------------------------------------------------------*/
+
 static void fastout (ISREPORT *rep, ITEM n)
 {                               /* --- fast output of an item set */
   char       *s;                /* to traverse the output buffer */
   const char *name;             /* to traverse the item names */
 
   assert(rep);                  /* check the function argument */
+  if (rep->repcnt >= rep->repmax)
+    return;                     /* check the result limit */
   rep->stats[rep->cnt] += 1;    /* count the reported item set */
   rep->repcnt          += 1;    /* (for its size and overall) */
   #ifdef ISR_PATSPEC            /* if pattern spectrum functions */
   if (rep->psp)                 /* count item set in pattern spectrum */
     psp_incfrq(rep->psp, rep->cnt, rep->supps[rep->cnt], 1);
   #endif
+  if (rep->tkheap)              /* update the top-k supports */
+    topk(rep, rep->supps[rep->cnt], 1);
   s = rep->pos[rep->pfx];       /* get the position for appending */
   while (rep->pfx < rep->cnt) { /* traverse the additional items */
     if (rep->pfx > 0)           /* if this is not the first item */
@@ -1119,7 +1845,7 @@ static void output (ISREPORT *rep)
   const char *name;             /* to traverse the item names */
 
   assert(rep                    /* check the function arguments */
-  &&    (rep->cnt >= rep->zmin)
+  &&   ((rep->cnt >= rep->zmin) || (rep->mode & ISR_PEXLIST))
   &&    (rep->cnt <= rep->zmax));
   if (rep->border               /* if there is a filtering border */
   && (rep->cnt < rep->bdrcnt)   /* and the set size is in its range */
@@ -1130,27 +1856,36 @@ static void output (ISREPORT *rep)
     if (rep->evaldir *rep->eval < rep->evalthh)
       return;                   /* if the item set does not qualify, */
   }                             /* abort the output function */
+  if (rep->repcnt >= rep->repmax)
+    return;                     /* check the result limit */
   rep->stats[rep->cnt] += 1;    /* count the reported item set */
   rep->repcnt          += 1;    /* (for its size and overall) */
   #ifdef ISR_PATSPEC            /* if pattern spectrum functions */
   if (rep->psp)                 /* count item set in pattern spectrum */
     psp_incfrq(rep->psp, rep->cnt, rep->supps[rep->cnt], 1);
   #endif
+  if (rep->tkheap)              /* update the top-k supports */
+    topk(rep, rep->supps[rep->cnt], 1);
   if (rep->repofn)              /* call reporting function if given */
     rep->repofn(rep, rep->repodat);
   if (!rep->file) return;       /* check for an output file */
-  s = rep->pos[rep->pfx];       /* get the position for appending */
-  while (rep->pfx < rep->cnt) { /* traverse the additional items */
-    if (rep->pfx > 0)           /* if this is not the first item */
-      for (name = rep->sep; *name; )
-        *s++ = *name++;         /* copy the item separator */
-    for (name = rep->inames[rep->items[rep->pfx]]; *name; )
-      *s++ = *name++;           /* copy the item name to the buffer */
-    rep->pos[++rep->pfx] = s;   /* compute and record new position */
-  }                             /* for appending the next item */
-  isr_putsn(rep, rep->out, (int)(s-rep->out));
-  isr_sinfo(rep, rep->supps[rep->cnt], rep->wgts[rep->cnt], rep->eval);
-  isr_putc (rep, '\n');         /* print the item set information */
+  if (rep->bin)                 /* if to write binary output */
+    binout(rep, rep->items, rep->cnt, rep->supps[rep->cnt], rep->eval);
+  else {                        /* if to write text output */
+    s = rep->pos[rep->pfx];     /* get the position for appending */
+    while (rep->pfx < rep->cnt) {  /* traverse the additional items */
+      if (rep->pfx > 0)         /* if this is not the first item */
+        for (name = rep->sep; *name; )
+          *s++ = *name++;       /* copy the item separator */
+      for (name = rep->inames[rep->items[rep->pfx]]; *name; )
+        *s++ = *name++;         /* copy the item name to the buffer */
+      rep->pos[++rep->pfx] = s; /* compute and record new position */
+    }                           /* for appending the next item */
+    isr_putsn(rep, rep->out, (int)(s-rep->out));
+    isr_sinfo(rep, rep->supps[rep->cnt], rep->wgts[rep->cnt],
+              rep->eval);       /* print the item set */
+    isr_putc (rep, '\n');       /* and its information */
+  }
   if (!rep->tidfile || !rep->tids) /* check whether to report */
     return;                        /* a list of transaction ids */
   if      (rep->tidcnt > 0) {   /* if tids are in ascending order */
@@ -1210,6 +1945,8 @@ int isr_report (ISREPORT *rep)
   #endif
 
   assert(rep);                  /* check the function argument */
+  if (rep->repcnt >= rep->repmax)
+    return -1;                  /* check the result limit */
   n = isr_pexcnt(rep);          /* get the number of perfect exts. */
   s = rep->supps[rep->cnt];     /* and the support of the item set */
   #ifdef ISR_CLOMAX             /* closed/maximal filtering support */
@@ -1229,6 +1966,14 @@ int isr_report (ISREPORT *rep)
     if ((rep->target & ISR_MAXIMAL) && (r >= 0))
       return  0;                /* check for a non-maximal item set */
   }                             /* (if the known support is > 0) */
+  else if (rep->cmhash) {       /* if a closed set hash filter exists */
+    if (cmh_super(rep->cmhash, rep->items, rep->cnt, s,
+                  rep->sigs[rep->cnt]))
+      return 0;                 /* check if item set is not closed */
+    if (cmh_add(rep->cmhash, rep->pexs, rep->cnt +n, s,
+                rep->sigs[rep->cnt]) < 0)
+      return -1;                /* add the item set (including the */
+  }                             /* perfect extensions) to the filter */
   #endif
   if ((s < rep->smin) || (s > rep->smax))
     return 0;                   /* check the item set support */
@@ -1247,6 +1992,7 @@ int isr_report (ISREPORT *rep)
       if (rep->psp && (psp_incfrq(rep->psp, z, s, 1) < 0))
         return -1;              /* if a pattern spectrum exists, */
       #endif                    /* count item set in pattern spectrum */
+      if (rep->tkheap) topk(rep, s, 1);
       return 0;                 /* return 'ok' */
     }
     m = 0; z = rep->cnt;        /* and init. the item set counter */
@@ -1269,15 +2015,24 @@ int isr_report (ISREPORT *rep)
         #endif                  /* count item set in pattern spectrum */
       }
     }                           /* (n choose k is the number of */
-    rep->repcnt += m;           /* item sets of size rep->cnt +k) */
+    if (m > rep->repmax -rep->repcnt)   /* item sets of size */
+      m = rep->repmax -rep->repcnt;     /* rep->cnt +k) */
+    rep->repcnt += m;           /* count sets up to the limit */
+    if (rep->tkheap) topk(rep, s, m);
     return 0;                   /* return 'ok' */
   }
   /* It is debatable whether this way of handling perfect extensions  */
   /* in case no output is produced is acceptable for fair benchmarks, */
   /* because the sets in the hypercube are not explicitly generated.  */
   if (rep->fast)                /* format support for fast output */
-    rep->size = sprintf(rep->foinfo, " (%"RSUPP_FMT")\n",
-                        rep->supps[rep->cnt]);
+    rep->size = foifmt(rep->foinfo, rep->supps[rep->cnt]);
+  if ((rep->mode & (ISR_NOEXPAND|ISR_PEXLIST)) == ISR_PEXLIST) {
+    output(rep);                /* if to list the perfect extensions, */
+    #ifndef NDEBUG              /* report only the generator, */
+    isr_flush(rep);             /* as the reporting function can */
+    #endif                      /* access the perfect extensions */
+    return 0;                   /* with isr_pexcnt() and isr_pexs() */
+  }                             /* (expansion is left to the caller) */
   if (rep->mode & ISR_NOEXPAND){/* if not to expand perfect exts. */
     k = rep->cnt +n;            /* if all perfext extensions make */
     if (k > rep->zmax) return 0;/* the item set too large, abort */
@@ -1361,11 +2116,15 @@ int isr_reprule (ISREPORT *rep, ITEM item,
   assert(rep                    /* check the function arguments */
   &&    (item >= 0) && (body > 0) && (head >= 0));
   assert(isr_uses(rep, item));  /* head item must be in item set */
+  if (rep->repcnt >= rep->repmax)
+    return -1;                  /* check the result limit */
   supp = rep->supps[n = rep->cnt]; /* get the item set support */
   if ((supp < rep->smin) || (supp > rep->smax))
     return 0;                   /* check the item set support */
   if ((n    < rep->zmin) || (n    > rep->zmax))
     return 0;                   /* check the item set size */
+  if (rep->tkevals && (topkr(rep, eval) < 0))
+    return 0;                   /* check and note top-k evaluation */
   rep->stats[n] += 1;           /* count the reported rule */
   rep->repcnt   += 1;           /* (for its size and overall) */
   #ifdef ISR_PATSPEC            /* if pattern spectrum functions */
@@ -1376,7 +2135,8 @@ int isr_reprule (ISREPORT *rep, ITEM item,
     rep->eval = eval;           /* note the evaluation */
     rep->rulefn(rep, rep->ruledat, item, body, head);
   }                             /* call the reporting function */
-  if (!rep->file) return 0;     /* check for an output file */
+  if (!rep->file || rep->bin)   /* check for a text output file */
+    return 0;                   /* (rules are not written in binary) */
   isr_puts(rep, rep->hdr);      /* print the record header */
   isr_puts(rep, rep->inames[item]);
   isr_puts(rep, rep->imp);      /* print rule head and impl. sign */
@@ -1399,6 +2159,8 @@ int isr_iset (ISREPORT *rep, const ITEM *items, ITEM n,
 
   assert(rep                    /* check the function arguments */
   &&    (items || (n <= 0)) && (supp >= 0));
+  if (rep->repcnt >= rep->repmax)
+    return -1;                  /* check the result limit */
   if ((supp < rep->smin) || (supp > rep->smax))
     return 0;                   /* check the item set support */
   if ((n    < rep->zmin) || (n    > rep->zmax))
@@ -1419,6 +2181,8 @@ int isr_iset (ISREPORT *rep, const ITEM *items, ITEM n,
     rep->repofn(rep, rep->repodat);
   }                             /* call the reporter function */
   if (!rep->file) return 0;     /* check for an output file */
+  if (rep->bin)                 /* if to write binary output */
+    return binout(rep, items, n, supp, eval);
   i = rep->cnt; rep->cnt = n;   /* note the number of items */
   isr_puts(rep, rep->hdr);      /* print the record header */
   if (n > 0)                    /* print the first item */
@@ -1457,6 +2221,8 @@ int isr_isetx (ISREPORT *rep, const ITEM *items, ITEM n,
     return -1;                  /* if a pattern spectrum exists, */
   #endif                        /* count item set in pattern spectrum */
   if (!rep->file) return 0;     /* check for an output file */
+  if (rep->bin)                 /* if to write binary output */
+    return binout(rep, items, n, supp, eval);   /* (no item weights) */
   i = rep->cnt; rep->cnt = n;   /* note the number of items */
   isr_puts(rep, rep->hdr);      /* print the record header */
   if (n > 0) {                  /* if at least one item */
@@ -1483,17 +2249,22 @@ int isr_rule (ISREPORT *rep, const ITEM *items, ITEM n,
 
   assert(rep                    /* check the function arguments */
   &&     items && (n > 0) && (supp > 0) && (body > 0) && (head > 0));
+  if (rep->repcnt >= rep->repmax)
+    return -1;                  /* check the result limit */
   if ((supp < rep->smin) || (supp > rep->smax))
     return 0;                   /* check the item set support */
   if ((n    < rep->zmin) || (n    > rep->zmax))
     return 0;                   /* check the item set size */
+  if (rep->tkevals && (topkr(rep, eval) < 0))
+    return 0;                   /* check and note top-k evaluation */
   rep->stats[n] += 1;           /* count the reported rule */
   rep->repcnt   += 1;           /* (for its size and overall) */
   if (rep->rulefn) {            /* if a reporting function is given */
     rep->eval = eval;           /* note the evaluation */
     rep->rulefn(rep, rep->ruledat, items[0], body, head);
   }                             /* call the reporting function */
-  if (!rep->file) return 0;     /* check for an output file */
+  if (!rep->file || rep->bin)   /* check for a text output file */
+    return 0;                   /* (rules are not written in binary) */
   i = rep->cnt; rep->cnt = n;   /* note the number of items */
   isr_puts(rep, rep->hdr);      /* print the record header */
   isr_puts(rep, rep->inames[*items++]);
@@ -1519,6 +2290,8 @@ int isr_seqrule (ISREPORT *rep, const ITEM *items, ITEM n,
 
   assert(rep                    /* check the function arguments */
   &&     items && (n > 0) && (supp > 0) && (body > 0) && (head > 0));
+  if (rep->repcnt >= rep->repmax)
+    return -1;                  /* check the result limit */
   if ((supp < rep->smin) || (supp > rep->smax))
     return 0;                   /* check the item set support */
   if ((n    < rep->zmin) || (n    > rep->zmax))
@@ -1533,7 +2306,8 @@ int isr_seqrule (ISREPORT *rep, const ITEM *items, ITEM n,
     rep->eval = eval;           /* note the evaluation */
     rep->rulefn(rep, rep->ruledat, items[n-1], body, head);
   }                             /* call the reporting function */
-  if (!rep->file) return 0;     /* check for an output file */
+  if (!rep->file || rep->bin)   /* check for a text output file */
+    return 0;                   /* (rules are not written in binary) */
   i = rep->cnt; rep->cnt = n;   /* note the number of items */
   isr_puts(rep, rep->hdr);      /* print the record header */
   if (--n > 0)                  /* print the first item in body */
@@ -1613,25 +2387,25 @@ PATSPEC* isr_rempsp (ISREPORT *rep, int delpsp)
 
 int isr_sinfo (ISREPORT *rep, RSUPP supp, double wgt, double eval)
 {                               /* --- print item set information */
-  int        k, n = 0;          /* number of decimals, char. counter */
-  double     sdbl, smax, wmax;  /* (maximum) support and weight */
-  const char *s, *t;            /* to traverse the format */
+  int          k, n = 0;        /* number of decimals, char. counter */
+  double       sdbl, smax, wmax;/* (maximum) support and weight */
+  const ISRFOP *o;              /* to traverse the format operations */
 
   assert(rep);                  /* check the function arguments */
   if (!rep->info || !rep->file)
     return 0;                   /* check for a given format and file */
+  if (!rep->fops && (fopcomp(rep) != 0))
+    return -1;                  /* compile the format if necessary */
   sdbl = (double)supp;          /* get support as double prec. number */
   smax = (double)rep->supps[0]; /* get maximum support and */
   if (smax <= 0) smax = 1;      /* avoid divisions by zero */
   wmax =         rep->wgts[0];  /* get maximum weight  and */
   if (wmax <= 0) wmax = 1;      /* avoid divisions by zero */
-  for (s = rep->info; *s; ) {   /* traverse the output format */
-    if (*s != '%') {            /* copy everything except '%' */
-      isr_putc(rep, *s++); n += 1; continue; }
-    t = s++; k = getsd(s, &s);  /* get the number of signif. digits */
-    switch (*s++) {             /* evaluate the indicator character */
-      case '%': isr_putc(rep, '%'); n += 1;               break;
-    case 'i': n += isr_intout(rep, (ptrdiff_t)rep->cnt);  break;
+  for (o = rep->fops; o->type >= 0; o++) {
+    k = o->len;                 /* traverse the format operations */
+    switch (o->type) {          /* evaluate the indicator character */
+      case  0 : isr_putsn(rep, o->text, k); n += k;       break;
+      case 'i': n += isr_intout(rep, (ptrdiff_t)rep->cnt);  break;
       case 'n': case 'd':
       #define int    1
       #define double 2
@@ -1655,10 +2429,8 @@ int isr_sinfo (ISREPORT *rep, RSUPP supp, double wgt, double eval)
       case 'E': n += isr_numout(rep, 100* eval,       k); break;
       case 'p': n += isr_numout(rep,      eval,       k); break;
       case 'P': n += isr_numout(rep, 100* eval,       k); break;
-      case  0 : --s;            /* print the requested quantity */
-    default : isr_putsn(rep, t, k = (int)(s-t)); n += k; t = s; break;
-    }                           /* otherwise copy characters */
-  }
+    }                           /* print the requested quantity */
+  }                             /* or copy the text */
   return n;                     /* return the number of characters */
 }  /* isr_sinfo() */
 
@@ -1760,3 +2532,63 @@ void isr_getinfo (ISREPORT *rep, const char *sel, double *vals)
     }                           /* store the corresponding value */
   }                             /* in the output vector */
 }  /* isr_getinfo() */
+
+/*----------------------------------------------------------------------
+  Main Function (output benchmark)
+----------------------------------------------------------------------*/
+#ifdef ISR_BENCH
+
+int main (int argc, char *argv[])
+{                               /* --- benchmark text output */
+  ITEMBASE   *base;             /* underlying item base */
+  ISREPORT   *rep;              /* item set reporter */
+  ITEM       i, k, n;           /* loop variable, set size, items */
+  ITEM       lo[9];             /* next item to try per set size */
+  size_t     m;                 /* number of item sets to report */
+  unsigned   r = 1;             /* state of pseudo-random generator */
+  const char *info;             /* item set information format */
+  const char *fname;            /* name of output file */
+  char       name[32];          /* buffer for item names */
+  clock_t    t;                 /* timer for measurements */
+  double     sec;               /* elapsed time in seconds */
+
+  n     = (argc > 1) ? (ITEM)atol(argv[1]) : 1000;
+  m     = (argc > 2) ? (size_t)atol(argv[2]) : 10000000;
+  info  = (argc > 3) ? argv[3] : " (%a)";
+  fname = (argc > 4) ? argv[4] : "/dev/null";
+  if (n < 16) n = 16;           /* get the benchmark parameters */
+  base  = ib_create(0, n);      /* create an item base */
+  if (!base) { fprintf(stderr, "not enough memory\n"); return -1; }
+  for (i = 0; i < n; i++) {     /* add items with numeric names */
+    sprintf(name, "%"ITEM_FMT, i);
+    if (ib_add(base, name) < 0) {
+      fprintf(stderr, "not enough memory\n"); return -1; }
+  }                             /* set the number of transactions */
+  ib_setwgt(base, (SUPP)1 << 22);
+  rep = isr_create(base);       /* create an item set reporter */
+  if (!rep
+  ||  (isr_setfmt(rep, 0, "", " ", " <- ", info) != 0)
+  ||  (isr_open(rep, NULL, fname) != 0)
+  ||  (isr_setup(rep) != 0)) {  /* set format and output file */
+    fprintf(stderr, "cannot set up the reporter\n"); return -1; }
+  t = clock();                  /* start the timer */
+  for (lo[k = 0] = 0; isr_repcnt(rep) < m; ) {
+    r = r *1103515245u +12345u; /* traverse a random search tree */
+    i = lo[k] +(ITEM)((r >> 16) & 7);
+    if ((k < 8) && (i < n) && ((r >> 28) != 0)) {
+      lo[k] = lo[k+1] = i+1;    /* add an item and report the set */
+      isr_add(rep, i, (RSUPP)1 << (20-2*k++));
+      isr_report(rep); }        /* (sets with few items are reported */
+    else if (k > 0) {           /* before their supersets) */
+      isr_remove(rep, 1); k--; }/* backtrack by removing an item */
+    else lo[0] = 0;             /* restart after a full traversal */
+  }
+  isr_close(rep);               /* write the remaining output */
+  sec = (double)(clock()-t) /(double)CLOCKS_PER_SEC;
+  fprintf(stderr, "%zu sets in %.2fs (%.0f sets/s)\n",
+          isr_repcnt(rep), sec, (sec > 0) ? (double)isr_repcnt(rep)/sec : 0);
+  isr_delete(rep, 1);           /* print the output throughput */
+  return 0;                     /* and clean up */
+}  /* main() */
+
+#endif
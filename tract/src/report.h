@@ -35,6 +35,18 @@
             2014.08.27 functions isr_settarg(), isr_target() etc. added
             2014.09.02 return type of reporting functions changed to int
             2014.09.18 functions isr_reprule(), isr_setrule() added
+            2026.10.18 mode ISR_PEXLIST and function isr_setpexl() added
+            2026.10.18 binary output format added (isr_openbin())
+            2026.10.18 reporter shards added (isr_clone(), isr_merge())
+            2026.10.18 compiled item set information format added
+            2026.10.18 mode ISR_CMHASH and function isr_addsig() added
+            2026.10.18 generator filter based on a generator index
+            2026.10.18 top-k item set mining added (isr_settopk())
+            2026.10.18 top-k rule mining added (isr_settopkr())
+            2026.10.18 result limit added (isr_setmax(), isr_atmax())
+            2026.10.18 progress/cancellation hook added (isr_setprog())
+            2026.10.18 function isr_prefix() added (copy current set)
+            2026.10.18 shard data function added (isr_setshard())
 ----------------------------------------------------------------------*/
 #ifndef __REPORT__
 #define __REPORT__
@@ -145,8 +157,21 @@
 /* --- modes (for isr_setup()) --- */
 #define ISR_NOFILTER  0x0010    /* do not use internal filtering */
 #define ISR_MAXONLY   0x0020    /* filter only with maximal sets */
-#define ISR_SORT      0x0040    /* generator filtering needs sorting */
+#define ISR_SORT      0x0040    /* sort items (no longer needed) */
 #define ISR_NOEXPAND  0x0080    /* do not expand perfect extensions */
+#define ISR_PEXLIST   0x0100    /* report perfect exts. as a list */
+#define ISR_CMHASH    0x0200    /* closed filter with tid set hashes */
+
+/* --- binary output format (for isr_openbin()) --- */
+#define ISR_BINMAGIC  "FIMB"    /* magic number at start of file */
+#define ISR_BINVERS   1         /* version of the binary format */
+#define ISR_BINEVAL   0x01      /* evaluation is stored (double) */
+#define ISR_BINDBL    0x02      /* support is stored as a double */
+
+/* --- shard data operations (for isr_setshard()) --- */
+#define ISR_SPLIT     0         /* create report data for a shard */
+#define ISR_JOIN      1         /* merge shard data into parent data */
+#define ISR_DROP      2         /* delete report data of a shard */
 
 /*----------------------------------------------------------------------
   Type Definitions
@@ -156,6 +181,20 @@ typedef double ISEVALFN (struct isreport *rep, void *data);
 typedef void   ISREPOFN (struct isreport *rep, void *data);
 typedef void   ISRULEFN (struct isreport *rep, void *data,
                          ITEM item, RSUPP body, RSUPP head);
+typedef int    ISPROGFN (struct isreport *rep, void *data);
+typedef int    ISSHDFN  (void *data, void **shard, int op);
+
+typedef struct {                /* --- an info. format operation --- */
+  int        type;              /* indicator character (0: text) */
+  int        len;               /* number of digits or text length */
+  const char *text;             /* text to copy (in format string) */
+} ISRFOP;                       /* (information format operation) */
+
+typedef struct isrchunk {       /* --- a queued output buffer --- */
+  struct isrchunk *succ;        /* successor in the output queue */
+  char       *buf;              /* filled output buffer */
+  size_t     len;               /* number of bytes in the buffer */
+} ISRCHUNK;                     /* (queued output buffer) */
 
 typedef struct isreport {       /* --- an item set reporter --- */
   ITEMBASE   *base;             /* underlying item base */
@@ -166,6 +205,12 @@ typedef struct isreport {       /* --- an item set reporter --- */
   ITEM       xmax;              /* maximum number for isr_xable() */
   RSUPP      smin;              /* minimum support of an item set */
   RSUPP      smax;              /* maximum support of an item set */
+  size_t     topk;              /* number of item sets to find */
+  size_t     tkcnt;             /* number of supports in top-k heap */
+  RSUPP      *tkheap;           /* min-heap of the top-k supports */
+  int        tkdir;             /* direction of rule evaluation */
+  double     tkeval;            /* minimum evaluation for top-k */
+  double     *tkevals;          /* min-heap of the top-k evaluations */
   RSUPP      *border;           /* item set filtering border */
   ITEM       bdrcnt;            /* number of used border entries */
   ITEM       bdrsize;           /* size of filtering border */
@@ -179,11 +224,14 @@ typedef struct isreport {       /* --- an item set reporter --- */
   double     *ldps;             /* binary logarithms of item probs. */
   #ifdef ISR_CLOMAX             /* if closed/maximal sets filter */
   CLOMAX     *clomax;           /* closed/maximal item set filter */
-  SYMTAB     *gentab;           /* generator      item set filter */
+  CMHASH     *cmhash;           /* closed item set hash filter */
+  GENTAB     *gentab;           /* generator      item set filter */
   #else                         /* if no closed/maximal sets filter */
   void       *clomax;           /* placeholder (for fixed offsets) */
+  void       *cmhash;           /* dito */
   void       *gentab;           /* dito */
   #endif
+  size_t     *sigs;             /* (prefix) item sets tid set sigs. */
   RSUPP      sto;               /* max. superset support for storing */
   int        dir;               /* direction of item order in clomax */
   ITEM       *iset;             /* additional buffer for an item set */
@@ -194,6 +242,7 @@ typedef struct isreport {       /* --- an item set reporter --- */
   double     eval;              /* additional evaluation value */
   ISREPOFN   *repofn;           /* item set reporting function */
   void       *repodat;          /* item set reporting data */
+  ISSHDFN    *shdfn;            /* shard reporting data function */
   ISRULEFN   *rulefn;           /* assoc. rule reporting function */
   void       *ruledat;          /* assoc. rule reporting data */
   int        scan;              /* flag for scanable item output */
@@ -206,6 +255,13 @@ typedef struct isreport {       /* --- an item set reporter --- */
   const char **inames;          /* (formatted) item names */
   size_t     sum;               /* sum of the item name sizes */
   size_t     repcnt;            /* number of reported item sets */
+  size_t     repmax;            /* maximum number of item sets */
+  size_t     nodes;             /* number of visited search nodes */
+  size_t     tick;              /* node count for next progress call */
+  size_t     ival;              /* nodes between progress calls */
+  ISPROGFN   *progfn;           /* progress/cancellation function */
+  void       *progdat;          /* progress/cancellation data */
+  int        stop;              /* whether the search was cancelled */
   size_t     *stats;            /* reported item sets per set size */
   #ifdef ISR_PATSPEC            /* if pattern spectrum support */
   PATSPEC    *psp;              /* an (optional) pattern spectrum */
@@ -227,6 +283,18 @@ typedef struct isreport {       /* --- an item set reporter --- */
   int        fast;              /* whether fast output is possible */
   int        size;              /* size of set info. for fastout() */
   char       foinfo[64];        /* item set info.    for fastout() */
+  ISRFOP     *fops;             /* compiled item set info. format */
+  int        bin;               /* binary output (-1: no header yet) */
+  int        bflags;            /* flags of binary output format */
+  ITEM       *bset;             /* last item set in binary output */
+  ITEM       bcnt;              /* number of items in last set */
+  char       *zbuf;             /* buffer for compressed blocks */
+  size_t     zsize;             /* size of compressed block buffer */
+  struct isreport *parent;      /* reporter this one is a shard of */
+  ISRCHUNK   *head;             /* queue of filled output buffers */
+  ISRCHUNK   *tail;             /* (written when merged into parent) */
+  size_t     qlen;              /* number of bytes in the queue */
+  int        err;               /* error status of the queue */
   char       *out;              /* output buffer for sets/rules */
   char       *pos[1];           /* append positions in output buffer */
 } ISREPORT;                     /* (item set reporter) */
@@ -237,6 +305,10 @@ typedef struct isreport {       /* --- an item set reporter --- */
 extern ISREPORT* isr_create   (ITEMBASE *base);
 extern int       isr_delete   (ISREPORT *rep, int delis);
 extern ITEMBASE* isr_base     (ISREPORT *rep);
+extern ISREPORT* isr_clone    (ISREPORT *rep);
+extern int       isr_merge    (ISREPORT *rep, ISREPORT *shard);
+extern ISREPORT* isr_parent   (ISREPORT *rep);
+extern size_t    isr_pending  (ISREPORT *rep);
 
 extern int       isr_settarg  (ISREPORT *rep,
                                int target, int mode, int dir);
@@ -245,6 +317,12 @@ extern int       isr_mode     (ISREPORT *rep);
 extern void      isr_setsupp  (ISREPORT *rep, RSUPP smin, RSUPP smax);
 extern ITEM      isr_smin     (ISREPORT *rep);
 extern ITEM      isr_smax     (ISREPORT *rep);
+extern int       isr_settopk  (ISREPORT *rep, size_t k);
+extern size_t    isr_topk     (ISREPORT *rep);
+extern SUPP      isr_tksupp   (ISREPORT *rep, SUPP smin);
+extern int       isr_settopkr (ISREPORT *rep, size_t k, int dir);
+extern int       isr_tkdir    (ISREPORT *rep);
+extern double    isr_tkeval   (ISREPORT *rep);
 extern void      isr_setsize  (ISREPORT *rep, ITEM  zmin, ITEM  zmax);
 extern ITEM      isr_zmin     (ISREPORT *rep);
 extern ITEM      isr_zmax     (ISREPORT *rep);
@@ -273,8 +351,11 @@ extern void      isr_setrepo  (ISREPORT *rep, ISREPOFN repofn,
                                void *data);
 extern void      isr_setrule  (ISREPORT *rep, ISRULEFN rulefn,
                                void *data);
+extern void      isr_setshard (ISREPORT *rep, ISSHDFN *shdfn);
+extern void      isr_setpexl  (ISREPORT *rep, int pexl);
 
 extern int       isr_open     (ISREPORT *rep, FILE *file, CCHAR *name);
+extern int       isr_openbin  (ISREPORT *rep, FILE *file, CCHAR *name);
 extern int       isr_close    (ISREPORT *rep);
 extern FILE*     isr_file     (ISREPORT *rep);
 extern CCHAR*    isr_name     (ISREPORT *rep);
@@ -289,12 +370,15 @@ extern int       isr_setup    (ISREPORT *rep);
 
 extern int       isr_add      (ISREPORT *rep, ITEM item, RSUPP supp);
 extern int       isr_addnc    (ISREPORT *rep, ITEM item, RSUPP supp);
+extern int       isr_addsig   (ISREPORT *rep, ITEM item, RSUPP supp,
+                               size_t sig);
 extern int       isr_addwgt   (ISREPORT *rep, ITEM item, RSUPP supp,
                                double wgt);
 extern int       isr_addpex   (ISREPORT *rep, ITEM item);
 extern void      isr_addpexpk (ISREPORT *rep, ITEM bits);
 extern int       isr_uses     (ISREPORT *rep, ITEM item);
 extern void      isr_remove   (ISREPORT *rep, ITEM n);
+extern void      isr_prefix   (ISREPORT *rep, ISREPORT *src);
 extern int       isr_xable    (ISREPORT *rep, ITEM n);
 
 extern ITEM      isr_cnt      (ISREPORT *rep);
@@ -341,6 +425,14 @@ extern int       isr_seqrule  (ISREPORT *rep, const ITEM *items,ITEM n,
 
 extern void      isr_reset    (ISREPORT *rep);
 extern size_t    isr_repcnt   (ISREPORT *rep);
+extern void      isr_setmax   (ISREPORT *rep, size_t max);
+extern int       isr_atmax    (ISREPORT *rep);
+extern void      isr_setprog  (ISREPORT *rep, ISPROGFN *fn, void *data,
+                               size_t ival);
+extern int       isr_tick     (ISREPORT *rep);
+extern int       isr_poll     (ISREPORT *rep);
+extern size_t    isr_nodes    (ISREPORT *rep);
+extern int       isr_stopped  (ISREPORT *rep);
 extern const size_t* isr_stats (ISREPORT *rep);
 extern void      isr_prstats  (ISREPORT *rep, FILE *out, ITEM min);
 #ifdef ISR_PATSPEC
@@ -367,15 +459,24 @@ extern int       isr_tail     (ISREPORT *rep, const ITEM *items,ITEM n);
   Preprocessor Definitions
 ----------------------------------------------------------------------*/
 #define isr_base(r)       ((r)->base)
+#define isr_parent(r)     ((r)->parent)
+#define isr_pending(r)    ((r)->qlen +(size_t)((r)->next -(r)->buf))
 #define isr_target(r)     ((r)->target)
 #define isr_mode(r)       ((r)->mode)
 #define isr_smin(r)       ((r)->smin)
 #define isr_smax(r)       ((r)->smax)
+#define isr_topk(r)       ((r)->topk)
+#define isr_tksupp(r,s)   (((r)->topk && ((r)->smin > (RSUPP)(s))) \
+                          ? (SUPP)(r)->smin : (s))
+#define isr_tkdir(r)      ((r)->tkdir)
+#define isr_tkeval(r)     ((r)->tkeval)
 #define isr_zmin(r)       ((r)->zmin)
 #define isr_zmax(r)       ((r)->zmax)
 #define isr_getbdr(r,s)   ((r)->border[s])
 #define isr_bdrcnt(r)     ((r)->bdrcnt)
 
+#define isr_setpexl(r,f)  ((r)->mode = (f) ? (r)->mode |  ISR_PEXLIST \
+                                          : (r)->mode & ~ISR_PEXLIST)
 #define isr_setsmt(r,s)   ((r)->supps[0] = (s))
 #define isr_setwgt(r,w)   ((r)->wgts[0]  = (w))
 
@@ -414,6 +515,10 @@ extern int       isr_tail     (ISREPORT *rep, const ITEM *items,ITEM n);
 #define isr_itemobj(r,i)  ib_obj((r)->base, i)
 
 #define isr_repcnt(r)     ((r)->repcnt)
+#define isr_atmax(r)      ((r)->repcnt >= (r)->repmax)
+#define isr_tick(r)       ((++(r)->nodes < (r)->tick) ? 0 : isr_poll(r))
+#define isr_nodes(r)      ((r)->nodes)
+#define isr_stopped(r)    ((r)->stop)
 #define isr_stats(r)      ((const size_t*)(r)->stats)
 #ifdef ISR_PATSPEC
 #define isr_getpsp(r)     ((r)->psp)
@@ -0,0 +1,326 @@
+/*----------------------------------------------------------------------
+  File    : repread.c
+  Contents: reader for binary item set files (written by isr_openbin())
+  History : 2026.10.18 file created
+----------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "repread.h"
+#ifdef STORAGE
+#include "storage.h"
+#endif
+
+/* The binary file format is described in report.c, in the section */
+/* "Binary Output Functions". Malformed or truncated files as well  */
+/* as failures to read are reported as read errors (E_FREAD).       */
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define LZ_MINLEN       4       /* minimum length of a match */
+#define BS_ITEMS      256       /* initial size of the item array */
+
+/*----------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------*/
+
+static int fgetvar (FILE *file, size_t *x)
+{                               /* --- read a variable length int. */
+  int    c;                     /* next character from the file */
+  int    s = 0;                 /* shift for the next 7 bits */
+  size_t v = 0;                 /* value read */
+
+  assert(file && x);            /* check the function arguments */
+  do {                          /* read bytes as long as the */
+    c = getc(file);             /* continuation flag is set */
+    if (c == EOF) return (s > 0) ? E_FREAD : RRD_EOF;
+    if (s >= (int)(8*sizeof(size_t))) return E_FREAD;
+    v |= (size_t)(c & 0x7f) << s; s += 7;
+  } while (c & 0x80);           /* combine the 7 bit pieces */
+  *x = v; return 0;             /* return the value read */
+}  /* fgetvar() */
+
+/*--------------------------------------------------------------------*/
+
+static int getvar (REPREAD *rrd, size_t *x)
+{                               /* --- get a var. length int. (block) */
+  int    s = 0;                 /* shift for the next 7 bits */
+  size_t v = 0;                 /* value read */
+  unsigned char c;              /* next byte from the block */
+
+  assert(rrd && x);             /* check the function arguments */
+  do {                          /* get bytes as long as the */
+    if (rrd->next >= rrd->end)  /* continuation flag is set */
+      return E_FREAD;           /* (records must not cross blocks) */
+    if (s >= (int)(8*sizeof(size_t))) return E_FREAD;
+    c  = *rrd->next++;          /* get the next byte */
+    v |= (size_t)(c & 0x7f) << s; s += 7;
+  } while (c & 0x80);           /* combine the 7 bit pieces */
+  *x = v; return 0;             /* return the value read */
+}  /* getvar() */
+
+/*--------------------------------------------------------------------*/
+
+static int getfix (REPREAD *rrd, uint64_t *x, int n)
+{                               /* --- get a fixed width integer */
+  int      i;                   /* loop variable */
+  uint64_t v = 0;               /* value read */
+
+  assert(rrd && x);             /* check the function arguments */
+  if (rrd->end -rrd->next < n)  /* check for enough bytes */
+    return E_FREAD;             /* in the current block */
+  for (i = 0; i < n; i++)       /* combine the bytes */
+    v |= (uint64_t)rrd->next[i] << (8*i);
+  rrd->next += n;               /* (little endian byte order) */
+  *x = v; return 0;             /* return the value read */
+}  /* getfix() */
+
+/*--------------------------------------------------------------------*/
+
+static size_t getlen (const unsigned char **s, const unsigned char *e,
+                      size_t n)
+{                               /* --- get a literal/match length */
+  unsigned char c;              /* next byte of the length */
+
+  if (n < 15) return n;         /* check for additional bytes */
+  do {                          /* add bytes while they are 255 */
+    if (*s >= e) return SIZE_MAX;
+    n += c = *(*s)++;           /* get the next length byte */
+  } while (c == 255);           /* and add it to the length */
+  return n;                     /* return the length */
+}  /* getlen() */
+
+/*--------------------------------------------------------------------*/
+
+static size_t lzdec (unsigned char *dst, size_t cap,
+                     const unsigned char *src, size_t n)
+{                               /* --- decompress a block */
+  const unsigned char *e = src +n;   /* end of the compressed data */
+  unsigned char       *d = dst;      /* to traverse the output */
+  size_t              k, off;        /* length, offset of a match */
+  int                 t;             /* token of a sequence */
+
+  assert(dst && src);           /* check the function arguments */
+  while (src < e) {             /* traverse the sequences */
+    t = *src++;                 /* get the token and */
+    k = getlen(&src, e, (size_t)(t >> 4)); /* the literal length */
+    if ((k > (size_t)(e -src))  /* check the literal length */
+    ||  (k > cap -(size_t)(d -dst)))
+      return SIZE_MAX;          /* (must fit input and output) */
+    memcpy(d, src, k); d += k; src += k;
+    if (src >= e) break;        /* copy literals, check for end */
+    if (e -src < 2) return SIZE_MAX;
+    off = (size_t)src[0] | ((size_t)src[1] << 8); src += 2;
+    if ((off <= 0) || (off > (size_t)(d -dst)))
+      return SIZE_MAX;          /* get and check the match offset */
+    k = getlen(&src, e, (size_t)(t & 15));
+    if (k == SIZE_MAX) return SIZE_MAX;
+    k += LZ_MINLEN;             /* get and check the match length */
+    if (k > cap -(size_t)(d -dst)) return SIZE_MAX;
+    for ( ; k > 0; k--) {       /* copy the match byte by byte */
+      *d = *(d -off); d++; }    /* (source and destination */
+  }                             /* may overlap) */
+  return (size_t)(d -dst);      /* return the decompressed size */
+}  /* lzdec() */
+
+/*--------------------------------------------------------------------*/
+
+static int getblk (REPREAD *rrd)
+{                               /* --- read the next block */
+  size_t        n, z;           /* raw and compressed block size */
+  unsigned char *p;             /* reallocated buffer */
+  int           r;              /* result of fgetvar() */
+
+  assert(rrd && rrd->file);     /* check the function argument */
+  do {                          /* skip empty blocks */
+    r = fgetvar(rrd->file, &n); /* read the block size */
+    if (r) return ((r == RRD_EOF) && !ferror(rrd->file))
+                  ? RRD_EOF : E_FREAD;
+    r = fgetvar(rrd->file, &z); /* read the compressed size */
+    if (r) return E_FREAD;      /* (EOF must be at block start) */
+  } while ((n <= 0) && (z <= 0));
+  if (n > rrd->bsize) {         /* if the block buffer is too small */
+    p = (unsigned char*)realloc(rrd->blk, n);
+    if (!p) return E_NOMEM;     /* enlarge the block buffer */
+    rrd->blk = p; rrd->bsize = n;
+  }
+  if (z <= 0) {                 /* if the block is not compressed, */
+    if (fread(rrd->blk, 1, n, rrd->file) != n)
+      return E_FREAD; }         /* read the block directly */
+  else {                        /* if the block is compressed */
+    if (z > rrd->zsize) {       /* if the buffer is too small */
+      p = (unsigned char*)realloc(rrd->zbuf, z);
+      if (!p) return E_NOMEM;   /* enlarge the buffer for */
+      rrd->zbuf = p; rrd->zsize = z;  /* the compressed block */
+    }
+    if (fread(rrd->zbuf, 1, z, rrd->file) != z)
+      return E_FREAD;           /* read the compressed block */
+    if (lzdec(rrd->blk, n, rrd->zbuf, z) != n)
+      return E_FREAD;           /* decompress the block */
+  }                             /* and check its size */
+  rrd->next = rrd->blk;         /* set the read position */
+  rrd->end  = rrd->blk +n;      /* and the end of the block */
+  return 0;                     /* return 'ok' */
+}  /* getblk() */
+
+/*----------------------------------------------------------------------
+  Main Functions
+----------------------------------------------------------------------*/
+
+REPREAD* rrd_create (void)
+{                               /* --- create a binary file reader */
+  REPREAD *rrd;                 /* created reader */
+
+  rrd = (REPREAD*)malloc(sizeof(REPREAD));
+  if (!rrd) return NULL;        /* create the base structure */
+  rrd->file  = NULL;            /* clear the file and its name */
+  rrd->name  = NULL;
+  rrd->flags = 0;               /* clear the format information */
+  rrd->supw  = 0;
+  rrd->ncnt  = 0;               /* there are no item names yet */
+  rrd->names = NULL;
+  rrd->cnt   = 0;               /* create the item array */
+  rrd->size  = BS_ITEMS;
+  rrd->items = (ITEM*)malloc((size_t)rrd->size *sizeof(ITEM));
+  if (!rrd->items) { free(rrd); return NULL; }
+  rrd->supp  = rrd->eval = 0;   /* clear the set information */
+  rrd->blk   = rrd->zbuf = NULL;/* there are no block buffers yet */
+  rrd->bsize = rrd->zsize = 0;
+  rrd->next  = rrd->end  = NULL;
+  return rrd;                   /* return the created reader */
+}  /* rrd_create() */
+
+/*--------------------------------------------------------------------*/
+
+static void clrnames (REPREAD *rrd)
+{                               /* --- delete the item names */
+  ITEM i;                       /* loop variable */
+
+  assert(rrd);                  /* check the function argument */
+  if (!rrd->names) return;      /* check for item names */
+  for (i = 0; i < rrd->ncnt; i++)
+    if (rrd->names[i]) free(rrd->names[i]);
+  free(rrd->names);             /* delete the names and the array */
+  rrd->names = NULL; rrd->ncnt = 0;
+}  /* clrnames() */
+
+/*--------------------------------------------------------------------*/
+
+void rrd_delete (REPREAD *rrd)
+{                               /* --- delete a binary file reader */
+  assert(rrd);                  /* check the function argument */
+  rrd_close(rrd);               /* close the input file */
+  clrnames(rrd);                /* and delete the item names */
+  if (rrd->zbuf) free(rrd->zbuf);
+  if (rrd->blk)  free(rrd->blk);
+  free(rrd->items);             /* delete the buffers */
+  free(rrd);                    /* and the base structure */
+}  /* rrd_delete() */
+
+/*--------------------------------------------------------------------*/
+
+int rrd_open (REPREAD *rrd, FILE *file, const char *name)
+{                               /* --- open a binary item set file */
+  unsigned char hdr[8];         /* buffer for the header fields */
+  size_t        n, len;         /* number of names, name length */
+  ITEM          i;              /* loop variable */
+  int           r;              /* result of fgetvar() */
+
+  assert(rrd);                  /* check the function arguments */
+  rrd_close(rrd);               /* close a previously opened file */
+  if (file)                     /* if a file is given, */
+    rrd->name = name;           /* store the file name */
+  else if (!name || !*name) {   /* if no proper name is given */
+    file = stdin;  rrd->name = "<stdin>"; }
+  else {                        /* if a proper name is given */
+    file = fopen(rrd->name = name, "rb");
+    if (!file) return E_FOPEN;  /* open file with given name */
+  }                             /* and check for an error */
+  rrd->file = file;             /* store the input file */
+  rrd->cnt  = 0;                /* there is no item set yet */
+  rrd->next = rrd->end = NULL;  /* and no block */
+  if ((fread(hdr, 1, 8, file) != 8)
+  ||  (memcmp(hdr, ISR_BINMAGIC, 4) != 0)
+  ||  (hdr[4] != ISR_BINVERS))  /* read and check the magic number */
+    return E_FREAD;             /* and the format version */
+  rrd->flags = hdr[5];          /* get the format flags */
+  rrd->supw  = hdr[6];          /* and the support width */
+  if ((rrd->supw < 1) || (rrd->supw > 8)
+  || ((rrd->flags & ISR_BINDBL) && (rrd->supw != 8)))
+    return E_FREAD;             /* check the support width */
+  clrnames(rrd);                /* delete old item names */
+  r = fgetvar(file, &n);        /* read the number of item names */
+  if (r || (n > (size_t)ITEM_MAX)) return E_FREAD;
+  if (n <= 0) return 0;         /* check for item names */
+  rrd->names = (char**)calloc(n, sizeof(char*));
+  if (!rrd->names) return E_NOMEM;
+  rrd->ncnt = (ITEM)n;          /* create the name array */
+  for (i = 0; i < rrd->ncnt; i++) {
+    if (fgetvar(file, &len) != 0) return E_FREAD;
+    rrd->names[i] = (char*)malloc((len+1) *sizeof(char));
+    if (!rrd->names[i]) return E_NOMEM;
+    if (fread(rrd->names[i], 1, len, file) != len) return E_FREAD;
+    rrd->names[i][len] = 0;     /* read the item names */
+  }                             /* (length and characters) */
+  return 0;                     /* return 'ok' */
+}  /* rrd_open() */
+
+/*--------------------------------------------------------------------*/
+
+int rrd_close (REPREAD *rrd)
+{                               /* --- close a binary item set file */
+  int r;                        /* result of fclose() */
+
+  assert(rrd);                  /* check the function argument */
+  if (!rrd->file) return 0;     /* check for an input file */
+  r = (rrd->file == stdin) ? 0 : fclose(rrd->file);
+  rrd->file = NULL;             /* close the input file */
+  return r;                     /* return the result of fclose() */
+}  /* rrd_close() */
+
+/*--------------------------------------------------------------------*/
+
+int rrd_read (REPREAD *rrd)
+{                               /* --- read the next item set */
+  size_t   p, m, x;             /* prefix length, new items, item */
+  uint64_t b;                   /* buffer for a fixed width value */
+  double   d;                   /* buffer for a double value */
+  ITEM     *items;              /* reallocated item array */
+  int      r;                   /* result of getblk() */
+
+  assert(rrd && rrd->file);     /* check the function argument */
+  if (rrd->next >= rrd->end) {  /* if the current block is empty, */
+    r = getblk(rrd);            /* read the next block */
+    if (r) return r;            /* (or report end of file) */
+  }
+  if ((getvar(rrd, &p) != 0) || (p > (size_t)rrd->cnt)
+  ||  (getvar(rrd, &m) != 0) || (m > (size_t)(ITEM_MAX -(ITEM)p)))
+    return E_FREAD;             /* get prefix length and new items */
+  if (p +m > (size_t)rrd->size){/* if the item array is too small */
+    x = (size_t)rrd->size +p +m;
+    items = (ITEM*)realloc(rrd->items, x *sizeof(ITEM));
+    if (!items) return E_NOMEM; /* enlarge the item array */
+    rrd->items = items; rrd->size = (ITEM)x;
+  }
+  for (rrd->cnt = (ITEM)p; m > 0; m--) {
+    if ((getvar(rrd, &x) != 0) || (x > (size_t)ITEM_MAX))
+      return E_FREAD;           /* get the new items */
+    rrd->items[rrd->cnt++] = (ITEM)x;
+  }                             /* and append them to the prefix */
+  if (getfix(rrd, &b, rrd->supw) != 0) return E_FREAD;
+  if (rrd->flags & ISR_BINDBL){ /* if the support is a double, */
+    memcpy(&d, &b, sizeof(d)); rrd->supp = d; }   /* copy the bits */
+  else {                        /* if the support is an integer, */
+    if ((rrd->supw < 8) && ((b >> (8*rrd->supw-1)) & 1))
+      b |= ~(uint64_t)0 << (8*rrd->supw);         /* sign extend */
+    rrd->supp = (double)(int64_t)b;               /* the value */
+  }                             /* get the item set support */
+  if (rrd->flags & ISR_BINEVAL){/* if there is an evaluation */
+    if (getfix(rrd, &b, 8) != 0) return E_FREAD;
+    memcpy(&d, &b, sizeof(d)); rrd->eval = d; }
+  else rrd->eval = 0;           /* get the item set evaluation */
+  return 0;                     /* return 'ok' */
+}  /* rrd_read() */
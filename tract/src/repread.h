@@ -0,0 +1,67 @@
+/*----------------------------------------------------------------------
+  File    : repread.h
+  Contents: reader for binary item set files (written by isr_openbin())
+  History : 2026.10.18 file created
+----------------------------------------------------------------------*/
+#ifndef __REPREAD__
+#define __REPREAD__
+#include "report.h"
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define RRD_EOF       1         /* end of file reached */
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct {                /* --- binary item set file reader --- */
+  FILE       *file;             /* file to read from */
+  const char *name;             /* name of the file */
+  int        flags;             /* format flags (e.g. ISR_BINEVAL) */
+  int        supw;              /* width of support values in bytes */
+  ITEM       ncnt;              /* number of item names */
+  char       **names;           /* item names (may be NULL) */
+  ITEM       cnt;               /* number of items in current set */
+  ITEM       size;              /* size of the item array */
+  ITEM       *items;            /* items of the current set */
+  double     supp;              /* support of the current set */
+  double     eval;              /* evaluation of the current set */
+  unsigned char *blk;           /* buffer for a decompressed block */
+  unsigned char *zbuf;          /* buffer for a compressed block */
+  size_t     bsize, zsize;      /* sizes of the block buffers */
+  unsigned char *next;          /* next byte to read in block */
+  unsigned char *end;           /* end of the current block */
+} REPREAD;                      /* (binary item set file reader) */
+
+/*----------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------*/
+extern REPREAD*    rrd_create (void);
+extern void        rrd_delete (REPREAD *rrd);
+extern int         rrd_open   (REPREAD *rrd, FILE *file, CCHAR *name);
+extern int         rrd_close  (REPREAD *rrd);
+extern int         rrd_read   (REPREAD *rrd);
+
+extern int         rrd_flags  (REPREAD *rrd);
+extern ITEM        rrd_ncnt   (REPREAD *rrd);
+extern CCHAR*      rrd_name   (REPREAD *rrd, ITEM item);
+extern ITEM        rrd_cnt    (REPREAD *rrd);
+extern const ITEM* rrd_items  (REPREAD *rrd);
+extern ITEM        rrd_item   (REPREAD *rrd, ITEM index);
+extern double      rrd_supp   (REPREAD *rrd);
+extern double      rrd_eval   (REPREAD *rrd);
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define rrd_flags(r)      ((r)->flags)
+#define rrd_ncnt(r)       ((r)->ncnt)
+#define rrd_name(r,i)     ((CCHAR*)(r)->names[i])
+#define rrd_cnt(r)        ((r)->cnt)
+#define rrd_items(r)      ((const ITEM*)(r)->items)
+#define rrd_item(r,i)     ((r)->items[i])
+#define rrd_supp(r)       ((r)->supp)
+#define rrd_eval(r)       ((r)->eval)
+
+#endif
@@ -0,0 +1,316 @@
+/*----------------------------------------------------------------------
+  File    : thdpool.c
+  Contents: pool of worker threads for parallel item set mining
+  History : 2026.10.18 file created from the worker code of sam/relim
+----------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <assert.h>
+#include "thdpool.h"
+#ifdef STORAGE
+#include "storage.h"
+#endif
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef struct {                /* --- fork/join job --- */
+  TPLFN      *fn;               /* function to execute */
+  void       *data;             /* data to execute the function on */
+  int        thrd;              /* whether a thread was started */
+  int        err;               /* error status of the function */
+  THREAD     thd;               /* handle of the thread */
+} JOB;                          /* (fork/join job) */
+
+/*----------------------------------------------------------------------
+  Auxiliary Functions
+----------------------------------------------------------------------*/
+
+static int wpoll (ISREPORT *rep, void *data)
+{                               /* --- check for a stop of the workers */
+  return (((THDPOOL*)data)->stop) ? -1 : 0;
+}  /* wpoll() */
+
+/*--------------------------------------------------------------------*/
+
+static WORKERDEF(worker, p)
+{                               /* --- worker function for a thread */
+  TPLWORK *w = (TPLWORK*)p;     /* type the argument pointer */
+  THDPOOL *pool = w->pool;      /* pool the worker belongs to */
+  int     r;                    /* error status */
+
+  assert(p);                    /* check the function argument */
+  r = pool->fn(w->data);        /* execute the task of the worker */
+  if (r < 0) pool->stop = -1;   /* on failure stop all workers, */
+  mtx_lock(&pool->mutex);       /* note the error status, */
+  w->err   = r;                 /* and mark the worker as done */
+  w->state = TPL_DONE;
+  mtx_free(&pool->mutex);
+  return THREAD_OK;             /* return a dummy result */
+}  /* worker() */
+
+/*--------------------------------------------------------------------*/
+
+static void prepare (TPLWORK *w)
+{                               /* --- prepare a worker for a task */
+  ISREPORT *rep = w->pool->report;  /* reporter of calling thread */
+
+  if (rep->repmax < SIZE_MAX)   /* limit the number of results */
+    isr_setmax(w->report, rep->repmax -rep->repcnt);
+}  /* prepare() */
+
+/*----------------------------------------------------------------------
+  Pool Functions
+----------------------------------------------------------------------*/
+
+THDPOOL* tpl_create (ISREPORT *report, int cnt, TPLFN *fn, size_t poll)
+{                               /* --- create a pool of workers */
+  int     i;                    /* loop variable */
+  THDPOOL *pool;                /* created pool of worker threads */
+  TPLWORK *w;                   /* to traverse the workers */
+
+  assert(report && (cnt > 0) && fn);  /* check the function args. */
+  pool = (THDPOOL*)calloc(1, sizeof(THDPOOL)
+                           +(size_t)(cnt-1) *sizeof(TPLWORK));
+  if (!pool) return NULL;       /* create a pool of workers */
+  pool->fn     = fn;            /* and initialize it */
+  pool->report = report;
+  pool->stop   = 0;
+  mtx_init(&pool->mutex);       /* create the state mutex */
+  for (i = 0; i < cnt; i++) {   /* traverse the workers */
+    w = pool->work +i;          /* and create a reporter shard */
+    w->pool   = pool;           /* for each of them */
+    w->report = isr_clone(report);
+    if (!w->report) break;      /* let the workers check for a stop */
+    isr_setprog(w->report, wpoll, pool, poll);
+  }
+  pool->size = pool->cnt = i;   /* note the number of workers */
+  return pool;                  /* return the created pool */
+}  /* tpl_create() */
+
+/* If not all reporter shards can be created, the pool has fewer     */
+/* workers than requested (possibly none), which the caller has to   */
+/* check with tpl_cnt(). The caller may also reduce the number of    */
+/* workers with tpl_setcnt(), e.g. if its own task data for a worker */
+/* cannot be created. The shards are created with a progress function */
+/* that only checks for a stop of the pool, so that all workers stop */
+/* if one of them fails or the calling thread requests it.           */
+
+/*--------------------------------------------------------------------*/
+
+void tpl_delete (THDPOOL *pool)
+{                               /* --- delete a pool of workers */
+  int i;                        /* loop variable */
+
+  assert(pool);                 /* check the function argument */
+  for (i = 0; i < pool->size; i++) {
+    assert(pool->work[i].state == TPL_IDLE);
+    isr_delete(pool->work[i].report, 0);
+  }                             /* delete the reporter shards, */
+  mtx_exit(&pool->mutex);       /* the state mutex */
+  free(pool);                   /* and the pool of workers */
+}  /* tpl_delete() */
+
+/*--------------------------------------------------------------------*/
+
+TPLWORK* tpl_idle (THDPOOL *pool)
+{                               /* --- get an idle worker */
+  int     i, s;                 /* loop variable, worker state */
+  TPLWORK *w = NULL;            /* to traverse the workers */
+
+  assert(pool);                 /* check the function argument */
+  if (pool->stop) return NULL;  /* check for a failed worker */
+  for (i = 0; i < pool->cnt; i++) {
+    w = pool->work +i;          /* traverse the workers */
+    mtx_lock(&pool->mutex);     /* get the state of the worker */
+    s = w->state;               /* (may be changed by the thread) */
+    mtx_free(&pool->mutex);
+    if ((s == TPL_DONE) && (tpl_collect(w) < 0)) {
+      pool->stop = -1; return NULL; }
+    if (s != TPL_BUSY) break;   /* collect the result of the worker */
+  }                             /* and check whether it is idle */
+  if (i >= pool->cnt) return NULL;   /* if no worker is idle, abort */
+  if (isr_atmax(pool->report)) {     /* check the result limit */
+    pool->stop = -1; return NULL; }  /* after merging the results */
+  return w;                     /* return the idle worker */
+}  /* tpl_idle() */
+
+/* The function tpl_idle() returns NULL if no worker is idle or if */
+/* the pool was stopped (due to a failure or the result limit); the */
+/* two cases can be distinguished with tpl_stopped(). The results   */
+/* are merged in the order in which the workers finish.             */
+
+/*--------------------------------------------------------------------*/
+
+TPLWORK* tpl_next (THDPOOL *pool)
+{                               /* --- get the next worker in turn */
+  TPLWORK *w;                   /* worker that is next in turn */
+
+  assert(pool && (pool->cnt > 0));   /* check the function argument */
+  w = pool->work +pool->next;   /* get the worker that is next */
+  mtx_lock(&pool->mutex);       /* if the worker is not idle, */
+  if (w->state != TPL_IDLE) {   /* collect its result */
+    mtx_free(&pool->mutex);     /* (may have to wait for the thread) */
+    if (tpl_collect(w) < 0) { pool->stop = -1; return NULL; } }
+  else mtx_free(&pool->mutex);  /* check for a stop and the limit */
+  if (pool->stop || isr_atmax(pool->report)) {
+    pool->stop = -1; return NULL; }
+  pool->next = (pool->next +1) % pool->cnt;
+  return w;                     /* advance the worker index and */
+}  /* tpl_next() */              /* return the next worker in turn */
+
+/* Since the workers are used in turn and a worker is only reused   */
+/* after its result was merged, the results are merged in the order */
+/* in which the tasks were handed out. This yields the same output  */
+/* as a sequential search if the tasks are the subproblems of the   */
+/* top level of the recursion, processed in the usual order.        */
+
+/*--------------------------------------------------------------------*/
+
+int tpl_start (TPLWORK *w)
+{                               /* --- start a worker thread */
+  #ifdef _WIN32                 /* if Microsoft Windows system */
+  DWORD thid;                   /* dummy for storing the thread id */
+  #endif                        /* (not really needed here) */
+
+  assert(w && (w->state == TPL_IDLE));
+  prepare(w);                   /* prepare the worker for the task */
+  w->state = TPL_BUSY;          /* mark the worker as busy */
+  w->thrd  = 1;                 /* and start a thread for it */
+  #ifdef _WIN32                 /* if Microsoft Windows system */
+  w->thd = CreateThread(NULL, 0, worker, w, 0, &thid);
+  if (w->thd) return 0;         /* if a thread was created, abort */
+  #else                         /* if Linux/Unix system */
+  if (pthread_create(&w->thd, NULL, worker, w) == 0)
+    return 0;                   /* if a thread was created, abort */
+  #endif
+  w->state = TPL_IDLE;          /* otherwise mark the worker */
+  w->thrd  = 0;                 /* as idle again and */
+  return -1;                    /* return an error indicator */
+}  /* tpl_start() */
+
+/* If no thread can be started, the caller may execute the task in  */
+/* the calling thread, either with tpl_run() (to have the result in */
+/* the reporter shard of the worker) or directly.                   */
+
+/*--------------------------------------------------------------------*/
+
+int tpl_run (TPLWORK *w)
+{                               /* --- run a worker in this thread */
+  assert(w && (w->state == TPL_IDLE));
+  prepare(w);                   /* prepare the worker for the task */
+  w->err = w->pool->fn(w->data);/* execute the task of the worker */
+  if (w->err < 0) w->pool->stop = -1;
+  w->thrd  = 0;                 /* on failure stop all workers */
+  w->state = TPL_DONE;          /* hold back the result (merged */
+  return w->err;                /* like that of a worker thread) */
+}  /* tpl_run() */
+
+/*--------------------------------------------------------------------*/
+
+int tpl_collect (TPLWORK *w)
+{                               /* --- collect the result of a worker */
+  int     r;                    /* error status */
+  THDPOOL *pool;                /* pool the worker belongs to */
+
+  assert(w && (w->state != TPL_IDLE));
+  pool = w->pool;               /* get the pool of the worker */
+  if (w->thrd) {                /* if a thread was started */
+    #ifdef _WIN32               /* if Microsoft Windows system */
+    WaitForSingleObject(w->thd, INFINITE);
+    CloseHandle(w->thd);        /* wait for the thread to finish, */
+    #else                       /* then close the thread handle */
+    pthread_join(w->thd, NULL); /* (join thread with this one) */
+    #endif
+    w->thrd = 0;                /* note that there is no thread */
+  }
+  w->state = TPL_IDLE;          /* mark the worker as idle and */
+  r = isr_merge(pool->report, w->report);
+  if ((pool->report->nodes >= pool->report->tick)
+  &&  (isr_poll(pool->report) < 0))  /* merge its reporter shard, */
+    r = -1;                     /* then call the progress function */
+  return (w->err < 0) ? w->err : r;
+}  /* tpl_collect() */          /* with the merged node counter */
+
+/*--------------------------------------------------------------------*/
+
+int tpl_drain (THDPOOL *pool)
+{                               /* --- collect the results of all */
+  int     i, r = 0;             /* loop variable, error status */
+  TPLWORK *w;                   /* to traverse the workers */
+
+  assert(pool);                 /* check the function argument */
+  for (i = 0; i < pool->cnt; i++) {
+    w = pool->work +pool->next; /* traverse the workers in turn */
+    if ((w->state != TPL_IDLE) && (tpl_collect(w) < 0))
+      r = pool->stop = -1;      /* collect the results */
+    pool->next = (pool->next +1) % pool->cnt;
+  }                             /* (in the order of the tasks) */
+  return r;                     /* return the error status */
+}  /* tpl_drain() */
+
+/*----------------------------------------------------------------------
+  Fork/Join Function
+----------------------------------------------------------------------*/
+
+static WORKERDEF(job, p)
+{                               /* --- job function for a thread */
+  JOB *j = (JOB*)p;             /* type the argument pointer */
+
+  assert(p);                    /* check the function argument */
+  j->err = j->fn(j->data);      /* execute the function */
+  return THREAD_OK;             /* return a dummy result */
+}  /* job() */
+
+/*--------------------------------------------------------------------*/
+
+int tpl_exec (void *data, size_t size, int cnt, TPLFN *fn)
+{                               /* --- execute jobs and wait for them */
+  int  i, e = 0;                /* loop variable, error status */
+  JOB  *jobs, *j;               /* to traverse the jobs */
+  #ifdef _WIN32                 /* if Microsoft Windows system */
+  DWORD thid;                   /* dummy for storing the thread id */
+  #endif                        /* (not really needed here) */
+
+  assert(data && (cnt > 0) && fn); /* check the function arguments */
+  jobs = (JOB*)malloc((size_t)cnt *sizeof(JOB));
+  if (!jobs) {                  /* if no job data can be created, */
+    for (i = 0; i < cnt; i++)   /* execute all jobs directly */
+      if (fn((char*)data +(size_t)i *size) < 0) e = -1;
+    return e;                   /* (in the calling thread) */
+  }                             /* and return the error status */
+  for (i = cnt; --i >= 0; ) {   /* traverse the jobs */
+    j = jobs +i; j->fn = fn;    /* and initialize them */
+    j->data = (char*)data +(size_t)i *size;
+    j->err  = 0; j->thrd = (i > 0);
+    if (!j->thrd) break;        /* start a thread for each job */
+    #ifdef _WIN32               /* (except the first) */
+    j->thd = CreateThread(NULL, 0, job, j, 0, &thid);
+    if (!j->thd) { j->thrd = 0; job(j); }
+    #else                       /* if Linux/Unix system */
+    if (pthread_create(&j->thd, NULL, job, j) != 0) {
+      j->thrd = 0; job(j); }    /* if a thread cannot be created, */
+    #endif                      /* execute the job in this thread */
+  }
+  job(jobs);                    /* execute the first job directly */
+  for (i = 0; i < cnt; i++) {   /* traverse the jobs */
+    j = jobs +i;                /* and wait for the threads */
+    #ifdef _WIN32               /* if Microsoft Windows system */
+    if (j->thrd) { WaitForSingleObject(j->thd, INFINITE);
+                   CloseHandle(j->thd); }
+    #else                       /* wait for the thread to finish */
+    if (j->thrd) pthread_join(j->thd, NULL);
+    #endif                      /* (join thread with this one) */
+    if (j->err < 0) e = -1;     /* collect the error status */
+  }
+  free(jobs);                   /* delete the job data */
+  return e;                     /* return the error status */
+}  /* tpl_exec() */
+
+/* The function tpl_exec() executes fn for cnt data elements of the */
+/* given size (in bytes), the first directly in the calling thread, */
+/* all others in threads of their own, and waits for all of them.   */
+/* If a thread cannot be created, its job is executed directly.     */
+/* Unlike the pool functions it needs no item set reporter, so it   */
+/* can also be used for tasks like parallel support counting.       */
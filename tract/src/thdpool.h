@@ -0,0 +1,107 @@
+/*----------------------------------------------------------------------
+  File    : thdpool.h
+  Contents: pool of worker threads for parallel item set mining
+  History : 2026.10.18 file created from the worker code of sam/relim
+----------------------------------------------------------------------*/
+#ifndef __THDPOOL__
+#define __THDPOOL__
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+#include "report.h"
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#ifdef _WIN32                   /* if Microsoft Windows system */
+#define THREAD      HANDLE      /* threads identified by handles */
+#define THREAD_OK   0           /* return value is DWORD */
+#define WORKERDEF(n,p)  DWORD WINAPI n (LPVOID p)
+#define MUTEX       CRITICAL_SECTION
+#define mtx_init(m) InitializeCriticalSection(m)
+#define mtx_exit(m) DeleteCriticalSection(m)
+#define mtx_lock(m) EnterCriticalSection(m)
+#define mtx_free(m) LeaveCriticalSection(m)
+#else                           /* if Linux/Unix system */
+#define THREAD      pthread_t   /* use the POSIX thread type */
+#define THREAD_OK   NULL        /* return value is void* */
+#define WORKERDEF(n,p)  void*        n (void* p)
+#define MUTEX       pthread_mutex_t
+#define mtx_init(m) pthread_mutex_init(m, NULL)
+#define mtx_exit(m) pthread_mutex_destroy(m)
+#define mtx_lock(m) pthread_mutex_lock(m)
+#define mtx_free(m) pthread_mutex_unlock(m)
+#endif                          /* definition of a worker function */
+
+#define TPL_IDLE    0           /* worker is idle */
+#define TPL_BUSY    1           /* worker thread is searching */
+#define TPL_DONE    2           /* result not yet merged */
+
+/*----------------------------------------------------------------------
+  Type Definitions
+----------------------------------------------------------------------*/
+typedef int TPLFN (void *data); /* task function of a worker */
+
+typedef struct {                /* --- worker of a thread pool --- */
+  void         *data;           /* task data (set by the caller) */
+  ISREPORT     *report;         /* item set reporter shard */
+  int          state;           /* state (idle, busy, or done) */
+  int          thrd;            /* whether a thread was started */
+  int          err;             /* error status of the task */
+  THREAD       thd;             /* handle of the thread */
+  struct tpool *pool;           /* pool the worker belongs to */
+} TPLWORK;                      /* (worker of a thread pool) */
+
+typedef struct tpool {          /* --- pool of worker threads --- */
+  TPLFN        *fn;             /* task function of the workers */
+  ISREPORT     *report;         /* reporter of the calling thread */
+  volatile int stop;            /* flag for stopping all workers */
+  MUTEX        mutex;           /* mutex for the worker states */
+  int          size;            /* number of created workers */
+  int          cnt;             /* number of workers in use */
+  int          next;            /* index of the next worker in turn */
+  TPLWORK      work[1];         /* data of the workers */
+} THDPOOL;                      /* (pool of worker threads) */
+
+/*----------------------------------------------------------------------
+  Functions
+----------------------------------------------------------------------*/
+extern THDPOOL*  tpl_create  (ISREPORT *report, int cnt, TPLFN *fn,
+                              size_t poll);
+extern void      tpl_delete  (THDPOOL *pool);
+extern int       tpl_cnt     (THDPOOL *pool);
+extern void      tpl_setcnt  (THDPOOL *pool, int cnt);
+extern TPLWORK*  tpl_worker  (THDPOOL *pool, int i);
+extern void      tpl_stop    (THDPOOL *pool);
+extern int       tpl_stopped (THDPOOL *pool);
+
+extern TPLWORK*  tpl_idle    (THDPOOL *pool);
+extern TPLWORK*  tpl_next    (THDPOOL *pool);
+extern int       tpl_start   (TPLWORK *w);
+extern int       tpl_run     (TPLWORK *w);
+extern int       tpl_collect (TPLWORK *w);
+extern int       tpl_drain   (THDPOOL *pool);
+
+extern void*     tpl_data    (TPLWORK *w);
+extern void      tpl_setdata (TPLWORK *w, void *data);
+extern ISREPORT* tpl_report  (TPLWORK *w);
+
+extern int       tpl_exec    (void *data, size_t size, int cnt,
+                              TPLFN *fn);
+
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#define tpl_cnt(p)        ((p)->cnt)
+#define tpl_setcnt(p,n)   ((p)->cnt = (n))
+#define tpl_worker(p,i)   ((p)->work +(i))
+#define tpl_stop(p)       ((p)->stop = -1)
+#define tpl_stopped(p)    ((p)->stop)
+
+#define tpl_data(w)       ((w)->data)
+#define tpl_setdata(w,d)  ((w)->data = (d))
+#define tpl_report(w)     ((w)->report)
+
+#endif
@@ -89,6 +89,8 @@
             2014.09.09 function ib_frqcnt() added (num. of freq. items)
             2014.10.17 function ib_clear() made a proper function
             2014.10.24 changed from LGPL license to MIT license
+            2026.10.18 SSE2 item array comparison ta_cmpitems() added
+            2026.10.18 item arrays padded for the vector loads (XITEMS)
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -103,6 +105,19 @@
 #ifdef TA_MAIN
 #include "error.h"
 #endif
+#define int         1           /* to check definitions */
+#define long        2           /* for certain types */
+#define ptrdiff_t   3
+#if ITEM==int && defined __SSE2__ && defined __GNUC__ \
+&&  !defined TA_NOSIMD
+#define TA_SSE2                 /* use SSE2 instructions if possible */
+#endif
+#undef int                      /* remove preprocessor definitions */
+#undef long                     /* needed for the type checking */
+#undef ptrdiff_t
+#ifdef TA_SSE2
+#include <emmintrin.h>
+#endif
 #ifdef STORAGE
 #include "storage.h"
 #endif
@@ -144,6 +159,12 @@
 #define TH_INSERT       8       /* threshold for insertion sort */
 #define TS_PRIMES    (sizeof(primes)/sizeof(*primes))
 
+#ifdef TA_SSE2                  /* 8 items (32 bytes) per step */
+#define XITEMS          7       /* extra items after the sentinel */
+#else                           /* (vector loads of ta_cmpitems() */
+#define XITEMS          0       /* must stay in the allocated block) */
+#endif
+
 #ifndef QUIET                   /* if not quiet version, */
 #define MSG         fprintf     /* print messages */
 #else                           /* if quiet version, */
@@ -954,15 +975,17 @@ void ib_show (ITEMBASE *base)
 
 TRACT* ta_create (const ITEM *items, ITEM n, SUPP wgt)
 {                               /* --- create a transaction */
+  ITEM  i;                      /* loop variable */
   TRACT *t;                     /* created transaction */
 
   assert(items || (n <= 0));    /* check the function arguments */
-  t = (TRACT*)malloc(sizeof(TRACT) +(size_t)n *sizeof(ITEM));
+  t = (TRACT*)malloc(sizeof(TRACT) +(size_t)(n+XITEMS) *sizeof(ITEM));
   if (!t) return NULL;          /* allocate a new transaction */
   t->wgt  = wgt;                /* set weight, size and marker */
   t->size = n; t->mark = 0;     /* and copy the items */
   memcpy(t->items, items, (size_t)n *sizeof(ITEM));
-  t->items[n] = TA_END;         /* store a sentinel after the items */
+  for (i = n+XITEMS; i >= n; i--)
+    t->items[i] = TA_END;       /* store a sentinel after the items */
   return t;                     /* and return the created transaction */
 }  /* ta_create() */
 
@@ -1104,18 +1127,57 @@ int ta_equal (const TRACT *t1, const TRACT *t2)
 
 /*--------------------------------------------------------------------*/
 
-int ta_cmp (const void *p1, const void *p2, void *data)
-{                               /* --- compare transactions */
-  const ITEM *a, *b;            /* to traverse the items */
+int ta_cmpitems (const ITEM *a, const ITEM *b)
+{                               /* --- compare item arrays */
+  #ifdef TA_SSE2                /* if SSE2 instructions available */
+  unsigned int m;               /* mismatch and sentinel bit mask */
+  __m128i      x0, x1, y0, y1;  /* items of the two arrays */
+  __m128i      e;               /* vector of sentinel bounds */
+  #endif
 
-  assert(p1 && p2);             /* check the function arguments */
-  a = ((const TRACT*)p1)->items;
-  b = ((const TRACT*)p2)->items;
-  for ( ; 1; a++, b++) {        /* traverse the item arrays */
+  assert(a && b);               /* check the function arguments */
+  #ifdef TA_SSE2                /* if SSE2 instructions available */
+  e = _mm_set1_epi32(TA_END+1); /* get the sentinel bound vector */
+  while (1) {                   /* lexicographic comparison loop */
+    x0 = _mm_loadu_si128((const __m128i*) a);
+    x1 = _mm_loadu_si128((const __m128i*)(a+4));
+    y0 = _mm_loadu_si128((const __m128i*) b);
+    y1 = _mm_loadu_si128((const __m128i*)(b+4));
+    m  = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi32(x0, y0))
+       | (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi32(x1, y1)) << 16;
+    m  = ~m                     /* find mismatches and sentinels */
+       | (unsigned int)_mm_movemask_epi8(_mm_cmpgt_epi32(e, x0))
+       | (unsigned int)_mm_movemask_epi8(_mm_cmpgt_epi32(e, x1)) << 16;
+    if (m) {                    /* if there is a mismatch/sentinel */
+      m = (unsigned int)__builtin_ctz(m) >> 2;
+      return (a[m] < b[m]) ? -1 : (a[m] > b[m]) ? +1 : 0;
+    }                           /* compare the first such items */
+    a += 8; b += 8;             /* (equal items mean a sentinel) */
+  }                             /* and otherwise go to next items */
+  #else                         /* if no SSE2 instructions available */
+  for ( ; 1; a++, b++) {        /* lexicographic comparison loop */
     if (*a < *b) return -1;     /* compare corresponding items */
     if (*a > *b) return +1;     /* and if one is greater, abort */
     if (*a <= TA_END) return 0; /* otherwise check for the sentinel */
   }                             /* and abort if it is reached */
+  #endif
+}  /* ta_cmpitems() */
+
+/* The SSE2 version compares 8 items per step: it determines a bit  */
+/* mask of the item positions at which the arrays differ or at which */
+/* the first array has a sentinel (end marker), and the first set   */
+/* bit yields the item that decides the comparison. Items following */
+/* the sentinel may be loaded, but their values are ignored. Such   */
+/* loads read at most 7 items beyond the sentinel, which is why all */
+/* transactions are allocated with XITEMS extra items at the end.   */
+
+/*--------------------------------------------------------------------*/
+
+int ta_cmp (const void *p1, const void *p2, void *data)
+{                               /* --- compare transactions */
+  assert(p1 && p2);             /* check the function arguments */
+  return ta_cmpitems(((const TRACT*)p1)->items,
+                     ((const TRACT*)p2)->items);
 }  /* ta_cmp() */
 
 /* Note that this comparison function also works correctly if there */
@@ -1174,16 +1236,9 @@ int ta_cmplim (const void *p1, const void *p2, void *data)
 
 int ta_cmpsfx (const void *p1, const void *p2, void *data)
 {                               /* --- compare transaction suffixes */
-  const ITEM *a, *b;            /* to traverse the items */
-
   assert(p1 && p2);             /* check the function arguments */
-  a = ((const TRACT*)p1)->items +*(ITEM*)data;
-  b = ((const TRACT*)p2)->items +*(ITEM*)data;
-  for ( ; 1; a++, b++) {        /* traverse the item arrays */
-    if (*a < *b) return -1;     /* compare corresponding items */
-    if (*a > *b) return +1;     /* and if one is greater, abort */
-    if (*a <= TA_END) return 0; /* otherwise check for the sentinel */
-  }                             /* and abort if it is reached */
+  return ta_cmpitems(((const TRACT*)p1)->items +*(ITEM*)data,
+                     ((const TRACT*)p2)->items +*(ITEM*)data);
 }  /* ta_cmpsfx() */
 
 /*--------------------------------------------------------------------*/
@@ -1657,7 +1712,7 @@ void tbg_delete (TABAG *bag, int delib)
 static TABAG* clone (TABAG *bag)
 {                               /* --- clone memory structure */
   TID    i;                     /* loop variable */
-  ITEM   n;                     /* number of items */
+  ITEM   n, k;                  /* number of items, loop var. */
   TABAG  *dst;                  /* created clone of the trans. bag */
   TRACT  *t;                    /* to traverse the transactions */
   WTRACT *x;                    /* to traverse the transactions */
@@ -1682,10 +1737,12 @@ static TABAG* clone (TABAG *bag)
   else {                        /* if simple transactions */
     for (i = 0; i < bag->cnt; i++) { /* traverse the transactions */
       n = ((TRACT*)bag->tracts[i])->size;
-      t = (TRACT*)malloc(sizeof(TRACT) +(size_t)(n+1) *sizeof(ITEM));
+      t = (TRACT*)malloc(sizeof(TRACT)
+                        +(size_t)(n+1+XITEMS) *sizeof(ITEM));
       if (!t) { tbg_delete(dst, 0); return NULL; }
       t->wgt  = 1;              /* create and init. the transaction */
-      t->size = n; t->mark = 0; t->items[n] = TA_END;
+      t->size = n; t->mark = 0;
+      for (k = n+XITEMS; k >= n; k--) t->items[k] = TA_END;
       dst->tracts[dst->cnt++] = t;
     }                           /* note the transaction size and */
   }                             /* store the created transaction */
@@ -53,6 +53,7 @@
             2014.09.08 transaction marker functions added (ta_..mark())
             2014.09.09 function ib_frqcnt() added (num. of freq. items)
             2014.10.17 function ib_clear() made a proper function
+            2026.10.18 function ta_cmpitems() added (SSE2 comparison)
 ----------------------------------------------------------------------*/
 #ifndef __TRACT__
 #define __TRACT__
@@ -621,6 +622,7 @@ extern ITEM         ta_pack     (TRACT *t, int n);
 extern ITEM         ta_unpack   (TRACT *t, int dir);
 
 extern int          ta_equal    (const TRACT *t1, const TRACT *t2);
+extern int          ta_cmpitems (const ITEM *a, const ITEM *b);
 extern int          ta_cmp      (const void *p1,
                                  const void *p2, void *data);
 extern int          ta_cmpep    (const void *p1,
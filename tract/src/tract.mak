@@ -155,6 +155,10 @@ report.obj:   report.h tract.h $(UTILDIR)\symtab.h
 report.obj:   report.c tract.mak
 	$(CC) $(CFLAGS) $(INCS) /D ISR_PATSPEC report.c /Fo$@
 
+repread.obj:  repread.h report.h tract.h $(UTILDIR)\arrays.h
+repread.obj:  repread.c tract.mak
+	$(CC) $(CFLAGS) $(INCS) repread.c /Fo$@
+
 repdbl.obj:   report.h tract.h $(UTILDIR)\symtab.h
 repdbl.obj:   report.c tract.mak
 	$(CC) $(CFLAGS) $(INCS) /D RSUPP=double /D ISR_PATSPEC \
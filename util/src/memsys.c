@@ -10,6 +10,8 @@
             2010.09.07 persistent allocation error indicator added
             2010.12.07 several explicit type casts added (for C++)
             2013.03.20 stack variables (cap, top) changed to size_t
+            2026.10.18 global memory limit added (ms_limit(), ms_over())
+            2026.10.18 linear (stack) allocator added (mst_alloc() etc.)
 ----------------------------------------------------------------------*/
 #include <stdio.h>
 #include <stdlib.h>
@@ -19,6 +21,28 @@
 #include "storage.h"
 #endif
 
+/*----------------------------------------------------------------------
+  Preprocessor Definitions
+----------------------------------------------------------------------*/
+#ifdef __GNUC__                 /* atomic update of the block total */
+#define MS_ADD(n)     __sync_add_and_fetch(&mstotal, (size_t)(n))
+#define MS_SUB(n)     __sync_sub_and_fetch(&mstotal, (size_t)(n))
+#else                           /* (memory systems may be used */
+#define MS_ADD(n)     (mstotal += (size_t)(n))  /* in several threads) */
+#define MS_SUB(n)     (mstotal -= (size_t)(n))
+#endif
+
+#define MST_ALIGN     16        /* alignment of stack allocations */
+#define MST_HDR       ((sizeof(MSBLK) +15) & ~(size_t)15)  /* header */
+#define MST_DATA(b)   ((char*)(b) +MST_HDR)
+
+/*----------------------------------------------------------------------
+  Global Variables
+----------------------------------------------------------------------*/
+static size_t          msmax   = 0; /* limit for the block memory */
+static volatile size_t mstotal = 0; /* total size of memory blocks */
+static volatile int    msover  = 0; /* whether limit was exceeded */
+
 /*----------------------------------------------------------------------
   Main Functions
 ----------------------------------------------------------------------*/
@@ -49,7 +73,7 @@ void ms_delete (MEMSYS *ms)
 
   assert(ms);                   /* check the function argument */
   for (b = ms->list; b; b = ms->list) {
-    ms->list = (void**)*b; free(b); }
+    ms->list = (void**)*b; free(b); MS_SUB(ms->mbsz *sizeof(void*)); }
   while (ms->list) {            /* delete the list of blocks */
     b = ms->list; ms->list = (void**)*b; free(b); }
   if (ms->stack) free(ms->stack);  /* delete a possible stack */
@@ -66,7 +90,8 @@ void ms_clear (MEMSYS *ms, int shrink)
     ms->next = ms->curr = NULL; /* clear the unassigned objects */
   else {                        /* if there are memory blocks, */
     if (shrink) {               /* if to shrink the memory block list */
-      while (*b) { ms->list = (void**)*b; free(b); b = ms->list; }
+      while (*b) { ms->list = (void**)*b; free(b); b = ms->list;
+                   MS_SUB(ms->mbsz *sizeof(void*)); }
       b[1] = NULL;              /* delete all but the last block */
     }                           /* and clear its successor pointer */
     ms->curr = b;               /* set the only memory block that */
@@ -100,8 +125,15 @@ void* ms_alloc (MEMSYS *ms)
     ms->curr = b = (void**)b[1];/* if there is a successor block */
     ms->next = obj = b+2; }     /* and get its first object */
   else {                        /* if there is no new object left */
+    if (msmax > 0) {            /* if the block memory is limited */
+      if (MS_ADD(ms->mbsz *sizeof(void*)) > msmax) {
+        MS_SUB(ms->mbsz *sizeof(void*));
+        msover = 1; ms->err = -1; return NULL;
+      } }                       /* check and note the block size */
+    else MS_ADD(ms->mbsz *sizeof(void*));
     b = (void**)malloc(ms->mbsz *sizeof(void*));
-    if (!b) { ms->err = -1; return NULL; }
+    if (!b) { MS_SUB(ms->mbsz *sizeof(void*));
+              ms->err = -1; return NULL; }
     b[1] = NULL;                /* allocate a new memory block and */
     b[0] = ms->list;            /* add it at the end of the list */
     if (ms->list) ms->list[1] = b;
@@ -162,3 +194,134 @@ ptrdiff_t ms_pop (MEMSYS *ms)
   ms->used = s->used;
   return (ptrdiff_t)ms->top;    /* return the new stack size */
 }  /* ms_pop() */
+
+/*--------------------------------------------------------------------*/
+
+void ms_limit (size_t max)
+{                               /* --- set a global memory limit */
+  msmax  = max;                 /* note the limit for memory blocks */
+  msover = 0;                   /* (0: no limit) and clear */
+}  /* ms_limit() */             /* the limit exceeded flag */
+
+/*--------------------------------------------------------------------*/
+
+int ms_over (void)
+{ return msover; }              /* --- check for an exceeded limit */
+
+/*--------------------------------------------------------------------*/
+
+size_t ms_total (void)
+{ return mstotal; }             /* --- get total size of all blocks */
+
+/* The memory limit is global, that is, it refers to the memory     */
+/* blocks of all memory systems together, so that it also covers   */
+/* memory systems that are created in the recursion of a miner or   */
+/* used in parallel threads. An allocation that would exceed the    */
+/* limit fails (like an allocation failure), but ms_over() tells    */
+/* the caller that the failure is due to the limit.                 */
+
+/*----------------------------------------------------------------------
+  Linear (Stack) Allocator Functions
+----------------------------------------------------------------------*/
+
+MSSTACK* mst_create (size_t bsz)
+{                               /* --- create a stack allocator */
+  MSSTACK *st;                  /* created stack allocator */
+
+  assert(bsz > 0);              /* check the function argument */
+  st = (MSSTACK*)malloc(sizeof(MSSTACK));
+  if (!st) return NULL;         /* create the base structure */
+  st->bsz  = (bsz +MST_ALIGN-1) & ~(size_t)(MST_ALIGN-1);
+  st->curr = NULL;              /* note the (aligned) block size */
+  st->next = st->end = NULL;    /* there are no memory blocks yet */
+  st->err  = 0;                 /* clear the error indicator */
+  return st;                    /* return the created allocator */
+}  /* mst_create() */
+
+/*--------------------------------------------------------------------*/
+
+static void blkdel (MSBLK *b)
+{                               /* --- delete a list of blocks */
+  MSBLK *s;                     /* successor block */
+
+  for ( ; b; b = s) {           /* traverse the blocks */
+    s = b->succ; MS_SUB(MST_HDR +b->size); free(b); }
+}  /* blkdel() */
+
+/*--------------------------------------------------------------------*/
+
+void mst_delete (MSSTACK *st)
+{                               /* --- delete a stack allocator */
+  MSBLK *b;                     /* to traverse the memory blocks */
+
+  assert(st);                   /* check the function argument */
+  if ((b = st->curr)) {         /* if there are memory blocks, */
+    while (b->pred) b = b->pred;/* find the first block and */
+    blkdel(b);                  /* delete all memory blocks */
+  }
+  free(st);                     /* delete the base structure */
+}  /* mst_delete() */
+
+/*--------------------------------------------------------------------*/
+
+void* mst_alloc (MSSTACK *st, size_t size)
+{                               /* --- allocate memory on the stack */
+  char  *p;                     /* allocated memory */
+  MSBLK *b;                     /* next/new memory block */
+  size_t z;                     /* size of a new memory block */
+
+  assert(st);                   /* check the function argument */
+  size = (size > 0) ? (size +MST_ALIGN-1) & ~(size_t)(MST_ALIGN-1)
+                   : MST_ALIGN; /* align the requested size */
+  if (size > (size_t)(st->end -st->next)) {
+    b = (st->curr) ? st->curr->succ : NULL;
+    if (b && (b->size < size)) {/* if the next block is too small, */
+      st->curr->succ = NULL;    /* delete it and all its successors */
+      blkdel(b); b = NULL;      /* (they are not used anyway) */
+    }
+    if (!b) {                   /* if there is no usable block */
+      z = (size > st->bsz) ? size : st->bsz;
+      if (msmax > 0) {          /* if the block memory is limited */
+        if (MS_ADD(MST_HDR +z) > msmax) {
+          MS_SUB(MST_HDR +z); msover = 1; st->err = -1; return NULL; }
+      }                         /* check and note the block size */
+      else MS_ADD(MST_HDR +z);
+      b = (MSBLK*)malloc(MST_HDR +z);
+      if (!b) { MS_SUB(MST_HDR +z); st->err = -1; return NULL; }
+      b->size = z;              /* allocate a new memory block */
+      b->succ = NULL;           /* and append it to the list */
+      b->pred = st->curr;       /* after the current block */
+      if (st->curr) st->curr->succ = b;
+    }
+    st->curr = b;               /* make the block the current one */
+    st->next = MST_DATA(b);     /* and get its memory range */
+    st->end  = st->next +b->size;
+  }
+  p = st->next;                 /* get the next free memory */
+  st->next += size;             /* and advance the position */
+  return p;                     /* return the allocated memory */
+}  /* mst_alloc() */
+
+/*--------------------------------------------------------------------*/
+
+void mst_free (MSSTACK *st, void *obj)
+{                               /* --- free memory on the stack */
+  char  *p = (char*)obj;        /* memory to free */
+  MSBLK *b;                     /* to traverse the memory blocks */
+
+  assert(st && obj && st->curr);/* check the function arguments */
+  for (b = st->curr; (p < MST_DATA(b)) || (p >= MST_DATA(b) +b->size);
+       b = b->pred)             /* find the block containing obj */
+    assert(b->pred);            /* (all later blocks become free) */
+  st->curr = b;                 /* free the memory from obj on */
+  st->next = p;                 /* (the freed blocks are kept */
+  st->end  = MST_DATA(b) +b->size;   /* for later allocations) */
+}  /* mst_free() */
+
+/* A stack allocator hands out memory from large blocks in strict  */
+/* LIFO order: mst_free() releases the given object and everything */
+/* allocated after it. Hence an allocation in a recursion and the  */
+/* corresponding release on return cost only a pointer update, and */
+/* no memory is returned to the system until mst_delete(). Blocks  */
+/* are counted for the global memory limit (see ms_limit()).       */
+
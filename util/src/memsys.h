@@ -9,6 +9,8 @@
             2010.08.03 state stack, functions ms_push(), ms_pop() added
             2010.09.07 functions ms_error() and ms_reset() added
             2013.03.20 stack variables (cap, top) changed to size_t
+            2026.10.18 global memory limit added (ms_limit(), ms_over())
+            2026.10.18 linear (stack) allocator added (mst_alloc() etc.)
 ----------------------------------------------------------------------*/
 #ifndef __MEMSYS__
 #define __MEMSYS__
@@ -38,6 +40,20 @@ typedef struct {                /* --- memory management system --- */
   MSSTATE *stack;               /* stack of memory system states */
 } MEMSYS;                       /* (memory management system) */
 
+typedef struct msblk {          /* --- stack memory block --- */
+  struct msblk *succ;           /* successor block (next to use) */
+  struct msblk *pred;           /* predecessor block */
+  size_t       size;            /* usable size of the block in bytes */
+} MSBLK;                        /* (stack memory block) */
+
+typedef struct {                /* --- linear (stack) allocator --- */
+  size_t  bsz;                  /* minimum size of a memory block */
+  MSBLK   *curr;                /* current memory block */
+  char    *next;                /* next free byte in current block */
+  char    *end;                 /* end of the current block */
+  int     err;                  /* allocation error indicator */
+} MSSTACK;                      /* (linear/stack allocator) */
+
 /*----------------------------------------------------------------------
   Functions
 ----------------------------------------------------------------------*/
@@ -52,6 +68,15 @@ extern int       ms_error  (MEMSYS *ms);
 extern int       ms_reset  (MEMSYS *ms);
 extern size_t    ms_used   (MEMSYS *ms);
 extern size_t    ms_umax   (MEMSYS *ms);
+extern void      ms_limit  (size_t max);
+extern int       ms_over   (void);
+extern size_t    ms_total  (void);
+
+extern MSSTACK*  mst_create (size_t bsz);
+extern void      mst_delete (MSSTACK *st);
+extern void*     mst_alloc  (MSSTACK *st, size_t size);
+extern void      mst_free   (MSSTACK *st, void *obj);
+extern int       mst_error  (MSSTACK *st);
 
 /*----------------------------------------------------------------------
   Preprocessor Definitions
@@ -60,5 +85,6 @@ extern size_t    ms_umax   (MEMSYS *ms);
 #define ms_reset(m)      ((m)->err = 0)
 #define ms_used(m)       ((m)->used)
 #define ms_umax(m)       ((m)->umax)
+#define mst_error(s)     ((s)->err)
 
 #endif